@@ -0,0 +1,574 @@
+// main.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <safe_forward_list.hpp>
+#include <safe_list.hpp>
+#include <safe_list_snapshot.hpp>
+#include <safe_magazine_allocator.hpp>
+#include <safe_unrolled_list.hpp>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace bench {
+    using ::mjx::safe_list;
+    using ::mjx::safe_unrolled_list;
+
+#ifndef SAFE_LIST_CHECKED_ITERATORS
+    // Note: The iterator checks must cost nothing unless they are requested, compare with safe_list_bench_checked.
+    static_assert(sizeof(safe_list<int>::iterator) == sizeof(void*), "unchecked iterators must be a node pointer.");
+#endif // SAFE_LIST_CHECKED_ITERATORS
+
+    template <size_t _Size>
+    struct _Payload { // element of the given size, compared by its first byte
+        unsigned char _Bytes[_Size];
+
+        _Payload() noexcept : _Bytes{} {}
+
+        _Payload(const size_t _Seed) noexcept : _Bytes{} {
+            _Bytes[0] = static_cast<unsigned char>(_Seed);
+        }
+
+        bool _Is_odd() const noexcept {
+            return (_Bytes[0] & 1) != 0;
+        }
+
+        size_t _Key() const noexcept {
+            return _Bytes[0];
+        }
+    };
+
+    // Note: safe_list<T> reports failures through its return values, the standard containers throw.
+    //       The functions below hide the differences, so every benchmark is written once for all containers.
+    template <class _Container, class _Ty>
+    inline void _Push_back(_Container& _Cont, const _Ty& _Value) {
+        _Cont.push_back(_Value);
+    }
+
+    template <class _Ty>
+    inline void _Push_back(safe_list<_Ty>& _Cont, const _Ty& _Value) {
+        (void) _Cont.push_back(_Value);
+    }
+
+    template <class _Container, class _Ty>
+    inline void _Push_front(_Container& _Cont, const _Ty& _Value) {
+        _Cont.push_front(_Value);
+    }
+
+    template <class _Ty>
+    inline void _Push_front(safe_list<_Ty>& _Cont, const _Ty& _Value) {
+        (void) _Cont.push_front(_Value);
+    }
+
+    template <class _Ty, class _Alloc, class _Policy>
+    inline void _Push_front(::mjx::safe_forward_list<_Ty, _Alloc, _Policy>& _Cont, const _Ty& _Value) {
+        (void) _Cont.push_front(_Value);
+    }
+
+    template <class _Container>
+    inline void _Reverse(_Container& _Cont) {
+        ::std::reverse(_Cont.begin(), _Cont.end());
+    }
+
+    template <class _Ty>
+    inline void _Reverse(::std::list<_Ty>& _Cont) {
+        _Cont.reverse();
+    }
+
+    template <class _Ty>
+    inline void _Reverse(safe_list<_Ty>& _Cont) {
+        _Cont.reverse();
+    }
+
+    template <class _Ty>
+    inline void _Push_back(safe_unrolled_list<_Ty>& _Cont, const _Ty& _Value) {
+        (void) _Cont.push_back(_Value);
+    }
+
+    template <class _Container, class _Ty>
+    inline size_t _Count_value(const _Container& _Cont, const _Ty& _Value) {
+        return static_cast<size_t>(::std::count(_Cont.begin(), _Cont.end(), _Value));
+    }
+
+    template <class _Ty>
+    inline size_t _Count_value(const safe_list<_Ty>& _Cont, const _Ty& _Value) {
+        return _Cont.count(_Value);
+    }
+
+    template <class _Ty>
+    inline size_t _Count_value(const safe_unrolled_list<_Ty>& _Cont, const _Ty& _Value) {
+        return _Cont.count(_Value);
+    }
+
+    template <class _Container, class _Pred>
+    inline void _Remove_if(_Container& _Cont, _Pred _Fn) {
+        _Cont.erase(::std::remove_if(_Cont.begin(), _Cont.end(), _Fn), _Cont.end());
+    }
+
+    template <class _Ty, class _Pred>
+    inline void _Remove_if(::std::list<_Ty>& _Cont, _Pred _Fn) {
+        _Cont.remove_if(_Fn);
+    }
+
+    template <class _Ty, class _Pred>
+    inline void _Remove_if(safe_list<_Ty>& _Cont, _Pred _Fn) {
+        (void) _Cont.remove_if(_Fn);
+    }
+
+    template <class _Container>
+    inline _Container _Make_container(const size_t _Count) {
+        using _Ty = typename _Container::value_type;
+        _Container _Cont;
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            _Push_back(_Cont, _Ty{_Idx});
+        }
+
+        return _Cont;
+    }
+
+    template <class _Container>
+    void _Bench_push_pop_back(::benchmark::State& _State) {
+        using _Ty          = typename _Container::value_type;
+        const size_t _Count = static_cast<size_t>(_State.range(0));
+        const _Ty _Value{};
+        for (auto _Unused : _State) {
+            _Container _Cont;
+            for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+                _Push_back(_Cont, _Value);
+            }
+
+            while (!_Cont.empty()) {
+                _Cont.pop_back();
+            }
+
+            ::benchmark::DoNotOptimize(_Cont);
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    template <class _Container>
+    void _Bench_push_pop_front(::benchmark::State& _State) {
+        using _Ty          = typename _Container::value_type;
+        const size_t _Count = static_cast<size_t>(_State.range(0));
+        const _Ty _Value{};
+        for (auto _Unused : _State) {
+            _Container _Cont;
+            for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+                _Push_front(_Cont, _Value);
+            }
+
+            while (!_Cont.empty()) {
+                _Cont.pop_front();
+            }
+
+            ::benchmark::DoNotOptimize(_Cont);
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    template <class _Container>
+    void _Bench_insert_middle(::benchmark::State& _State) {
+        using _Ty          = typename _Container::value_type;
+        const size_t _Count = static_cast<size_t>(_State.range(0));
+        const _Ty _Value{};
+        for (auto _Unused : _State) {
+            _State.PauseTiming();
+            _Container _Cont = _Make_container<_Container>(_Count);
+            auto _Where      = ::std::next(_Cont.begin(), static_cast<ptrdiff_t>(_Count / 2));
+            _State.ResumeTiming();
+            for (size_t _Idx = 0; _Idx < _Count; ++_Idx) { // keep inserting before the same element
+                _Where = _Cont.insert(_Where, _Value);
+            }
+
+            ::benchmark::DoNotOptimize(_Cont);
+            _State.PauseTiming();
+            _Cont.clear();
+            _State.ResumeTiming();
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    template <class _Container>
+    void _Bench_remove_if(::benchmark::State& _State) {
+        using _Ty          = typename _Container::value_type;
+        const size_t _Count = static_cast<size_t>(_State.range(0));
+        for (auto _Unused : _State) {
+            _State.PauseTiming();
+            _Container _Cont = _Make_container<_Container>(_Count);
+            _State.ResumeTiming();
+            _Remove_if(_Cont, [](const _Ty& _Value) noexcept { return _Value._Is_odd(); });
+            ::benchmark::DoNotOptimize(_Cont);
+            _State.PauseTiming();
+            _Cont.clear();
+            _State.ResumeTiming();
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    template <class _Container>
+    void _Bench_copy(::benchmark::State& _State) {
+        const size_t _Count     = static_cast<size_t>(_State.range(0));
+        const _Container _Source = _Make_container<_Container>(_Count);
+        for (auto _Unused : _State) {
+            _Container _Copy(_Source);
+            ::benchmark::DoNotOptimize(_Copy);
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    template <class _Container>
+    void _Bench_clear(::benchmark::State& _State) {
+        const size_t _Count = static_cast<size_t>(_State.range(0));
+        for (auto _Unused : _State) {
+            _State.PauseTiming();
+            _Container _Cont = _Make_container<_Container>(_Count);
+            _State.ResumeTiming();
+            _Cont.clear();
+            ::benchmark::DoNotOptimize(_Cont);
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    template <class _Container>
+    void _Bench_reverse(::benchmark::State& _State) {
+        const size_t _Count = static_cast<size_t>(_State.range(0));
+        _Container _Cont    = _Make_container<_Container>(_Count);
+        for (auto _Unused : _State) {
+            _Reverse(_Cont);
+            ::benchmark::DoNotOptimize(_Cont);
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    template <class _Container>
+    void _Bench_iterate(::benchmark::State& _State) {
+        const size_t _Count     = static_cast<size_t>(_State.range(0));
+        const _Container _Cont = _Make_container<_Container>(_Count);
+        for (auto _Unused : _State) {
+            size_t _Sum = 0;
+            for (const auto& _Value : _Cont) {
+                _Sum += _Value._Key();
+            }
+
+            ::benchmark::DoNotOptimize(_Sum);
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    template <class _Ty>
+    void _Bench_iterate_frozen(::benchmark::State& _State) {
+        const size_t _Count = static_cast<size_t>(_State.range(0));
+        safe_list<_Ty> _List = _Make_container<safe_list<_Ty>>(_Count);
+        ::mjx::safe_list_snapshot<_Ty> _Snapshot;
+        (void) _List.freeze(_Snapshot);
+        for (auto _Unused : _State) {
+            size_t _Sum = 0;
+            for (const auto& _Value : _Snapshot) {
+                _Sum += _Value._Key();
+            }
+
+            ::benchmark::DoNotOptimize(_Sum);
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    template <class _Container>
+    void _Bench_iterate_prefetched(::benchmark::State& _State) {
+        const size_t _Count     = static_cast<size_t>(_State.range(0));
+        const _Container _Cont = _Make_container<_Container>(_Count);
+        for (auto _Unused : _State) {
+            size_t _Sum = 0;
+            for (const auto& _Value : ::mjx::safe_list_prefetched(_Cont)) {
+                _Sum += _Value._Key();
+            }
+
+            ::benchmark::DoNotOptimize(_Sum);
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    template <class _Container>
+    void _Bench_count(::benchmark::State& _State) {
+        const size_t _Count = static_cast<size_t>(_State.range(0));
+        _Container _Cont;
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) { // 42 appears once in every 100 elements
+            _Push_back(_Cont, static_cast<int>(_Idx % 100));
+        }
+
+        for (auto _Unused : _State) {
+            ::benchmark::DoNotOptimize(_Count_value(_Cont, 42));
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    using _Skip_indexed_list = safe_list<int, ::mjx::safe_allocator<int>, ::mjx::safe_list_policy<
+        ::mjx::safe_list_heap_storage, ::mjx::safe_list_no_stats, ::mjx::safe_list_skip_index<>>>;
+
+    template <class _Container>
+    void _Bench_iterator_at(::benchmark::State& _State) {
+        const size_t _Count = static_cast<size_t>(_State.range(0));
+        _Container _Cont;
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            (void) _Cont.push_back(static_cast<int>(_Idx));
+        }
+
+        size_t _Pos = 0;
+        for (auto _Unused : _State) {
+            _Pos = (_Pos + 7919) % _Count; // a fixed stride visits the positions in a scattered order
+            ::benchmark::DoNotOptimize(*_Cont.iterator_at(_Pos));
+        }
+
+        _State.SetItemsProcessed(_State.iterations());
+    }
+
+    template <class _Container>
+    void _Bench_short_lived(::benchmark::State& _State) {
+        // Note: Builds and destroys a short list, the common case the inline storage is meant for.
+        const size_t _Count = static_cast<size_t>(_State.range(0));
+        for (auto _Unused : _State) {
+            _Container _Cont;
+            for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+                (void) _Cont.push_back(static_cast<int>(_Idx));
+            }
+
+            ::benchmark::DoNotOptimize(_Cont);
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    template <class _Container>
+    void _Bench_cross_thread_free(::benchmark::State& _State) {
+        // Note: This thread allocates the nodes and another one frees them, as in a producer/consumer pipeline.
+        const size_t _Count = static_cast<size_t>(_State.range(0));
+        _Container _Cont;
+        for (auto _Unused : _State) {
+            for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+                (void) _Cont.push_back(static_cast<int>(_Idx));
+            }
+
+            ::std::thread([&_Cont]() noexcept { _Cont.clear(); }).join();
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    using _Magazine_list = safe_list<int, ::mjx::safe_magazine_allocator<int>>;
+
+    template <class _Container>
+    void _Bench_deserialize(::benchmark::State& _State) {
+        // Note: A warm restart, the list is rebuilt from an image written by serialize_to().
+        const size_t _Count = static_cast<size_t>(_State.range(0));
+        safe_list<int> _Source;
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            (void) _Source.push_back(static_cast<int>(_Idx));
+        }
+
+        ::std::vector<uint64_t> _Image(_Source.serialized_size() / sizeof(uint64_t) + 1);
+        (void) _Source.serialize_to(_Image.data(), _Image.size() * sizeof(uint64_t));
+        for (auto _Unused : _State) {
+            _Container _Cont;
+            (void) _Cont.deserialize_from(_Image.data(), _Image.size() * sizeof(uint64_t));
+            ::benchmark::DoNotOptimize(_Cont);
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    using _Slab_list = safe_list<int, ::mjx::safe_allocator<int>, ::mjx::safe_list_slab_storage<>>;
+
+    inline constexpr size_t _Batch_size = 64; // elements a producer or consumer handles at once
+
+    template <class _Container>
+    void _Bench_consume_single(::benchmark::State& _State) {
+        // Note: The producer pushes and the consumer pops one element at a time, reading it through front().
+        const size_t _Count = static_cast<size_t>(_State.range(0));
+        _Container _Cont;
+        int _Batch[_Batch_size];
+        for (size_t _Idx = 0; _Idx < _Batch_size; ++_Idx) {
+            _Batch[_Idx] = static_cast<int>(_Idx);
+        }
+
+        for (auto _Unused : _State) {
+            int64_t _Sum = 0;
+            for (size_t _Done = 0; _Done < _Count; _Done += _Batch_size) {
+                for (size_t _Idx = 0; _Idx < _Batch_size; ++_Idx) {
+                    (void) _Cont.push_back(_Batch[_Idx]);
+                }
+
+                while (!_Cont.empty()) {
+                    _Sum += *_Cont.front();
+                    _Cont.pop_front();
+                }
+            }
+
+            ::benchmark::DoNotOptimize(_Sum);
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    template <class _Container>
+    void _Bench_consume_batched(::benchmark::State& _State) {
+        // Note: The same pipeline as _Bench_consume_single(), with push_back_n() and pop_front_n().
+        const size_t _Count = static_cast<size_t>(_State.range(0));
+        _Container _Cont;
+        int _Batch[_Batch_size];
+        int _Out[_Batch_size];
+        for (size_t _Idx = 0; _Idx < _Batch_size; ++_Idx) {
+            _Batch[_Idx] = static_cast<int>(_Idx);
+        }
+
+        for (auto _Unused : _State) {
+            int64_t _Sum = 0;
+            for (size_t _Done = 0; _Done < _Count; _Done += _Batch_size) {
+                (void) _Cont.push_back_n(_Batch, _Batch_size);
+                int* const _Last = _Cont.pop_front_n(_Batch_size, _Out);
+                for (int* _Iter = _Out; _Iter != _Last; ++_Iter) {
+                    _Sum += *_Iter;
+                }
+            }
+
+            ::benchmark::DoNotOptimize(_Sum);
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    using _Bounded_list = safe_list<int, ::mjx::safe_allocator<int>, ::mjx::safe_list_bounded_storage>;
+
+    template <class _Container>
+    void _Bench_steady_queue(::benchmark::State& _State) {
+        // Note: A queue kept at a constant depth, one push_back() and one pop_front() per item.
+        //       Every node is reserved up front, so neither storage touches the allocator.
+        const size_t _Depth = static_cast<size_t>(_State.range(0));
+        _Container _Cont;
+        (void) _Cont.reserve_nodes(_Depth + 1);
+        for (size_t _Idx = 0; _Idx < _Depth; ++_Idx) {
+            (void) _Cont.push_back(static_cast<int>(_Idx));
+        }
+
+        int _Value = 0;
+        for (auto _Unused : _State) {
+            (void) _Cont.push_back(_Value++);
+            _Cont.pop_front();
+        }
+
+        ::benchmark::DoNotOptimize(_Cont);
+        _State.SetItemsProcessed(_State.iterations());
+    }
+
+    inline safe_list<int> _Make_duplicates(const size_t _Count) { // every value occurs twice, scattered
+        safe_list<int> _List;
+        for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+            (void) _List.push_back(static_cast<int>(_Idx * 2654435761U % (_Count / 2 + 1)));
+        }
+
+        return _List;
+    }
+
+    void _Bench_dedupe_unordered_set(::benchmark::State& _State) {
+        // Note: The replaced pattern, remove_if() with a captured std::unordered_set.
+        const size_t _Count          = static_cast<size_t>(_State.range(0));
+        const safe_list<int> _Source = _Make_duplicates(_Count);
+        for (auto _Unused : _State) {
+            safe_list<int> _List(_Source);
+            ::std::unordered_set<int> _Seen;
+            _List.remove_if([&_Seen](const int _Value) { return !_Seen.insert(_Value).second; });
+            ::benchmark::DoNotOptimize(_List);
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    void _Bench_dedupe_unsorted(::benchmark::State& _State) {
+        const size_t _Count          = static_cast<size_t>(_State.range(0));
+        const safe_list<int> _Source = _Make_duplicates(_Count);
+        for (auto _Unused : _State) {
+            safe_list<int> _List(_Source);
+            (void) _List.dedupe_unsorted();
+            ::benchmark::DoNotOptimize(_List);
+        }
+
+        _State.SetItemsProcessed(_State.iterations() * static_cast<int64_t>(_Count));
+    }
+
+    template <class _Ty>
+    using _Stack_list = ::mjx::safe_forward_list<_Ty, ::mjx::safe_allocator<_Ty>,
+        ::mjx::safe_forward_list_policy<::mjx::safe_list_heap_storage, ::mjx::safe_list_uncounted_size>>;
+
+    inline void _Lengths(::benchmark::internal::Benchmark* const _Bench) {
+        _Bench->RangeMultiplier(16)->Range(16, 65536);
+    }
+
+    inline void _Short_lengths(::benchmark::internal::Benchmark* const _Bench) { // for O(N^2) deque runs
+        _Bench->RangeMultiplier(8)->Range(16, 4096);
+    }
+
+#define _SAFE_LIST_BENCH_CONTAINERS(_Func, _Ty, _Args)             \
+    BENCHMARK_TEMPLATE(_Func, safe_list<_Ty>)->Apply(_Args);       \
+    BENCHMARK_TEMPLATE(_Func, ::std::list<_Ty>)->Apply(_Args);     \
+    BENCHMARK_TEMPLATE(_Func, ::std::deque<_Ty>)->Apply(_Args)
+
+#define _SAFE_LIST_BENCH(_Func, _Args)                          \
+    _SAFE_LIST_BENCH_CONTAINERS(_Func, _Payload<8>, _Args);     \
+    _SAFE_LIST_BENCH_CONTAINERS(_Func, _Payload<64>, _Args);    \
+    _SAFE_LIST_BENCH_CONTAINERS(_Func, _Payload<256>, _Args)
+
+    _SAFE_LIST_BENCH(_Bench_push_pop_back, _Lengths);
+    _SAFE_LIST_BENCH(_Bench_push_pop_front, _Lengths);
+    BENCHMARK_TEMPLATE(_Bench_push_pop_front, _Stack_list<_Payload<8>>)->Apply(_Lengths);
+    _SAFE_LIST_BENCH(_Bench_insert_middle, _Short_lengths);
+    _SAFE_LIST_BENCH(_Bench_remove_if, _Lengths);
+    _SAFE_LIST_BENCH(_Bench_copy, _Lengths);
+    _SAFE_LIST_BENCH(_Bench_clear, _Lengths);
+    _SAFE_LIST_BENCH(_Bench_reverse, _Lengths);
+    _SAFE_LIST_BENCH(_Bench_iterate, _Lengths);
+    BENCHMARK_TEMPLATE(_Bench_iterate_prefetched, safe_list<_Payload<8>>)->Apply(_Lengths);
+    BENCHMARK_TEMPLATE(_Bench_iterate_prefetched, safe_list<_Payload<64>>)->Apply(_Lengths);
+    BENCHMARK_TEMPLATE(_Bench_iterate_prefetched, safe_list<_Payload<256>>)->Apply(_Lengths);
+    BENCHMARK_TEMPLATE(_Bench_iterate_frozen, _Payload<8>)->Apply(_Lengths);
+    BENCHMARK_TEMPLATE(_Bench_iterate, ::std::vector<_Payload<8>>)->Apply(_Lengths);
+    BENCHMARK_TEMPLATE(_Bench_count, safe_unrolled_list<int>)->Apply(_Lengths);
+    _SAFE_LIST_BENCH_CONTAINERS(_Bench_count, int, _Lengths);
+    BENCHMARK_TEMPLATE(_Bench_iterator_at, safe_list<int>)->Apply(_Lengths);
+    BENCHMARK_TEMPLATE(_Bench_iterator_at, _Skip_indexed_list)->Apply(_Lengths);
+    BENCHMARK_TEMPLATE(_Bench_short_lived, safe_list<int>)->DenseRange(2, 8, 2);
+    BENCHMARK_TEMPLATE(_Bench_short_lived, ::mjx::safe_small_list<int, 8>)->DenseRange(2, 8, 2);
+    BENCHMARK_TEMPLATE(_Bench_cross_thread_free, safe_list<int>)->Range(4096, 262144);
+    BENCHMARK_TEMPLATE(_Bench_cross_thread_free, _Magazine_list)->Range(4096, 262144);
+    BENCHMARK_TEMPLATE(_Bench_deserialize, safe_list<int>)->Apply(_Lengths);
+    BENCHMARK_TEMPLATE(_Bench_deserialize, _Slab_list)->Apply(_Lengths);
+    BENCHMARK_TEMPLATE(_Bench_consume_single, safe_list<int>)->Range(4096, 65536);
+    BENCHMARK_TEMPLATE(_Bench_consume_batched, safe_list<int>)->Range(4096, 65536);
+    BENCHMARK_TEMPLATE(_Bench_consume_single, _Slab_list)->Range(4096, 65536);
+    BENCHMARK_TEMPLATE(_Bench_consume_batched, _Slab_list)->Range(4096, 65536);
+    BENCHMARK_TEMPLATE(_Bench_steady_queue, safe_list<int>)->Range(16, 65536);
+    BENCHMARK_TEMPLATE(_Bench_steady_queue, _Bounded_list)->Range(16, 65536);
+    BENCHMARK(_Bench_dedupe_unordered_set)->Apply(_Lengths);
+    BENCHMARK(_Bench_dedupe_unsorted)->Apply(_Lengths);
+
+#undef _SAFE_LIST_BENCH
+#undef _SAFE_LIST_BENCH_CONTAINERS
+} // namespace bench
+
+BENCHMARK_MAIN();
@@ -0,0 +1,190 @@
+// safe_async_list.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SAFE_ASYNC_LIST_HPP_
+#define _SAFE_ASYNC_LIST_HPP_
+#include <safe_mpsc_list.hpp>
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>) // requires C++20 coroutines
+#include <atomic>
+#include <coroutine>
+#include <new>
+#include <thread>
+
+namespace mjx {
+    template <class _Ty, class _Alloc = safe_allocator<_Ty>>
+    class safe_async_list { // awaitable multi-producer single-consumer queue
+    private:
+        using _Traits  = _Safe_list_traits<_Ty>;
+        using _Queue_t = safe_mpsc_list<_Ty, _Alloc>;
+
+        class _Pop_awaiter;
+
+    public:
+        using value_type      = _Ty;
+        using allocator_type  = _Alloc;
+        using size_type       = size_t;
+        using reference       = _Ty&;
+        using const_reference = const _Ty&;
+
+        // Note: Any number of threads may call push_back() and emplace_back() at the same time,
+        //       the remaining member functions belong to a single consumer. At most one coroutine
+        //       may wait in pop_front() at a time and the list must outlive it.
+        //       A push that finds a waiting coroutine resumes it on the pushing thread, before returning.
+
+        safe_async_list() noexcept : _Queue(), _Waiter(nullptr) {}
+
+        explicit safe_async_list(const allocator_type& _Al) noexcept : _Queue(_Al), _Waiter(nullptr) {}
+
+        safe_async_list(const safe_async_list&)            = delete;
+        safe_async_list& operator=(const safe_async_list&) = delete;
+
+        ~safe_async_list() noexcept {}
+
+        allocator_type get_allocator() const noexcept {
+            return _Queue.get_allocator();
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return _Queue.empty();
+        }
+
+        [[nodiscard]] bool push_back(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace_back(_Value);
+        }
+
+        [[nodiscard]] bool push_back(value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace_back(::std::move(_Value));
+        }
+
+        template <class... _Types>
+        [[nodiscard]] bool emplace_back(_Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            if (!_Queue.emplace_back(::std::forward<_Types>(_Args)...)) { // allocation failed, nobody is woken
+                return false;
+            }
+
+            // Note: The fence pairs with the one in _Pop_awaiter::await_suspend(), either the consumer
+            //       sees the new element or this thread sees the registered coroutine (or both).
+            ::std::atomic_thread_fence(::std::memory_order_seq_cst);
+            if (_Waiter.load(::std::memory_order_relaxed)) { // fast path skips the exchange
+                _Wake(_Waiter.exchange(nullptr, ::std::memory_order_acquire));
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] bool try_pop_front(value_type& _Value) noexcept(::std::is_nothrow_move_assignable_v<_Ty>) {
+            return _Queue.pop_front(_Value);
+        }
+
+        [[nodiscard]] _Pop_awaiter pop_front() noexcept {
+            // Note: co_await pop_front() yields the oldest element, suspending while the list is empty.
+            return _Pop_awaiter(*this);
+        }
+
+        void clear() noexcept {
+            _Queue.clear();
+        }
+
+    private:
+        void _Wake(void* _Address) noexcept {
+            // Note: _Address is the registration this thread has won (or a null-pointer). The registration
+            //       may be newer than this thread's element: the consumer can take the element, suspend again
+            //       and be found by this push. Resuming it then would leave it waiting in await_resume()
+            //       for a push that may never come, so the registration is handed back instead. While it is
+            //       held here, the consumer is suspended and its end of the queue can be read.
+            while (_Address) {
+                const void* const _Mark = _Queue._Consumer_mark();
+                if (_Queue._Pushed_since(_Mark)) { // an element is there (or about to be)
+                    ::std::coroutine_handle<>::from_address(_Address).resume();
+                    return;
+                }
+
+                _Waiter.store(_Address, ::std::memory_order_release);
+                ::std::atomic_thread_fence(::std::memory_order_seq_cst); // pairs with the producers' fence
+                if (!_Queue._Pushed_since(_Mark)) { // the next push_back() resumes the coroutine
+                    return;
+                }
+
+                void* _Expected = _Address;
+                if (!_Waiter.compare_exchange_strong(
+                        _Expected, nullptr, ::std::memory_order_acq_rel, ::std::memory_order_relaxed)) {
+                    return; // another producer has taken it
+                }
+            }
+        }
+
+        class _Pop_awaiter {
+        public:
+            explicit _Pop_awaiter(safe_async_list& _List) noexcept : _List(_List), _Has_value(false) {}
+
+            _Pop_awaiter(const _Pop_awaiter&)            = delete;
+            _Pop_awaiter& operator=(const _Pop_awaiter&) = delete;
+
+            ~_Pop_awaiter() noexcept {
+                if (_Has_value) { // the value was not taken
+                    _Value_ptr()->~_Ty();
+                }
+            }
+
+            bool await_ready() noexcept(_Traits::_Is_nothrow_move_constructible) {
+                return _Try_take();
+            }
+
+            bool await_suspend(const ::std::coroutine_handle<> _Handle) noexcept {
+                // Note: Once the coroutine is registered, a producer may resume it on another thread
+                //       at any moment, so *this is not touched afterwards. From then on only the producers'
+                //       end of the queue is read and the element is taken by await_resume().
+                safe_async_list& _Owner = _List;
+                const void* const _Mark = _Owner._Queue._Consumer_mark();
+                void* const _Address    = _Handle.address();
+                _Owner._Waiter.store(_Address, ::std::memory_order_release);
+                ::std::atomic_thread_fence(::std::memory_order_seq_cst);
+                if (!_Owner._Queue._Pushed_since(_Mark)) { // stay suspended, the next push_back() resumes the coroutine
+                    return true;
+                }
+
+                // Note: A push has started meanwhile, withdraw the registration. If a producer has already
+                //       taken it, the coroutine is (or is about to be) resumed by that producer.
+                void* _Expected = _Address;
+                return !_Owner._Waiter.compare_exchange_strong(
+                    _Expected, nullptr, ::std::memory_order_acq_rel, ::std::memory_order_relaxed);
+            }
+
+            _Ty await_resume() noexcept(_Traits::_Is_nothrow_move_constructible) {
+                while (!_Has_value && !_Try_take()) { // the element is hidden behind a push that is in progress
+                    ::std::this_thread::yield();
+                }
+
+                return ::std::move(*_Value_ptr());
+            }
+
+        private:
+            _Ty* _Value_ptr() noexcept {
+                return ::std::launder(reinterpret_cast<_Ty*>(_Buffer));
+            }
+
+            bool _Try_take() noexcept(_Traits::_Is_nothrow_move_constructible) {
+                auto _Take = [this](_Ty&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+                    ::new (static_cast<void*>(_Buffer)) _Ty(::std::move(_Value));
+                    _Has_value = true;
+                };
+
+                return _List._Queue._Pop_front_with(_Take);
+            }
+
+            safe_async_list& _List;
+            bool _Has_value;
+            alignas(_Ty) unsigned char _Buffer[sizeof(_Ty)]; // storage for the popped element
+        };
+
+        _Queue_t _Queue;
+        ::std::atomic<void*> _Waiter; // address of the suspended consumer, null if none
+    };
+} // namespace mjx
+#endif // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#endif // _SAFE_ASYNC_LIST_HPP_
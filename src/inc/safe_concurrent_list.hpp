@@ -0,0 +1,416 @@
+// safe_concurrent_list.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SAFE_CONCURRENT_LIST_HPP_
+#define _SAFE_CONCURRENT_LIST_HPP_
+#include <atomic>
+#include <thread>
+#include <safe_list.hpp>
+#include <safe_list_epoch.hpp>
+
+namespace mjx {
+    class _Safe_concurrent_list_link : public _Safe_list_retired_link { // links of the sentinels and the nodes
+    public:
+        ::std::atomic<_Safe_concurrent_list_link*> _Next; // pointer to the next node
+        ::std::atomic<_Safe_concurrent_list_link*> _Prev; // pointer to the previous node
+        ::std::atomic<bool> _Marked; // set once the node is logically removed
+        ::std::atomic<bool> _Locked; // per-node spinlock, taken by writers only
+
+        _Safe_concurrent_list_link() noexcept
+            : _Safe_list_retired_link(), _Next(nullptr), _Prev(nullptr), _Marked(false), _Locked(false) {}
+
+        void _Lock() noexcept {
+            for (;;) { // test-and-test-and-set
+                if (!_Locked.exchange(true, ::std::memory_order_acquire)) {
+                    return;
+                }
+
+                while (_Locked.load(::std::memory_order_relaxed)) {
+                    ::std::this_thread::yield();
+                }
+            }
+        }
+
+        void _Unlock() noexcept {
+            _Locked.store(false, ::std::memory_order_release);
+        }
+    };
+
+    template <class _Ty, class _Traits>
+    class _Safe_concurrent_list_node : public _Safe_concurrent_list_link {
+    public:
+        _Ty _Value; // the stored value, never modified after the node is linked
+
+        template <class... _Types>
+        explicit _Safe_concurrent_list_node(::std::in_place_t, _Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>)
+            : _Safe_concurrent_list_link(), _Value(::std::forward<_Types>(_Args)...) {}
+
+        ~_Safe_concurrent_list_node() noexcept {}
+    };
+
+    template <class _Ty, class _Alloc = safe_allocator<_Ty>>
+    class safe_concurrent_list { // exception-safe concurrent doubly-linked list
+    private:
+        using _Traits    = _Safe_list_traits<_Ty>;
+        using _Link_t    = _Safe_concurrent_list_link;
+        using _Node_t    = _Safe_concurrent_list_node<_Ty, _Traits>;
+        using _Al_traits = ::std::allocator_traits<_Alloc>;
+        using _Alnode_t  = typename _Al_traits::template rebind_alloc<_Node_t>;
+
+        static_assert(_Is_nothrow_allocator<_Alnode_t>, "Alloc must not throw, allocate() returns a null-pointer.");
+
+    public:
+        using value_type      = _Ty;
+        using allocator_type  = _Alloc;
+        using size_type       = size_t;
+        using reference       = _Ty&;
+        using const_reference = const _Ty&;
+
+        // Note: Every member function except the destructor may be called from any number of threads.
+        //       The list is a lazy list (Heller et al.): readers traverse without taking any lock,
+        //       writers lock the two nodes around the change, validate them and unlink a node only
+        //       after marking it as removed. Locks are always taken in list order, so writers cannot deadlock.
+        //       Elements are exposed as const references only, they are never modified while linked.
+        //       Removed nodes are retired and freed in batches by epoch-based reclamation (see safe_list_epoch.hpp)
+        //       once no running operation can reach them, the allocator must be thread-safe.
+        //       Predicates of the writing functions may be called more than once per element.
+
+        safe_concurrent_list() noexcept : _Mystorage() {}
+
+        explicit safe_concurrent_list(const allocator_type& _Al) noexcept : _Mystorage(_Alnode_t(_Al)) {}
+
+        safe_concurrent_list(const safe_concurrent_list&)            = delete;
+        safe_concurrent_list& operator=(const safe_concurrent_list&) = delete;
+
+        ~safe_concurrent_list() noexcept {
+            // Note: No other thread may use the list, linked and retired nodes are freed.
+            _Link_t* _Next;
+            for (_Link_t* _Link = _Mystorage._Head._Next.load(::std::memory_order_relaxed);
+                 _Link != &_Mystorage._Tail; _Link = _Next) {
+                _Next = _Link->_Next.load(::std::memory_order_relaxed);
+                _Free_node(static_cast<_Node_t*>(_Link));
+            }
+
+            _Mystorage._Retired._Free_all([this](_Link_t* const _Link) noexcept {
+                _Free_node(static_cast<_Node_t*>(_Link));
+            });
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(_Mystorage._Get_allocator());
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return _Mystorage._Size.load(::std::memory_order_relaxed) == 0;
+        }
+
+        size_type size() const noexcept {
+            // Note: A snapshot, concurrent writers may change the size right after the call.
+            return _Mystorage._Size.load(::std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] bool push_front(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace_front(_Value);
+        }
+
+        [[nodiscard]] bool push_front(value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace_front(::std::move(_Value));
+        }
+
+        [[nodiscard]] bool push_back(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace_back(_Value);
+        }
+
+        [[nodiscard]] bool push_back(value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace_back(::std::move(_Value));
+        }
+
+        template <class... _Types>
+        [[nodiscard]] bool emplace_front(_Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            _Node_t* const _New_node = _Make_node(::std::forward<_Types>(_Args)...);
+            if (!_New_node) { // allocation failed
+                return false;
+            }
+
+            // Note: The head sentinel is never removed and its successor cannot be removed
+            //       without its lock, so no validation is needed.
+            _Mystorage._Head._Lock();
+            _Link_after(&_Mystorage._Head, _New_node);
+            _Mystorage._Head._Unlock();
+            return true;
+        }
+
+        template <class... _Types>
+        [[nodiscard]] bool emplace_back(_Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            _Node_t* const _New_node = _Make_node(::std::forward<_Types>(_Args)...);
+            if (!_New_node) { // allocation failed
+                return false;
+            }
+
+            {
+                const safe_list_epoch_guard _Guard;
+                for (;;) { // retry until the last node is still the last node after locking it
+                    _Link_t* const _Prev = _Mystorage._Tail._Prev.load(::std::memory_order_acquire);
+                    _Prev->_Lock();
+                    if (_Validate(_Prev, &_Mystorage._Tail)) {
+                        _Link_after(_Prev, _New_node);
+                        _Prev->_Unlock();
+                        break;
+                    }
+
+                    _Prev->_Unlock();
+                }
+            }
+
+            _Reclaim();
+            return true;
+        }
+
+        template <class _Pred, class... _Types>
+        [[nodiscard]] bool emplace_before(_Pred _Where, _Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>
+            && ::std::is_nothrow_invocable_v<_Pred&, const _Ty&>) {
+            // Note: Inserts before the first element that satisfies _Where, or at the end if there is none.
+            _Node_t* const _New_node = _Make_node(::std::forward<_Types>(_Args)...);
+            if (!_New_node) { // allocation failed
+                return false;
+            }
+
+            {
+                const safe_list_epoch_guard _Guard;
+                for (;;) { // retry until the found position is still valid after locking it
+                    _Link_t* _Prev = &_Mystorage._Head;
+                    _Link_t* _Next = _Prev->_Next.load(::std::memory_order_acquire);
+                    while (_Next != &_Mystorage._Tail && !_Where(static_cast<_Node_t*>(_Next)->_Value)) {
+                        _Prev = _Next;
+                        _Next = _Next->_Next.load(::std::memory_order_acquire);
+                    }
+
+                    _Prev->_Lock();
+                    _Next->_Lock();
+                    const bool _Valid = _Validate(_Prev, _Next);
+                    if (_Valid) {
+                        _Link_after(_Prev, _New_node);
+                    }
+
+                    _Next->_Unlock();
+                    _Prev->_Unlock();
+                    if (_Valid) {
+                        break;
+                    }
+                }
+            }
+
+            _Reclaim();
+            return true;
+        }
+
+        template <class _Pred>
+        [[nodiscard]] bool insert_before(_Pred _Where, const value_type& _Value) noexcept(
+            _Traits::_Is_nothrow_copy_constructible && ::std::is_nothrow_invocable_v<_Pred&, const _Ty&>) {
+            return emplace_before(_Where, _Value);
+        }
+
+        template <class _Pred>
+        [[nodiscard]] bool insert_before(_Pred _Where, value_type&& _Value) noexcept(
+            _Traits::_Is_nothrow_move_constructible && ::std::is_nothrow_invocable_v<_Pred&, const _Ty&>) {
+            return emplace_before(_Where, ::std::move(_Value));
+        }
+
+        template <class _Pred>
+        [[nodiscard]] bool erase_first(_Pred _Func) noexcept(::std::is_nothrow_invocable_v<_Pred&, const _Ty&>) {
+            // Note: Removes the first element that satisfies _Func, returns false if there is none.
+            return _Erase(_Func, false) != 0;
+        }
+
+        template <class _Pred>
+        size_type remove_if(_Pred _Func) noexcept(::std::is_nothrow_invocable_v<_Pred&, const _Ty&>) {
+            return _Erase(_Func, true);
+        }
+
+        size_type remove(const value_type& _Value) noexcept {
+            return remove_if([&_Value](const value_type& _Elem) noexcept { return _Elem == _Value; });
+        }
+
+        void clear() noexcept {
+            (void) remove_if([](const value_type&) noexcept { return true; });
+        }
+
+        size_type reclaim() noexcept {
+            // Note: Frees the removed nodes that no running operation can reach, returns their number.
+            //       Writers call it automatically once enough nodes were removed.
+            return _Mystorage._Retired._Reclaim([this](_Link_t* const _Link) noexcept {
+                _Free_node(static_cast<_Node_t*>(_Link));
+            });
+        }
+
+        template <class _Fn>
+        void for_each(_Fn _Func) const noexcept(::std::is_nothrow_invocable_v<_Fn&, const _Ty&>) {
+            // Note: Visits every element that is linked during the whole scan, elements inserted
+            //       or removed concurrently may or may not be visited.
+            const safe_list_epoch_guard _Guard;
+            for (const _Link_t* _Link = _Mystorage._Head._Next.load(::std::memory_order_acquire);
+                 _Link != &_Mystorage._Tail; _Link = _Link->_Next.load(::std::memory_order_acquire)) {
+                if (!_Link->_Marked.load(::std::memory_order_acquire)) { // skip removed nodes
+                    _Func(static_cast<const _Node_t*>(_Link)->_Value);
+                }
+            }
+        }
+
+        template <class _Pred>
+        size_type count_if(_Pred _Func) const noexcept(::std::is_nothrow_invocable_v<_Pred&, const _Ty&>) {
+            size_type _Count = 0;
+            for_each([&](const value_type& _Elem) noexcept(::std::is_nothrow_invocable_v<_Pred&, const _Ty&>) {
+                if (_Func(_Elem)) {
+                    ++_Count;
+                }
+            });
+            return _Count;
+        }
+
+        template <class _Pred>
+        [[nodiscard]] bool find_if(_Pred _Func, value_type& _Result) const noexcept(
+            ::std::is_nothrow_invocable_v<_Pred&, const _Ty&> && ::std::is_nothrow_copy_assignable_v<_Ty>) {
+            // Note: Copies the first element that satisfies _Func to _Result.
+            const safe_list_epoch_guard _Guard;
+            for (const _Link_t* _Link = _Mystorage._Head._Next.load(::std::memory_order_acquire);
+                 _Link != &_Mystorage._Tail; _Link = _Link->_Next.load(::std::memory_order_acquire)) {
+                const _Ty& _Elem = static_cast<const _Node_t*>(_Link)->_Value;
+                if (!_Link->_Marked.load(::std::memory_order_acquire) && _Func(_Elem)) {
+                    _Result = _Elem;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        [[nodiscard]] bool contains(const value_type& _Value) const noexcept {
+            const safe_list_epoch_guard _Guard;
+            for (const _Link_t* _Link = _Mystorage._Head._Next.load(::std::memory_order_acquire);
+                 _Link != &_Mystorage._Tail; _Link = _Link->_Next.load(::std::memory_order_acquire)) {
+                if (!_Link->_Marked.load(::std::memory_order_acquire)
+                    && static_cast<const _Node_t*>(_Link)->_Value == _Value) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+    private:
+        struct _Storage_t : _Safe_list_alloc_holder<_Alnode_t> {
+            using _Mybase = _Safe_list_alloc_holder<_Alnode_t>;
+
+            _Link_t _Head; // head sentinel, never removed
+            _Link_t _Tail; // tail sentinel, never removed
+            ::std::atomic<size_type> _Size; // number of linked elements
+            _Safe_list_retire_list<_Link_t> _Retired; // removed nodes waiting to be freed
+
+            _Storage_t() noexcept : _Mybase(), _Head(), _Tail(), _Size(0), _Retired() {
+                _Link_sentinels();
+            }
+
+            explicit _Storage_t(const _Alnode_t& _Al) noexcept : _Mybase(_Al), _Head(), _Tail(), _Size(0), _Retired() {
+                _Link_sentinels();
+            }
+
+            void _Link_sentinels() noexcept {
+                _Head._Next.store(&_Tail, ::std::memory_order_relaxed);
+                _Tail._Prev.store(&_Head, ::std::memory_order_relaxed);
+            }
+        };
+
+        template <class... _Types>
+        _Node_t* _Make_node(_Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            _Node_t* const _Raw = _Mystorage._Get_allocator().allocate(1);
+            return _Raw ? ::new (static_cast<void*>(_Raw)) _Node_t(::std::in_place, ::std::forward<_Types>(_Args)...)
+                        : nullptr;
+        }
+
+        void _Free_node(_Node_t* const _Node) noexcept {
+            _Node->~_Node_t();
+            _Mystorage._Get_allocator().deallocate(_Node, 1);
+        }
+
+        static bool _Validate(const _Link_t* const _Prev, const _Link_t* const _Next) noexcept {
+            // Note: Both nodes must be locked, checks that they are still linked and adjacent.
+            return !_Prev->_Marked.load(::std::memory_order_acquire)
+                && !_Next->_Marked.load(::std::memory_order_acquire)
+                && _Prev->_Next.load(::std::memory_order_acquire) == _Next;
+        }
+
+        void _Link_after(_Link_t* const _Prev, _Link_t* const _New_node) noexcept {
+            // Note: _Prev must be locked, the successor's _Prev is owned by whoever holds _Prev's lock.
+            _Link_t* const _Next = _Prev->_Next.load(::std::memory_order_relaxed);
+            _New_node->_Next.store(_Next, ::std::memory_order_relaxed);
+            _New_node->_Prev.store(_Prev, ::std::memory_order_relaxed);
+            _Prev->_Next.store(_New_node, ::std::memory_order_release); // publish the node to readers
+            _Next->_Prev.store(_New_node, ::std::memory_order_release);
+            _Mystorage._Size.fetch_add(1, ::std::memory_order_relaxed);
+        }
+
+        template <class _Pred>
+        size_type _Erase(_Pred& _Func, const bool _All) noexcept(::std::is_nothrow_invocable_v<_Pred&, const _Ty&>) {
+            size_type _Count = 0;
+            {
+                const safe_list_epoch_guard _Guard;
+                _Link_t* _Prev = &_Mystorage._Head;
+                _Link_t* _Node = _Prev->_Next.load(::std::memory_order_acquire);
+                while (_Node != &_Mystorage._Tail) {
+                    if (_Node->_Marked.load(::std::memory_order_acquire)
+                        || !_Func(static_cast<_Node_t*>(_Node)->_Value)) { // keep looking
+                        _Prev = _Node;
+                        _Node = _Node->_Next.load(::std::memory_order_acquire);
+                        continue;
+                    }
+
+                    _Prev->_Lock();
+                    _Node->_Lock();
+                    const bool _Valid = _Validate(_Prev, _Node);
+                    if (_Valid) { // mark first, then unlink, readers on _Node can still move forward
+                        _Link_t* const _Next = _Node->_Next.load(::std::memory_order_relaxed);
+                        _Node->_Marked.store(true, ::std::memory_order_release);
+                        _Prev->_Next.store(_Next, ::std::memory_order_release);
+                        _Next->_Prev.store(_Prev, ::std::memory_order_release);
+                        _Mystorage._Size.fetch_sub(1, ::std::memory_order_relaxed);
+                    }
+
+                    _Node->_Unlock();
+                    _Prev->_Unlock();
+                    if (_Valid) {
+                        (void) _Mystorage._Retired._Retire(_Node);
+                        ++_Count;
+                        if (!_All) {
+                            break;
+                        }
+
+                        _Node = _Prev->_Next.load(::std::memory_order_acquire);
+                    } else { // the neighbourhood changed, start over
+                        _Prev = &_Mystorage._Head;
+                        _Node = _Prev->_Next.load(::std::memory_order_acquire);
+                    }
+                }
+            }
+
+            _Reclaim();
+            return _Count;
+        }
+
+        void _Reclaim() noexcept {
+            if (_Mystorage._Retired._Size() >= _Safe_list_retire_list<_Link_t>::_Batch_size) { // a batch is ready
+                (void) reclaim();
+            }
+        }
+
+        _Storage_t _Mystorage;
+    };
+} // namespace mjx
+
+#endif // _SAFE_CONCURRENT_LIST_HPP_
@@ -0,0 +1,690 @@
+// safe_forward_list.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SAFE_FORWARD_LIST_HPP_
+#define _SAFE_FORWARD_LIST_HPP_
+#include <safe_list.hpp>
+
+namespace mjx {
+    struct safe_list_counted_size {}; // the list counts its nodes, size() runs in O(1) (the default)
+    struct safe_list_uncounted_size {}; // no counter is kept, size() walks the list
+
+    struct safe_list_no_tail {}; // only the first node is known, there is no back() (the default)
+    struct safe_list_with_tail {}; // the last node is known too, push_back() and back() run in O(1)
+
+    template <class _Storage = safe_list_heap_storage, class _Size = safe_list_counted_size,
+        class _Tail = safe_list_no_tail>
+    struct safe_forward_list_policy {}; // combines the storage with the size and tail policies
+
+    template <class _Policy>
+    struct _Safe_forward_list_policy_traits { // a bare storage tag selects the default policies
+        using _Storage = _Policy;
+
+        static constexpr bool _Counted = true;
+        static constexpr bool _Tailed  = false;
+    };
+
+    template <class _Storage_tag, class _Size_policy, class _Tail_policy>
+    struct _Safe_forward_list_policy_traits<safe_forward_list_policy<_Storage_tag, _Size_policy, _Tail_policy>> {
+        static_assert(::std::is_same_v<_Size_policy, safe_list_counted_size>
+            || ::std::is_same_v<_Size_policy, safe_list_uncounted_size>, "unknown size policy.");
+        static_assert(::std::is_same_v<_Tail_policy, safe_list_no_tail>
+            || ::std::is_same_v<_Tail_policy, safe_list_with_tail>, "unknown tail policy.");
+
+        using _Storage = _Storage_tag;
+
+        static constexpr bool _Counted = ::std::is_same_v<_Size_policy, safe_list_counted_size>;
+        static constexpr bool _Tailed  = ::std::is_same_v<_Tail_policy, safe_list_with_tail>;
+    };
+
+    template <class _Ty, class _Traits>
+    class _Safe_forward_list_node {
+    public:
+        _Safe_forward_list_node* _Next; // pointer to the next node
+        _Ty _Value; // the stored value
+
+        template <class... _Types>
+        explicit _Safe_forward_list_node(::std::in_place_t, _Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>)
+            : _Next(nullptr), _Value(::std::forward<_Types>(_Args)...) {}
+
+        ~_Safe_forward_list_node() noexcept {}
+
+        _Safe_forward_list_node(const _Safe_forward_list_node&)            = delete;
+        _Safe_forward_list_node& operator=(const _Safe_forward_list_node&) = delete;
+    };
+
+    template <bool _Counted>
+    class _Safe_forward_list_counter { // counts the nodes of a list
+    public:
+        size_t _Size; // number of nodes
+
+        _Safe_forward_list_counter() noexcept : _Size(0) {}
+
+        void _Add_size(const size_t _Count) noexcept {
+            _Size += _Count;
+        }
+
+        void _Subtract_size(const size_t _Count) noexcept {
+            _Size -= _Count;
+        }
+
+        void _Swap_size(_Safe_forward_list_counter& _Other) noexcept {
+            ::std::swap(_Size, _Other._Size);
+        }
+    };
+
+    template <>
+    class _Safe_forward_list_counter<false> { // counts nothing, every update compiles away
+    public:
+        void _Add_size(size_t) noexcept {}
+
+        void _Subtract_size(size_t) noexcept {}
+
+        void _Swap_size(_Safe_forward_list_counter&) noexcept {}
+    };
+
+    template <class _Node_type, bool _Tailed>
+    class _Safe_forward_list_tail { // remembers the last node of a list
+    public:
+        _Node_type* _Tail; // pointer to the last node
+
+        _Safe_forward_list_tail() noexcept : _Tail(nullptr) {}
+
+        void _Swap_tail(_Safe_forward_list_tail& _Other) noexcept {
+            ::std::swap(_Tail, _Other._Tail);
+        }
+    };
+
+    template <class _Node_type>
+    class _Safe_forward_list_tail<_Node_type, false> { // remembers nothing, every update compiles away
+    public:
+        void _Swap_tail(_Safe_forward_list_tail&) noexcept {}
+    };
+
+    template <class _Node_type, class _Alloc, class _Storage, bool _Counted, bool _Tailed>
+    class _Safe_forward_list_storage
+        : public _Safe_forward_list_counter<_Counted>, // empty without a size counter (EBO)
+          public _Safe_forward_list_tail<_Node_type, _Tailed>, // empty without a tail pointer
+          public _Safe_list_node_pool<_Node_type, _Alloc, size_t, _Storage> {
+    private:
+        using _Mybase = _Safe_list_node_pool<_Node_type, _Alloc, size_t, _Storage>;
+
+    public:
+        static_assert(_Is_nothrow_allocator<_Alloc>, "Alloc must not throw, allocate() returns a null-pointer.");
+
+        _Node_type* _Head; // pointer to the first node
+
+        _Safe_forward_list_storage() noexcept : _Mybase(), _Head(nullptr) {}
+
+        explicit _Safe_forward_list_storage(const _Alloc& _Al) noexcept : _Mybase(_Al), _Head(nullptr) {}
+
+        _Safe_forward_list_storage(const _Safe_forward_list_storage&)            = delete;
+        _Safe_forward_list_storage& operator=(const _Safe_forward_list_storage&) = delete;
+
+        void _Swap(_Safe_forward_list_storage& _Other) noexcept {
+            static_assert(!_Is_inline_storage<_Storage>, "inline nodes cannot be swapped, use _Steal().");
+            _Mybase::_Swap(_Other);
+            this->_Swap_size(_Other);
+            this->_Swap_tail(_Other);
+            ::std::swap(_Head, _Other._Head);
+        }
+
+        void _Steal(_Safe_forward_list_storage& _Other) noexcept {
+            // Note: Called on an empty storage, as _Safe_list_storage::_Steal(). The values of the inline
+            //       nodes of _Other are moved into the slots of this storage, its heap nodes are taken over.
+            static_assert(_Is_inline_storage<_Storage>, "only inline nodes have to be moved.");
+            this->_Swap_heap(_Other);
+            this->_Swap_size(_Other);
+            this->_Swap_tail(_Other);
+            ::std::swap(_Head, _Other._Head);
+            _Node_type* _Prev = nullptr;
+            for (_Node_type* _Node = _Head; _Node != nullptr; _Node = _Node->_Next) {
+                if (_Other._Is_inline(_Node)) { // move the value into a slot of this storage
+                    _Node_type* const _New_node = ::new (static_cast<void*>(this->_Allocate_node()))
+                        _Node_type(::std::in_place, ::std::move(_Node->_Value)); // always a free slot
+                    _New_node->_Next               = _Node->_Next;
+                    (_Prev ? _Prev->_Next : _Head) = _New_node;
+                    if constexpr (_Tailed) {
+                        if (!_New_node->_Next) { // the last node has moved
+                            this->_Tail = _New_node;
+                        }
+                    }
+
+                    _Node->~_Node_type();
+                    _Node = _New_node;
+                }
+
+                _Prev = _Node;
+            }
+
+            _Other._Release_nodes(); // every slot of _Other is free now
+        }
+    };
+
+    template <class _Ty, class _Node_t, bool _Is_const>
+    class _Safe_forward_list_iterator { // forward list iterator
+    public:
+        using value_type        = _Ty;
+        using difference_type   = ptrdiff_t;
+        using pointer           = ::std::conditional_t<_Is_const, const _Ty*, _Ty*>;
+        using reference         = ::std::conditional_t<_Is_const, const _Ty&, _Ty&>;
+        using iterator_category = ::std::forward_iterator_tag;
+
+        _Safe_forward_list_iterator() noexcept : _Node(nullptr) {}
+
+        explicit _Safe_forward_list_iterator(_Node_t* const _Node) noexcept : _Node(_Node) {}
+
+        template <bool _Other_const, ::std::enable_if_t<_Is_const && !_Other_const, int> = 0>
+        _Safe_forward_list_iterator(const _Safe_forward_list_iterator<_Ty, _Node_t, _Other_const>& _Other) noexcept
+            : _Node(_Other._Get_node()) {}
+
+        ~_Safe_forward_list_iterator() noexcept {}
+
+        explicit operator bool() const noexcept {
+            return _Node != nullptr;
+        }
+
+        bool valid() const noexcept {
+            return _Node != nullptr;
+        }
+
+        bool operator==(const _Safe_forward_list_iterator& _Other) const noexcept {
+            return _Node == _Other._Node;
+        }
+
+        bool operator!=(const _Safe_forward_list_iterator& _Other) const noexcept {
+            return _Node != _Other._Node;
+        }
+
+        reference operator*() const noexcept {
+            return _Node->_Value;
+        }
+
+        pointer operator->() const noexcept {
+            return ::std::addressof(_Node->_Value);
+        }
+
+        _Safe_forward_list_iterator& operator++() noexcept {
+            _Node = _Node->_Next;
+            return *this;
+        }
+
+        _Safe_forward_list_iterator operator++(int) noexcept {
+            _Safe_forward_list_iterator _Temp = *this;
+            _Node                             = _Node->_Next;
+            return _Temp;
+        }
+
+        _Node_t* _Get_node() const noexcept {
+            return _Node;
+        }
+
+    private:
+        _Node_t* _Node;
+    };
+
+    template <class _Ty, class _Alloc = safe_allocator<_Ty>, class _Policy = safe_list_heap_storage>
+    class safe_forward_list { // exception-safe singly-linked list
+    private:
+        using _Traits    = _Safe_list_traits<_Ty>;
+        using _Node_t    = _Safe_forward_list_node<_Ty, _Traits>;
+        using _Al_traits = ::std::allocator_traits<_Alloc>;
+        using _Alnode_t  = typename _Al_traits::template rebind_alloc<_Node_t>;
+        using _Storage   = typename _Safe_forward_list_policy_traits<_Policy>::_Storage;
+
+        static constexpr bool _Counted = _Safe_forward_list_policy_traits<_Policy>::_Counted;
+        static constexpr bool _Tailed  = _Safe_forward_list_policy_traits<_Policy>::_Tailed;
+
+    public:
+        using value_type      = _Ty;
+        using allocator_type  = _Alloc;
+        using policy_type     = _Policy;
+        using storage_type    = _Storage;
+        using size_type       = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer         = _Ty*;
+        using const_pointer   = const _Ty*;
+        using reference       = _Ty&;
+        using const_reference = const _Ty&;
+
+        using iterator       = _Safe_forward_list_iterator<_Ty, _Node_t, false>;
+        using const_iterator = _Safe_forward_list_iterator<_Ty, _Node_t, true>;
+
+        static_assert(::std::is_same_v<typename _Alloc::value_type, _Ty>, "Alloc::value_type must be T.");
+        static_assert(!_Is_inline_storage<_Storage> || _Traits::_Is_nothrow_move_constructible,
+            "T must be nothrow move constructible to be stored inline.");
+
+        // Note: The singly-linked counterpart of safe_list<T, Alloc, Policy> with the same storage backends
+        //       (the heap with an optional node cache, slabs or inline slots). A node holds a single link.
+        //       What else the list keeps is chosen by the policy, see safe_forward_list_policy:
+        //       - safe_list_uncounted_size drops the size counter, size() then walks the list,
+        //       - safe_list_with_tail adds a pointer to the last node, for push_back() and back().
+        //       Whatever a policy leaves out is an empty base, so neither the list nor the code of any
+        //       modifier pays for it. Iterators stay valid until their element is erased.
+
+        safe_forward_list() noexcept : _Mystorage() {}
+
+        explicit safe_forward_list(const allocator_type& _Al) noexcept : _Mystorage(_Alnode_t(_Al)) {}
+
+        safe_forward_list(const safe_forward_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible)
+            : _Mystorage(_Alnode_t(_Al_traits::select_on_container_copy_construction(_Other.get_allocator()))) {
+            (void) _Append_copies(_Other);
+        }
+
+        safe_forward_list(safe_forward_list&& _Other) noexcept : _Mystorage(_Other._Mystorage._Get_allocator()) {
+            if constexpr (_Is_inline_storage<_Storage>) { // the inline values must be moved
+                _Mystorage._Steal(_Other._Mystorage);
+            } else {
+                _Mystorage._Swap(_Other._Mystorage); // swap storages
+            }
+        }
+
+        safe_forward_list(::std::initializer_list<value_type> _Init_list,
+            const allocator_type& _Al = allocator_type{}) noexcept(_Traits::_Is_nothrow_copy_constructible)
+            : _Mystorage(_Alnode_t(_Al)) {
+            (void) _Append_range(_Init_list.begin(), _Init_list.end());
+        }
+
+        ~safe_forward_list() noexcept {
+            clear();
+        }
+
+        safe_forward_list& operator=(const safe_forward_list& _Other) noexcept(
+            _Traits::_Is_nothrow_copy_constructible) {
+            if (this != ::std::addressof(_Other)) {
+                clear();
+                (void) _Append_copies(_Other);
+            }
+
+            return *this;
+        }
+
+        safe_forward_list& operator=(safe_forward_list&& _Other) noexcept {
+            if (this != ::std::addressof(_Other)) {
+                if constexpr (_Is_inline_storage<_Storage>) {
+                    clear();
+                    _Mystorage._Steal(_Other._Mystorage);
+                } else {
+                    _Mystorage._Swap(_Other._Mystorage);
+                }
+            }
+
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(_Mystorage._Get_allocator());
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return _Mystorage._Head == nullptr;
+        }
+
+        size_type size() const noexcept {
+            if constexpr (_Counted) {
+                return _Mystorage._Size;
+            } else { // count the nodes
+                size_type _Count = 0;
+                for (const _Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Node->_Next) {
+                    ++_Count;
+                }
+
+                return _Count;
+            }
+        }
+
+        size_type max_size() const noexcept {
+            if constexpr (_Is_bounded_storage<_Storage>) { // the capacity set by reserve_nodes()
+                return _Mystorage._Capacity;
+            } else {
+                return static_cast<size_type>(-1) / sizeof(_Node_t);
+            }
+        }
+
+        iterator begin() noexcept {
+            return iterator{_Mystorage._Head};
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator{_Mystorage._Head};
+        }
+
+        const_iterator cbegin() const noexcept {
+            return const_iterator{_Mystorage._Head};
+        }
+
+        iterator end() noexcept {
+            return iterator{};
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator{};
+        }
+
+        const_iterator cend() const noexcept {
+            return const_iterator{};
+        }
+
+        pointer front() noexcept {
+            return _Mystorage._Head ? ::std::addressof(_Mystorage._Head->_Value) : nullptr;
+        }
+
+        const_pointer front() const noexcept {
+            return _Mystorage._Head ? ::std::addressof(_Mystorage._Head->_Value) : nullptr;
+        }
+
+        pointer back() noexcept {
+            static_assert(_Tailed, "back() requires the safe_list_with_tail policy.");
+            return _Mystorage._Tail ? ::std::addressof(_Mystorage._Tail->_Value) : nullptr;
+        }
+
+        const_pointer back() const noexcept {
+            static_assert(_Tailed, "back() requires the safe_list_with_tail policy.");
+            return _Mystorage._Tail ? ::std::addressof(_Mystorage._Tail->_Value) : nullptr;
+        }
+
+        void clear() noexcept {
+            if (_Mystorage._Head) { // non-empty list, erase elements
+                _Node_t* _Next;
+                for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Next) {
+                    _Next = _Node->_Next;
+                    _Free_node(_Node);
+                }
+
+                _Mystorage._Head = nullptr;
+                if constexpr (_Counted) {
+                    _Mystorage._Size = 0;
+                }
+
+                if constexpr (_Tailed) {
+                    _Mystorage._Tail = nullptr;
+                }
+
+                _Mystorage._Release_nodes();
+            }
+        }
+
+        [[nodiscard]] bool push_front(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace_front(_Value);
+        }
+
+        [[nodiscard]] bool push_front(value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace_front(::std::move(_Value));
+        }
+
+        template <class... _Types>
+        [[nodiscard]] bool emplace_front(
+            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            _Node_t* const _New_node = _Make_node(::std::forward<_Types>(_Args)...);
+            if (!_New_node) { // allocation failed
+                return false;
+            }
+
+            _New_node->_Next = _Mystorage._Head;
+            _Mystorage._Head = _New_node;
+            if constexpr (_Tailed) {
+                if (!_New_node->_Next) { // the first node is also the last one
+                    _Mystorage._Tail = _New_node;
+                }
+            }
+
+            _Mystorage._Add_size(1);
+            return true;
+        }
+
+        [[nodiscard]] bool push_back(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace_back(_Value);
+        }
+
+        [[nodiscard]] bool push_back(value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace_back(::std::move(_Value));
+        }
+
+        template <class... _Types>
+        [[nodiscard]] bool emplace_back(
+            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            static_assert(_Tailed, "push_back() requires the safe_list_with_tail policy.");
+            _Node_t* const _New_node = _Make_node(::std::forward<_Types>(_Args)...);
+            if (!_New_node) { // allocation failed
+                return false;
+            }
+
+            (_Mystorage._Tail ? _Mystorage._Tail->_Next : _Mystorage._Head) = _New_node;
+            _Mystorage._Tail                                                = _New_node;
+            _Mystorage._Add_size(1);
+            return true;
+        }
+
+        iterator insert_after(const_iterator _Where, const value_type& _Value) noexcept(
+            _Traits::_Is_nothrow_copy_constructible) {
+            return emplace_after(_Where, _Value);
+        }
+
+        iterator insert_after(const_iterator _Where, value_type&& _Value) noexcept(
+            _Traits::_Is_nothrow_move_constructible) {
+            return emplace_after(_Where, ::std::move(_Value));
+        }
+
+        template <class... _Types>
+        iterator emplace_after(const_iterator _Where,
+            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            // Note: Inserts after _Where, or at the front if _Where is end().
+            //       Returns an empty iterator if the allocation failed.
+            _Node_t* const _Prev = _Where._Get_node();
+            if (!_Prev) { // insert at the front
+                return emplace_front(::std::forward<_Types>(_Args)...) ? begin() : iterator{};
+            }
+
+            _Node_t* const _New_node = _Make_node(::std::forward<_Types>(_Args)...);
+            if (!_New_node) { // allocation failed
+                return iterator{};
+            }
+
+            _New_node->_Next = _Prev->_Next;
+            _Prev->_Next     = _New_node;
+            if constexpr (_Tailed) {
+                if (_Mystorage._Tail == _Prev) { // inserted after the last node
+                    _Mystorage._Tail = _New_node;
+                }
+            }
+
+            _Mystorage._Add_size(1);
+            return iterator{_New_node};
+        }
+
+        void pop_front() noexcept {
+            _Node_t* const _Head = _Mystorage._Head;
+            if (_Head) {
+                _Mystorage._Head = _Head->_Next;
+                if constexpr (_Tailed) {
+                    if (!_Head->_Next) { // erase the only node
+                        _Mystorage._Tail = nullptr;
+                    }
+                }
+
+                _Mystorage._Subtract_size(1);
+                _Free_node(_Head);
+            }
+        }
+
+        iterator erase_after(const_iterator _Where) noexcept {
+            // Note: Erases the element after _Where, or the first one if _Where is end().
+            //       Returns an iterator to the element after the erased one.
+            _Node_t* const _Prev = _Where._Get_node();
+            _Node_t* const _Node = _Prev ? _Prev->_Next : _Mystorage._Head;
+            if (!_Node) { // nothing to erase
+                return iterator{};
+            }
+
+            _Unlink(_Prev, _Node);
+            return iterator{_Prev ? _Prev->_Next : _Mystorage._Head};
+        }
+
+        template <class _Pr>
+        size_type remove_if(_Pr _Pred) noexcept(::std::is_nothrow_invocable_v<_Pr, const _Ty&>) {
+            size_type _Count = 0;
+            _Node_t* _Prev   = nullptr;
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Next) {
+                _Next = _Node->_Next;
+                if (_Pred(static_cast<const _Ty&>(_Node->_Value))) { // element found, erase it
+                    _Unlink(_Prev, _Node);
+                    ++_Count;
+                } else {
+                    _Prev = _Node;
+                }
+            }
+
+            return _Count;
+        }
+
+        size_type remove(const value_type& _Value) noexcept {
+            return remove_if([_Value](const value_type& _Node_value) noexcept { return _Node_value == _Value; });
+        }
+
+        void reverse() noexcept {
+            _Node_t* _Prev = nullptr;
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Next) {
+                _Next        = _Node->_Next;
+                _Node->_Next = _Prev;
+                _Prev        = _Node;
+            }
+
+            if constexpr (_Tailed) {
+                _Mystorage._Tail = _Mystorage._Head;
+            }
+
+            _Mystorage._Head = _Prev;
+        }
+
+        [[nodiscard]] bool reserve_nodes(const size_type _Count) noexcept {
+            return _Mystorage._Reserve(_Count);
+        }
+
+        void shrink_to_fit() noexcept {
+            _Mystorage._Shrink();
+        }
+
+        size_type cached_nodes() const noexcept {
+            return _Mystorage._Available();
+        }
+
+        size_type node_cache_limit() const noexcept {
+            static_assert(!_Is_slab_storage<_Storage> && !_Is_bounded_storage<_Storage>,
+                "the slab and bounded storages do not limit spent nodes.");
+            return _Mystorage._Cache_limit;
+        }
+
+        void node_cache_limit(const size_type _New_limit) noexcept {
+            static_assert(!_Is_slab_storage<_Storage> && !_Is_bounded_storage<_Storage>,
+                "the slab and bounded storages do not limit spent nodes.");
+            _Mystorage._Cache_limit = _New_limit;
+            _Mystorage._Trim_cache(_New_limit);
+        }
+
+        void swap(safe_forward_list& _Other) noexcept {
+            if constexpr (_Is_inline_storage<_Storage>) { // three moves, the inline values change places
+                if (this != ::std::addressof(_Other)) {
+                    safe_forward_list _Temp(::std::move(_Other));
+                    _Other = ::std::move(*this);
+                    *this  = ::std::move(_Temp);
+                }
+            } else {
+                _Mystorage._Swap(_Other._Mystorage);
+            }
+        }
+
+    private:
+        using _Storage_t = _Safe_forward_list_storage<_Node_t, _Alnode_t, _Storage, _Counted, _Tailed>;
+
+        template <class... _Types>
+        _Node_t* _Make_node(_Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            static_assert(_Traits::template
+                _Is_constructible<_Types&&...>, "T must be constructible from Types...");
+            if constexpr (_Counted) {
+                if (_Mystorage._Size == max_size()) { // not enough space for another element
+                    return nullptr;
+                }
+            }
+
+            _Node_t* const _Raw = _Mystorage._Allocate_node();
+            return _Raw ? ::new (static_cast<void*>(_Raw)) _Node_t(::std::in_place, ::std::forward<_Types>(_Args)...)
+                        : nullptr;
+        }
+
+        void _Free_node(_Node_t* const _Node) noexcept {
+            _Node->~_Node_t();
+            _Mystorage._Deallocate_node(_Node);
+        }
+
+        void _Unlink(_Node_t* const _Prev, _Node_t* const _Node) noexcept {
+            // Note: _Prev is the node before _Node, a null-pointer if _Node is the first one.
+            (_Prev ? _Prev->_Next : _Mystorage._Head) = _Node->_Next;
+            if constexpr (_Tailed) {
+                if (_Mystorage._Tail == _Node) { // erase the last node
+                    _Mystorage._Tail = _Prev;
+                }
+            }
+
+            _Mystorage._Subtract_size(1);
+            _Free_node(_Node);
+        }
+
+        template <class _InIt>
+        bool _Append_range(_InIt _First, const _InIt _Last) noexcept(
+            _Traits::template _Is_nothrow_constructible<decltype(*::std::declval<_InIt>())>) {
+            // Note: Appends as many elements as can be allocated, the last node is tracked locally
+            //       so that no tail pointer is needed.
+            _Node_t* _Prev = nullptr;
+            for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Node->_Next) {
+                _Prev = _Node;
+            }
+
+            for (; _First != _Last; ++_First) {
+                const iterator _New = emplace_after(const_iterator{_Prev}, *_First);
+                if (!_New) { // allocation failed
+                    return false;
+                }
+
+                _Prev = _New._Get_node();
+            }
+
+            return true;
+        }
+
+        bool _Append_copies(const safe_forward_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            if constexpr (_Is_bounded_storage<_Storage>) { // the copy gets the same capacity
+                (void) _Mystorage._Reserve(_Other._Mystorage._Capacity);
+            }
+
+            return _Append_range(_Other.begin(), _Other.end());
+        }
+
+        _Storage_t _Mystorage;
+    };
+
+    template <class _Ty, class _Alloc, class _Policy>
+    void swap(
+        safe_forward_list<_Ty, _Alloc, _Policy>& _Left, safe_forward_list<_Ty, _Alloc, _Policy>& _Right) noexcept {
+        _Left.swap(_Right);
+    }
+
+    template <class _Ty, class _Alloc, class _Policy>
+    typename safe_forward_list<_Ty, _Alloc, _Policy>::size_type erase(
+        safe_forward_list<_Ty, _Alloc, _Policy>& _List, const _Ty& _Value) noexcept {
+        return _List.remove(_Value);
+    }
+
+    template <class _Ty, class _Alloc, class _Policy, class _Pr>
+    typename safe_forward_list<_Ty, _Alloc, _Policy>::size_type erase(safe_forward_list<_Ty, _Alloc, _Policy>& _List,
+        _Pr _Pred) noexcept(::std::is_nothrow_invocable_v<_Pr, const _Ty&>) {
+        return _List.remove_if(_Pred);
+    }
+} // namespace mjx
+
+#endif // _SAFE_FORWARD_LIST_HPP_
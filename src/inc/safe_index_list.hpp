@@ -0,0 +1,687 @@
+// safe_index_list.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SAFE_INDEX_LIST_HPP_
+#define _SAFE_INDEX_LIST_HPP_
+#include <cstdint>
+#include <cstring>
+#include <safe_list.hpp>
+
+namespace mjx {
+    inline constexpr uint32_t _Safe_index_list_npos = UINT32_MAX; // no slot, marks both ends of the list
+    inline constexpr uint32_t _Safe_index_list_free = UINT32_MAX - 1; // _Prev of a slot in the free chain
+
+    struct _Safe_index_list_link { // links of a single slot
+        uint32_t _Next; // index of the next slot
+        uint32_t _Prev; // index of the previous slot
+    };
+
+    template <class _List, bool _Is_const, bool _Is_reverse>
+    class _Safe_index_list_iterator { // list iterator, points to the list and the slot index
+    private:
+        using _List_ptr = ::std::conditional_t<_Is_const, const _List*, _List*>;
+
+    public:
+        using value_type        = typename _List::value_type;
+        using difference_type   = ptrdiff_t;
+        using pointer           = ::std::conditional_t<_Is_const, const value_type*, value_type*>;
+        using reference         = ::std::conditional_t<_Is_const, const value_type&, value_type&>;
+        using iterator_category = ::std::bidirectional_iterator_tag;
+
+        // Note: The iterator refers to the slot, not to its address, so it stays valid when the list grows.
+
+        _Safe_index_list_iterator() noexcept : _Mylist(nullptr), _Index(_Safe_index_list_npos) {}
+
+        _Safe_index_list_iterator(_List_ptr const _Mylist, const uint32_t _Index) noexcept
+            : _Mylist(_Mylist), _Index(_Index) {}
+
+        template <bool _Other_const, ::std::enable_if_t<_Is_const && !_Other_const, int> = 0>
+        _Safe_index_list_iterator(
+            const _Safe_index_list_iterator<_List, _Other_const, _Is_reverse>& _Other) noexcept
+            : _Mylist(_Other._Get_list()), _Index(_Other._Get_index()) {}
+
+        ~_Safe_index_list_iterator() noexcept {}
+
+        explicit operator bool() const noexcept {
+            return _Index != _Safe_index_list_npos;
+        }
+
+        bool valid() const noexcept {
+            return _Index != _Safe_index_list_npos;
+        }
+
+        size_t index() const noexcept {
+            // Note: The slot index of the element, it does not change until the element is erased.
+            return _Index;
+        }
+
+        bool operator==(const _Safe_index_list_iterator& _Other) const noexcept {
+            return _Index == _Other._Index;
+        }
+
+        bool operator!=(const _Safe_index_list_iterator& _Other) const noexcept {
+            return _Index != _Other._Index;
+        }
+
+        reference operator*() const noexcept {
+            return _Mylist->_Value_at(_Index);
+        }
+
+        pointer operator->() const noexcept {
+            return ::std::addressof(_Mylist->_Value_at(_Index));
+        }
+
+        _Safe_index_list_iterator& operator++() noexcept {
+            const _Safe_index_list_link& _Link = _Mylist->_Link_at(_Index);
+            _Index                             = _Is_reverse ? _Link._Prev : _Link._Next;
+            return *this;
+        }
+
+        _Safe_index_list_iterator operator++(int) noexcept {
+            _Safe_index_list_iterator _Temp = *this;
+            ++*this;
+            return _Temp;
+        }
+
+        _Safe_index_list_iterator& operator--() noexcept {
+            // Note: Also works on end(), the past-the-last slot is followed by the first one.
+            if (_Index == _Safe_index_list_npos) {
+                _Index = _Is_reverse ? _Mylist->_First_index() : _Mylist->_Last_index();
+            } else {
+                const _Safe_index_list_link& _Link = _Mylist->_Link_at(_Index);
+                _Index                             = _Is_reverse ? _Link._Next : _Link._Prev;
+            }
+
+            return *this;
+        }
+
+        _Safe_index_list_iterator operator--(int) noexcept {
+            _Safe_index_list_iterator _Temp = *this;
+            --*this;
+            return _Temp;
+        }
+
+        _List_ptr _Get_list() const noexcept {
+            return _Mylist;
+        }
+
+        uint32_t _Get_index() const noexcept {
+            return _Index;
+        }
+
+    private:
+        _List_ptr _Mylist;
+        uint32_t _Index;
+    };
+
+    template <class _Ty, class _Alloc = safe_allocator<_Ty>>
+    class safe_index_list { // exception-safe doubly-linked list stored in contiguous arrays
+    private:
+        using _Traits    = _Safe_list_traits<_Ty>;
+        using _Self_t    = safe_index_list<_Ty, _Alloc>;
+        using _Link_t    = _Safe_index_list_link;
+        using _Al_traits = ::std::allocator_traits<_Alloc>;
+        using _Alval_t   = typename _Al_traits::template rebind_alloc<_Ty>;
+        using _Allink_t  = typename _Al_traits::template rebind_alloc<_Link_t>;
+
+        static_assert(_Traits::_Is_nothrow_move_constructible, "T must be nothrow move constructible.");
+        static_assert(_Is_nothrow_allocator<_Alval_t> && _Is_nothrow_allocator<_Allink_t>,
+            "Alloc must not throw, allocate() returns a null-pointer.");
+
+        static constexpr uint32_t _Npos        = _Safe_index_list_npos;
+        static constexpr uint32_t _Min_capacity = 8; // slots allocated by the first insertion
+
+    public:
+        using value_type      = _Ty;
+        using allocator_type  = _Alloc;
+        using size_type       = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer         = _Ty*;
+        using const_pointer   = const _Ty*;
+        using reference       = _Ty&;
+        using const_reference = const _Ty&;
+
+        using iterator               = _Safe_index_list_iterator<_Self_t, false, false>;
+        using const_iterator         = _Safe_index_list_iterator<_Self_t, true, false>;
+        using reverse_iterator       = _Safe_index_list_iterator<_Self_t, false, true>;
+        using const_reverse_iterator = _Safe_index_list_iterator<_Self_t, true, true>;
+
+        // Note: The values and the links live in two parallel arrays indexed by 32-bit slot numbers,
+        //       so a scan touches contiguous memory and a node costs 8 bytes of links on every platform.
+        //       Erased slots are chained into a free list and reused before the arrays grow.
+        //       Growing moves the values into larger arrays, which invalidates pointers and references
+        //       to the elements, but not the iterators and slot indices, those stay valid until
+        //       the element is erased. The links hold no addresses, the arrays of a trivially copyable T
+        //       can be copied with memcpy(), mapped into another process or written to a file as they are.
+
+        // Note: Used by the iterators, not a part of the public interface.
+        reference _Value_at(const uint32_t _Index) noexcept {
+            return _Mystorage._Values[_Index];
+        }
+
+        const_reference _Value_at(const uint32_t _Index) const noexcept {
+            return _Mystorage._Values[_Index];
+        }
+
+        const _Link_t& _Link_at(const uint32_t _Index) const noexcept {
+            return _Mystorage._Links[_Index];
+        }
+
+        uint32_t _First_index() const noexcept {
+            return _Mystorage._Head;
+        }
+
+        uint32_t _Last_index() const noexcept {
+            return _Mystorage._Tail;
+        }
+
+        safe_index_list() noexcept : _Mystorage() {}
+
+        explicit safe_index_list(const allocator_type& _Al) noexcept : _Mystorage(_Al) {}
+
+        safe_index_list(const safe_index_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible)
+            : _Mystorage(_Al_traits::select_on_container_copy_construction(_Other.get_allocator())) {
+            (void) _Copy_list(_Other);
+        }
+
+        safe_index_list(safe_index_list&& _Other) noexcept : _Mystorage(_Other._Mystorage._Get_allocator()) {
+            _Mystorage._Swap(_Other._Mystorage); // swap storages
+        }
+
+        safe_index_list(::std::initializer_list<value_type> _Init_list,
+            const allocator_type& _Al = allocator_type{}) noexcept(_Traits::_Is_nothrow_copy_constructible)
+            : _Mystorage(_Al) {
+            if (!reserve(_Init_list.size())) { // allocation failed
+                return;
+            }
+
+            for (const value_type& _Value : _Init_list) {
+                (void) push_back(_Value); // never fails, the space is reserved
+            }
+        }
+
+        ~safe_index_list() noexcept {
+            clear();
+            _Release_arrays();
+        }
+
+        safe_index_list& operator=(const safe_index_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            if (this != ::std::addressof(_Other)) {
+                clear();
+                (void) _Copy_list(_Other);
+            }
+
+            return *this;
+        }
+
+        safe_index_list& operator=(safe_index_list&& _Other) noexcept {
+            if (this != ::std::addressof(_Other)) {
+                _Mystorage._Swap(_Other._Mystorage);
+            }
+
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(_Mystorage._Get_allocator());
+        }
+
+        bool empty() const noexcept {
+            return _Mystorage._Size == 0;
+        }
+
+        size_type size() const noexcept {
+            return _Mystorage._Size;
+        }
+
+        size_type max_size() const noexcept {
+            // Note: _Safe_index_list_free and _Safe_index_list_npos are not valid slot indices.
+            constexpr size_type _Max_index  = _Safe_index_list_free;
+            constexpr size_type _Max_memory = static_cast<size_type>(-1) / (sizeof(_Ty) + sizeof(_Link_t));
+            return _Max_index < _Max_memory ? _Max_index : _Max_memory;
+        }
+
+        size_type capacity() const noexcept {
+            return _Mystorage._Capacity;
+        }
+
+        [[nodiscard]] bool reserve(const size_type _Count) noexcept {
+            // Note: Makes room for _Count elements, returns false if the arrays could not grow.
+            if (_Count <= _Mystorage._Capacity) { // enough space
+                return true;
+            }
+
+            if (_Count > max_size()) { // not enough space for that many elements
+                return false;
+            }
+
+            return _Grow(static_cast<uint32_t>(_Count));
+        }
+
+        iterator begin() noexcept {
+            return iterator{this, _Mystorage._Head};
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator{this, _Mystorage._Head};
+        }
+
+        const_iterator cbegin() const noexcept {
+            return const_iterator{this, _Mystorage._Head};
+        }
+
+        reverse_iterator rbegin() noexcept {
+            return reverse_iterator{this, _Mystorage._Tail};
+        }
+
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator{this, _Mystorage._Tail};
+        }
+
+        const_reverse_iterator crbegin() const noexcept {
+            return const_reverse_iterator{this, _Mystorage._Tail};
+        }
+
+        iterator end() noexcept {
+            return iterator{this, _Npos}; // past-the-last element, can be decremented
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator{this, _Npos};
+        }
+
+        const_iterator cend() const noexcept {
+            return const_iterator{this, _Npos};
+        }
+
+        reverse_iterator rend() noexcept {
+            return reverse_iterator{this, _Npos};
+        }
+
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator{this, _Npos};
+        }
+
+        const_reverse_iterator crend() const noexcept {
+            return const_reverse_iterator{this, _Npos};
+        }
+
+        iterator iterator_to_slot(const size_type _Index) noexcept {
+            // Note: Returns an empty iterator if _Index does not hold an element.
+            return iterator{this, _Is_used_slot(_Index) ? static_cast<uint32_t>(_Index) : _Npos};
+        }
+
+        const_iterator iterator_to_slot(const size_type _Index) const noexcept {
+            return const_iterator{this, _Is_used_slot(_Index) ? static_cast<uint32_t>(_Index) : _Npos};
+        }
+
+        pointer front() noexcept {
+            return _Mystorage._Head != _Npos ? _Mystorage._Values + _Mystorage._Head : nullptr;
+        }
+
+        const_pointer front() const noexcept {
+            return _Mystorage._Head != _Npos ? _Mystorage._Values + _Mystorage._Head : nullptr;
+        }
+
+        pointer back() noexcept {
+            return _Mystorage._Tail != _Npos ? _Mystorage._Values + _Mystorage._Tail : nullptr;
+        }
+
+        const_pointer back() const noexcept {
+            return _Mystorage._Tail != _Npos ? _Mystorage._Values + _Mystorage._Tail : nullptr;
+        }
+
+        void clear() noexcept {
+            // Note: Keeps the arrays, the slots are reused by the next insertions.
+            if constexpr (!::std::is_trivially_destructible_v<_Ty>) { // no walk for trivial types
+                for (uint32_t _Index = _Mystorage._Head; _Index != _Npos; _Index = _Mystorage._Links[_Index]._Next) {
+                    _Mystorage._Values[_Index].~_Ty();
+                }
+            }
+
+            _Mystorage._Head = _Npos;
+            _Mystorage._Tail = _Npos;
+            _Mystorage._Free = _Npos;
+            _Mystorage._Size = 0;
+            _Mystorage._Used = 0;
+        }
+
+        iterator insert(const_iterator _Where, const value_type& _Value) noexcept(
+            _Traits::_Is_nothrow_copy_constructible) {
+            return emplace(_Where, _Value);
+        }
+
+        iterator insert(const_iterator _Where, value_type&& _Value) noexcept {
+            return emplace(_Where, ::std::move(_Value));
+        }
+
+        template <class... _Types>
+        iterator emplace(const_iterator _Where,
+            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            // Note: Inserts before _Where, returns an empty iterator if the allocation failed.
+            static_assert(_Traits::template _Is_constructible<_Types&&...>, "T must be constructible from Types...");
+            const uint32_t _Index = _Make_slot(::std::forward<_Types>(_Args)...);
+            if (_Index == _Npos) { // allocation failed
+                return iterator{};
+            }
+
+            _Link_before(_Where._Get_index(), _Index);
+            return iterator{this, _Index};
+        }
+
+        [[nodiscard]] bool push_back(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace_back(_Value);
+        }
+
+        [[nodiscard]] bool push_back(value_type&& _Value) noexcept {
+            return emplace_back(::std::move(_Value));
+        }
+
+        [[nodiscard]] bool push_front(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace_front(_Value);
+        }
+
+        [[nodiscard]] bool push_front(value_type&& _Value) noexcept {
+            return emplace_front(::std::move(_Value));
+        }
+
+        template <class... _Types>
+        [[nodiscard]] bool emplace_back(_Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            return emplace(cend(), ::std::forward<_Types>(_Args)...).valid();
+        }
+
+        template <class... _Types>
+        [[nodiscard]] bool emplace_front(_Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            return emplace(cbegin(), ::std::forward<_Types>(_Args)...).valid();
+        }
+
+        iterator erase(const_iterator _Where) noexcept {
+            // Note: Returns an iterator to the element after the erased one.
+            const uint32_t _Index = _Where._Get_index();
+            if (_Index == _Npos) { // past-the-last element, nothing to erase
+                return end();
+            }
+
+            const uint32_t _Next = _Mystorage._Links[_Index]._Next;
+            _Unlink(_Index);
+            return iterator{this, _Next};
+        }
+
+        void pop_back() noexcept {
+            if (_Mystorage._Tail != _Npos) {
+                _Unlink(_Mystorage._Tail);
+            }
+        }
+
+        void pop_front() noexcept {
+            if (_Mystorage._Head != _Npos) {
+                _Unlink(_Mystorage._Head);
+            }
+        }
+
+        template <class _Pr>
+        size_type remove_if(_Pr _Pred) noexcept(::std::is_nothrow_invocable_v<_Pr, const _Ty&>) {
+            size_type _Count = 0;
+            uint32_t _Next;
+            for (uint32_t _Index = _Mystorage._Head; _Index != _Npos; _Index = _Next) {
+                _Next = _Mystorage._Links[_Index]._Next;
+                if (_Pred(static_cast<const _Ty&>(_Mystorage._Values[_Index]))) { // element found, erase it
+                    _Unlink(_Index);
+                    ++_Count;
+                }
+            }
+
+            return _Count;
+        }
+
+        size_type remove(const value_type& _Value) noexcept {
+            return remove_if([_Value](const value_type& _Node_value) noexcept { return _Node_value == _Value; });
+        }
+
+        void reverse() noexcept {
+            uint32_t _Next;
+            for (uint32_t _Index = _Mystorage._Head; _Index != _Npos; _Index = _Next) {
+                _Link_t& _Link = _Mystorage._Links[_Index];
+                _Next          = _Link._Next;
+                _Link._Next    = _Link._Prev;
+                _Link._Prev    = _Next;
+            }
+
+            ::std::swap(_Mystorage._Head, _Mystorage._Tail);
+        }
+
+        void swap(safe_index_list& _Other) noexcept {
+            _Mystorage._Swap(_Other._Mystorage);
+        }
+
+    private:
+        struct _Storage_t : _Safe_list_alloc_holder<_Alval_t> {
+            using _Mybase = _Safe_list_alloc_holder<_Alval_t>;
+
+            _Ty* _Values; // array of _Capacity slots, only the used ones hold a value
+            _Link_t* _Links; // array of _Capacity links, parallel to _Values
+            uint32_t _Head; // index of the first slot
+            uint32_t _Tail; // index of the last slot
+            uint32_t _Free; // index of the first erased slot, the chain continues through _Next
+            uint32_t _Size; // number of elements
+            uint32_t _Used; // number of slots that were ever taken, the others were never touched
+            uint32_t _Capacity; // number of allocated slots
+
+            _Storage_t() noexcept : _Mybase(), _Values(nullptr), _Links(nullptr), _Head(_Npos),
+                _Tail(_Npos), _Free(_Npos), _Size(0), _Used(0), _Capacity(0) {}
+
+            explicit _Storage_t(const _Alval_t& _Al) noexcept : _Mybase(_Al), _Values(nullptr), _Links(nullptr),
+                _Head(_Npos), _Tail(_Npos), _Free(_Npos), _Size(0), _Used(0), _Capacity(0) {}
+
+            void _Swap(_Storage_t& _Other) noexcept {
+                using ::std::swap; // enable ADL for allocators
+                swap(this->_Get_allocator(), _Other._Get_allocator());
+                swap(_Values, _Other._Values);
+                swap(_Links, _Other._Links);
+                swap(_Head, _Other._Head);
+                swap(_Tail, _Other._Tail);
+                swap(_Free, _Other._Free);
+                swap(_Size, _Other._Size);
+                swap(_Used, _Other._Used);
+                swap(_Capacity, _Other._Capacity);
+            }
+        };
+
+        bool _Is_used_slot(const size_type _Index) const noexcept {
+            return _Index < _Mystorage._Used && _Mystorage._Links[_Index]._Prev != _Safe_index_list_free;
+        }
+
+        uint32_t _Next_capacity() const noexcept {
+            const size_type _Max = max_size();
+            if (_Mystorage._Capacity == _Max) { // cannot grow anymore
+                return 0;
+            }
+
+            const size_type _Doubled = static_cast<size_type>(_Mystorage._Capacity) * 2;
+            if (_Doubled < _Min_capacity) {
+                return _Max < _Min_capacity ? static_cast<uint32_t>(_Max) : _Min_capacity;
+            }
+
+            return static_cast<uint32_t>(_Doubled < _Max ? _Doubled : _Max);
+        }
+
+        bool _Grow(const uint32_t _New_capacity) noexcept {
+            // Note: Moves the values into larger arrays at the same indices, the old arrays are kept on failure.
+            _Alval_t& _Alval = _Mystorage._Get_allocator();
+            _Allink_t _Allink(_Alval);
+            _Ty* const _New_values = _Alval.allocate(_New_capacity);
+            if (!_New_values) { // allocation failed
+                return false;
+            }
+
+            _Link_t* const _New_links = _Allink.allocate(_New_capacity);
+            if (!_New_links) { // allocation failed, keep the old arrays
+                _Alval.deallocate(_New_values, _New_capacity);
+                return false;
+            }
+
+            if (_Mystorage._Used > 0) {
+                ::memcpy(static_cast<void*>(_New_links), _Mystorage._Links, _Mystorage._Used * sizeof(_Link_t));
+                if constexpr (::std::is_trivially_copyable_v<_Ty>) {
+                    ::memcpy(static_cast<void*>(_New_values), static_cast<const void*>(_Mystorage._Values),
+                        _Mystorage._Used * sizeof(_Ty));
+                } else {
+                    for (uint32_t _Index = _Mystorage._Head; _Index != _Npos;
+                         _Index          = _Mystorage._Links[_Index]._Next) {
+                        ::new (static_cast<void*>(_New_values + _Index)) _Ty(::std::move(_Mystorage._Values[_Index]));
+                        _Mystorage._Values[_Index].~_Ty();
+                    }
+                }
+            }
+
+            _Release_arrays();
+            _Mystorage._Values   = _New_values;
+            _Mystorage._Links    = _New_links;
+            _Mystorage._Capacity = _New_capacity;
+            return true;
+        }
+
+        void _Release_arrays() noexcept {
+            if (_Mystorage._Capacity > 0) {
+                _Alval_t& _Alval = _Mystorage._Get_allocator();
+                _Allink_t _Allink(_Alval);
+                _Alval.deallocate(_Mystorage._Values, _Mystorage._Capacity);
+                _Allink.deallocate(_Mystorage._Links, _Mystorage._Capacity);
+                _Mystorage._Values   = nullptr;
+                _Mystorage._Links    = nullptr;
+                _Mystorage._Capacity = 0;
+            }
+        }
+
+        template <class... _Types>
+        uint32_t _Make_slot(_Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            // Note: Constructs the value in a free slot, returns _Npos if the arrays could not grow.
+            //       The value is constructed before the arrays grow, since _Args may refer to an element.
+            if (_Mystorage._Free != _Npos) { // reuse an erased slot
+                const uint32_t _Index = _Mystorage._Free;
+                ::new (static_cast<void*>(_Mystorage._Values + _Index)) _Ty(::std::forward<_Types>(_Args)...);
+                _Mystorage._Free = _Mystorage._Links[_Index]._Next;
+                return _Index;
+            }
+
+            if (_Mystorage._Used == _Mystorage._Capacity) { // no untouched slots, the arrays must grow
+                const uint32_t _New_capacity = _Next_capacity();
+                if (_New_capacity == 0) { // not enough space for another element
+                    return _Npos;
+                }
+
+                _Ty _Value(::std::forward<_Types>(_Args)...);
+                if (!_Grow(_New_capacity)) { // allocation failed
+                    return _Npos;
+                }
+
+                ::new (static_cast<void*>(_Mystorage._Values + _Mystorage._Used)) _Ty(::std::move(_Value));
+            } else {
+                ::new (static_cast<void*>(_Mystorage._Values + _Mystorage._Used)) _Ty(::std::forward<_Types>(_Args)...);
+            }
+
+            return _Mystorage._Used++;
+        }
+
+        void _Link_before(const uint32_t _Next, const uint32_t _Index) noexcept {
+            // Note: _Next equal to _Npos links _Index at the end of the list.
+            const uint32_t _Prev = _Next != _Npos ? _Mystorage._Links[_Next]._Prev : _Mystorage._Tail;
+            _Mystorage._Links[_Index] = _Link_t{_Next, _Prev};
+            if (_Prev != _Npos) {
+                _Mystorage._Links[_Prev]._Next = _Index;
+            } else {
+                _Mystorage._Head = _Index;
+            }
+
+            if (_Next != _Npos) {
+                _Mystorage._Links[_Next]._Prev = _Index;
+            } else {
+                _Mystorage._Tail = _Index;
+            }
+
+            ++_Mystorage._Size;
+        }
+
+        void _Unlink(const uint32_t _Index) noexcept {
+            _Link_t& _Link = _Mystorage._Links[_Index];
+            if (_Link._Prev != _Npos) {
+                _Mystorage._Links[_Link._Prev]._Next = _Link._Next;
+            } else {
+                _Mystorage._Head = _Link._Next;
+            }
+
+            if (_Link._Next != _Npos) {
+                _Mystorage._Links[_Link._Next]._Prev = _Link._Prev;
+            } else {
+                _Mystorage._Tail = _Link._Prev;
+            }
+
+            _Mystorage._Values[_Index].~_Ty();
+            _Link._Next      = _Mystorage._Free; // push the slot onto the free chain
+            _Link._Prev      = _Safe_index_list_free;
+            _Mystorage._Free = _Index;
+            --_Mystorage._Size;
+        }
+
+        bool _Copy_list(const safe_index_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            // Note: The list must be empty. A trivially copyable T is copied together with the free chain
+            //       as two memcpy() calls, so the copy keeps the slot indices of _Other.
+            if constexpr (::std::is_trivially_copyable_v<_Ty>) {
+                const uint32_t _Used = _Other._Mystorage._Used;
+                if (_Used == 0) { // nothing to copy
+                    return true;
+                }
+
+                if (_Used > _Mystorage._Capacity && !_Grow(_Used)) { // allocation failed
+                    return false;
+                }
+
+                ::memcpy(static_cast<void*>(_Mystorage._Values), static_cast<const void*>(_Other._Mystorage._Values),
+                    _Used * sizeof(_Ty));
+                ::memcpy(static_cast<void*>(_Mystorage._Links), _Other._Mystorage._Links, _Used * sizeof(_Link_t));
+                _Mystorage._Head = _Other._Mystorage._Head;
+                _Mystorage._Tail = _Other._Mystorage._Tail;
+                _Mystorage._Free = _Other._Mystorage._Free;
+                _Mystorage._Size = _Other._Mystorage._Size;
+                _Mystorage._Used = _Used;
+                return true;
+            } else {
+                if (!reserve(_Other.size())) { // allocation failed
+                    return false;
+                }
+
+                for (const value_type& _Value : _Other) {
+                    (void) push_back(_Value); // never fails, the space is reserved
+                }
+
+                return true;
+            }
+        }
+
+        _Storage_t _Mystorage;
+    };
+
+    template <class _Ty, class _Alloc>
+    void swap(safe_index_list<_Ty, _Alloc>& _Left, safe_index_list<_Ty, _Alloc>& _Right) noexcept {
+        _Left.swap(_Right);
+    }
+
+    template <class _Ty, class _Alloc>
+    typename safe_index_list<_Ty, _Alloc>::size_type erase(
+        safe_index_list<_Ty, _Alloc>& _List, const _Ty& _Value) noexcept {
+        return _List.remove(_Value);
+    }
+
+    template <class _Ty, class _Alloc, class _Pr>
+    typename safe_index_list<_Ty, _Alloc>::size_type erase(
+        safe_index_list<_Ty, _Alloc>& _List, _Pr _Pred) noexcept(::std::is_nothrow_invocable_v<_Pr, const _Ty&>) {
+        return _List.remove_if(_Pred);
+    }
+} // namespace mjx
+
+#endif // _SAFE_INDEX_LIST_HPP_
@@ -0,0 +1,363 @@
+// safe_intrusive_list.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SAFE_INTRUSIVE_LIST_HPP_
+#define _SAFE_INTRUSIVE_LIST_HPP_
+#include <safe_list.hpp>
+
+namespace mjx {
+    class safe_list_hook { // links embedded in the elements of safe_intrusive_list<T, Hook>
+    public:
+        safe_list_hook* _Next; // pointer to the next hook, a pointer to itself if not linked
+        safe_list_hook* _Prev; // pointer to the previous hook, a pointer to itself if not linked
+
+        safe_list_hook() noexcept : _Next(this), _Prev(this) {}
+
+        // Note: Copying an element must not copy its links, the copy starts unlinked.
+        safe_list_hook(const safe_list_hook&) noexcept : _Next(this), _Prev(this) {}
+
+        safe_list_hook& operator=(const safe_list_hook&) noexcept {
+            return *this;
+        }
+
+        ~safe_list_hook() noexcept {}
+
+        bool is_linked() const noexcept {
+            return _Next != this;
+        }
+
+        void _Reset() noexcept {
+            _Next = this;
+            _Prev = this;
+        }
+    };
+
+    template <class _Ty, safe_list_hook _Ty::*_Hook>
+    class safe_intrusive_list { // exception-safe intrusive doubly-linked list
+    private:
+        using _Traits = _Safe_list_traits<_Ty>;
+        using _Self_t = safe_intrusive_list<_Ty, _Hook>;
+
+    public:
+        using value_type      = _Ty;
+        using size_type       = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer         = _Ty*;
+        using const_pointer   = const _Ty*;
+        using reference       = _Ty&;
+        using const_reference = const _Ty&;
+
+        using iterator               = _Safe_list_iterator<_Self_t, _Traits>;
+        using const_iterator         = _Safe_list_const_iterator<_Self_t, _Traits>;
+        using reverse_iterator       = _Safe_list_reverse_iterator<_Self_t, _Traits>;
+        using const_reverse_iterator = _Safe_list_const_reverse_iterator<_Self_t, _Traits>;
+
+        // Note: The list links the elements through their safe_list_hook member and never allocates,
+        //       it does not own the elements either. An element must outlive its membership in the list
+        //       and can be linked into one list per hook at a time. Unlinked hooks point to themselves,
+        //       so is_linked() tells whether an element can be inserted. The list leaves every hook
+        //       unlinked when it is cleared or destroyed.
+
+        // Note: Used by the iterators, not a part of the public interface.
+        using _Node_type = safe_list_hook;
+
+        static reference _Value_of(safe_list_hook* const _Node) noexcept {
+            return *reinterpret_cast<_Ty*>(reinterpret_cast<unsigned char*>(_Node) - _Hook_offset());
+        }
+
+        safe_intrusive_list() noexcept : _Head(nullptr), _Tail(nullptr), _Size(0) {}
+
+        safe_intrusive_list(const safe_intrusive_list&)            = delete;
+        safe_intrusive_list& operator=(const safe_intrusive_list&) = delete;
+
+        safe_intrusive_list(safe_intrusive_list&& _Other) noexcept : _Head(nullptr), _Tail(nullptr), _Size(0) {
+            swap(_Other);
+        }
+
+        ~safe_intrusive_list() noexcept {
+            clear();
+        }
+
+        safe_intrusive_list& operator=(safe_intrusive_list&& _Other) noexcept {
+            if (this != ::std::addressof(_Other)) {
+                clear();
+                swap(_Other);
+            }
+
+            return *this;
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return _Size == 0;
+        }
+
+        size_type size() const noexcept {
+            return _Size;
+        }
+
+        iterator begin() noexcept {
+            return iterator{_Head};
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator{_Head};
+        }
+
+        const_iterator cbegin() const noexcept {
+            return const_iterator{_Head};
+        }
+
+        reverse_iterator rbegin() noexcept {
+            return reverse_iterator{_Tail};
+        }
+
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator{_Tail};
+        }
+
+        const_reverse_iterator crbegin() const noexcept {
+            return const_reverse_iterator{_Tail};
+        }
+
+        iterator end() noexcept {
+            return iterator{nullptr}; // past-the-last element (null-pointer)
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator{nullptr}; // past-the-last element (null-pointer)
+        }
+
+        const_iterator cend() const noexcept {
+            return const_iterator{nullptr}; // past-the-last element (null-pointer)
+        }
+
+        reverse_iterator rend() noexcept {
+            return reverse_iterator{nullptr};
+        }
+
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator{nullptr};
+        }
+
+        const_reverse_iterator crend() const noexcept {
+            return const_reverse_iterator{nullptr};
+        }
+
+        pointer front() noexcept {
+            return _Head ? ::std::addressof(_Value_of(_Head)) : nullptr;
+        }
+
+        const_pointer front() const noexcept {
+            return _Head ? ::std::addressof(_Value_of(_Head)) : nullptr;
+        }
+
+        pointer back() noexcept {
+            return _Tail ? ::std::addressof(_Value_of(_Tail)) : nullptr;
+        }
+
+        const_pointer back() const noexcept {
+            return _Tail ? ::std::addressof(_Value_of(_Tail)) : nullptr;
+        }
+
+        static iterator iterator_to(value_type& _Value) noexcept {
+            // Note: _Value must be linked into a list, the iterator refers to its position there.
+            return iterator{::std::addressof(_Value.*_Hook)};
+        }
+
+        static const_iterator iterator_to(const value_type& _Value) noexcept {
+            return const_iterator{const_cast<safe_list_hook*>(::std::addressof(_Value.*_Hook))};
+        }
+
+        [[nodiscard]] bool push_back(value_type& _Value) noexcept {
+            // Note: Never fails to allocate, returns false only if _Value is already linked.
+            return insert(cend(), _Value).valid();
+        }
+
+        [[nodiscard]] bool push_front(value_type& _Value) noexcept {
+            return insert(cbegin(), _Value).valid();
+        }
+
+        iterator insert(const_iterator _Where, value_type& _Value) noexcept {
+            // Note: Returns an iterator to _Value, or an empty iterator if _Value is already linked.
+            safe_list_hook* const _New_hook = ::std::addressof(_Value.*_Hook);
+            if (_New_hook->is_linked()) { // the element belongs to a list
+                return iterator{};
+            }
+
+            safe_list_hook* const _Next = const_cast<safe_list_hook*>(_Where._Get_node());
+            safe_list_hook* const _Prev = _Next ? _Next->_Prev : _Tail;
+            _New_hook->_Next            = _Next;
+            _New_hook->_Prev            = _Prev;
+            if (_Prev) {
+                _Prev->_Next = _New_hook;
+            } else {
+                _Head = _New_hook;
+            }
+
+            if (_Next) {
+                _Next->_Prev = _New_hook;
+            } else {
+                _Tail = _New_hook;
+            }
+
+            ++_Size;
+            return iterator{_New_hook};
+        }
+
+        iterator erase(const_iterator _Where) noexcept {
+            // Note: Unlinks the element at _Where, returns an iterator to the next element.
+            safe_list_hook* const _Hook_ptr = const_cast<safe_list_hook*>(_Where._Get_node());
+            if (!_Hook_ptr) { // past-the-last element, nothing to erase
+                return end();
+            }
+
+            safe_list_hook* const _Next = _Hook_ptr->_Next;
+            _Unlink(_Hook_ptr);
+            return iterator{_Next};
+        }
+
+        [[nodiscard]] bool erase(value_type& _Value) noexcept {
+            // Note: Unlinks _Value in O(1), it must be linked into this list or not linked at all.
+            safe_list_hook* const _Hook_ptr = ::std::addressof(_Value.*_Hook);
+            if (!_Hook_ptr->is_linked()) { // not linked, nothing to erase
+                return false;
+            }
+
+            _Unlink(_Hook_ptr);
+            return true;
+        }
+
+        void pop_back() noexcept {
+            if (_Tail) {
+                _Unlink(_Tail);
+            }
+        }
+
+        void pop_front() noexcept {
+            if (_Head) {
+                _Unlink(_Head);
+            }
+        }
+
+        void clear() noexcept {
+            safe_list_hook* _Next;
+            for (safe_list_hook* _Node = _Head; _Node != nullptr; _Node = _Next) {
+                _Next = _Node->_Next;
+                _Node->_Reset();
+            }
+
+            _Head = nullptr;
+            _Tail = nullptr;
+            _Size = 0;
+        }
+
+        template <class _Pr>
+        size_type remove_if(_Pr _Pred) noexcept(::std::is_nothrow_invocable_v<_Pr, const _Ty&>) {
+            // Note: Unlinks the matching elements, they are not destroyed.
+            size_type _Count = 0;
+            safe_list_hook* _Next;
+            for (safe_list_hook* _Node = _Head; _Node != nullptr; _Node = _Next) {
+                _Next = _Node->_Next;
+                if (_Pred(static_cast<const _Ty&>(_Value_of(_Node)))) {
+                    _Unlink(_Node);
+                    ++_Count;
+                }
+            }
+
+            return _Count;
+        }
+
+        void reverse() noexcept {
+            safe_list_hook* _Next;
+            for (safe_list_hook* _Node = _Head; _Node != nullptr; _Node = _Next) {
+                _Next        = _Node->_Next;
+                _Node->_Next = _Node->_Prev;
+                _Node->_Prev = _Next;
+            }
+
+            ::std::swap(_Head, _Tail);
+        }
+
+        void splice(const_iterator _Where, safe_intrusive_list& _Other) noexcept {
+            // Note: Moves all elements of _Other before _Where in O(1).
+            if (this == ::std::addressof(_Other) || _Other._Size == 0) { // nothing to move
+                return;
+            }
+
+            safe_list_hook* const _Next = const_cast<safe_list_hook*>(_Where._Get_node());
+            safe_list_hook* const _Prev = _Next ? _Next->_Prev : _Tail;
+            _Other._Head->_Prev         = _Prev;
+            _Other._Tail->_Next         = _Next;
+            if (_Prev) {
+                _Prev->_Next = _Other._Head;
+            } else {
+                _Head = _Other._Head;
+            }
+
+            if (_Next) {
+                _Next->_Prev = _Other._Tail;
+            } else {
+                _Tail = _Other._Tail;
+            }
+
+            _Size        += _Other._Size;
+            _Other._Head  = nullptr;
+            _Other._Tail  = nullptr;
+            _Other._Size  = 0;
+        }
+
+        void swap(safe_intrusive_list& _Other) noexcept {
+            ::std::swap(_Head, _Other._Head);
+            ::std::swap(_Tail, _Other._Tail);
+            ::std::swap(_Size, _Other._Size);
+        }
+
+    private:
+        static size_t _Hook_offset() noexcept {
+            // Note: offsetof() does not accept a pointer to member, so the offset is measured
+            //       on storage that never holds a constructed object. Compilers fold it into a constant.
+            union _Probe_t {
+                _Ty _Object;
+
+                _Probe_t() noexcept {}
+
+                ~_Probe_t() noexcept {}
+            };
+
+            const _Probe_t _Probe;
+            return static_cast<size_t>(reinterpret_cast<const unsigned char*>(::std::addressof(_Probe._Object.*_Hook))
+                                       - reinterpret_cast<const unsigned char*>(::std::addressof(_Probe._Object)));
+        }
+
+        void _Unlink(safe_list_hook* const _Node) noexcept {
+            if (_Node->_Prev) {
+                _Node->_Prev->_Next = _Node->_Next;
+            } else {
+                _Head = _Node->_Next;
+            }
+
+            if (_Node->_Next) {
+                _Node->_Next->_Prev = _Node->_Prev;
+            } else {
+                _Tail = _Node->_Prev;
+            }
+
+            _Node->_Reset();
+            --_Size;
+        }
+
+        safe_list_hook* _Head; // pointer to the first hook
+        safe_list_hook* _Tail; // pointer to the last hook
+        size_type _Size; // number of linked elements
+    };
+
+    template <class _Ty, safe_list_hook _Ty::*_Hook>
+    void swap(safe_intrusive_list<_Ty, _Hook>& _Left, safe_intrusive_list<_Ty, _Hook>& _Right) noexcept {
+        _Left.swap(_Right);
+    }
+} // namespace mjx
+
+#endif // _SAFE_INTRUSIVE_LIST_HPP_
@@ -6,34 +6,458 @@
 #pragma once
 #ifndef _SAFE_LIST_HPP_
 #define _SAFE_LIST_HPP_
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
 #include <new>
 #include <type_traits>
 #include <utility>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif // defined(_MSC_VER)
+
+// Note: The search kernels use the widest instruction set the compiler is allowed to emit,
+//       define SAFE_LIST_NO_SIMD to always use the scalar loops.
+#if !defined(SAFE_LIST_NO_SIMD) && defined(__AVX2__)
+#define _SAFE_LIST_SIMD_AVX2 1
+#include <immintrin.h>
+#elif !defined(SAFE_LIST_NO_SIMD) \
+    && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define _SAFE_LIST_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif !defined(SAFE_LIST_NO_SIMD) && defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#define _SAFE_LIST_SIMD_NEON 1
+#include <arm_neon.h>
+#endif // !defined(SAFE_LIST_NO_SIMD) && defined(__AVX2__)
+
+// Note: Number of nodes the internal traversals (and safe_list_prefetching_iterator) keep
+//       between the visited node and the prefetched one, zero disables prefetching.
+#ifndef SAFE_LIST_PREFETCH_DISTANCE
+#define SAFE_LIST_PREFETCH_DISTANCE 4
+#endif // SAFE_LIST_PREFETCH_DISTANCE
+
+// Note: Define SAFE_LIST_CHECKED_ITERATORS to make the iterators remember their list and check every use.
+//       A failed check prints a message and aborts. Without it, the iterators hold a single node pointer
+//       and every check compiles to nothing.
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+#include <cstdio>
+#include <cstdlib>
+#endif // SAFE_LIST_CHECKED_ITERATORS
 
 namespace mjx {
-    template <class _Ty, class... _Types>
-    [[nodiscard]] constexpr _Ty* _Construct_object(const _Types&... _Args) noexcept {
-        void* const _Raw = ::operator new(sizeof(_Ty), ::std::nothrow);
-        return _Raw ? ::new (_Raw) _Ty(_Args...) : nullptr;
+    inline void _Safe_list_prefetch(const void* const _Ptr) noexcept {
+        // Note: Only a hint, an invalid address is never dereferenced.
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch(static_cast<const char*>(_Ptr), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(_Ptr);
+#else // ^^^ GCC/Clang ^^^ / vvv other compilers vvv
+        (void) _Ptr;
+#endif // defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
     }
 
-    template <class _Ty, class... _Types>
-    [[nodiscard]] constexpr _Ty* _Construct_object(_Types&&... _Args) noexcept {
-        void* const _Raw = ::operator new(sizeof(_Ty), ::std::nothrow);
-        return _Raw ? ::new (_Raw) _Ty(::std::forward<_Types>(_Args)...) : nullptr;
+    inline constexpr size_t _Safe_list_prefetch_distance = SAFE_LIST_PREFETCH_DISTANCE;
+
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+    [[noreturn]] inline void _Safe_list_check_failed(const char* const _Message) noexcept {
+        ::std::fprintf(stderr, "safe_list: %s\n", _Message);
+        ::std::abort();
+    }
+#endif // SAFE_LIST_CHECKED_ITERATORS
+
+    template <class _Node_t, size_t _Distance = _Safe_list_prefetch_distance>
+    class _Safe_list_lookahead { // walks _Distance nodes ahead of a traversal and prefetches them
+    public:
+        // Note: The node loads of a list depend on each other, so the cursor ahead only hides the latency
+        //       behind the work done on the visited nodes. The nodes between the cursor and the visited
+        //       node must stay alive, the visited node itself may be destroyed.
+        explicit _Safe_list_lookahead(_Node_t* const _First) noexcept : _Ahead(_First) {
+            for (size_t _Idx = 0; _Idx < _Distance; ++_Idx) {
+                _Step();
+            }
+        }
+
+        void _Step() noexcept {
+            if constexpr (_Distance > 0) {
+                if (_Ahead) {
+                    _Ahead = _Ahead->_Next;
+                    if (_Ahead) {
+                        _Safe_list_prefetch(_Ahead);
+                    }
+                }
+            }
+        }
+
+    private:
+        _Node_t* _Ahead; // the last prefetched node
+    };
+
+    inline size_t _Safe_list_lowest_bit(const uint64_t _Mask) noexcept {
+        // Note: _Mask must not be zero.
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctzll(_Mask));
+#elif defined(_MSC_VER)
+        unsigned long _Index;
+        if (_BitScanForward(&_Index, static_cast<unsigned long>(_Mask))) {
+            return _Index;
+        }
+
+        (void) _BitScanForward(&_Index, static_cast<unsigned long>(_Mask >> 32));
+        return _Index + 32;
+#else // ^^^ MSVC ^^^ / vvv other compilers vvv
+        size_t _Index = 0;
+        for (uint64_t _Bits = _Mask; (_Bits & 1) == 0; _Bits >>= 1) {
+            ++_Index;
+        }
+
+        return _Index;
+#endif // defined(__GNUC__) || defined(__clang__)
+    }
+
+    template <size_t _Size>
+    using _Safe_list_uint_t = ::std::conditional_t<_Size == 1, uint8_t,
+        ::std::conditional_t<_Size == 2, uint16_t, ::std::conditional_t<_Size == 4, uint32_t, uint64_t>>>;
+
+    template <size_t _Elem_size>
+    struct _Safe_list_simd_block; // compares a block of elements with a broadcast value
+
+#if defined(_SAFE_LIST_SIMD_AVX2) || defined(_SAFE_LIST_SIMD_SSE2) || defined(_SAFE_LIST_SIMD_NEON)
+    inline constexpr bool _Safe_list_has_simd = true;
+
+    template <size_t _Elem_size>
+    struct _Safe_list_simd_block {
+        // Note: _Equal() sets every bit of the matching lanes. _Mask() turns that into a mask with
+        //       _Bits_per_element set bits for every match, the lowest bits belong to the first element.
+        //       Counting subtracts the comparisons from per-lane counters, _Max_blocks bounds the number
+        //       of blocks a counter can take before it has to be summed up.
+        using _Lane_t = _Safe_list_uint_t<_Elem_size>;
+
+        static constexpr size_t _Max_blocks = _Elem_size == 1 ? UINT8_MAX : _Elem_size == 2 ? UINT16_MAX : SIZE_MAX;
+
+#ifdef _SAFE_LIST_SIMD_AVX2
+        using _Vector_t = __m256i;
+
+        static constexpr size_t _Bytes            = 32;
+        static constexpr size_t _Bits_per_element = _Elem_size;
+
+        static _Vector_t _Broadcast(const uint64_t _Bits) noexcept {
+            if constexpr (_Elem_size == 1) {
+                return _mm256_set1_epi8(static_cast<char>(_Bits));
+            } else if constexpr (_Elem_size == 2) {
+                return _mm256_set1_epi16(static_cast<short>(_Bits));
+            } else if constexpr (_Elem_size == 4) {
+                return _mm256_set1_epi32(static_cast<int>(_Bits));
+            } else {
+                return _mm256_set1_epi64x(static_cast<long long>(_Bits));
+            }
+        }
+
+        static _Vector_t _Equal(const unsigned char* const _Ptr, const _Vector_t _Value) noexcept {
+            const __m256i _Block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_Ptr));
+            if constexpr (_Elem_size == 1) {
+                return _mm256_cmpeq_epi8(_Block, _Value);
+            } else if constexpr (_Elem_size == 2) {
+                return _mm256_cmpeq_epi16(_Block, _Value);
+            } else if constexpr (_Elem_size == 4) {
+                return _mm256_cmpeq_epi32(_Block, _Value);
+            } else {
+                return _mm256_cmpeq_epi64(_Block, _Value);
+            }
+        }
+
+        static uint64_t _Mask(const _Vector_t _Equal) noexcept {
+            return static_cast<uint32_t>(_mm256_movemask_epi8(_Equal));
+        }
+
+        static _Vector_t _Zero() noexcept {
+            return _mm256_setzero_si256();
+        }
+
+        static _Vector_t _Subtract(const _Vector_t _Counters, const _Vector_t _Equal) noexcept {
+            if constexpr (_Elem_size == 1) {
+                return _mm256_sub_epi8(_Counters, _Equal);
+            } else if constexpr (_Elem_size == 2) {
+                return _mm256_sub_epi16(_Counters, _Equal);
+            } else if constexpr (_Elem_size == 4) {
+                return _mm256_sub_epi32(_Counters, _Equal);
+            } else {
+                return _mm256_sub_epi64(_Counters, _Equal);
+            }
+        }
+
+        static void _Store(_Lane_t* const _Dest, const _Vector_t _Counters) noexcept {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(_Dest), _Counters);
+        }
+#elif defined(_SAFE_LIST_SIMD_SSE2)
+        using _Vector_t = __m128i;
+
+        static constexpr size_t _Bytes            = 16;
+        static constexpr size_t _Bits_per_element = _Elem_size;
+
+        static _Vector_t _Broadcast(const uint64_t _Bits) noexcept {
+            if constexpr (_Elem_size == 1) {
+                return _mm_set1_epi8(static_cast<char>(_Bits));
+            } else if constexpr (_Elem_size == 2) {
+                return _mm_set1_epi16(static_cast<short>(_Bits));
+            } else if constexpr (_Elem_size == 4) {
+                return _mm_set1_epi32(static_cast<int>(_Bits));
+            } else { // two 32-bit halves, works on 32-bit targets as well
+                return _mm_set_epi32(static_cast<int>(_Bits >> 32), static_cast<int>(_Bits),
+                    static_cast<int>(_Bits >> 32), static_cast<int>(_Bits));
+            }
+        }
+
+        static _Vector_t _Equal(const unsigned char* const _Ptr, const _Vector_t _Value) noexcept {
+            const __m128i _Block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(_Ptr));
+            if constexpr (_Elem_size == 1) {
+                return _mm_cmpeq_epi8(_Block, _Value);
+            } else if constexpr (_Elem_size == 2) {
+                return _mm_cmpeq_epi16(_Block, _Value);
+            } else if constexpr (_Elem_size == 4) {
+                return _mm_cmpeq_epi32(_Block, _Value);
+            } else { // SSE2 has no 64-bit comparison, both 32-bit halves must be equal
+                const __m128i _Halves = _mm_cmpeq_epi32(_Block, _Value);
+                return _mm_and_si128(_Halves, _mm_shuffle_epi32(_Halves, _MM_SHUFFLE(2, 3, 0, 1)));
+            }
+        }
+
+        static uint64_t _Mask(const _Vector_t _Equal) noexcept {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_Equal));
+        }
+
+        static _Vector_t _Zero() noexcept {
+            return _mm_setzero_si128();
+        }
+
+        static _Vector_t _Subtract(const _Vector_t _Counters, const _Vector_t _Equal) noexcept {
+            if constexpr (_Elem_size == 1) {
+                return _mm_sub_epi8(_Counters, _Equal);
+            } else if constexpr (_Elem_size == 2) {
+                return _mm_sub_epi16(_Counters, _Equal);
+            } else if constexpr (_Elem_size == 4) {
+                return _mm_sub_epi32(_Counters, _Equal);
+            } else {
+                return _mm_sub_epi64(_Counters, _Equal);
+            }
+        }
+
+        static void _Store(_Lane_t* const _Dest, const _Vector_t _Counters) noexcept {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(_Dest), _Counters);
+        }
+#else // ^^^ SSE2 ^^^ / vvv NEON vvv
+        using _Vector_t = uint8x16_t;
+
+        static constexpr size_t _Bytes            = 16;
+        static constexpr size_t _Bits_per_element = _Elem_size * 4; // 4 bits per byte
+
+        static _Vector_t _Broadcast(const uint64_t _Bits) noexcept {
+            if constexpr (_Elem_size == 1) {
+                return vdupq_n_u8(static_cast<uint8_t>(_Bits));
+            } else if constexpr (_Elem_size == 2) {
+                return vreinterpretq_u8_u16(vdupq_n_u16(static_cast<uint16_t>(_Bits)));
+            } else if constexpr (_Elem_size == 4) {
+                return vreinterpretq_u8_u32(vdupq_n_u32(static_cast<uint32_t>(_Bits)));
+            } else {
+                return vreinterpretq_u8_u64(vdupq_n_u64(_Bits));
+            }
+        }
+
+        static _Vector_t _Equal(const unsigned char* const _Ptr, const _Vector_t _Value) noexcept {
+            const uint8x16_t _Block = vld1q_u8(_Ptr);
+            if constexpr (_Elem_size == 1) {
+                return vceqq_u8(_Block, _Value);
+            } else if constexpr (_Elem_size == 2) {
+                return vreinterpretq_u8_u16(vceqq_u16(vreinterpretq_u16_u8(_Block), vreinterpretq_u16_u8(_Value)));
+            } else if constexpr (_Elem_size == 4) {
+                return vreinterpretq_u8_u32(vceqq_u32(vreinterpretq_u32_u8(_Block), vreinterpretq_u32_u8(_Value)));
+            } else {
+                return vreinterpretq_u8_u64(vceqq_u64(vreinterpretq_u64_u8(_Block), vreinterpretq_u64_u8(_Value)));
+            }
+        }
+
+        static uint64_t _Mask(const _Vector_t _Equal) noexcept {
+            // Note: NEON has no movemask, narrowing every byte to 4 bits gives a similar 64-bit mask.
+            return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(_Equal), 4)), 0);
+        }
+
+        static _Vector_t _Zero() noexcept {
+            return vdupq_n_u8(0);
+        }
+
+        static _Vector_t _Subtract(const _Vector_t _Counters, const _Vector_t _Equal) noexcept {
+            if constexpr (_Elem_size == 1) {
+                return vsubq_u8(_Counters, _Equal);
+            } else if constexpr (_Elem_size == 2) {
+                return vreinterpretq_u8_u16(vsubq_u16(vreinterpretq_u16_u8(_Counters), vreinterpretq_u16_u8(_Equal)));
+            } else if constexpr (_Elem_size == 4) {
+                return vreinterpretq_u8_u32(vsubq_u32(vreinterpretq_u32_u8(_Counters), vreinterpretq_u32_u8(_Equal)));
+            } else {
+                return vreinterpretq_u8_u64(vsubq_u64(vreinterpretq_u64_u8(_Counters), vreinterpretq_u64_u8(_Equal)));
+            }
+        }
+
+        static void _Store(_Lane_t* const _Dest, const _Vector_t _Counters) noexcept {
+            vst1q_u8(reinterpret_cast<uint8_t*>(_Dest), _Counters);
+        }
+#endif // _SAFE_LIST_SIMD_AVX2
+
+        static size_t _Sum(const _Vector_t _Counters) noexcept {
+            _Lane_t _Lanes[_Bytes / _Elem_size];
+            _Store(_Lanes, _Counters);
+            size_t _Total = 0;
+            for (const _Lane_t _Lane : _Lanes) {
+                _Total += static_cast<size_t>(_Lane);
+            }
+
+            return _Total;
+        }
+    };
+#else // ^^^ SIMD available ^^^ / vvv scalar only vvv
+    inline constexpr bool _Safe_list_has_simd = false;
+#endif // defined(_SAFE_LIST_SIMD_AVX2) || defined(_SAFE_LIST_SIMD_SSE2) || defined(_SAFE_LIST_SIMD_NEON)
+
+    template <class _Ty>
+    inline constexpr bool _Is_bitwise_comparable = // operator== compares the object representation
+        (::std::is_integral_v<_Ty> || ::std::is_enum_v<_Ty> || ::std::is_pointer_v<_Ty>)
+        && (sizeof(_Ty) == 1 || sizeof(_Ty) == 2 || sizeof(_Ty) == 4 || sizeof(_Ty) == 8);
+
+    template <class _Ty>
+    uint64_t _Safe_list_value_bits(const _Ty& _Value) noexcept {
+        // Note: Copied through an unsigned integer of the same size, so the value lands in the low bits.
+        _Safe_list_uint_t<sizeof(_Ty)> _Bits;
+        ::memcpy(&_Bits, ::std::addressof(_Value), sizeof(_Ty));
+        return _Bits;
+    }
+
+    template <class _Traits, class _Ty>
+    size_t _Safe_list_find_in_run(const _Ty* const _First, const size_t _Count, const _Ty& _Value) noexcept {
+        // Note: Returns the index of the first element equal to _Value in [_First, _First + _Count),
+        //       or _Count if there is none.
+        size_t _Idx = 0;
+        if constexpr (_Traits::_Is_vectorizable_search) {
+            using _Block_t                  = _Safe_list_simd_block<sizeof(_Ty)>;
+            constexpr size_t _Per_block     = _Block_t::_Bytes / sizeof(_Ty);
+            const auto _Pattern             = _Block_t::_Broadcast(_Safe_list_value_bits(_Value));
+            const unsigned char* const _Ptr = reinterpret_cast<const unsigned char*>(_First);
+            for (; _Idx + _Per_block <= _Count; _Idx += _Per_block) {
+                const uint64_t _Mask = _Block_t::_Mask(_Block_t::_Equal(_Ptr + _Idx * sizeof(_Ty), _Pattern));
+                if (_Mask != 0) { // at least one element matches
+                    return _Idx + _Safe_list_lowest_bit(_Mask) / _Block_t::_Bits_per_element;
+                }
+            }
+        }
+
+        for (; _Idx < _Count; ++_Idx) { // the scalar loop, or the tail shorter than a block
+            if (_First[_Idx] == _Value) {
+                return _Idx;
+            }
+        }
+
+        return _Count;
+    }
+
+    template <class _Traits, class _Ty>
+    size_t _Safe_list_count_in_run(const _Ty* const _First, const size_t _Count, const _Ty& _Value) noexcept {
+        size_t _Idx   = 0;
+        size_t _Found = 0;
+        if constexpr (_Traits::_Is_vectorizable_search) {
+            using _Block_t                  = _Safe_list_simd_block<sizeof(_Ty)>;
+            constexpr size_t _Per_block     = _Block_t::_Bytes / sizeof(_Ty);
+            const auto _Pattern             = _Block_t::_Broadcast(_Safe_list_value_bits(_Value));
+            const unsigned char* const _Ptr = reinterpret_cast<const unsigned char*>(_First);
+            while (_Idx + _Per_block <= _Count) {
+                auto _Counters = _Block_t::_Zero();
+                for (size_t _Blocks = 0; _Blocks < _Block_t::_Max_blocks && _Idx + _Per_block <= _Count;
+                     ++_Blocks, _Idx += _Per_block) {
+                    _Counters = _Block_t::_Subtract(_Counters, _Block_t::_Equal(_Ptr + _Idx * sizeof(_Ty), _Pattern));
+                }
+
+                _Found += _Block_t::_Sum(_Counters);
+            }
+        }
+
+        for (; _Idx < _Count; ++_Idx) {
+            if (_First[_Idx] == _Value) {
+                ++_Found;
+            }
+        }
+
+        return _Found;
     }
 
     template <class _Ty>
-    constexpr void _Destroy_object(_Ty* const _Ptr) noexcept {
-        if (_Ptr) {
-            _Ptr->~_Ty();
-            ::operator delete(_Ptr, ::std::nothrow);
+    class safe_allocator { // default non-throwing allocator
+    public:
+        using value_type      = _Ty;
+        using size_type       = size_t;
+        using difference_type = ptrdiff_t;
+
+        using propagate_on_container_copy_assignment = ::std::false_type;
+        using propagate_on_container_move_assignment = ::std::true_type;
+        using propagate_on_container_swap            = ::std::true_type;
+        using is_always_equal                        = ::std::true_type;
+
+        template <class _Other>
+        struct rebind {
+            using other = safe_allocator<_Other>;
+        };
+
+        constexpr safe_allocator() noexcept = default;
+
+        template <class _Other>
+        constexpr safe_allocator(const safe_allocator<_Other>&) noexcept {}
+
+        // Note: Unlike std::allocator<T>, this allocator never throws. A null-pointer is returned
+        //       if the requested size is too large or the allocation failed. Every allocator used
+        //       with safe_list<T> must follow the same contract, allocate() must be noexcept.
+
+        [[nodiscard]] _Ty* allocate(const size_type _Count) noexcept {
+            if (_Count > static_cast<size_type>(-1) / sizeof(_Ty)) { // requested size is too large
+                return nullptr;
+            }
+
+            if constexpr (alignof(_Ty) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) { // over-aligned type
+                return static_cast<_Ty*>(::operator new(
+                    _Count * sizeof(_Ty), ::std::align_val_t{alignof(_Ty)}, ::std::nothrow));
+            } else {
+                return static_cast<_Ty*>(::operator new(_Count * sizeof(_Ty), ::std::nothrow));
+            }
         }
+
+        void deallocate(_Ty* const _Ptr, size_type) noexcept {
+            if constexpr (alignof(_Ty) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) { // over-aligned type
+                ::operator delete(_Ptr, ::std::align_val_t{alignof(_Ty)}, ::std::nothrow);
+            } else {
+                ::operator delete(_Ptr, ::std::nothrow);
+            }
+        }
+    };
+
+    template <class _Ty, class _Other>
+    constexpr bool operator==(const safe_allocator<_Ty>&, const safe_allocator<_Other>&) noexcept {
+        return true;
+    }
+
+    template <class _Ty, class _Other>
+    constexpr bool operator!=(const safe_allocator<_Ty>&, const safe_allocator<_Other>&) noexcept {
+        return false;
     }
 
+    template <class _Alloc>
+    inline constexpr bool _Is_nothrow_allocator = // checks whether _Alloc follows the non-throwing contract
+        noexcept(::std::declval<_Alloc&>().allocate(size_t{1}))
+        && noexcept(::std::declval<_Alloc&>().deallocate(
+            ::std::declval<typename _Alloc::value_type*>(), size_t{1}));
+
+    template <class _Rng>
+    using _Range_reference_t = decltype(*::std::begin(::std::declval<_Rng&>()));
+
     template <class _Ty>
     struct _Safe_list_traits { // traits for safe_list<T>
         static constexpr bool _Is_nothrow_default_constructible // checks default construction safety
@@ -44,10 +468,16 @@ namespace mjx {
 
         static constexpr bool _Is_nothrow_move_constructible // checks move construction safety
             = ::std::is_nothrow_move_constructible_v<_Ty>;
+
+        static constexpr bool _Is_nothrow_copy_assignable // checks copy assignment safety
+            = ::std::is_nothrow_copy_assignable_v<_Ty>;
     
         static constexpr bool _Is_nothrow_swappable // checks swap safety
             = ::std::is_nothrow_swappable_v<_Ty>;
 
+        static constexpr bool _Is_vectorizable_search // checks whether find() and count() can compare blocks
+            = _Safe_list_has_simd && _Is_bitwise_comparable<_Ty>;
+
         template <class... _Types>
         static constexpr bool _Is_nothrow_constructible // checks variadic-args construciton safety
             = ::std::is_nothrow_constructible_v<_Ty, _Types...>;
@@ -64,8 +494,8 @@ namespace mjx {
         _Safe_list_node* _Prev; // pointer to the previous node
         _Ty _Value; // the stored value
 
-        static_assert(_Traits::template _Is_constructible<> // default constructible
-            && _Traits::template _Is_constructible<const _Ty&> // copy/move constructible
+        // Note: Values are constructed in place, so T does not have to be default constructible.
+        static_assert(_Traits::template _Is_constructible<const _Ty&> // copy/move constructible
             && _Traits::template _Is_constructible<_Ty&&>, "T must be constructible.");
 
         _Safe_list_node() noexcept(_Traits::_Is_nothrow_default_constructible)
@@ -78,893 +508,3443 @@ namespace mjx {
 
         explicit _Safe_list_node(_Ty&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible)
             : _Next(nullptr), _Prev(nullptr), _Value(::std::move(_Value)) {}
+
+        template <class... _Types>
+        explicit _Safe_list_node(::std::in_place_t, _Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>)
+            : _Next(nullptr), _Prev(nullptr), _Value(::std::forward<_Types>(_Args)...) {}
     };
 
-    template <class _Ty, class _Traits, class _Size_type>
-    class _Safe_list_storage {
+    template <class _Alloc, bool = ::std::is_empty_v<_Alloc> && !::std::is_final_v<_Alloc>>
+    class _Safe_list_alloc_holder : private _Alloc { // stores an empty allocator (EBO)
     public:
-        using _Value_type = _Ty;
-        using _Node_type  = _Safe_list_node<_Ty, _Traits>;
+        _Safe_list_alloc_holder() noexcept : _Alloc() {}
 
-        _Node_type* _Head; // pointer to the first node
-        _Node_type* _Tail; // pointer to the last node
-        _Size_type _Size; // number of nodes
+        explicit _Safe_list_alloc_holder(const _Alloc& _Al) noexcept : _Alloc(_Al) {}
 
-        _Safe_list_storage() noexcept : _Head(nullptr), _Tail(nullptr), _Size(0) {}
+        _Alloc& _Get_allocator() noexcept {
+            return *this;
+        }
 
-        void _Swap(_Safe_list_storage& _Other) noexcept {
-            ::std::swap(_Head, _Other._Head);
-            ::std::swap(_Tail, _Other._Tail);
-            ::std::swap(_Size, _Other._Size);
+        const _Alloc& _Get_allocator() const noexcept {
+            return *this;
         }
     };
 
-    template <class _List, class _Traits>
-    class _Safe_list_iterator_base { // base class for all list iterators
+    template <class _Alloc>
+    class _Safe_list_alloc_holder<_Alloc, false> { // stores a stateful or final allocator
     public:
-        using value_type        = typename _List::value_type;
-        using difference_type   = typename _List::difference_type;
-        using iterator_category = ::std::bidirectional_iterator_tag;
+        _Safe_list_alloc_holder() noexcept : _Myal() {}
 
-    protected:
-        using _Node_t = _Safe_list_node<value_type, _Traits>;
+        explicit _Safe_list_alloc_holder(const _Alloc& _Al) noexcept : _Myal(_Al) {}
 
-    public:
-        _Safe_list_iterator_base() noexcept : _Node(nullptr) {}
+        _Alloc& _Get_allocator() noexcept {
+            return _Myal;
+        }
 
-        explicit _Safe_list_iterator_base(_Node_t* const _Node) noexcept : _Node(_Node) {}
+        const _Alloc& _Get_allocator() const noexcept {
+            return _Myal;
+        }
 
-        ~_Safe_list_iterator_base() noexcept {}
+    private:
+        _Alloc _Myal;
+    };
 
-        explicit operator bool() const noexcept {
-            return _Node != nullptr;
-        }
+    struct safe_list_heap_storage {}; // every node is allocated separately (the default)
 
-        bool valid() const noexcept {
-            return _Node != nullptr;
-        }
+    template <size_t _Slab_size = 4096>
+    struct safe_list_slab_storage { // nodes are carved out of contiguous slabs owned by the list
+        static_assert(_Slab_size > 0, "slab size must be positive.");
+    };
 
-        bool operator==(const _Safe_list_iterator_base& _Other) const noexcept {
-            return _Node == _Other._Node;
-        }
+    template <class _Storage>
+    inline constexpr bool _Is_slab_storage = false;
 
-        bool operator!=(const _Safe_list_iterator_base& _Other) const noexcept {
-            return _Node != _Other._Node;
-        }
+    template <size_t _Slab_size>
+    inline constexpr bool _Is_slab_storage<safe_list_slab_storage<_Slab_size>> = true;
 
-        _Node_t* _Get_node() noexcept {
-            return _Node;
-        }
+    template <size_t _Capacity = 8>
+    struct safe_list_inline_storage { // the first _Capacity nodes live inside the list object
+        static_assert(_Capacity > 0, "inline capacity must be positive.");
+    };
 
-        const _Node_t* _Get_node() const noexcept {
-            return _Node;
-        }
+    template <class _Storage>
+    inline constexpr bool _Is_inline_storage = false;
 
-    protected:
-        _Node_t* _Node;
+    template <size_t _Capacity>
+    inline constexpr bool _Is_inline_storage<safe_list_inline_storage<_Capacity>> = true;
+
+    struct safe_list_bounded_storage {}; // a fixed number of nodes, allocated as one block by reserve_nodes()
+
+    template <class _Storage>
+    inline constexpr bool _Is_bounded_storage = false;
+
+    template <>
+    inline constexpr bool _Is_bounded_storage<safe_list_bounded_storage> = true;
+
+    struct safe_list_reserve_t { // selects the constructor that reserves nodes, see safe_list::reserve_nodes()
+        explicit safe_list_reserve_t() = default;
     };
 
-    template <class _List, class _Traits>
-    class _Safe_list_iterator
-        : public _Safe_list_iterator_base<_List, _Traits> { // mutable list iterator
-    private:
-        using _Mybase = _Safe_list_iterator_base<_List, _Traits>;
-        using _Node_t = typename _Mybase::_Node_t;
+    inline constexpr safe_list_reserve_t safe_list_reserve{};
 
-    public:
-        using value_type        = typename _Mybase::value_type;
-        using difference_type   = typename _Mybase::difference_type;
-        using pointer           = typename _List::pointer;
-        using reference         = typename _List::reference;
-        using iterator_category = typename _Mybase::iterator_category;
+    struct safe_list_stats { // a snapshot of the counters collected by a stats policy
+        size_t allocations; // number of nodes taken from the storage
+        size_t failed_allocations; // number of nodes the storage could not provide
+        size_t frees; // number of nodes given back to the storage
+        size_t peak_size; // the largest size the list has reached
+        size_t sampled_operations; // number of timed operations
+        uint64_t sampled_nanoseconds; // time spent in the timed operations
+    };
 
-        _Safe_list_iterator() noexcept : _Mybase() {}
+    struct safe_list_no_stats { // collects nothing (the default)
+        using _Sample_type = bool;
 
-        explicit _Safe_list_iterator(_Node_t* const _Node) noexcept : _Mybase(_Node) {}
+        void _On_allocate(bool) noexcept {}
 
-        ~_Safe_list_iterator() noexcept {}
-    
-        reference operator*() const noexcept {
-            return this->_Node->_Value;
-        }
+        void _On_free(size_t = 1) noexcept {}
 
-        pointer operator->() const noexcept {
-            return ::std::addressof(this->_Node->_Value);
-        }
+        void _On_size(size_t) noexcept {}
 
-        _Safe_list_iterator& operator++() noexcept {
-            this->_Node = this->_Node->_Next;
-            return *this;
+        _Sample_type _Begin_sample() noexcept {
+            return false;
         }
 
-        _Safe_list_iterator& operator++(int) noexcept {
-            _Safe_list_iterator _Temp = *this;
-            this->_Node               = this->_Node->_Next;
-            return _Temp;
-        }
+        void _End_sample(_Sample_type) noexcept {}
 
-        _Safe_list_iterator& operator--() noexcept {
-            this->_Node = this->_Node->_Prev;
-            return *this;
+        safe_list_stats _Get() const noexcept {
+            return safe_list_stats{0, 0, 0, 0, 0, 0};
         }
 
-        _Safe_list_iterator& operator--(int) noexcept {
-            _Safe_list_iterator _Temp = *this;
-            this->_Node               = this->_Node->_Prev;
-            return _Temp;
-        }
+        void _Reset() noexcept {}
     };
 
-    template <class _List, class _Traits>
-    class _Safe_list_const_iterator
-        : public _Safe_list_iterator_base<_List, _Traits> { // constant list iterator
-    private:
-        using _Mybase = _Safe_list_iterator_base<_List, _Traits>;
-        using _Node_t = typename _Mybase::_Node_t;
-
+    template <size_t _Sample_period = 0>
+    class safe_list_counting_stats { // counts node allocations, frees and the peak size
     public:
-        using value_type        = typename _Mybase::value_type;
-        using difference_type   = typename _Mybase::difference_type;
-        using pointer           = typename _List::const_pointer;
-        using reference         = typename _List::const_reference;
-        using iterator_category = typename _Mybase::iterator_category;
-
-        _Safe_list_const_iterator() noexcept : _Mybase() {}
-
-        explicit _Safe_list_const_iterator(_Node_t* const _Node) noexcept : _Mybase(_Node) {}
-
-        ~_Safe_list_const_iterator() noexcept {}
+        // Note: Every _Sample_period-th modifying operation is timed with std::chrono::steady_clock,
+        //       zero disables the sampling. The counters are plain integers, a list is not thread-safe
+        //       and neither are its statistics.
+        using _Sample_type = ::std::chrono::steady_clock::time_point; // the epoch means not sampled
+
+        safe_list_counting_stats() noexcept : _Mystats{0, 0, 0, 0, 0, 0}, _Operations(0) {}
+
+        void _On_allocate(const bool _Succeeded) noexcept {
+            if (_Succeeded) {
+                ++_Mystats.allocations;
+            } else {
+                ++_Mystats.failed_allocations;
+            }
+        }
 
-        reference operator*() const noexcept {
-            return this->_Node->_Value;
+        void _On_free(const size_t _Count = 1) noexcept {
+            _Mystats.frees += _Count;
         }
 
-        pointer operator->() const noexcept {
-            return ::std::addressof(this->_Node->_Value);
+        void _On_size(const size_t _Size) noexcept {
+            if (_Size > _Mystats.peak_size) {
+                _Mystats.peak_size = _Size;
+            }
         }
 
-        _Safe_list_const_iterator& operator++() noexcept {
-            this->_Node = this->_Node->_Next;
-            return *this;
+        _Sample_type _Begin_sample() noexcept {
+            if constexpr (_Sample_period > 0) {
+                if (++_Operations == _Sample_period) { // time this operation
+                    _Operations = 0;
+                    return ::std::chrono::steady_clock::now();
+                }
+            }
+
+            return _Sample_type{};
         }
 
-        _Safe_list_const_iterator& operator++(int) noexcept {
-            _Safe_list_const_iterator _Temp = *this;
-            this->_Node                     = this->_Node->_Next;
-            return _Temp;
+        void _End_sample(const _Sample_type _Start) noexcept {
+            if constexpr (_Sample_period > 0) {
+                if (_Start != _Sample_type{}) {
+                    const auto _Elapsed = ::std::chrono::steady_clock::now() - _Start;
+                    ++_Mystats.sampled_operations;
+                    _Mystats.sampled_nanoseconds += static_cast<uint64_t>(
+                        ::std::chrono::duration_cast<::std::chrono::nanoseconds>(_Elapsed).count());
+                }
+            } else {
+                (void) _Start;
+            }
         }
 
-        _Safe_list_const_iterator& operator--() noexcept {
-            this->_Node = this->_Node->_Prev;
-            return *this;
+        safe_list_stats _Get() const noexcept {
+            return _Mystats;
         }
 
-        _Safe_list_const_iterator& operator--(int) noexcept {
-            _Safe_list_const_iterator _Temp = *this;
-            this->_Node                     = this->_Node->_Prev;
-            return _Temp;
+        void _Reset() noexcept {
+            _Mystats    = safe_list_stats{0, 0, 0, 0, 0, 0};
+            _Operations = 0;
         }
-    };
 
-    template <class _List, class _Traits>
-    class _Safe_list_reverse_iterator
-        : public _Safe_list_iterator_base<_List, _Traits> { // mutable list reverse iterator
     private:
-        using _Mybase = _Safe_list_iterator_base<_List, _Traits>;
-        using _Node_t = typename _Mybase::_Node_t;
+        safe_list_stats _Mystats;
+        size_t _Operations; // operations since the last sample
+    };
 
+    template <class _Stats>
+    class _Safe_list_sample_scope { // times the enclosing operation if the stats policy samples it
     public:
-        using value_type        = typename _Mybase::value_type;
-        using difference_type   = typename _Mybase::difference_type;
-        using pointer           = typename _List::pointer;
-        using reference         = typename _List::reference;
-        using iterator_category = typename _Mybase::iterator_category;
+        explicit _Safe_list_sample_scope(_Stats& _Mystats) noexcept
+            : _Mystats(_Mystats), _Start(_Mystats._Begin_sample()) {}
 
-        _Safe_list_reverse_iterator() noexcept : _Mybase() {}
+        ~_Safe_list_sample_scope() noexcept {
+            _Mystats._End_sample(_Start);
+        }
 
-        explicit _Safe_list_reverse_iterator(_Node_t* const _Node) noexcept : _Mybase(_Node) {}
+        _Safe_list_sample_scope(const _Safe_list_sample_scope&)            = delete;
+        _Safe_list_sample_scope& operator=(const _Safe_list_sample_scope&) = delete;
 
-        ~_Safe_list_reverse_iterator() noexcept {}
+    private:
+        _Stats& _Mystats;
+        typename _Stats::_Sample_type _Start;
+    };
 
-        reference operator*() const noexcept {
-            return this->_Node->_Value;
+    struct safe_list_no_index {}; // positions are reached by walking from the nearer end (the default)
+
+    template <size_t _Stride = 64>
+    struct safe_list_skip_index { // records every _Stride-th node for the positional lookups
+        static_assert(_Stride > 0, "stride must be positive.");
+    };
+
+    struct safe_list_no_budget { // the list may allocate any amount of memory (the default)
+        static constexpr bool _Enabled = false;
+
+        bool _Admits(size_t) const noexcept {
+            return true;
         }
+    };
 
-        pointer operator->() const noexcept {
-            return ::std::addressof(this->_Node->_Value);
+    class safe_list_memory_budget { // limits the bytes a list keeps allocated, see safe_list::memory_budget()
+    public:
+        static constexpr bool _Enabled = true;
+
+        safe_list_memory_budget() noexcept : _Limit(static_cast<size_t>(-1)) {}
+
+        bool _Admits(const size_t _Bytes) const noexcept {
+            return _Bytes <= _Limit;
         }
 
-        _Safe_list_reverse_iterator& operator++() noexcept {
-            this->_Node = this->_Node->_Prev;
-            return *this;
+        size_t _Get_limit() const noexcept {
+            return _Limit;
         }
 
-        _Safe_list_reverse_iterator& operator++(int) noexcept {
-            _Safe_list_reverse_iterator _Temp = *this;
-            this->_Node                       = this->_Node->_Prev;
-            return _Temp;
+        void _Set_limit(const size_t _New_limit) noexcept {
+            _Limit = _New_limit;
         }
 
-        _Safe_list_reverse_iterator& operator--() noexcept {
-            this->_Node = this->_Node->_Next;
-            return *this;
+    private:
+        size_t _Limit; // the most bytes the list may hold, unlimited until set
+    };
+
+    template <class _Storage = safe_list_heap_storage, class _Stats = safe_list_no_stats,
+        class _Index = safe_list_no_index, class _Budget = safe_list_no_budget>
+    struct safe_list_policy {}; // combines the storage with the stats, index and budget policies
+
+    template <class _Policy>
+    struct _Safe_list_policy_traits { // a bare storage tag selects the default policies
+        using _Storage = _Policy;
+        using _Stats   = safe_list_no_stats;
+        using _Index   = safe_list_no_index;
+        using _Budget  = safe_list_no_budget;
+    };
+
+    template <class _Storage_tag, class _Stats_policy, class _Index_policy, class _Budget_policy>
+    struct _Safe_list_policy_traits<safe_list_policy<_Storage_tag, _Stats_policy, _Index_policy, _Budget_policy>> {
+        using _Storage = _Storage_tag;
+        using _Stats   = _Stats_policy;
+        using _Index   = _Index_policy;
+        using _Budget  = _Budget_policy;
+    };
+
+    struct _Safe_list_spent_node { // a cached node whose value has been destroyed
+        _Safe_list_spent_node* _Next; // pointer to the next cached node
+    };
+
+    template <class _Node_type>
+    void _Push_spent_node(_Safe_list_spent_node*& _List, _Node_type* const _Node) noexcept {
+        static_assert(sizeof(_Node_type) >= sizeof(_Safe_list_spent_node)
+            && alignof(_Node_type) >= alignof(_Safe_list_spent_node), "a spent node must fit in a node.");
+        _List = ::new (static_cast<void*>(_Node)) _Safe_list_spent_node{_List};
+    }
+
+    template <class _Node_type>
+    _Node_type* _Pop_spent_node(_Safe_list_spent_node*& _List) noexcept {
+        _Safe_list_spent_node* const _Spent = _List;
+        _List                               = _Spent->_Next;
+        _Spent->~_Safe_list_spent_node();
+        return reinterpret_cast<_Node_type*>(_Spent);
+    }
+
+    template <class _Node_type, class _Alloc, class _Size_type, class _Storage>
+    class _Safe_list_node_pool; // provides raw memory for nodes
+
+    template <class _Node_type, class _Alloc, class _Size_type>
+    class _Safe_list_node_pool<_Node_type, _Alloc, _Size_type, safe_list_heap_storage>
+        : public _Safe_list_alloc_holder<_Alloc> { // allocates every node separately, caches spent nodes
+    private:
+        using _Mybase = _Safe_list_alloc_holder<_Alloc>;
+
+    public:
+        _Safe_list_spent_node* _Cache; // pointer to the first cached node
+        _Size_type _Cache_size; // number of cached nodes
+        _Size_type _Cache_limit; // maximum number of cached nodes (0 disables the cache)
+
+        _Safe_list_node_pool() noexcept : _Mybase(), _Cache(nullptr), _Cache_size(0), _Cache_limit(0) {}
+
+        explicit _Safe_list_node_pool(const _Alloc& _Al) noexcept
+            : _Mybase(_Al), _Cache(nullptr), _Cache_size(0), _Cache_limit(0) {}
+
+        ~_Safe_list_node_pool() noexcept {
+            _Shrink();
         }
 
-        _Safe_list_reverse_iterator& operator--(int) noexcept {
-            _Safe_list_reverse_iterator _Temp = *this;
-            this->_Node                       = this->_Node->_Next;
-            return _Temp;
+        _Safe_list_node_pool(const _Safe_list_node_pool&)            = delete;
+        _Safe_list_node_pool& operator=(const _Safe_list_node_pool&) = delete;
+
+        void _Swap(_Safe_list_node_pool& _Other) noexcept {
+            // Note: Cached nodes were allocated with this pool's allocator, so they must be swapped
+            //       together with the allocator. The cache limit is a property of the list and stays.
+            using ::std::swap; // enable ADL for allocators
+            swap(this->_Get_allocator(), _Other._Get_allocator());
+            swap(_Cache, _Other._Cache);
+            swap(_Cache_size, _Other._Cache_size);
+            _Trim_cache(_Cache_limit);
+            _Other._Trim_cache(_Other._Cache_limit);
+        }
+
+        _Node_type* _Allocate_node() noexcept {
+            if (_Cache) { // reuse a cached node
+                --_Cache_size;
+                return _Pop_spent_node<_Node_type>(_Cache);
+            }
+
+            return this->_Get_allocator().allocate(1);
+        }
+
+        void _Deallocate_node(_Node_type* const _Node) noexcept {
+            if (_Cache_size < _Cache_limit) { // keep the node for later use
+                _Push_spent_node(_Cache, _Node);
+                ++_Cache_size;
+            } else {
+                this->_Get_allocator().deallocate(_Node, 1);
+            }
+        }
+
+        void _Release_nodes() noexcept {
+            // Note: Called once all nodes were destroyed. Every node has already been deallocated
+            //       (or cached) separately, so there is nothing to release here.
+        }
+
+        _Size_type _Available() const noexcept {
+            return _Cache_size;
+        }
+
+        // Note: _Pool_bytes() tells how many bytes the pool holds while _Size nodes are in use,
+        //       _Growth_bytes() and _Reserve_bytes() how many the next allocation and _Reserve() would add.
+
+        size_t _Pool_bytes(const _Size_type _Size) const noexcept {
+            return (static_cast<size_t>(_Size) + _Cache_size) * sizeof(_Node_type); // every node is separate
+        }
+
+        size_t _Growth_bytes() const noexcept {
+            return _Cache ? 0 : sizeof(_Node_type);
+        }
+
+        size_t _Reserve_bytes(const _Size_type _Count) const noexcept {
+            return _Count > _Cache_size ? static_cast<size_t>(_Count - _Cache_size) * sizeof(_Node_type) : 0;
+        }
+
+        bool _Reserve(const _Size_type _Count) noexcept {
+            if (_Cache_limit < _Count) { // the cache must be able to hold the reserved nodes
+                _Cache_limit = _Count;
+            }
+
+            while (_Cache_size < _Count) {
+                _Node_type* const _Raw = this->_Get_allocator().allocate(1);
+                if (!_Raw) { // allocation failed, keep already cached nodes
+                    return false;
+                }
+
+                _Push_spent_node(_Cache, _Raw);
+                ++_Cache_size;
+            }
+
+            return true;
+        }
+
+        void _Trim_cache(const _Size_type _New_size) noexcept {
+            while (_Cache_size > _New_size) {
+                --_Cache_size;
+                this->_Get_allocator().deallocate(_Pop_spent_node<_Node_type>(_Cache), 1);
+            }
+        }
+
+        void _Shrink() noexcept {
+            _Trim_cache(0);
         }
     };
 
-    template <class _List, class _Traits>
-    class _Safe_list_const_reverse_iterator
-        : public _Safe_list_iterator_base<_List, _Traits> { // constant list reverse iterator
+    template <class _Node_type, size_t _Slab_size>
+    struct _Safe_list_slab { // a contiguous block of nodes
+        static constexpr size_t _Header_size = sizeof(void*);
+        static constexpr size_t _Capacity    = // number of nodes per slab (at least one)
+            _Slab_size > _Header_size + sizeof(_Node_type) ? (_Slab_size - _Header_size) / sizeof(_Node_type) : 1;
+
+        _Safe_list_slab* _Next; // pointer to the next slab
+        alignas(_Node_type) unsigned char _Nodes[_Capacity * sizeof(_Node_type)]; // storage for nodes
+
+        _Node_type* _Node_at(const size_t _Index) noexcept {
+            return reinterpret_cast<_Node_type*>(_Nodes + _Index * sizeof(_Node_type));
+        }
+    };
+
+    template <class _Node_type, class _Alloc, class _Size_type, size_t _Slab_size>
+    class _Safe_list_node_pool<_Node_type, _Alloc, _Size_type, safe_list_slab_storage<_Slab_size>>
+        : public _Safe_list_alloc_holder<_Alloc> { // carves nodes out of slabs, releases whole slabs
     private:
-        using _Mybase = _Safe_list_iterator_base<_List, _Traits>;
-        using _Node_t = typename _Mybase::_Node_t;
+        using _Mybase   = _Safe_list_alloc_holder<_Alloc>;
+        using _Slab_t   = _Safe_list_slab<_Node_type, _Slab_size>;
+        using _Alslab_t = typename ::std::allocator_traits<_Alloc>::template rebind_alloc<_Slab_t>;
+
+        static_assert(_Is_nothrow_allocator<_Alslab_t>, "Alloc must not throw, allocate() returns a null-pointer.");
 
     public:
-        using value_type        = typename _Mybase::value_type;
-        using difference_type   = typename _Mybase::difference_type;
-        using pointer           = typename _List::const_pointer;
-        using reference         = typename _List::const_reference;
-        using iterator_category = typename _Mybase::iterator_category;
+        static constexpr size_t _Nodes_per_slab = _Slab_t::_Capacity;
+
+        _Slab_t* _Slabs; // pointer to the slab nodes are currently carved from, followed by full slabs
+        _Slab_t* _Spare; // pointer to the first reserved (untouched) slab
+        _Safe_list_spent_node* _Free; // pointer to the first spent node inside the slabs
+        _Size_type _Free_size; // number of spent nodes
+        _Size_type _Spare_size; // number of reserved slabs
+        size_t _Bump; // number of nodes already carved from the current slab
+        size_t _Slab_count; // number of slabs owned by the pool, including the reserved ones
+
+        _Safe_list_node_pool() noexcept : _Mybase(), _Slabs(nullptr), _Spare(nullptr),
+            _Free(nullptr), _Free_size(0), _Spare_size(0), _Bump(_Nodes_per_slab), _Slab_count(0) {}
+
+        explicit _Safe_list_node_pool(const _Alloc& _Al) noexcept : _Mybase(_Al), _Slabs(nullptr), _Spare(nullptr),
+            _Free(nullptr), _Free_size(0), _Spare_size(0), _Bump(_Nodes_per_slab), _Slab_count(0) {}
+
+        ~_Safe_list_node_pool() noexcept {
+            _Release_nodes();
+            _Shrink();
+        }
+
+        _Safe_list_node_pool(const _Safe_list_node_pool&)            = delete;
+        _Safe_list_node_pool& operator=(const _Safe_list_node_pool&) = delete;
+
+        void _Swap(_Safe_list_node_pool& _Other) noexcept {
+            using ::std::swap; // enable ADL for allocators
+            swap(this->_Get_allocator(), _Other._Get_allocator());
+            swap(_Slabs, _Other._Slabs);
+            swap(_Spare, _Other._Spare);
+            swap(_Free, _Other._Free);
+            swap(_Free_size, _Other._Free_size);
+            swap(_Spare_size, _Other._Spare_size);
+            swap(_Bump, _Other._Bump);
+            swap(_Slab_count, _Other._Slab_count);
+        }
+
+        _Node_type* _Allocate_node() noexcept {
+            if (_Free) { // reuse a spent node
+                --_Free_size;
+                return _Pop_spent_node<_Node_type>(_Free);
+            }
 
-        _Safe_list_const_reverse_iterator() noexcept : _Mybase() {}
+            if (_Bump == _Nodes_per_slab) { // the current slab is full, start a new one
+                _Slab_t* _New_slab;
+                if (_Spare) { // use a reserved slab
+                    _New_slab = _Spare;
+                    _Spare    = _Spare->_Next;
+                    --_Spare_size;
+                } else {
+                    _Alslab_t _Al(this->_Get_allocator());
+                    _New_slab = _Al.allocate(1);
+                    if (!_New_slab) { // allocation failed
+                        return nullptr;
+                    }
+
+                    ++_Slab_count;
+                }
+
+                _New_slab->_Next = _Slabs;
+                _Slabs           = _New_slab;
+                _Bump            = 0;
+            }
+
+            return _Slabs->_Node_at(_Bump++);
+        }
+
+        void _Deallocate_node(_Node_type* const _Node) noexcept {
+            // Note: A single node cannot be returned to the allocator, it stays in its slab
+            //       and will be reused by the next allocation.
+            _Push_spent_node(_Free, _Node);
+            ++_Free_size;
+        }
+
+        void _Release_nodes() noexcept {
+            // Note: Called once all nodes were destroyed. Every slab is released at once,
+            //       there is no need to visit the spent nodes.
+            _Alslab_t _Al(this->_Get_allocator());
+            _Slab_t* _Next;
+            for (_Slab_t* _Slab = _Slabs; _Slab != nullptr; _Slab = _Next) {
+                _Next = _Slab->_Next;
+                _Al.deallocate(_Slab, 1);
+                --_Slab_count;
+            }
+
+            _Slabs     = nullptr;
+            _Free      = nullptr;
+            _Free_size = 0;
+            _Bump      = _Nodes_per_slab;
+        }
+
+        _Size_type _Available() const noexcept {
+            return static_cast<_Size_type>(
+                _Free_size + (_Nodes_per_slab - _Bump) + _Spare_size * _Nodes_per_slab);
+        }
+
+        size_t _Pool_bytes(_Size_type) const noexcept {
+            return _Slab_count * sizeof(_Slab_t); // the nodes in use live in the slabs
+        }
+
+        size_t _Growth_bytes() const noexcept {
+            return _Free || _Bump < _Nodes_per_slab || _Spare ? 0 : sizeof(_Slab_t);
+        }
+
+        size_t _Reserve_bytes(const _Size_type _Count) const noexcept {
+            const _Size_type _Left = _Available();
+            return _Count > _Left ? (_Count - _Left + _Nodes_per_slab - 1) / _Nodes_per_slab * sizeof(_Slab_t) : 0;
+        }
+
+        bool _Reserve(const _Size_type _Count) noexcept {
+            _Alslab_t _Al(this->_Get_allocator());
+            while (_Available() < _Count) {
+                _Slab_t* const _New_slab = _Al.allocate(1);
+                if (!_New_slab) { // allocation failed, keep already reserved slabs
+                    return false;
+                }
+
+                _New_slab->_Next = _Spare;
+                _Spare           = _New_slab;
+                ++_Spare_size;
+                ++_Slab_count;
+            }
+
+            return true;
+        }
+
+        void _Shrink() noexcept {
+            _Alslab_t _Al(this->_Get_allocator());
+            while (_Spare) {
+                _Slab_t* const _Slab = _Spare;
+                _Spare               = _Slab->_Next;
+                _Al.deallocate(_Slab, 1);
+                --_Slab_count;
+            }
+
+            _Spare_size = 0;
+        }
+    };
+
+    template <class _Node_type, class _Alloc, class _Size_type, size_t _Capacity>
+    class _Safe_list_node_pool<_Node_type, _Alloc, _Size_type, safe_list_inline_storage<_Capacity>>
+        : public _Safe_list_node_pool<_Node_type, _Alloc, _Size_type, safe_list_heap_storage> { // slots, then heap
+    private:
+        using _Mybase = _Safe_list_node_pool<_Node_type, _Alloc, _Size_type, safe_list_heap_storage>;
+
+    public:
+        // Note: The slots are handed out in order and reused through _Free. Once every slot is taken,
+        //       nodes are allocated (and cached) as with the heap storage. The slots cannot travel with
+        //       the allocator, so the pools cannot be swapped, _Safe_list_storage::_Steal() moves
+        //       the values of the inline nodes instead.
+        _Safe_list_spent_node* _Free; // pointer to the first spent slot
+        _Size_type _Free_size; // number of spent slots
+        size_t _Bump; // number of slots handed out since the pool was last emptied
+        alignas(_Node_type) unsigned char _Slots[_Capacity * sizeof(_Node_type)]; // storage for inline nodes
+
+        _Safe_list_node_pool() noexcept : _Mybase(), _Free(nullptr), _Free_size(0), _Bump(0) {}
+
+        explicit _Safe_list_node_pool(const _Alloc& _Al) noexcept
+            : _Mybase(_Al), _Free(nullptr), _Free_size(0), _Bump(0) {}
+
+        _Safe_list_node_pool(const _Safe_list_node_pool&)            = delete;
+        _Safe_list_node_pool& operator=(const _Safe_list_node_pool&) = delete;
+
+        void _Swap(_Safe_list_node_pool&) = delete;
+
+        void _Swap_heap(_Safe_list_node_pool& _Other) noexcept {
+            // Note: Swaps the allocators and the cached heap nodes, the slots stay where they are.
+            _Mybase::_Swap(_Other);
+        }
+
+        bool _Is_inline(const _Node_type* const _Node) const noexcept {
+            const unsigned char* const _Ptr = reinterpret_cast<const unsigned char*>(_Node);
+            const ::std::less<const unsigned char*> _Less; // a total order, unlike the built-in operator
+            return !_Less(_Ptr, _Slots) && _Less(_Ptr, _Slots + sizeof(_Slots));
+        }
+
+        _Node_type* _Allocate_node() noexcept {
+            if (_Free) { // reuse a spent slot
+                --_Free_size;
+                return _Pop_spent_node<_Node_type>(_Free);
+            }
+
+            if (_Bump < _Capacity) { // take the next untouched slot
+                return reinterpret_cast<_Node_type*>(_Slots + _Bump++ * sizeof(_Node_type));
+            }
+
+            return _Mybase::_Allocate_node();
+        }
+
+        void _Deallocate_node(_Node_type* const _Node) noexcept {
+            if (_Is_inline(_Node)) { // keep the slot for later use
+                _Push_spent_node(_Free, _Node);
+                ++_Free_size;
+            } else {
+                _Mybase::_Deallocate_node(_Node);
+            }
+        }
+
+        void _Release_nodes() noexcept {
+            // Note: Called once all nodes were destroyed, every slot is free again.
+            _Free      = nullptr;
+            _Free_size = 0;
+            _Bump      = 0;
+        }
+
+        _Size_type _Free_slots() const noexcept {
+            return static_cast<_Size_type>(_Free_size + (_Capacity - _Bump));
+        }
+
+        _Size_type _Available() const noexcept {
+            return static_cast<_Size_type>(_Free_slots() + _Mybase::_Available());
+        }
+
+        size_t _Pool_bytes(const _Size_type _Size) const noexcept {
+            // Note: The slots are a part of the list itself, only the heap nodes are counted.
+            const size_t _Slots_used = _Bump - _Free_size;
+            return _Mybase::_Pool_bytes(static_cast<_Size_type>(_Size - _Slots_used));
+        }
+
+        size_t _Growth_bytes() const noexcept {
+            return _Free || _Bump < _Capacity ? 0 : _Mybase::_Growth_bytes();
+        }
+
+        size_t _Reserve_bytes(const _Size_type _Count) const noexcept {
+            const _Size_type _Slots_left = _Free_slots();
+            return _Count <= _Slots_left ? 0 : _Mybase::_Reserve_bytes(static_cast<_Size_type>(_Count - _Slots_left));
+        }
+
+        bool _Reserve(const _Size_type _Count) noexcept {
+            // Note: Only the nodes that do not fit in the free slots are cached.
+            const _Size_type _Slots_left = _Free_slots();
+            return _Count <= _Slots_left || _Mybase::_Reserve(static_cast<_Size_type>(_Count - _Slots_left));
+        }
+    };
+
+    struct safe_list_handle { // identifies an element of a list with the bounded storage, see safe_list::handle()
+        size_t _Index; // position of the node in the block
+        uint64_t _Generation; // generation of the node when the handle was made, zero if none
+
+        safe_list_handle() noexcept : _Index(0), _Generation(0) {}
+
+        safe_list_handle(const size_t _Index, const uint64_t _Generation) noexcept
+            : _Index(_Index), _Generation(_Generation) {}
+
+        bool operator==(const safe_list_handle& _Other) const noexcept {
+            return _Index == _Other._Index && _Generation == _Other._Generation;
+        }
+
+        bool operator!=(const safe_list_handle& _Other) const noexcept {
+            return !(*this == _Other);
+        }
+    };
+
+    inline uint64_t _Safe_list_next_block_tag() noexcept {
+        // Note: Every block gets its own tag in the upper half of its generations, so a handle
+        //       made for one block never matches a node of another one.
+        static ::std::atomic<uint64_t> _Serial{0};
+        return (_Serial.fetch_add(1, ::std::memory_order_relaxed) + 1) << 32;
+    }
+
+    inline uint64_t _Safe_list_next_generation(const uint64_t _Generation) noexcept {
+        // Note: Increments the lower half only, the block tag in the upper half never changes.
+        return (_Generation & ~uint64_t{0xFFFFFFFF}) | ((_Generation + 1) & uint64_t{0xFFFFFFFF});
+    }
+
+    template <class _Node_type>
+    struct _Safe_list_block_slot { // a node of the bounded storage and its generation
+        alignas(_Node_type) unsigned char _Node[sizeof(_Node_type)]; // storage for the node, must come first
+        uint64_t _Generation; // odd while the node is in use, lower half incremented on every (de)allocation
+
+        _Node_type* _Get() noexcept {
+            return reinterpret_cast<_Node_type*>(_Node);
+        }
+    };
+
+    template <class _Node_type, class _Alloc, class _Size_type>
+    class _Safe_list_node_pool<_Node_type, _Alloc, _Size_type, safe_list_bounded_storage>
+        : public _Safe_list_alloc_holder<_Alloc> { // hands out nodes of a single block, never grows
+    private:
+        using _Mybase   = _Safe_list_alloc_holder<_Alloc>;
+        using _Slot_t   = _Safe_list_block_slot<_Node_type>;
+        using _Alslot_t = typename ::std::allocator_traits<_Alloc>::template rebind_alloc<_Slot_t>;
+
+        static_assert(_Is_nothrow_allocator<_Alslot_t>, "Alloc must not throw, allocate() returns a null-pointer.");
+
+    public:
+        // Note: The first _Reserve() allocates the block and fixes the capacity. Nodes are handed out
+        //       in order and recycled through _Free, neither path touches the allocator again.
+        //       Each node carries a generation next to it, which makes the handles checkable in O(1).
+        _Slot_t* _Block; // pointer to the block, null until the capacity is set
+        _Safe_list_spent_node* _Free; // pointer to the first spent node inside the block
+        _Size_type _Free_size; // number of spent nodes
+        _Size_type _Capacity; // number of nodes in the block
+        _Size_type _Bump; // number of nodes handed out since the pool was last emptied
+
+        _Safe_list_node_pool() noexcept
+            : _Mybase(), _Block(nullptr), _Free(nullptr), _Free_size(0), _Capacity(0), _Bump(0) {}
+
+        explicit _Safe_list_node_pool(const _Alloc& _Al) noexcept
+            : _Mybase(_Al), _Block(nullptr), _Free(nullptr), _Free_size(0), _Capacity(0), _Bump(0) {}
+
+        ~_Safe_list_node_pool() noexcept {
+            _Release_nodes();
+            _Shrink();
+        }
+
+        _Safe_list_node_pool(const _Safe_list_node_pool&)            = delete;
+        _Safe_list_node_pool& operator=(const _Safe_list_node_pool&) = delete;
+
+        void _Swap(_Safe_list_node_pool& _Other) noexcept {
+            using ::std::swap; // enable ADL for allocators
+            swap(this->_Get_allocator(), _Other._Get_allocator());
+            swap(_Block, _Other._Block);
+            swap(_Free, _Other._Free);
+            swap(_Free_size, _Other._Free_size);
+            swap(_Capacity, _Other._Capacity);
+            swap(_Bump, _Other._Bump);
+        }
+
+        static _Slot_t* _Slot_of(_Node_type* const _Node) noexcept {
+            return reinterpret_cast<_Slot_t*>(_Node); // the node is the first member of its slot
+        }
+
+        _Node_type* _Allocate_node() noexcept {
+            _Slot_t* _Slot;
+            if (_Free) { // reuse a spent node
+                --_Free_size;
+                _Slot = _Slot_of(_Pop_spent_node<_Node_type>(_Free));
+            } else if (_Bump < _Capacity) { // take the next untouched node
+                _Slot = _Block + _Bump++;
+            } else { // the block is full
+                return nullptr;
+            }
+
+            _Slot->_Generation = _Safe_list_next_generation(_Slot->_Generation); // odd, the node is in use
+            return _Slot->_Get();
+        }
+
+        void _Deallocate_node(_Node_type* const _Node) noexcept {
+            _Slot_t* const _Slot = _Slot_of(_Node);
+            _Slot->_Generation   = _Safe_list_next_generation(_Slot->_Generation); // even, every handle is stale
+            _Push_spent_node(_Free, _Node);
+            ++_Free_size;
+        }
+
+        void _Release_nodes() noexcept {
+            // Note: Called once all nodes were destroyed, every node of the block is free again.
+            //       The nodes that were still in use get an even generation, like a deallocated node.
+            for (_Size_type _Idx = 0; _Idx < _Bump; ++_Idx) {
+                if (_Block[_Idx]._Generation & 1) { // still in use
+                    _Block[_Idx]._Generation = _Safe_list_next_generation(_Block[_Idx]._Generation);
+                }
+            }
+
+            _Free      = nullptr;
+            _Free_size = 0;
+            _Bump      = 0;
+        }
+
+        _Size_type _Available() const noexcept {
+            return static_cast<_Size_type>(_Free_size + (_Capacity - _Bump));
+        }
+
+        size_t _Pool_bytes(_Size_type) const noexcept {
+            return static_cast<size_t>(_Capacity) * sizeof(_Slot_t); // the block, whether its nodes are used or not
+        }
+
+        size_t _Growth_bytes() const noexcept {
+            return 0; // the block never grows
+        }
+
+        size_t _Reserve_bytes(const _Size_type _Count) const noexcept {
+            return _Block ? 0 : static_cast<size_t>(_Count) * sizeof(_Slot_t);
+        }
+
+        bool _Reserve(const _Size_type _Count) noexcept {
+            if (!_Block && _Count > 0) { // set the capacity
+                _Alslot_t _Al(this->_Get_allocator());
+                _Block = _Al.allocate(_Count);
+                if (!_Block) { // allocation failed, the capacity stays zero
+                    return false;
+                }
+
+                const uint64_t _Tag = _Safe_list_next_block_tag();
+                for (_Size_type _Idx = 0; _Idx < _Count; ++_Idx) { // also touches every page of the block
+                    _Block[_Idx]._Generation = _Tag;
+                }
+
+                _Capacity = _Count;
+            }
+
+            return _Count <= _Available();
+        }
+
+        void _Shrink() noexcept {
+            // Note: The block can only be released while none of its nodes is in use.
+            if (_Block && _Free_size == _Bump) {
+                _Alslot_t _Al(this->_Get_allocator());
+                _Al.deallocate(_Block, _Capacity);
+                _Block     = nullptr;
+                _Free      = nullptr;
+                _Free_size = 0;
+                _Capacity  = 0;
+                _Bump      = 0;
+            }
+        }
+
+        safe_list_handle _Handle_of(const _Node_type* const _Node) const noexcept {
+            const _Slot_t* const _Slot = reinterpret_cast<const _Slot_t*>(_Node);
+            return safe_list_handle{static_cast<size_t>(_Slot - _Block), _Slot->_Generation};
+        }
+
+        _Node_type* _Node_of(const safe_list_handle& _Handle) const noexcept {
+            // Note: Returns a null-pointer if the handle does not refer to a node of this block that is
+            //       still in use. Nothing but the generation at the handle's index is read.
+            if (_Handle._Index >= _Capacity || _Block[_Handle._Index]._Generation != _Handle._Generation
+                || (_Handle._Generation & 1) == 0) {
+                return nullptr;
+            }
+
+            return _Block[_Handle._Index]._Get();
+        }
+    };
+
+    template <class _Node_type>
+    _Node_type* _Safe_list_walk_to(
+        _Node_type* const _Head, _Node_type* const _Tail, const size_t _Size, const size_t _Pos) noexcept {
+        // Note: Returns the node at _Pos (less than _Size), walking from the nearer end.
+        _Node_type* _Node;
+        if (_Pos <= _Size / 2) { // walk forward from the first node
+            _Node = _Head;
+            for (size_t _Step = 0; _Step < _Pos; ++_Step) {
+                _Node = _Node->_Next;
+            }
+        } else { // walk backward from the last node
+            _Node = _Tail;
+            for (size_t _Step = _Pos + 1; _Step < _Size; ++_Step) {
+                _Node = _Node->_Prev;
+            }
+        }
+
+        return _Node;
+    }
+
+    template <class _Node_type, class _Alloc, class _Index>
+    class _Safe_list_skip_table { // no table, every lookup walks from the nearer end
+    public:
+        _Node_type* _Seek(_Node_type* const _Head, _Node_type* const _Tail, const size_t _Size, const size_t _Pos,
+            const _Alloc&, size_t) const noexcept {
+            return _Safe_list_walk_to(_Head, _Tail, _Size, _Pos);
+        }
+
+        _Node_type* _Seek(
+            _Node_type* const _Head, _Node_type* const _Tail, const size_t _Size, const size_t _Pos) const noexcept {
+            return _Safe_list_walk_to(_Head, _Tail, _Size, _Pos);
+        }
+
+        size_t _Index_bytes() const noexcept {
+            return 0;
+        }
+
+        size_t _Index_state() const noexcept {
+            return 0;
+        }
+
+        void _Invalidate_index(size_t = 0) noexcept {}
+
+        void _Restore_index(size_t, size_t) noexcept {}
+
+        void _Release_index(const _Alloc&) noexcept {}
+
+        void _Swap_index(_Safe_list_skip_table&) noexcept {}
+    };
+
+    template <class _Node_type, class _Alloc, size_t _Stride>
+    class _Safe_list_skip_table<_Node_type, _Alloc, safe_list_skip_index<_Stride>> { // every _Stride-th node
+    private:
+        using _Alentry_t = typename ::std::allocator_traits<_Alloc>::template rebind_alloc<_Node_type*>;
+
+        static_assert(_Is_nothrow_allocator<_Alentry_t>, "Alloc must not throw, allocate() returns a null-pointer.");
+
+    public:
+        // Note: _Entries[_Idx] is the node at position _Idx * _Stride. Only the first _Valid entries
+        //       are up to date, a modification at position _Pos drops the entries at _Pos and past it.
+        //       The lookups record the missing entries on their way, so the table is rebuilt lazily
+        //       and only as far as it is used. If the table cannot grow, the lookup walks instead.
+        //       The const lookups only read the table, so they can run concurrently like any const access.
+        _Safe_list_skip_table() noexcept : _Entries(nullptr), _Valid(0), _Capacity(0) {}
+
+        _Safe_list_skip_table(const _Safe_list_skip_table&)            = delete;
+        _Safe_list_skip_table& operator=(const _Safe_list_skip_table&) = delete;
+
+        _Node_type* _Seek(_Node_type* const _Head, _Node_type* const _Tail, const size_t _Size, const size_t _Pos,
+            const _Alloc& _Al, const size_t _Bytes_left) noexcept {
+            // Note: The table grows by at most _Bytes_left bytes, the memory budget of the list.
+            const size_t _Entry   = _Pos / _Stride;
+            const size_t _To_tail = _Size - 1 - _Pos; // distance from the last node
+            if (_Entry >= _Valid) { // record the entries up to _Entry
+                const size_t _Recorded = _Valid > 0 ? (_Valid - 1) * _Stride : 0;
+                if (_To_tail < _Pos - _Recorded
+                    || !_Reserve_entries(_Entry + 1, _Al, _Bytes_left)) { // walk without the table
+                    return _Safe_list_walk_to(_Head, _Tail, _Size, _Pos);
+                }
+
+                if (_Valid == 0) {
+                    _Entries[_Valid++] = _Head;
+                }
+
+                _Node_type* _Node = _Entries[_Valid - 1];
+                while (_Valid <= _Entry) {
+                    for (size_t _Step = 0; _Step < _Stride; ++_Step) {
+                        _Node = _Node->_Next;
+                    }
+
+                    _Entries[_Valid++] = _Node;
+                }
+            }
+
+            const size_t _Offset = _Pos - _Entry * _Stride;
+            if (_To_tail < _Offset) { // the last node is nearer than the entry
+                return _Safe_list_walk_to(_Head, _Tail, _Size, _Pos);
+            }
+
+            _Node_type* _Node = _Entries[_Entry];
+            for (size_t _Step = 0; _Step < _Offset; ++_Step) {
+                _Node = _Node->_Next;
+            }
+
+            return _Node;
+        }
+
+        _Node_type* _Seek(
+            _Node_type* const _Head, _Node_type* const _Tail, const size_t _Size, const size_t _Pos) const noexcept {
+            // Note: Starts at the last recorded entry before _Pos (or at the nearer end), records nothing.
+            if (_Valid > 0) {
+                const size_t _Entry   = _Pos / _Stride < _Valid ? _Pos / _Stride : _Valid - 1;
+                const size_t _Offset  = _Pos - _Entry * _Stride;
+                const size_t _To_tail = _Size - 1 - _Pos; // distance from the last node
+                if (_Offset <= _To_tail) { // the entry is nearer than the last node
+                    _Node_type* _Node = _Entries[_Entry];
+                    for (size_t _Step = 0; _Step < _Offset; ++_Step) {
+                        _Node = _Node->_Next;
+                    }
+
+                    return _Node;
+                }
+            }
+
+            return _Safe_list_walk_to(_Head, _Tail, _Size, _Pos);
+        }
+
+        size_t _Index_bytes() const noexcept {
+            return _Capacity * sizeof(_Node_type*);
+        }
+
+        size_t _Index_state() const noexcept {
+            return _Valid;
+        }
+
+        void _Invalidate_index(const size_t _Pos = 0) noexcept {
+            const size_t _Kept = (_Pos + _Stride - 1) / _Stride; // the entries before _Pos
+            if (_Valid > _Kept) {
+                _Valid = _Kept;
+            }
+        }
+
+        void _Restore_index(const size_t _State, const size_t _Pos) noexcept {
+            // Note: Used after an operation that invalidated the whole table but is known
+            //       to have changed the positions from _Pos on only.
+            _Valid = _State;
+            _Invalidate_index(_Pos);
+        }
+
+        void _Release_index(const _Alloc& _Al) noexcept {
+            if (_Entries) {
+                _Alentry_t _Entry_al(_Al);
+                _Entry_al.deallocate(_Entries, _Capacity);
+                _Entries  = nullptr;
+                _Valid    = 0;
+                _Capacity = 0;
+            }
+        }
+
+        void _Swap_index(_Safe_list_skip_table& _Other) noexcept {
+            // Note: The table was allocated with the list's allocator, so it moves together with it.
+            ::std::swap(_Entries, _Other._Entries);
+            ::std::swap(_Valid, _Other._Valid);
+            ::std::swap(_Capacity, _Other._Capacity);
+        }
+
+    private:
+        bool _Reserve_entries(const size_t _Count, const _Alloc& _Al, const size_t _Bytes_left) noexcept {
+            if (_Count <= _Capacity) { // enough space
+                return true;
+            }
+
+            size_t _New_capacity = _Capacity > 0 ? _Capacity * 2 : 16;
+            if (_New_capacity < _Count) {
+                _New_capacity = _Count;
+            }
+
+            if ((_New_capacity - _Capacity) * sizeof(_Node_type*) > _Bytes_left) { // over the memory budget
+                return false;
+            }
+
+            _Alentry_t _Entry_al(_Al);
+            _Node_type** const _New_entries = _Entry_al.allocate(_New_capacity);
+            if (!_New_entries) { // allocation failed, keep the old table
+                return false;
+            }
+
+            if (_Entries) {
+                ::memcpy(static_cast<void*>(_New_entries), _Entries, _Valid * sizeof(_Node_type*));
+                _Entry_al.deallocate(_Entries, _Capacity);
+            }
+
+            _Entries  = _New_entries;
+            _Capacity = _New_capacity;
+            return true;
+        }
+
+        _Node_type** _Entries; // the recorded nodes, filled by the lookups
+        size_t _Valid; // number of up-to-date entries
+        size_t _Capacity; // number of allocated entries
+    };
+
+    template <class _Ty, class _Traits, class _Size_type, class _Alloc, class _Storage, class _Stats, class _Index,
+        class _Budget>
+    class _Safe_list_storage
+        : public _Stats, // the stats policy is usually empty (EBO)
+          public _Budget, // the budget policy is usually empty (EBO)
+          public _Safe_list_skip_table<_Safe_list_node<_Ty, _Traits>, _Alloc, _Index>, // empty without an index
+          public _Safe_list_node_pool<_Safe_list_node<_Ty, _Traits>, _Alloc, _Size_type, _Storage> {
+    private:
+        using _Mybase = _Safe_list_node_pool<_Safe_list_node<_Ty, _Traits>, _Alloc, _Size_type, _Storage>;
+
+    public:
+        using _Value_type = _Ty;
+        using _Node_type  = _Safe_list_node<_Ty, _Traits>;
+        using _Alloc_type = _Alloc;
+
+        static_assert(::std::is_same_v<typename _Alloc::value_type, _Node_type>, "Alloc must allocate nodes.");
+        static_assert(_Is_nothrow_allocator<_Alloc>, "Alloc must not throw, allocate() returns a null-pointer.");
+
+        _Node_type* _Head; // pointer to the first node
+        _Node_type* _Tail; // pointer to the last node
+        _Size_type _Size; // number of nodes
+
+        _Safe_list_storage() noexcept : _Mybase(), _Head(nullptr), _Tail(nullptr), _Size(0) {}
+
+        explicit _Safe_list_storage(const _Alloc& _Al) noexcept
+            : _Mybase(_Al), _Head(nullptr), _Tail(nullptr), _Size(0) {}
+
+        ~_Safe_list_storage() noexcept {
+            this->_Release_index(this->_Get_allocator());
+        }
+
+        _Safe_list_storage(const _Safe_list_storage&)            = delete;
+        _Safe_list_storage& operator=(const _Safe_list_storage&) = delete;
+
+        _Node_type* _Node_at(const size_t _Pos) noexcept {
+            // Note: _Pos must be less than _Size.
+            return this->_Seek(_Head, _Tail, _Size, _Pos, this->_Get_allocator(), _Bytes_left());
+        }
+
+        _Node_type* _Node_at(const size_t _Pos) const noexcept {
+            // Note: Like above, but leaves the index as it is.
+            return this->_Seek(_Head, _Tail, _Size, _Pos);
+        }
+
+        size_t _Memory_usage() const noexcept {
+            return this->_Pool_bytes(_Size) + this->_Index_bytes();
+        }
+
+        size_t _Bytes_left() const noexcept {
+            // Note: The bytes the list may still allocate without exceeding its budget.
+            if constexpr (_Budget::_Enabled) {
+                const size_t _Used  = _Memory_usage();
+                const size_t _Limit = this->_Get_limit();
+                return _Used < _Limit ? _Limit - _Used : 0;
+            } else {
+                return static_cast<size_t>(-1);
+            }
+        }
+
+        bool _Admits_growth(const size_t _Bytes) const noexcept {
+            return _Bytes == 0 || _Bytes <= _Bytes_left();
+        }
+
+        _Node_type* _Allocate_node() noexcept {
+            // Note: Hides the pool's _Allocate_node() and _Reserve(), so that the budget sees every node
+            //       the list takes. A node that needs no new memory is always handed out.
+            if constexpr (_Budget::_Enabled) {
+                if (!_Admits_growth(this->_Growth_bytes())) { // fails like an allocation
+                    return nullptr;
+                }
+            }
+
+            return _Mybase::_Allocate_node();
+        }
+
+        bool _Reserve(const _Size_type _Count) noexcept {
+            if constexpr (_Budget::_Enabled) {
+                if (!_Admits_growth(this->_Reserve_bytes(_Count))) {
+                    return false;
+                }
+            }
+
+            return _Mybase::_Reserve(_Count);
+        }
+
+        void _Swap(_Safe_list_storage& _Other) noexcept {
+            // Note: The statistics stay with their list, only the peak size may change.
+            static_assert(!_Is_inline_storage<_Storage>, "inline nodes cannot be swapped, use _Steal().");
+            _Mybase::_Swap(_Other);
+            this->_Swap_index(_Other);
+            ::std::swap(_Head, _Other._Head);
+            ::std::swap(_Tail, _Other._Tail);
+            ::std::swap(_Size, _Other._Size);
+            this->_On_size(_Size);
+            _Other._On_size(_Other._Size);
+        }
+
+        void _Steal(_Safe_list_storage& _Other) noexcept {
+            // Note: Called on an empty storage. Takes over the allocator, the index and the heap nodes
+            //       of _Other, the values of its inline nodes are moved into the slots of this storage.
+            //       There are always enough free slots, both pools have the same capacity.
+            //       Leaves _Other empty, with this storage's former allocator.
+            static_assert(_Is_inline_storage<_Storage>, "only inline nodes have to be moved.");
+            this->_Swap_heap(_Other);
+            this->_Swap_index(_Other);
+            this->_Invalidate_index(); // the moved nodes have new addresses
+            _Head        = _Other._Head;
+            _Tail        = _Other._Tail;
+            _Size        = _Other._Size;
+            _Other._Head = nullptr;
+            _Other._Tail = nullptr;
+            _Other._Size = 0;
+            for (_Node_type* _Node = _Head; _Node != nullptr; _Node = _Node->_Next) {
+                if (!_Other._Is_inline(_Node)) { // a heap node, keep it
+                    continue;
+                }
+
+                _Node_type* const _New_node = ::new (static_cast<void*>(this->_Allocate_node()))
+                    _Node_type(::std::in_place, ::std::move(_Node->_Value)); // always a free slot
+                _New_node->_Next = _Node->_Next;
+                _New_node->_Prev = _Node->_Prev;
+                (_Node->_Prev ? _Node->_Prev->_Next : _Head) = _New_node;
+                (_Node->_Next ? _Node->_Next->_Prev : _Tail) = _New_node;
+                _Node->~_Node_type();
+                _Node = _New_node;
+            }
+
+            _Other._Release_nodes(); // every slot of _Other is free now
+            this->_On_size(_Size);
+        }
+    };
+
+    template <class _List, class _Traits>
+    class _Safe_list_iterator_base { // base class for all list iterators
+    public:
+        using value_type        = typename _List::value_type;
+        using difference_type   = typename _List::difference_type;
+        using iterator_category = ::std::bidirectional_iterator_tag;
+
+    protected:
+        using _Node_t = typename _List::_Node_type; // safe_list<T> and safe_intrusive_list<T, Hook> differ here
+
+    public:
+        // Note: With SAFE_LIST_CHECKED_ITERATORS, an iterator made by a list also remembers that list.
+        //       Stepping or dereferencing the end, comparing iterators of two lists and passing an iterator
+        //       to another list are reported. Iterators of a list that was moved, swapped or spliced from
+        //       still name the old list, so they must be obtained again. Without the macro _Owner does
+        //       not exist and the _Verify_*() functions are empty.
+        _Safe_list_iterator_base() noexcept : _Node(nullptr) {}
+
+        explicit _Safe_list_iterator_base(_Node_t* const _Node) noexcept : _Node(_Node) {}
+
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+        _Safe_list_iterator_base(_Node_t* const _Node, const void* const _Owner) noexcept
+            : _Node(_Node), _Owner(_Owner) {}
+#endif // SAFE_LIST_CHECKED_ITERATORS
+
+        ~_Safe_list_iterator_base() noexcept {}
+
+        explicit operator bool() const noexcept {
+            return _Node != nullptr;
+        }
+
+        bool valid() const noexcept {
+            return _Node != nullptr;
+        }
+
+        bool operator==(const _Safe_list_iterator_base& _Other) const noexcept {
+            _Verify_comparable(_Other);
+            return _Node == _Other._Node;
+        }
+
+        bool operator!=(const _Safe_list_iterator_base& _Other) const noexcept {
+            _Verify_comparable(_Other);
+            return _Node != _Other._Node;
+        }
+
+        _Node_t* _Get_node() noexcept {
+            return _Node;
+        }
+
+        const _Node_t* _Get_node() const noexcept {
+            return _Node;
+        }
+
+        const void* _Get_owner() const noexcept {
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+            return _Owner;
+#else // ^^^ SAFE_LIST_CHECKED_ITERATORS ^^^ / vvv !SAFE_LIST_CHECKED_ITERATORS vvv
+            return nullptr;
+#endif // SAFE_LIST_CHECKED_ITERATORS
+        }
+
+        void _Verify_owner(const void* const _Container) const noexcept {
+            // Note: Iterators that were not made by a list (e.g. default constructed ones) have no owner.
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+            if (_Owner && _Owner != _Container) {
+                _Safe_list_check_failed("the iterator belongs to another list");
+            }
+#else // ^^^ SAFE_LIST_CHECKED_ITERATORS ^^^ / vvv !SAFE_LIST_CHECKED_ITERATORS vvv
+            (void) _Container;
+#endif // SAFE_LIST_CHECKED_ITERATORS
+        }
+
+    protected:
+        void _Verify_dereferenceable() const noexcept {
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+            if (!_Node) {
+                _Safe_list_check_failed("the end iterator cannot be dereferenced or stepped");
+            }
+#endif // SAFE_LIST_CHECKED_ITERATORS
+        }
+
+        void _Verify_comparable(const _Safe_list_iterator_base& _Other) const noexcept {
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+            if (_Owner && _Other._Owner && _Owner != _Other._Owner) {
+                _Safe_list_check_failed("iterators of different lists cannot be compared");
+            }
+#else // ^^^ SAFE_LIST_CHECKED_ITERATORS ^^^ / vvv !SAFE_LIST_CHECKED_ITERATORS vvv
+            (void) _Other;
+#endif // SAFE_LIST_CHECKED_ITERATORS
+        }
+
+        _Node_t* _Node;
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+        const void* _Owner = nullptr; // the list that made the iterator, null if none
+#endif // SAFE_LIST_CHECKED_ITERATORS
+    };
+
+    template <class _List, class _Traits>
+    class _Safe_list_iterator
+        : public _Safe_list_iterator_base<_List, _Traits> { // mutable list iterator
+    private:
+        using _Mybase = _Safe_list_iterator_base<_List, _Traits>;
+        using _Node_t = typename _Mybase::_Node_t;
+
+    public:
+        using value_type        = typename _Mybase::value_type;
+        using difference_type   = typename _Mybase::difference_type;
+        using pointer           = typename _List::pointer;
+        using reference         = typename _List::reference;
+        using iterator_category = typename _Mybase::iterator_category;
+
+        _Safe_list_iterator() noexcept : _Mybase() {}
+
+        explicit _Safe_list_iterator(_Node_t* const _Node) noexcept : _Mybase(_Node) {}
+
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+        _Safe_list_iterator(_Node_t* const _Node, const void* const _Owner) noexcept : _Mybase(_Node, _Owner) {}
+#endif // SAFE_LIST_CHECKED_ITERATORS
+
+        ~_Safe_list_iterator() noexcept {}
+    
+        reference operator*() const noexcept {
+            this->_Verify_dereferenceable();
+            return _List::_Value_of(this->_Node);
+        }
+
+        pointer operator->() const noexcept {
+            this->_Verify_dereferenceable();
+            return ::std::addressof(_List::_Value_of(this->_Node));
+        }
+
+        _Safe_list_iterator& operator++() noexcept {
+            this->_Verify_dereferenceable();
+            this->_Node = this->_Node->_Next;
+            return *this;
+        }
+
+        _Safe_list_iterator operator++(int) noexcept {
+            this->_Verify_dereferenceable();
+            _Safe_list_iterator _Temp = *this;
+            this->_Node               = this->_Node->_Next;
+            return _Temp;
+        }
+
+        _Safe_list_iterator& operator--() noexcept {
+            this->_Verify_dereferenceable();
+            this->_Node = this->_Node->_Prev;
+            return *this;
+        }
+
+        _Safe_list_iterator operator--(int) noexcept {
+            this->_Verify_dereferenceable();
+            _Safe_list_iterator _Temp = *this;
+            this->_Node               = this->_Node->_Prev;
+            return _Temp;
+        }
+    };
+
+    template <class _List, class _Traits>
+    class _Safe_list_const_iterator
+        : public _Safe_list_iterator_base<_List, _Traits> { // constant list iterator
+    private:
+        using _Mybase = _Safe_list_iterator_base<_List, _Traits>;
+        using _Node_t = typename _Mybase::_Node_t;
+
+    public:
+        using value_type        = typename _Mybase::value_type;
+        using difference_type   = typename _Mybase::difference_type;
+        using pointer           = typename _List::const_pointer;
+        using reference         = typename _List::const_reference;
+        using iterator_category = typename _Mybase::iterator_category;
+
+        _Safe_list_const_iterator() noexcept : _Mybase() {}
+
+        explicit _Safe_list_const_iterator(_Node_t* const _Node) noexcept : _Mybase(_Node) {}
+
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+        _Safe_list_const_iterator(_Node_t* const _Node, const void* const _Owner) noexcept : _Mybase(_Node, _Owner) {}
+#endif // SAFE_LIST_CHECKED_ITERATORS
+
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+        _Safe_list_const_iterator(const _Safe_list_iterator<_List, _Traits>& _Iter) noexcept
+            : _Mybase(const_cast<_Node_t*>(_Iter._Get_node()), _Iter._Get_owner()) {}
+#else // ^^^ SAFE_LIST_CHECKED_ITERATORS ^^^ / vvv !SAFE_LIST_CHECKED_ITERATORS vvv
+        _Safe_list_const_iterator(const _Safe_list_iterator<_List, _Traits>& _Iter) noexcept
+            : _Mybase(const_cast<_Node_t*>(_Iter._Get_node())) {}
+#endif // SAFE_LIST_CHECKED_ITERATORS
+
+        ~_Safe_list_const_iterator() noexcept {}
+
+        reference operator*() const noexcept {
+            this->_Verify_dereferenceable();
+            return _List::_Value_of(this->_Node);
+        }
+
+        pointer operator->() const noexcept {
+            this->_Verify_dereferenceable();
+            return ::std::addressof(_List::_Value_of(this->_Node));
+        }
+
+        _Safe_list_const_iterator& operator++() noexcept {
+            this->_Verify_dereferenceable();
+            this->_Node = this->_Node->_Next;
+            return *this;
+        }
+
+        _Safe_list_const_iterator operator++(int) noexcept {
+            this->_Verify_dereferenceable();
+            _Safe_list_const_iterator _Temp = *this;
+            this->_Node                     = this->_Node->_Next;
+            return _Temp;
+        }
+
+        _Safe_list_const_iterator& operator--() noexcept {
+            this->_Verify_dereferenceable();
+            this->_Node = this->_Node->_Prev;
+            return *this;
+        }
+
+        _Safe_list_const_iterator operator--(int) noexcept {
+            this->_Verify_dereferenceable();
+            _Safe_list_const_iterator _Temp = *this;
+            this->_Node                     = this->_Node->_Prev;
+            return _Temp;
+        }
+    };
+
+    template <class _List, class _Traits>
+    class _Safe_list_reverse_iterator
+        : public _Safe_list_iterator_base<_List, _Traits> { // mutable list reverse iterator
+    private:
+        using _Mybase = _Safe_list_iterator_base<_List, _Traits>;
+        using _Node_t = typename _Mybase::_Node_t;
+
+    public:
+        using value_type        = typename _Mybase::value_type;
+        using difference_type   = typename _Mybase::difference_type;
+        using pointer           = typename _List::pointer;
+        using reference         = typename _List::reference;
+        using iterator_category = typename _Mybase::iterator_category;
+
+        _Safe_list_reverse_iterator() noexcept : _Mybase() {}
+
+        explicit _Safe_list_reverse_iterator(_Node_t* const _Node) noexcept : _Mybase(_Node) {}
+
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+        _Safe_list_reverse_iterator(_Node_t* const _Node, const void* const _Owner) noexcept : _Mybase(_Node, _Owner) {}
+#endif // SAFE_LIST_CHECKED_ITERATORS
+
+        ~_Safe_list_reverse_iterator() noexcept {}
+
+        reference operator*() const noexcept {
+            this->_Verify_dereferenceable();
+            return _List::_Value_of(this->_Node);
+        }
+
+        pointer operator->() const noexcept {
+            this->_Verify_dereferenceable();
+            return ::std::addressof(_List::_Value_of(this->_Node));
+        }
+
+        _Safe_list_reverse_iterator& operator++() noexcept {
+            this->_Verify_dereferenceable();
+            this->_Node = this->_Node->_Prev;
+            return *this;
+        }
+
+        _Safe_list_reverse_iterator operator++(int) noexcept {
+            this->_Verify_dereferenceable();
+            _Safe_list_reverse_iterator _Temp = *this;
+            this->_Node                       = this->_Node->_Prev;
+            return _Temp;
+        }
+
+        _Safe_list_reverse_iterator& operator--() noexcept {
+            this->_Verify_dereferenceable();
+            this->_Node = this->_Node->_Next;
+            return *this;
+        }
+
+        _Safe_list_reverse_iterator operator--(int) noexcept {
+            this->_Verify_dereferenceable();
+            _Safe_list_reverse_iterator _Temp = *this;
+            this->_Node                       = this->_Node->_Next;
+            return _Temp;
+        }
+    };
+
+    template <class _List, class _Traits>
+    class _Safe_list_const_reverse_iterator
+        : public _Safe_list_iterator_base<_List, _Traits> { // constant list reverse iterator
+    private:
+        using _Mybase = _Safe_list_iterator_base<_List, _Traits>;
+        using _Node_t = typename _Mybase::_Node_t;
+
+    public:
+        using value_type        = typename _Mybase::value_type;
+        using difference_type   = typename _Mybase::difference_type;
+        using pointer           = typename _List::const_pointer;
+        using reference         = typename _List::const_reference;
+        using iterator_category = typename _Mybase::iterator_category;
+
+        _Safe_list_const_reverse_iterator() noexcept : _Mybase() {}
+
+        explicit _Safe_list_const_reverse_iterator(_Node_t* const _Node) noexcept : _Mybase(_Node) {}
+
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+        _Safe_list_const_reverse_iterator(_Node_t* const _Node, const void* const _Owner) noexcept
+            : _Mybase(_Node, _Owner) {}
+#endif // SAFE_LIST_CHECKED_ITERATORS
+
+        ~_Safe_list_const_reverse_iterator() noexcept {}
+
+        reference operator*() const noexcept {
+            this->_Verify_dereferenceable();
+            return _List::_Value_of(this->_Node);
+        }
+
+        pointer operator->() const noexcept {
+            this->_Verify_dereferenceable();
+            return ::std::addressof(_List::_Value_of(this->_Node));
+        }
+
+        _Safe_list_const_reverse_iterator& operator++() noexcept {
+            this->_Verify_dereferenceable();
+            this->_Node = this->_Node->_Prev;
+            return *this;
+        }
+
+        _Safe_list_const_reverse_iterator operator++(int) noexcept {
+            this->_Verify_dereferenceable();
+            _Safe_list_const_reverse_iterator _Temp = *this;
+            this->_Node                             = this->_Node->_Prev;
+            return _Temp;
+        }
+
+        _Safe_list_const_reverse_iterator& operator--() noexcept {
+            this->_Verify_dereferenceable();
+            this->_Node = this->_Node->_Next;
+            return *this;
+        }
+
+        _Safe_list_const_reverse_iterator operator--(int) noexcept {
+            this->_Verify_dereferenceable();
+            _Safe_list_const_reverse_iterator _Temp = *this;
+            this->_Node                             = this->_Node->_Next;
+            return _Temp;
+        }
+    };
+
+    template <class _Iter, size_t _Distance = _Safe_list_prefetch_distance>
+    class safe_list_prefetching_iterator { // forward iterator adapter that prefetches the nodes ahead
+    private:
+        using _Node_ptr = decltype(::std::declval<const _Iter&>()._Get_node());
+
+    public:
+        using value_type        = typename _Iter::value_type;
+        using difference_type   = typename _Iter::difference_type;
+        using pointer           = typename _Iter::pointer;
+        using reference         = typename _Iter::reference;
+        using iterator_category = ::std::forward_iterator_tag;
+
+        // Note: Adapts the forward iterators of safe_list<T> and safe_intrusive_list<T, Hook>.
+        //       Worth it for cold lists whose nodes are scattered in memory, a list that was built
+        //       in one go is usually prefetched well enough by the hardware.
+
+        safe_list_prefetching_iterator() noexcept : _Where(), _Lookahead(nullptr) {}
+
+        explicit safe_list_prefetching_iterator(const _Iter _Where) noexcept
+            : _Where(_Where), _Lookahead(_Where._Get_node()) {}
+
+        ~safe_list_prefetching_iterator() noexcept {}
+
+        bool operator==(const safe_list_prefetching_iterator& _Other) const noexcept {
+            return _Where == _Other._Where;
+        }
+
+        bool operator!=(const safe_list_prefetching_iterator& _Other) const noexcept {
+            return _Where != _Other._Where;
+        }
+
+        reference operator*() const noexcept {
+            return *_Where;
+        }
+
+        pointer operator->() const noexcept {
+            return _Where.operator->();
+        }
+
+        safe_list_prefetching_iterator& operator++() noexcept {
+            ++_Where;
+            _Lookahead._Step();
+            return *this;
+        }
+
+        safe_list_prefetching_iterator operator++(int) noexcept {
+            safe_list_prefetching_iterator _Temp = *this;
+            ++*this;
+            return _Temp;
+        }
+
+        _Iter base() const noexcept {
+            return _Where;
+        }
+
+    private:
+        _Iter _Where;
+        _Safe_list_lookahead<::std::remove_pointer_t<_Node_ptr>, _Distance> _Lookahead;
+    };
+
+    template <class _Iter, size_t _Distance>
+    class _Safe_list_prefetched_range { // a range of prefetching iterators
+    public:
+        using iterator = safe_list_prefetching_iterator<_Iter, _Distance>;
+
+        _Safe_list_prefetched_range(const _Iter _First, const _Iter _Last) noexcept : _First(_First), _Last(_Last) {}
+
+        iterator begin() const noexcept {
+            return _First;
+        }
+
+        iterator end() const noexcept {
+            return _Last;
+        }
+
+    private:
+        iterator _First;
+        iterator _Last;
+    };
+
+    template <size_t _Distance = _Safe_list_prefetch_distance, class _List>
+    auto safe_list_prefetched(_List& _Target) noexcept {
+        // Note: for (auto& _Elem : safe_list_prefetched(_List)) visits the list with prefetching.
+        return _Safe_list_prefetched_range<decltype(_Target.begin()), _Distance>(_Target.begin(), _Target.end());
+    }
+
+    // Note: A serialized list (an image) is a header followed by the elements as a contiguous array,
+    //       so it can be written with a single write() and used in place after mmap(). The header records
+    //       the element size but not the byte order, an image is read on the architecture that wrote it.
+    inline constexpr uint64_t _Safe_list_image_magic = 0x31474D494C53464Eu; // tells a list image apart
+
+    struct _Safe_list_image_header { // the header of a serialized list
+        uint64_t _Magic; // _Safe_list_image_magic
+        uint64_t _Count; // number of elements
+        uint64_t _Element_size; // sizeof(T)
+    };
+
+    template <class _Ty>
+    struct _Safe_list_image { // the layout of a serialized safe_list<T>
+        static_assert(::std::is_trivially_copyable_v<_Ty>, "T must be trivially copyable to be serialized.");
+
+        static constexpr size_t _Data_offset = // the elements start at the first suitably aligned offset
+            (sizeof(_Safe_list_image_header) + alignof(_Ty) - 1) / alignof(_Ty) * alignof(_Ty);
+
+        static constexpr size_t _Max_count = (static_cast<size_t>(-1) - _Data_offset) / sizeof(_Ty);
+
+        static size_t _Size(const size_t _Count) noexcept {
+            return _Data_offset + _Count * sizeof(_Ty);
+        }
+
+        static unsigned char* _Write_header(void* const _Buffer, const size_t _Count) noexcept {
+            // Note: Returns the location of the first element, the padding is zeroed.
+            const _Safe_list_image_header _Header = {_Safe_list_image_magic, _Count, sizeof(_Ty)};
+            unsigned char* const _Bytes           = static_cast<unsigned char*>(_Buffer);
+            ::memcpy(_Bytes, &_Header, sizeof(_Header));
+            ::memset(_Bytes + sizeof(_Header), 0, _Data_offset - sizeof(_Header));
+            return _Bytes + _Data_offset;
+        }
+
+        static const _Ty* _Elements(const void* const _Data, const size_t _Data_size, size_t& _Count) noexcept {
+            // Note: Returns the first element of the image, or a null-pointer if _Data does not hold
+            //       a complete image of a list of T. The image must be aligned to alignof(T).
+            if (!_Data || _Data_size < _Data_offset || reinterpret_cast<uintptr_t>(_Data) % alignof(_Ty) != 0) {
+                return nullptr;
+            }
+
+            _Safe_list_image_header _Header;
+            ::memcpy(&_Header, _Data, sizeof(_Header));
+            if (_Header._Magic != _Safe_list_image_magic || _Header._Element_size != sizeof(_Ty)
+                || _Header._Count > (_Data_size - _Data_offset) / sizeof(_Ty)) { // not an image or truncated
+                return nullptr;
+            }
+
+            _Count = static_cast<size_t>(_Header._Count);
+            return reinterpret_cast<const _Ty*>(static_cast<const unsigned char*>(_Data) + _Data_offset);
+        }
+    };
+
+    template <class _Node_type, class _Alnode, class _Alloc>
+    class _Safe_list_node_handle : private _Safe_list_alloc_holder<_Alnode> { // owns a node extracted from a list
+    private:
+        using _Mybase = _Safe_list_alloc_holder<_Alnode>;
+
+    public:
+        using value_type     = decltype(_Node_type::_Value);
+        using allocator_type = _Alloc;
+
+        // Note: An extracted node keeps its value and the allocator it came from. Inserting it into a list
+        //       with an equal allocator relinks the node, nothing is allocated, copied or moved. A handle
+        //       that still owns its node destroys the value and returns the node to its allocator.
+        _Safe_list_node_handle() noexcept : _Mybase(), _Node(nullptr) {}
+
+        _Safe_list_node_handle(_Node_type* const _Node, const _Alnode& _Al) noexcept
+            : _Mybase(_Al), _Node(_Node) {}
+
+        _Safe_list_node_handle(_Safe_list_node_handle&& _Other) noexcept
+            : _Mybase(_Other._Get_allocator()), _Node(_Other._Node) {
+            _Other._Node = nullptr;
+        }
+
+        ~_Safe_list_node_handle() noexcept {
+            _Destroy();
+        }
+
+        _Safe_list_node_handle& operator=(_Safe_list_node_handle&& _Other) noexcept {
+            if (this != ::std::addressof(_Other)) {
+                _Destroy();
+                this->_Get_allocator() = _Other._Get_allocator();
+                _Node                  = _Other._Node;
+                _Other._Node           = nullptr;
+            }
+
+            return *this;
+        }
+
+        _Safe_list_node_handle(const _Safe_list_node_handle&)            = delete;
+        _Safe_list_node_handle& operator=(const _Safe_list_node_handle&) = delete;
+
+        bool empty() const noexcept {
+            return _Node == nullptr;
+        }
+
+        explicit operator bool() const noexcept {
+            return _Node != nullptr;
+        }
+
+        value_type& value() const noexcept {
+            // Note: The handle must not be empty.
+            return _Node->_Value;
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(this->_Get_allocator());
+        }
+
+        void swap(_Safe_list_node_handle& _Other) noexcept {
+            using ::std::swap;
+            swap(this->_Get_allocator(), _Other._Get_allocator());
+            swap(_Node, _Other._Node);
+        }
+
+        friend void swap(_Safe_list_node_handle& _Left, _Safe_list_node_handle& _Right) noexcept {
+            _Left.swap(_Right);
+        }
+
+        // Note: Used by safe_list, not a part of the public interface.
+        const _Alnode& _Get_node_allocator() const noexcept {
+            return this->_Get_allocator();
+        }
+
+        _Node_type* _Release() noexcept {
+            _Node_type* const _Released = _Node;
+            _Node                       = nullptr;
+            return _Released;
+        }
+
+    private:
+        void _Destroy() noexcept {
+            if (_Node) {
+                _Node->~_Node_type();
+                this->_Get_allocator().deallocate(_Node, 1);
+                _Node = nullptr;
+            }
+        }
+
+        _Node_type* _Node; // the owned node, a null-pointer if the handle is empty
+    };
+
+    struct _Safe_list_parallel_access; // defined in safe_list_parallel.hpp
+
+    template <class _Ty, class _Alloc = safe_allocator<_Ty>>
+    class safe_list_snapshot; // defined in safe_list_snapshot.hpp
+
+    template <class _Ty, class _Alloc = safe_allocator<_Ty>, class _Policy = safe_list_heap_storage>
+    class safe_list { // exception-safe doubly-linked list
+    private:
+        using _Traits    = _Safe_list_traits<_Ty>;
+        using _Node_t    = _Safe_list_node<_Ty, _Traits>;
+        using _Self_t    = safe_list<_Ty, _Alloc, _Policy>;
+        using _Al_traits = ::std::allocator_traits<_Alloc>;
+        using _Alnode_t  = typename _Al_traits::template rebind_alloc<_Node_t>;
+        using _Alslot_t  = typename _Al_traits::template rebind_alloc<_Node_t*>; // for dedupe_unsorted()
+        using _Storage   = typename _Safe_list_policy_traits<_Policy>::_Storage;
+        using _Stats     = typename _Safe_list_policy_traits<_Policy>::_Stats;
+        using _Index     = typename _Safe_list_policy_traits<_Policy>::_Index;
+        using _Budget    = typename _Safe_list_policy_traits<_Policy>::_Budget;
+        using _Sample_t  = _Safe_list_sample_scope<_Stats>;
+
+    public:
+        using value_type      = _Ty;
+        using allocator_type  = _Alloc;
+        using policy_type     = _Policy;
+        using storage_type    = _Storage;
+        using stats_type      = _Stats;
+        using index_type      = _Index;
+        using budget_type     = _Budget;
+        using size_type       = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer         = _Ty*;
+        using const_pointer   = const _Ty*;
+        using reference       = _Ty&;
+        using const_reference = const _Ty&;
+    
+        using iterator               = _Safe_list_iterator<_Self_t, _Traits>;
+        using const_iterator         = _Safe_list_const_iterator<_Self_t, _Traits>;
+        using reverse_iterator       = _Safe_list_reverse_iterator<_Self_t, _Traits>;
+        using const_reverse_iterator = _Safe_list_const_reverse_iterator<_Self_t, _Traits>;
+        using node_type              = _Safe_list_node_handle<_Node_t, _Alnode_t, _Alloc>;
+
+        static_assert(::std::is_same_v<typename _Alloc::value_type, _Ty>, "Alloc::value_type must be T.");
+        static_assert(!_Is_inline_storage<_Storage> || _Traits::_Is_nothrow_move_constructible,
+            "T must be nothrow move constructible to be stored inline.");
+
+        // Note: Used by the iterators, not a part of the public interface.
+        using _Node_type = _Node_t;
+
+        static reference _Value_of(_Node_t* const _Node) noexcept {
+            return _Node->_Value;
+        }
+
+        safe_list() noexcept : _Mystorage() {}
+
+        explicit safe_list(const allocator_type& _Al) noexcept : _Mystorage(_Alnode_t(_Al)) {}
+
+        safe_list(const safe_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible)
+            : _Mystorage(_Al_traits::select_on_container_copy_construction(_Other.get_allocator())) {
+            _Copy_list(_Other);
+        }
+
+        safe_list(const safe_list& _Other, const allocator_type& _Al) noexcept(
+            _Traits::_Is_nothrow_copy_constructible) : _Mystorage(_Alnode_t(_Al)) {
+            _Copy_list(_Other);
+        }
+
+        safe_list(safe_list&& _Other) noexcept : _Mystorage(_Other._Mystorage._Get_allocator()) {
+            if constexpr (_Is_inline_storage<_Storage>) { // the inline values must be moved
+                _Mystorage._Steal(_Other._Mystorage);
+            } else {
+                _Mystorage._Swap(_Other._Mystorage); // swap storages
+            }
+        }
+
+        safe_list(safe_list_reserve_t, const size_type _Capacity, const allocator_type& _Al = allocator_type{}) noexcept
+            : _Mystorage(_Alnode_t(_Al)) {
+            // Note: Equivalent to reserve_nodes(_Capacity) right after construction, with the bounded
+            //       storage it allocates the block and fixes the capacity. If that fails, the capacity
+            //       stays zero (max_size() tells).
+            (void) reserve_nodes(_Capacity);
+        }
+
+        explicit safe_list(const size_type _Count, const allocator_type& _Al = allocator_type{}) noexcept(
+            _Traits::_Is_nothrow_default_constructible) : _Mystorage(_Alnode_t(_Al)) {
+            (void) resize(_Count);
+        }
+
+        explicit safe_list(const size_type _Count, const value_type& _Value,
+            const allocator_type& _Al = allocator_type{}) noexcept(_Traits::_Is_nothrow_copy_constructible)
+            : _Mystorage(_Alnode_t(_Al)) {
+            (void) resize(_Count, _Value);
+        }
+
+        safe_list(::std::initializer_list<value_type> _Init_list, const allocator_type& _Al = allocator_type{})
+            noexcept(_Traits::_Is_nothrow_copy_constructible) : _Mystorage(_Alnode_t(_Al)) {
+            (void) assign(_Init_list);
+        }
+
+        ~safe_list() noexcept {
+            clear();
+        }
+        
+        safe_list& operator=(const safe_list& _Other) noexcept(
+            _Traits::_Is_nothrow_copy_constructible && _Traits::_Is_nothrow_copy_assignable) {
+            // Note: The nodes this list already owns are reused, only the missing ones are allocated.
+            if (this != ::std::addressof(_Other)) {
+                _Assign_list(_Other);
+            }
+
+            return *this;
+        }
+
+        safe_list& operator=(safe_list&& _Other) noexcept {
+            // Note: The allocator always travels with the nodes, otherwise the nodes would have to be
+            //       reallocated with this list's allocator, an operation that might fail.
+            //       With the inline storage, the elements of this list are destroyed and _Other is left
+            //       empty, the values of its inline nodes are moved, the heap nodes are taken over.
+            if (this != ::std::addressof(_Other)) {
+                if constexpr (_Is_inline_storage<_Storage>) {
+                    clear();
+                    _Mystorage._Steal(_Other._Mystorage);
+                } else {
+                    _Mystorage._Swap(_Other._Mystorage);
+                }
+            }
+
+            return *this;
+        }
+
+        safe_list& operator=(
+            ::std::initializer_list<value_type> _Init_list) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            (void) assign(_Init_list);
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(_Mystorage._Get_allocator());
+        }
+
+        // Note: The stats policy (safe_list_policy<Storage, Stats>) decides what is collected,
+        //       safe_list_no_stats compiles every hook to nothing and stats() returns zeros.
+        //       The statistics belong to the list object, they are neither copied nor swapped.
+
+        safe_list_stats stats() const noexcept {
+            return _Mystorage._Get();
+        }
+
+        void reset_stats() noexcept {
+            _Mystorage._Reset();
+        }
+
+        bool empty() const noexcept {
+            return _Mystorage._Size == 0;
+        }
+
+        size_type size() const noexcept {
+            return _Mystorage._Size;
+        }
+
+        size_type max_size() const noexcept {
+            if constexpr (_Is_bounded_storage<_Storage>) { // the capacity set by reserve_nodes()
+                return _Mystorage._Capacity;
+            } else {
+                return static_cast<size_type>(-1) / sizeof(_Ty);
+            }
+        }
+
+        iterator begin() noexcept {
+            return _Make_iter<iterator>(_Mystorage._Head);
+        }
+
+        const_iterator begin() const noexcept {
+            return _Make_iter<const_iterator>(_Mystorage._Head);
+        }
+
+        const_iterator cbegin() const noexcept {
+            return _Make_iter<const_iterator>(_Mystorage._Head);
+        }
+
+        reverse_iterator rbegin() noexcept {
+            return _Make_iter<reverse_iterator>(_Mystorage._Tail);
+        }
+
+        const_reverse_iterator rbegin() const noexcept {
+            return _Make_iter<const_reverse_iterator>(_Mystorage._Tail);
+        }
+
+        const_reverse_iterator crbegin() const noexcept {
+            return _Make_iter<const_reverse_iterator>(_Mystorage._Tail);
+        }
+
+        iterator end() noexcept {
+            return _Make_iter<iterator>(nullptr); // past-the-last element (null-pointer)
+        }
+
+        const_iterator end() const noexcept {
+            return _Make_iter<const_iterator>(nullptr); // past-the-last element (null-pointer)
+        }
+
+        const_iterator cend() const noexcept {
+            return _Make_iter<const_iterator>(nullptr); // past-the-last element (null-pointer)
+        }
+
+        reverse_iterator rend() noexcept {
+            return _Make_iter<reverse_iterator>(nullptr);
+        }
+
+        const_reverse_iterator rend() const noexcept {
+            return _Make_iter<const_reverse_iterator>(nullptr);
+        }
+
+        const_reverse_iterator crend() const noexcept {
+            return _Make_iter<const_reverse_iterator>(nullptr);
+        }
+
+        // Note: Since the container is exception-safe, front() and back() cannot throw an exception
+        //       if the list is empty. Instead, we use pointers to access the first and the last node.
+        //       This approach is not compatible with std::list, but it works perfectly in this case.
+
+        pointer front() noexcept {
+            return !empty() ? ::std::addressof(_Mystorage._Head->_Value) : nullptr;
+        }
+
+        const_pointer front() const noexcept {
+            return !empty() ? ::std::addressof(_Mystorage._Head->_Value) : nullptr;
+        }
+
+        pointer back() noexcept {
+            return !empty() ? ::std::addressof(_Mystorage._Tail->_Value) : nullptr;
+        }
+
+        const_pointer back() const noexcept {
+            return !empty() ? ::std::addressof(_Mystorage._Tail->_Value) : nullptr;
+        }
+
+        // Note: The positional functions reach the position from the nearer end of the list. With
+        //       safe_list_skip_index<N> in the policy, they start at most N - 1 nodes before it instead
+        //       (after the index has been rebuilt up to the position, which happens on the first lookup).
+        //       The const overloads never rebuild the index, they use what the others have recorded.
+        //       insert_at() and erase_at() keep the index before the position, other modifications
+        //       keep only what they provably do not shift (e.g. push_back() and pop_back() keep everything).
+
+        pointer at_index(const size_type _Pos) noexcept {
+            return _Pos < _Mystorage._Size ? ::std::addressof(_Mystorage._Node_at(_Pos)->_Value) : nullptr;
+        }
+
+        const_pointer at_index(const size_type _Pos) const noexcept {
+            return _Pos < _Mystorage._Size ? ::std::addressof(_Mystorage._Node_at(_Pos)->_Value) : nullptr;
+        }
+
+        iterator iterator_at(const size_type _Pos) noexcept {
+            // Note: Returns end() if _Pos is not less than size().
+            return _Make_iter<iterator>(_Pos < _Mystorage._Size ? _Mystorage._Node_at(_Pos) : nullptr);
+        }
+
+        const_iterator iterator_at(const size_type _Pos) const noexcept {
+            return _Make_iter<const_iterator>(_Pos < _Mystorage._Size ? _Mystorage._Node_at(_Pos) : nullptr);
+        }
+
+        [[nodiscard]] bool assign(
+            size_type _Count, const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            // Note: The new nodes are created before the old ones are destroyed,
+            //       so the list is left unchanged if an allocation fails.
+            //       If T can be assigned without throwing, the existing nodes are overwritten instead,
+            //       only the missing nodes are created and only the surplus ones are freed.
+            _Chain_t _Chain;
+            if constexpr (_Traits::_Is_nothrow_copy_assignable) {
+                if (_Count > _Mystorage._Size // create the missing nodes first
+                    && !_Make_chain_n(_Chain, _Count - _Mystorage._Size, _Value)) {
+                    return false;
+                }
+
+                size_type _Idx = 0;
+                for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr && _Idx < _Count; _Node = _Node->_Next) {
+                    _Node->_Value = _Value;
+                    ++_Idx;
+                }
+
+                _Truncate(_Count);
+            } else {
+                if (!_Make_chain_n(_Chain, _Count, _Value)) { // failed to create new nodes
+                    return false;
+                }
+
+                _Destroy_nodes();
+            }
+
+            _Adopt_chain(nullptr, _Chain);
+            return true;
+        }
+
+        template <class _InIt>
+        [[nodiscard]] bool assign(_InIt _First, _InIt _Last) noexcept(
+            _Traits::template _Is_nothrow_constructible<decltype(*::std::declval<_InIt>())>) {
+            static_assert(_Traits::template _Is_constructible<decltype(*::std::declval<_InIt>())>,
+                "T must be constructible from InIt's value type.");
+            using _Category = typename ::std::iterator_traits<_InIt>::iterator_category;
+            _Chain_t _Chain;
+            if constexpr (::std::is_base_of_v<::std::forward_iterator_tag, _Category>
+                          && ::std::is_nothrow_assignable_v<_Ty&, decltype(*::std::declval<_InIt>())>) {
+                // Note: Same as assign(count, value), the existing nodes are overwritten. The range
+                //       is traversed twice, the elements past the current size are copied first.
+                const size_type _Count = static_cast<size_type>(::std::distance(_First, _Last));
+                if (_Count > _Mystorage._Size // create the missing nodes first
+                    && !_Make_chain(_Chain, ::std::next(_First, static_cast<ptrdiff_t>(_Mystorage._Size)), _Last)) {
+                    return false;
+                }
+
+                for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr && _First != _Last; _Node = _Node->_Next) {
+                    _Node->_Value = *_First;
+                    ++_First;
+                }
+
+                _Truncate(_Count);
+            } else {
+                if (!_Make_chain(_Chain, _First, _Last)) { // failed to create new nodes
+                    return false;
+                }
+
+                _Destroy_nodes();
+            }
+
+            _Adopt_chain(nullptr, _Chain);
+            return true;
+        }
+
+        [[nodiscard]] bool assign(
+            ::std::initializer_list<value_type> _Init_list) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return assign(_Init_list.begin(), _Init_list.end());
+        }
+
+        template <class _Rng>
+        [[nodiscard]] bool assign_range(_Rng&& _Range) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Range_reference_t<_Rng>>) {
+            return assign(::std::begin(_Range), ::std::end(_Range));
+        }
+
+        size_type serialized_size() const noexcept {
+            // Note: Returns the number of bytes serialize_to() writes.
+            return _Safe_list_image<_Ty>::_Size(_Mystorage._Size);
+        }
+
+        [[nodiscard]] bool serialize_to(void* const _Buffer, const size_type _Buffer_size) const noexcept {
+            // Note: Writes the elements as a length-prefixed contiguous array that deserialize_from()
+            //       and safe_list_view<T> (safe_list_view.hpp) read back. Returns false if the buffer
+            //       is smaller than serialized_size(). T must be trivially copyable.
+            if (_Buffer_size < serialized_size()) { // not enough space
+                return false;
+            }
+
+            unsigned char* _Out = _Safe_list_image<_Ty>::_Write_header(_Buffer, _Mystorage._Size);
+            _Safe_list_lookahead<const _Node_t> _Lookahead(_Mystorage._Head);
+            for (const _Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Node->_Next) {
+                _Lookahead._Step();
+                ::memcpy(_Out, ::std::addressof(_Node->_Value), sizeof(_Ty));
+                _Out += sizeof(_Ty);
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] bool deserialize_from(const void* const _Data, const size_type _Data_size) noexcept {
+            // Note: Replaces the elements with the ones of an image written by serialize_to(), _Data must be
+            //       aligned to alignof(T) (a mapped file is). The list is left unchanged if the image is malformed
+            //       or an allocation fails. As with assign(), the existing nodes are overwritten and the missing
+            //       ones are created as a single chain, with the slab storage all slabs are allocated at once.
+            size_type _Count          = 0;
+            const _Ty* const _Elements = _Safe_list_image<_Ty>::_Elements(_Data, _Data_size, _Count);
+            if (!_Elements) { // not a valid image
+                return false;
+            }
+
+            return assign(_Elements, _Elements + _Count);
+        }
+
+        [[nodiscard]] bool freeze(safe_list_snapshot<_Ty, _Alloc>& _Snapshot) noexcept {
+            // Note: Moves the elements into _Snapshot (safe_list_snapshot.hpp), a single contiguous array,
+            //       and frees the nodes. Returns false and leaves both unchanged if the array cannot be
+            //       allocated. T must be nothrow move constructible.
+            return _Snapshot._Take(*this);
+        }
+
+        [[nodiscard]] bool thaw(
+            const safe_list_snapshot<_Ty, _Alloc>& _Snapshot) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            // Note: Replaces the elements with copies of the snapshot's, see assign().
+            return assign(_Snapshot.begin(), _Snapshot.end());
+        }
+
+        void clear() noexcept {
+            const _Sample_t _Sample(_Mystorage); // times the operation if the stats policy samples it
+            if (_Mystorage._Size > 0) { // non-empty list, erase elements
+                _Mystorage._Invalidate_index();
+                if constexpr (_Is_slab_storage<_Storage> || _Is_bounded_storage<_Storage>) {
+                    // Note: Destroy the values only, then release the slabs (or the whole block) at once.
+                    if constexpr (!::std::is_trivially_destructible_v<_Ty>) { // no walk for trivial types
+                        for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Node->_Next) {
+                            _Node->_Value.~_Ty();
+                        }
+                    }
+
+                    _Mystorage._On_free(_Mystorage._Size);
+                    _Mystorage._Head = nullptr;
+                    _Mystorage._Tail = nullptr;
+                    _Mystorage._Size = 0;
+                } else {
+                    _Destroy_nodes();
+                }
+
+                _Mystorage._Release_nodes();
+            }
+        }
+
+        iterator insert(
+            const_iterator _Where, const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace(_Where, _Value);
+        }
+
+        iterator insert(const_iterator _Where, value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace(_Where, ::std::move(_Value));
+        }
+
+        iterator insert(const_iterator _Where,
+            size_type _Count, const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            // Note: All nodes are created first and linked at once. If an allocation fails,
+            //       the already created nodes are destroyed and the list is left unchanged.
+            _Where._Verify_owner(this);
+            if (_Count == 0) { // nothing to insert
+                return _Make_iter<iterator>(_Where._Get_node());
+            }
+
+            _Chain_t _Chain;
+            if (!_Make_chain_n(_Chain, _Count, _Value)) { // failed to create new nodes
+                return iterator{};
+            }
+
+            return _Adopt_chain(_Where._Get_node(), _Chain);
+        }
+
+        template <class _InIt>
+        iterator insert(const_iterator _Where, _InIt _First, _InIt _Last) noexcept(
+            _Traits::template _Is_nothrow_constructible<decltype(*::std::declval<_InIt>())>) {
+            static_assert(_Traits::template _Is_constructible<decltype(*::std::declval<_InIt>())>,
+                "T must be constructible from InIt's value type.");
+            _Where._Verify_owner(this);
+            if (_First == _Last) { // nothing to insert
+                return _Make_iter<iterator>(_Where._Get_node());
+            }
+
+            _Chain_t _Chain;
+            if (!_Make_chain(_Chain, _First, _Last)) { // failed to create new nodes
+                return iterator{};
+            }
+
+            return _Adopt_chain(_Where._Get_node(), _Chain);
+        }
+
+        iterator insert(const_iterator _Where,
+            ::std::initializer_list<value_type> _Init_list) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return insert(_Where, _Init_list.begin(), _Init_list.end());
+        }
+
+        template <class _Rng>
+        iterator insert_range(const_iterator _Where, _Rng&& _Range) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Range_reference_t<_Rng>>) {
+            return insert(_Where, ::std::begin(_Range), ::std::end(_Range));
+        }
+
+        template <class _Rng>
+        [[nodiscard]] bool append_range(_Rng&& _Range) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Range_reference_t<_Rng>>) {
+            _Chain_t _Chain;
+            if (!_Make_chain(_Chain, ::std::begin(_Range), ::std::end(_Range))) { // failed to create new nodes
+                return false;
+            }
+
+            _Adopt_chain(nullptr, _Chain);
+            return true;
+        }
+
+        template <class _Rng>
+        [[nodiscard]] bool prepend_range(_Rng&& _Range) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Range_reference_t<_Rng>>) {
+            _Chain_t _Chain;
+            if (!_Make_chain(_Chain, ::std::begin(_Range), ::std::end(_Range))) { // failed to create new nodes
+                return false;
+            }
+
+            _Adopt_chain(_Mystorage._Head, _Chain);
+            return true;
+        }
+
+        template <class... _Types>
+        iterator emplace(const_iterator _Where,
+            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            const _Sample_t _Sample(_Mystorage);
+            _Where._Verify_owner(this);
+            if (_Mystorage._Size == max_size()) { // not enough space for another element
+                return iterator{};
+            }
+
+            _Node_t* const _New_node = _Make_node(::std::forward<_Types>(_Args)...);
+            if (!_New_node) { // allocation failed
+                return iterator{};
+            }
+
+            _Link_before(_Where._Get_node(), _New_node);
+            return _Make_iter<iterator>(_New_node);
+        }
+
+        iterator erase(const_iterator _Where) noexcept {
+            // Note: erase(cend()) erases the last element and returns an iterator to the new last element,
+            //       with SAFE_LIST_CHECKED_ITERATORS it aborts instead (unless the list is empty).
+            //       Otherwise the returned iterator points to the element after the erased one.
+            //       The links of the node itself tell its position, nothing is compared with begin() or end().
+            const _Sample_t _Sample(_Mystorage);
+            _Where._Verify_owner(this);
+            if (_Mystorage._Size == 0) { // empty list, nothing to do
+                return iterator{};
+            }
+
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+            if (!_Where) {
+                _Safe_list_check_failed("the end iterator cannot be erased");
+            }
+#endif // SAFE_LIST_CHECKED_ITERATORS
+
+            _Node_t* const _Node = _Where ? _Where._Get_node() : _Mystorage._Tail;
+            _Node_t* const _Prev = _Node->_Prev;
+            _Node_t* const _Next = _Node->_Next;
+            if (_Prev) {
+                _Prev->_Next = _Next;
+            } else { // erase the first node
+                _Mystorage._Head = _Next;
+            }
+
+            if (_Next) {
+                _Next->_Prev = _Prev;
+            } else { // erase the last node
+                _Mystorage._Tail = _Prev;
+            }
+
+            _Mystorage._Invalidate_index(_Next ? 0 : _Mystorage._Size - 1); // the last node keeps the other entries
+            _Free_node(_Node);
+            --_Mystorage._Size;
+            return _Make_iter<iterator>(_Where ? _Next : _Prev);
+        }
+
+        iterator erase(const_iterator _First, const_iterator _Last) noexcept {
+            // Note: Detaches [_First, _Last) with a single link update, then destroys the detached nodes
+            //       in one loop. Returns an iterator to _Last.
+            const _Sample_t _Sample(_Mystorage);
+            _First._Verify_owner(this);
+            _Last._Verify_owner(this);
+            _Node_t* const _First_node = _First._Get_node();
+            _Node_t* const _Last_node  = _Last._Get_node();
+            if (!_First_node || _First_node == _Last_node) { // nothing to erase
+                return _Make_iter<iterator>(_Last_node);
+            }
+
+            _Detach_chain(_First_node, _Last_node ? _Last_node->_Prev : _Mystorage._Tail);
+            size_type _Count = 0;
+            _Node_t* _Next;
+            for (_Node_t* _Node = _First_node; _Node != nullptr; _Node = _Next) {
+                _Next = _Node->_Next;
+                _Free_node(_Node);
+                ++_Count;
+            }
+
+            _Mystorage._Size -= _Count;
+            return _Make_iter<iterator>(_Last_node);
+        }
+
+        template <class... _Types>
+        iterator emplace_at(const size_type _Pos,
+            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            // Note: Inserts before the element at _Pos, or appends if _Pos is equal to size().
+            //       Returns an empty iterator if _Pos is greater than size() or the insertion failed.
+            if (_Pos > _Mystorage._Size) { // out of range
+                return iterator{};
+            }
+
+            const const_iterator _Where = iterator_at(_Pos);
+            const size_t _Index_state   = _Mystorage._Index_state();
+            const iterator _Iter        = emplace(_Where, ::std::forward<_Types>(_Args)...);
+            _Mystorage._Restore_index(_Index_state, _Pos); // only the positions from _Pos on have changed
+            return _Iter;
+        }
+
+        iterator insert_at(
+            const size_type _Pos, const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace_at(_Pos, _Value);
+        }
+
+        iterator insert_at(
+            const size_type _Pos, value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace_at(_Pos, ::std::move(_Value));
+        }
+
+        iterator erase_at(const size_type _Pos) noexcept {
+            // Note: Returns an iterator to the element after the erased one, end() if _Pos is out of range.
+            if (_Pos >= _Mystorage._Size) { // out of range
+                return end();
+            }
+
+            _Node_t* const _Node      = _Mystorage._Node_at(_Pos);
+            _Node_t* const _Next      = _Node->_Next;
+            const size_t _Index_state = _Mystorage._Index_state();
+            (void) erase(_Make_iter<iterator>(_Node));
+            _Mystorage._Restore_index(_Index_state, _Pos);
+            return _Make_iter<iterator>(_Next);
+        }
+
+        [[nodiscard]] bool push_back(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace_back(_Value);
+        }
+
+        [[nodiscard]] bool push_back(value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace_back(::std::move(_Value));
+        }
+
+        template <class... _Types>
+        [[nodiscard]] bool emplace_back(
+            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            const _Sample_t _Sample(_Mystorage);
+            if (_Mystorage._Size == max_size()) { // not enough space for another element
+                return false;
+            }
+
+            _Node_t* const _New_node = _Make_node(::std::forward<_Types>(_Args)...);
+            if (!_New_node) { // allocation failed
+                return false;
+            }
+
+            _Link_back(_New_node);
+            return true;
+        }
+
+        [[nodiscard]] bool push_front(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace_front(_Value);
+        }
+
+        [[nodiscard]] bool push_front(value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace_front(::std::move(_Value));
+        }
+
+        template <class... _Types>
+        [[nodiscard]] bool emplace_front(
+            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            const _Sample_t _Sample(_Mystorage);
+            if (_Mystorage._Size == max_size()) { // not enough space for another element
+                return false;
+            }
+
+            _Node_t* const _New_node = _Make_node(::std::forward<_Types>(_Args)...);
+            if (!_New_node) { // allocation failed
+                return false;
+            }
+
+            _Link_front(_New_node);
+            return true;
+        }
+
+        void pop_back() noexcept {
+            const _Sample_t _Sample(_Mystorage);
+            _Mystorage._Invalidate_index(_Mystorage._Size > 0 ? _Mystorage._Size - 1 : 0);
+            switch (_Mystorage._Size) {
+            case 0: // empty list, nothing to do
+                break;
+            case 1: // erase the only node (destroys the whole list)
+                _Free_node(_Mystorage._Head);
+                _Mystorage._Head = nullptr;
+                _Mystorage._Tail = nullptr;
+                _Mystorage._Size = 0;
+                break;
+            default: // erase an element
+                _Node_t* const _Tail = _Mystorage._Tail;
+                _Tail->_Prev->_Next  = nullptr;
+                _Mystorage._Tail     = _Tail->_Prev;
+                --_Mystorage._Size;
+                _Free_node(_Tail);
+                break;
+            }
+        }
+
+        void pop_front() noexcept {
+            const _Sample_t _Sample(_Mystorage);
+            _Mystorage._Invalidate_index();
+            switch (_Mystorage._Size) {
+            case 0: // empty list, nothing to do
+                break;
+            case 1: // erase the only node (destroys the whole list)
+                _Free_node(_Mystorage._Head);
+                _Mystorage._Head = nullptr;
+                _Mystorage._Tail = nullptr;
+                _Mystorage._Size = 0;
+                break;
+            default: // erase an element
+                _Node_t* const _Head = _Mystorage._Head;
+                _Head->_Next->_Prev  = nullptr;
+                _Mystorage._Head     = _Head->_Next;
+                --_Mystorage._Size;
+                _Free_node(_Head);
+                break;
+            }
+        }
+
+        template <class _InIt>
+        [[nodiscard]] bool push_back_n(_InIt _First, const size_type _Count) noexcept(
+            _Traits::template _Is_nothrow_constructible<decltype(*::std::declval<_InIt>())>) {
+            // Note: Creates the _Count elements starting at _First as one chain and links it with a single update,
+            //       all or none. The size is checked once and, with the slab storage, every slab is allocated at once.
+            const _Sample_t _Sample(_Mystorage);
+            if (_Count > max_size() - _Mystorage._Size) { // not enough space for new elements
+                return false;
+            }
+
+            _Chain_t _Chain;
+            _Prepare_nodes(_Count);
+            for (; _Chain._Size < _Count; ++_First) {
+                if (!_Chain_append(_Chain, *_First)) { // failed to create a new node, rollback
+                    _Free_chain(_Chain);
+                    return false;
+                }
+            }
+
+            _Adopt_chain(nullptr, _Chain);
+            return true;
+        }
+
+        template <class _OutIt>
+        _OutIt pop_front_n(size_type _Count, _OutIt _Dest) noexcept(
+            noexcept(*_Dest = ::std::move(::std::declval<_Ty&>())) && noexcept(++_Dest)) {
+            // Note: Moves up to _Count elements from the front of the list to _Dest and frees their nodes
+            //       in the same loop. The links and the size are updated once, when the loop ends,
+            //       or when writing to _Dest throws, in which case the remaining elements stay in the list.
+            const _Sample_t _Sample(_Mystorage);
+            if (_Count > _Mystorage._Size) {
+                _Count = _Mystorage._Size;
+            }
+
+            _Front_cut _Cut(*this);
+            _Safe_list_lookahead<_Node_t> _Lookahead(_Mystorage._Head);
+            while (_Cut._Count < _Count) {
+                _Node_t* const _Node = _Cut._Head;
+                _Lookahead._Step();
+                *_Dest = ::std::move(_Node->_Value);
+                ++_Dest;
+                _Cut._Head = _Node->_Next;
+                ++_Cut._Count;
+                _Free_node(_Node);
+            }
+
+            return _Dest;
+        }
+
+        template <class _OutIt>
+        _OutIt drain_into(_OutIt _Dest) noexcept(
+            noexcept(*_Dest = ::std::move(::std::declval<_Ty&>())) && noexcept(++_Dest)) {
+            // Note: Moves every element to _Dest and leaves the list empty, the storage keeps its memory.
+            return pop_front_n(_Mystorage._Size, _Dest);
+        }
+
+        [[nodiscard]] bool resize(const size_type _New_size) noexcept(_Traits::_Is_nothrow_default_constructible) {
+            if (_Mystorage._Size < _New_size) { // create new nodes, all or none
+                _Chain_t _Chain;
+                if (!_Make_chain_n(_Chain, _New_size - _Mystorage._Size)) { // failed to create new nodes
+                    return false;
+                }
+
+                _Adopt_chain(nullptr, _Chain);
+            } else { // delete existing nodes
+                _Truncate(_New_size);
+            }
+
+            return true;
+        }
 
-        explicit _Safe_list_const_reverse_iterator(_Node_t* const _Node) noexcept : _Mybase(_Node) {}
+        [[nodiscard]] bool resize(const size_type _New_size,
+            const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            if (_Mystorage._Size < _New_size) { // create new nodes, all or none
+                _Chain_t _Chain;
+                if (!_Make_chain_n(_Chain, _New_size - _Mystorage._Size, _Value)) { // failed to create new nodes
+                    return false;
+                }
 
-        ~_Safe_list_const_reverse_iterator() noexcept {}
+                _Adopt_chain(nullptr, _Chain);
+            } else { // delete existing nodes
+                _Truncate(_New_size);
+            }
 
-        reference operator*() const noexcept {
-            return this->_Node->_Value;
+            return true;
         }
 
-        pointer operator->() const noexcept {
-            return ::std::addressof(this->_Node->_Value);
-        }
+        // Note: With the heap storage, the node cache is disabled by default. Once enabled, spent nodes
+        //       are not returned to the allocator, but kept in a bounded free list and reused by
+        //       the next insertion. This makes queue-like workloads (e.g. push_back() + pop_front())
+        //       allocation-free. With the slab storage, spent nodes always stay in their slabs
+        //       and reserve_nodes() allocates whole slabs in advance.
 
-        _Safe_list_const_reverse_iterator& operator++() noexcept {
-            this->_Node = this->_Node->_Prev;
-            return *this;
+        [[nodiscard]] bool reserve_nodes(const size_type _Count) noexcept {
+            return _Mystorage._Reserve(_Count);
         }
 
-        _Safe_list_const_reverse_iterator& operator++(int) noexcept {
-            _Safe_list_const_reverse_iterator _Temp = *this;
-            this->_Node                             = this->_Node->_Prev;
-            return _Temp;
+        void shrink_to_fit() noexcept {
+            _Mystorage._Shrink();
         }
 
-        _Safe_list_const_reverse_iterator& operator--() noexcept {
-            this->_Node = this->_Node->_Next;
-            return *this;
+        size_type cached_nodes() const noexcept {
+            return _Mystorage._Available();
         }
 
-        _Safe_list_const_reverse_iterator& operator--(int) noexcept {
-            _Safe_list_const_reverse_iterator _Temp = *this;
-            this->_Node                             = this->_Node->_Next;
-            return _Temp;
+        size_type node_cache_limit() const noexcept {
+            static_assert(!_Is_slab_storage<_Storage> && !_Is_bounded_storage<_Storage>,
+                "the slab and bounded storages do not limit spent nodes.");
+            return _Mystorage._Cache_limit;
         }
-    };
-
-    template <class _Ty>
-    class safe_list { // exception-safe doubly-linked list
-    private:
-        using _Traits = _Safe_list_traits<_Ty>;
-        using _Node_t = _Safe_list_node<_Ty, _Traits>;
-        using _Self_t = safe_list<_Ty>;
-        
-    public:
-        using value_type      = _Ty;
-        using size_type       = size_t;
-        using difference_type = ptrdiff_t;
-        using pointer         = _Ty*;
-        using const_pointer   = const _Ty*;
-        using reference       = _Ty&;
-        using const_reference = const _Ty&;
-    
-        using iterator               = _Safe_list_iterator<_Self_t, _Traits>;
-        using const_iterator         = _Safe_list_const_iterator<_Self_t, _Traits>;
-        using reverse_iterator       = _Safe_list_reverse_iterator<_Self_t, _Traits>;
-        using const_reverse_iterator = _Safe_list_const_reverse_iterator<_Self_t, _Traits>;
-
-        safe_list() noexcept : _Mystorage() {}
 
-        safe_list(const safe_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible) : _Mystorage() {
-            _Copy_list(_Other);
+        void node_cache_limit(const size_type _New_limit) noexcept {
+            static_assert(!_Is_slab_storage<_Storage> && !_Is_bounded_storage<_Storage>,
+                "the slab and bounded storages do not limit spent nodes.");
+            _Mystorage._Cache_limit = _New_limit;
+            _Mystorage._Trim_cache(_New_limit);
         }
 
-        safe_list(safe_list&& _Other) noexcept : _Mystorage() {
-            _Mystorage._Swap(_Other._Mystorage); // swap storages
-        }
+        // Note: memory_usage() returns the bytes the list holds through its allocator: the nodes in use,
+        //       the cached nodes, the slabs or the block and the positional index. The list object itself
+        //       (and the slots of the inline storage in it) is not included. With safe_list_memory_budget
+        //       as the budget policy, memory_budget(bytes) caps that number. An operation that would exceed
+        //       the budget fails as if the allocator had returned a null-pointer, the positional index
+        //       stops growing instead and dedupe_unsorted() scans without its table. Reusing a spent node
+        //       never fails. Lowering the budget below the current usage frees nothing, call shrink_to_fit()
+        //       for that. The budget stays with the list when it is moved or swapped.
 
-        explicit safe_list(
-            const size_type _Count) noexcept(_Traits::_Is_nothrow_move_constructible) : _Mystorage() {
-            (void) resize(_Count);
+        size_type memory_usage() const noexcept {
+            return _Mystorage._Memory_usage();
         }
 
-        explicit safe_list(const size_type _Count,
-            const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) : _Mystorage() {
-            (void) resize(_Count, _Value);
+        size_type memory_budget() const noexcept {
+            static_assert(_Budget::_Enabled, "the memory budget requires safe_list_memory_budget.");
+            return _Mystorage._Get_limit();
         }
 
-        safe_list(::std::initializer_list<value_type> _Init_list) noexcept(
-            _Traits::_Is_nothrow_copy_constructible) : _Mystorage() {
-            (void) assign(_Init_list);
+        void memory_budget(const size_type _New_budget) noexcept {
+            static_assert(_Budget::_Enabled, "the memory budget requires safe_list_memory_budget.");
+            _Mystorage._Set_limit(_New_budget);
         }
 
-        ~safe_list() noexcept {
-            clear();
-        }
-        
-        safe_list& operator=(const safe_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible) {
-            if (this != ::std::addressof(_Other)) {
-                _Copy_list(_Other);
+        void swap(safe_list& _Other) noexcept {
+            if constexpr (_Is_inline_storage<_Storage>) { // three moves, the inline values change places
+                if (this != ::std::addressof(_Other)) {
+                    safe_list _Temp(::std::move(_Other));
+                    _Other = ::std::move(*this);
+                    *this  = ::std::move(_Temp);
+                }
+            } else {
+                _Mystorage._Swap(_Other._Mystorage);
             }
-
-            return *this;
         }
 
-        safe_list& operator=(safe_list&& _Other) noexcept {
-            if (this != ::std::addressof(_Other)) {
-                _Mystorage._Swap(_Other._Mystorage);
+        template <class _Pr>
+        size_type remove_if(_Pr _Pred) noexcept(::std::is_nothrow_invocable_v<_Pr, const _Ty&>) {
+            const _Sample_t _Sample(_Mystorage);
+            if (_Mystorage._Size == 0) { // must not be empty
+                return 0;
+            }
+            
+            size_type _Count = 0;
+            _Safe_list_lookahead<_Node_t> _Lookahead(_Mystorage._Head);
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Next) {
+                _Next = _Node->_Next;
+                _Lookahead._Step();
+                if (_Pred(_Node->_Value)) { // element found, erase it
+                    _Delete_node(_Node);
+                    ++_Count;
+                }
             }
 
-            return *this;
+            return _Count;
         }
 
-        safe_list& operator=(
-            ::std::initializer_list<value_type> _Init_list) noexcept(_Traits::_Is_nothrow_copy_constructible) {
-            (void) assign(_Init_list);
-            return *this;
+        template <class _Fn>
+        void for_each(_Fn _Func) noexcept(::std::is_nothrow_invocable_v<_Fn&, _Ty&>) {
+            // Note: Same as a range-for loop, but the nodes ahead are prefetched.
+            _Safe_list_lookahead<_Node_t> _Lookahead(_Mystorage._Head);
+            for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Node->_Next) {
+                _Lookahead._Step();
+                _Func(_Node->_Value);
+            }
         }
 
-        bool empty() const noexcept {
-            return _Mystorage._Size == 0;
+        template <class _Fn>
+        void for_each(_Fn _Func) const noexcept(::std::is_nothrow_invocable_v<_Fn&, const _Ty&>) {
+            _Safe_list_lookahead<const _Node_t> _Lookahead(_Mystorage._Head);
+            for (const _Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Node->_Next) {
+                _Lookahead._Step();
+                _Func(static_cast<const _Ty&>(_Node->_Value));
+            }
         }
 
-        size_type size() const noexcept {
-            return _Mystorage._Size;
+        size_type remove(const value_type& _Value) noexcept {
+            return remove_if(
+                [_Value](const value_type& _Node_value) noexcept {
+                    return _Node_value == _Value;
+                }
+            );
         }
 
-        size_type max_size() const noexcept {
-            return static_cast<size_type>(-1) / sizeof(_Ty);
+        size_type unique() noexcept(noexcept(::std::declval<const _Ty&>() == ::std::declval<const _Ty&>())) {
+            return unique(::std::equal_to<>{});
         }
 
-        iterator begin() noexcept {
-            return iterator{_Mystorage._Head};
-        }
+        template <class _Pr>
+        size_type unique(_Pr _Pred) noexcept(::std::is_nothrow_invocable_v<_Pr&, const _Ty&, const _Ty&>) {
+            // Note: Erases every element for which _Pred(kept, element) holds, where kept is the nearest
+            //       element before it that was not erased. Only the erased nodes are unlinked and freed.
+            const _Sample_t _Sample(_Mystorage);
+            if (_Mystorage._Size < 2) { // no duplicates possible
+                return 0;
+            }
 
-        const_iterator begin() const noexcept {
-            return const_iterator{_Mystorage._Head};
-        }
+            size_type _Count = 0;
+            _Node_t* _Kept   = _Mystorage._Head;
+            _Safe_list_lookahead<_Node_t> _Lookahead(_Kept->_Next);
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Kept->_Next; _Node != nullptr; _Node = _Next) {
+                _Next = _Node->_Next;
+                _Lookahead._Step();
+                if (_Pred(static_cast<const _Ty&>(_Kept->_Value), static_cast<const _Ty&>(_Node->_Value))) {
+                    _Delete_node(_Node);
+                    ++_Count;
+                } else {
+                    _Kept = _Node;
+                }
+            }
 
-        const_iterator cbegin() const noexcept {
-            return const_iterator{_Mystorage._Head};
+            return _Count;
         }
 
-        reverse_iterator rbegin() noexcept {
-            return reverse_iterator{_Mystorage._Tail};
-        }
+        template <class _Hasher = ::std::hash<_Ty>, class _Keyeq = ::std::equal_to<>>
+        size_type dedupe_unsorted(_Hasher _Hash = _Hasher{}, _Keyeq _Eq = _Keyeq{}) noexcept(
+            ::std::is_nothrow_invocable_v<_Hasher&, const _Ty&>
+            && ::std::is_nothrow_invocable_v<_Keyeq&, const _Ty&, const _Ty&>) {
+            // Note: Erases every element equal to an earlier one, the first occurrence of each value stays.
+            //       The kept nodes are recorded in a temporary open-addressing table (linear probing,
+            //       at most half full), allocated with the list's allocator and freed before returning.
+            //       If the table cannot be allocated, every element is compared with the kept ones instead,
+            //       which takes O(n^2) time but never fails.
+            const _Sample_t _Sample(_Mystorage);
+            if (_Mystorage._Size < 2) { // no duplicates possible
+                return 0;
+            }
 
-        const_reverse_iterator rbegin() const noexcept {
-            return const_reverse_iterator{_Mystorage._Tail};
-        }
+            constexpr size_t _Hash_bits = sizeof(size_t) * 8;
+            size_t _Slot_bits           = 1;
+            while (_Slot_bits < _Hash_bits - 2 && (size_t{1} << _Slot_bits) < _Mystorage._Size * 2) {
+                ++_Slot_bits;
+            }
 
-        const_reverse_iterator crbegin() const noexcept {
-            return const_reverse_iterator{_Mystorage._Tail};
-        }
+            const size_t _Slots = size_t{1} << _Slot_bits;
+            _Alslot_t _Al(_Mystorage._Get_allocator());
+            const bool _Fits = _Mystorage._Size <= _Slots / 2 // the table fits in memory and in the budget
+                            && _Mystorage._Admits_growth(_Slots * sizeof(_Node_t*));
+            _Node_t** const _Table = _Fits ? _Al.allocate(_Slots) : nullptr;
+            if (!_Table) { // fall back to the quadratic scan
+                return _Dedupe_scan(_Eq);
+            }
 
-        iterator end() noexcept {
-            return iterator{nullptr}; // past-the-last element (null-pointer)
-        }
+            for (size_t _Slot = 0; _Slot < _Slots; ++_Slot) {
+                _Table[_Slot] = nullptr;
+            }
 
-        const_iterator end() const noexcept {
-            return const_iterator{nullptr}; // past-the-last element (null-pointer)
-        }
+            constexpr size_t _Multiplier = sizeof(size_t) == 8 ? static_cast<size_t>(0x9E3779B97F4A7C15ULL)
+                                                               : static_cast<size_t>(0x9E3779B9UL);
+            size_type _Count = 0;
+            _Safe_list_lookahead<_Node_t> _Lookahead(_Mystorage._Head);
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Next) {
+                _Next = _Node->_Next;
+                _Lookahead._Step();
+                const _Ty& _Value = _Node->_Value;
+                size_t _Slot      = (static_cast<size_t>(_Hash(_Value)) * _Multiplier) >> (_Hash_bits - _Slot_bits);
+                for (;;) { // the table is never full, an empty slot ends the probe
+                    _Node_t* const _Entry = _Table[_Slot];
+                    if (!_Entry) { // the first occurrence, keep it
+                        _Table[_Slot] = _Node;
+                        break;
+                    }
 
-        const_iterator cend() const noexcept {
-            return const_iterator{nullptr}; // past-the-last element (null-pointer)
-        }
+                    if (_Eq(static_cast<const _Ty&>(_Entry->_Value), _Value)) { // a duplicate, erase it
+                        _Delete_node(_Node);
+                        ++_Count;
+                        break;
+                    }
 
-        reverse_iterator rend() noexcept {
-            return reverse_iterator{nullptr};
-        }
+                    _Slot = (_Slot + 1) & (_Slots - 1);
+                }
+            }
 
-        const_reverse_iterator rend() const noexcept {
-            return const_reverse_iterator{nullptr};
+            _Al.deallocate(_Table, _Slots);
+            return _Count;
         }
 
-        const_reverse_iterator crend() const noexcept {
-            return const_reverse_iterator{nullptr};
-        }
+        // Note: With the bounded storage, handle() makes a safe_list_handle for an element, which can be
+        //       stored instead of an iterator. find() and erase() check it in O(1): a handle is stale once
+        //       its element was erased or the list was cleared (its node carries a new generation then),
+        //       and it never matches a node of another block. A handle follows its element when the list
+        //       is moved or swapped. Only the lower half of a node's generation counts up, so it wraps
+        //       around after 2^31 reuses of the same node, a stale handle could be taken for a live one then.
 
-        // Note: Since the container is exception-safe, front() and back() cannot throw an exception
-        //       if the list is empty. Instead, we use pointers to access the first and the last node.
-        //       This approach is not compatible with std::list, but it works perfectly in this case.
+        safe_list_handle handle(const const_iterator _Where) const noexcept {
+            static_assert(_Is_bounded_storage<_Storage>, "handles require the bounded storage.");
+            _Where._Verify_owner(this);
+            return _Where ? _Mystorage._Handle_of(_Where._Get_node()) : safe_list_handle{};
+        }
 
-        pointer front() noexcept {
-            return !empty() ? ::std::addressof(_Mystorage._Head->_Value) : nullptr;
+        iterator find(const safe_list_handle& _Handle) noexcept {
+            static_assert(_Is_bounded_storage<_Storage>, "handles require the bounded storage.");
+            return _Make_iter<iterator>(_Mystorage._Node_of(_Handle));
         }
 
-        const_pointer front() const noexcept {
-            return !empty() ? ::std::addressof(_Mystorage._Head->_Value) : nullptr;
+        const_iterator find(const safe_list_handle& _Handle) const noexcept {
+            static_assert(_Is_bounded_storage<_Storage>, "handles require the bounded storage.");
+            return _Make_iter<const_iterator>(_Mystorage._Node_of(_Handle));
         }
 
-        pointer back() noexcept {
-            return !empty() ? ::std::addressof(_Mystorage._Tail->_Value) : nullptr;
+        [[nodiscard]] bool erase(const safe_list_handle& _Handle) noexcept {
+            // Note: Returns false and leaves the list unchanged if the handle is stale.
+            static_assert(_Is_bounded_storage<_Storage>, "handles require the bounded storage.");
+            const _Sample_t _Sample(_Mystorage);
+            _Node_t* const _Node = _Mystorage._Node_of(_Handle);
+            if (!_Node) { // stale handle
+                return false;
+            }
+
+            _Delete_node(_Node);
+            return true;
         }
 
-        const_pointer back() const noexcept {
-            return !empty() ? ::std::addressof(_Mystorage._Tail->_Value) : nullptr;
+        iterator find(const value_type& _Value) noexcept {
+            // Note: Returns end() if no element is equal to _Value. Every node holds a single value,
+            //       so the list is always searched one node at a time (see safe_unrolled_list).
+            return _Make_iter<iterator>(const_cast<_Node_t*>(_Find_node(_Value)));
         }
 
-        [[nodiscard]] bool assign(
-            size_type _Count, const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
-            clear(); // must be empty
-            return resize(_Count, _Value);
+        const_iterator find(const value_type& _Value) const noexcept {
+            return _Make_iter<const_iterator>(const_cast<_Node_t*>(_Find_node(_Value)));
         }
 
-        template <class _InIt>
-        [[nodiscard]] bool assign(_InIt _First, _InIt _Last) noexcept(
-            _Traits::template _Is_nothrow_constructible<decltype(*::std::declval<_InIt>())>) {
-            static_assert(_Traits::template _Is_constructible<decltype(*::std::declval<_InIt>())>,
-                "T must be constructible from InIt's value type.");
-            clear(); // must be empty
-            for (; _First != _Last; ++_First) {
-                if (!push_back(static_cast<_Ty>(*_First))) { // failed to create a new node
-                    return false;
+        size_type count(const value_type& _Value) const noexcept {
+            size_type _Count = 0;
+            _Safe_list_lookahead<const _Node_t> _Lookahead(_Mystorage._Head);
+            for (const _Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Node->_Next) {
+                _Lookahead._Step();
+                if (_Node->_Value == _Value) {
+                    ++_Count;
                 }
             }
 
-            return true;
+            return _Count;
         }
 
-        [[nodiscard]] bool assign(
-            ::std::initializer_list<value_type> _Init_list) noexcept(_Traits::_Is_nothrow_copy_constructible) {
-            return assign(_Init_list.begin(), _Init_list.end());
+        [[nodiscard]] bool contains(const value_type& _Value) const noexcept {
+            return _Find_node(_Value) != nullptr;
         }
 
-        void clear() noexcept {
-            if (_Mystorage._Size > 0) { // non-empty list, erase elements
-                _Node_t* _Next;
-                for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Next) {
-                    _Next = _Node->_Next;
-                    _Destroy_object(_Node);
+        void reverse() noexcept {
+            // Note: Only the links are swapped, the values stay where they are.
+            if (_Mystorage._Size > 1) { // must contains at least 2 nodes
+                _Mystorage._Invalidate_index();
+                _Node_t* _Node = _Mystorage._Head;
+                while (_Node) {
+                    _Node_t* const _Next = _Node->_Next;
+                    _Node->_Next         = _Node->_Prev;
+                    _Node->_Prev         = _Next;
+                    _Node                = _Next;
                 }
 
-                _Mystorage._Head = nullptr;
-                _Mystorage._Tail = nullptr;
-                _Mystorage._Size = 0;
+                ::std::swap(_Mystorage._Head, _Mystorage._Tail);
             }
         }
 
-        iterator insert(
-            const_iterator _Where, const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
-            if (_Mystorage._Size == max_size()) { // not enough space for another element
-                return iterator{};
-            }
-
-            if (empty()) { // _Where is unused since the list is empty
-                return push_back(_Value) ? begin() : iterator{};
-            }
-
-            _Node_t* const _New_node = _Make_node(_Value);
-            if (!_New_node) { // allocation failed
-                return iterator{};
-            }
+        // Note: splice(), transfer(), extract(), merge() and sort() only relink nodes, they never allocate,
+        //       copy or move values. Nodes can only be moved to another list (or inserted from a node_type)
+        //       if both allocators compare equal, otherwise the operation fails and returns false or end().
+        //       The memory budget of the receiving list must admit the nodes as well. The slab, inline
+        //       and bounded storages own their nodes, so nodes cannot leave the list they were created in:
+        //       splice() and transfer() reorder such a list, but fail if the nodes would move to another one.
 
-            if (_Where == cbegin()) { // insert before the first node
-                _Mystorage._Head->_Prev        = _New_node;
-                _Mystorage._Head->_Prev->_Next = _Mystorage._Head;
-                _Mystorage._Head               = _Mystorage._Head->_Prev;
-            } else if (_Where == cend()) { // insert before the last node
-                _New_node->_Prev        = _Mystorage._Tail;
-                _Mystorage._Tail->_Next = _New_node;
-                _Mystorage._Tail        = _Mystorage._Tail->_Next;
-            } else { // insert before the inner node
-                _Node_t* const _Node     = _Where._Get_node();
-                _Node_t* const _Old_prev = _Node->_Prev;
-                _Node->_Prev             = _New_node;
-                _New_node->_Prev         = _Old_prev;
-                _New_node->_Next         = _Node;
-                _Old_prev->_Next         = _New_node;
-            }
+        [[nodiscard]] bool splice(const_iterator _Where, safe_list& _Other) noexcept {
+            return splice(_Where, _Other, _Other.cbegin(), _Other.cend(), _Other._Mystorage._Size);
+        }
 
-            ++_Mystorage._Size;
-            return iterator{_New_node};
+        [[nodiscard]] bool splice(const_iterator _Where, safe_list& _Other, const_iterator _Iter) noexcept {
+            return _Iter ? splice(_Where, _Other, _Iter, const_iterator{_Iter._Get_node()->_Next}, 1) : true;
         }
 
-        iterator insert(const_iterator _Where, value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
-            if (_Mystorage._Size == max_size()) { // not enough space for another element
-                return iterator{};
+        [[nodiscard]] bool splice(
+            const_iterator _Where, safe_list& _Other, const_iterator _First, const_iterator _Last) noexcept {
+            // Note: The number of spliced nodes is computed in O(distance(_First, _Last)),
+            //       use the overload that takes the count to splice in O(1).
+            size_type _Count = 0;
+            if (this != ::std::addressof(_Other)) { // the size changes only if nodes move between lists
+                for (const_iterator _Iter = _First; _Iter != _Last; ++_Iter) {
+                    ++_Count;
+                }
             }
 
-            if (empty()) { // _Where is unused since the list is empty
-                return push_back(::std::move(_Value)) ? begin() : iterator{};
-            }
+            return splice(_Where, _Other, _First, _Last, _Count);
+        }
 
-            _Node_t* const _New_node = _Make_node(::std::move(_Value));
-            if (!_New_node) { // allocation failed
-                return iterator{};
+        [[nodiscard]] bool splice(const_iterator _Where, safe_list& _Other,
+            const_iterator _First, const_iterator _Last, const size_type _Count) noexcept {
+            // Note: _Count must be equal to distance(_First, _Last), it is ignored if _Other is *this.
+            //       Within one list, _Where may not lie in [_First, _Last) (like std::list, the splice
+            //       is then a no-op), so the range is walked in O(distance(_First, _Last)).
+            _Where._Verify_owner(this);
+            _First._Verify_owner(::std::addressof(_Other));
+            _Last._Verify_owner(::std::addressof(_Other));
+            if (_First == _Last) { // nothing to do
+                return true;
             }
 
-            if (_Where == cbegin()) { // insert before the first node
-                _Mystorage._Head->_Prev        = _New_node;
-                _Mystorage._Head->_Prev->_Next = _Mystorage._Head;
-                _Mystorage._Head               = _Mystorage._Head->_Prev;
-            } else if (_Where == cend()) { // insert before the last node
-                _New_node->_Prev        = _Mystorage._Tail;
-                _Mystorage._Tail->_Next = _New_node;
-                _Mystorage._Tail        = _Mystorage._Tail->_Next;
-            } else { // insert before the inner node
-                _Node_t* const _Node     = _Where._Get_node();
-                _Node_t* const _Old_prev = _Node->_Prev;
-                _Node->_Prev             = _New_node;
-                _New_node->_Prev         = _Old_prev;
-                _New_node->_Next         = _Node;
-                _Old_prev->_Next         = _New_node;
+            const bool _Same_list = this == ::std::addressof(_Other);
+            if (_Same_list) { // the range must not be attached before itself
+                for (const_iterator _Iter = _First; _Iter != _Last; ++_Iter) {
+                    if (_Iter == _Where) { // _Where lies in the range, nothing moves
+                        return true;
+                    }
+                }
+            } else { // nodes move to another list
+                if constexpr (_Is_slab_storage<_Storage> || _Is_inline_storage<_Storage>
+                              || _Is_bounded_storage<_Storage>) { // nodes cannot leave their storage
+                    return false;
+                } else if (!_Can_adopt_nodes(_Other._Mystorage._Get_allocator(), _Count)) {
+                    return false;
+                }
             }
 
-            ++_Mystorage._Size;
-            return iterator{_New_node};
-        }
-
-        iterator insert(const_iterator _Where,
-            size_type _Count, const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
-            iterator _Iter;
-            while (_Count-- > 0) {
-                _Iter  = insert(_Where, _Value);
-                _Where = const_iterator{_Iter._Get_node()}; // update _Where's previous node
+            _Node_t* const _First_node = _First._Get_node();
+            _Node_t* const _Last_node  = _Last ? _Last._Get_node()->_Prev : _Other._Mystorage._Tail;
+            _Other._Detach_chain(_First_node, _Last_node);
+            _Attach_chain(_Where._Get_node(), _First_node, _Last_node);
+            if (!_Same_list) {
+                _Other._Mystorage._Size -= _Count;
+                _Mystorage._Size += _Count;
+                _Mystorage._On_size(_Mystorage._Size);
             }
 
-            return _Iter;
+            return true;
         }
 
-        template <class _InIt>
-        iterator insert(const_iterator _Where, _InIt _First, _InIt _Last) noexcept(
-            _Traits::template _Is_nothrow_constructible<decltype(*::std::declval<_InIt>())>) {
-            static_assert(_Traits::template _Is_constructible<decltype(*::std::declval<_InIt>())>,
-                "T must be constructible from InIt's value type.");
-            iterator _Iter;
-            for (; _First != _Last; ++_First) {
-                _Iter  = insert(_Where, static_cast<_Ty>(*_First));
-                _Where = const_iterator{_Iter._Get_node()->_Next};
+        safe_list slice(const_iterator _First, const_iterator _Last) noexcept {
+            // Note: The number of sliced nodes is computed in O(distance(_First, _Last)),
+            //       use the overload that takes the count to slice in O(1).
+            size_type _Count = 0;
+            for (const_iterator _Iter = _First; _Iter != _Last; ++_Iter) {
+                ++_Count;
             }
 
-            return _Iter;
+            return slice(_First, _Last, _Count);
         }
 
-        iterator insert(const_iterator _Where,
-            ::std::initializer_list<value_type> _Init_list) noexcept(_Traits::_Is_nothrow_copy_constructible) {
-            return insert(_Where, _Init_list.begin(), _Init_list.end());
+        safe_list slice(const_iterator _First, const_iterator _Last, const size_type _Count) noexcept {
+            // Note: Moves [_First, _Last) into a new list that shares this list's allocator, nothing is
+            //       allocated, copied or moved. _Count must be equal to distance(_First, _Last).
+            static_assert(!_Is_slab_storage<_Storage> && !_Is_inline_storage<_Storage>
+                && !_Is_bounded_storage<_Storage>, "nodes cannot leave the slab, inline or bounded storage.");
+            safe_list _Result(get_allocator());
+            (void) _Result.splice(_Result.cend(), *this, _First, _Last, _Count); // the allocators compare equal
+            return _Result;
         }
 
-        template <class... _Types>
-        iterator emplace(const_iterator _Where,
-            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
-            return insert(_Where, _Ty{::std::forward<_Types>(_Args)...});
-        }
+        iterator transfer(const_iterator _Where, safe_list& _Source, const_iterator _Iter) noexcept {
+            // Note: Moves the element at _Iter from _Source before _Where, like splice() but returns
+            //       an iterator to the moved element, or end() if nothing was moved.
+            if (!_Iter) { // no element to move
+                return iterator{};
+            }
 
-        iterator erase(const_iterator _Where) noexcept {
-            if (_Mystorage._Size == 0) { // empty list, nothing to do
+            if (!splice(_Where, _Source, _Iter)) { // the allocators differ or the list is full
                 return iterator{};
             }
 
-            if (_Where == cbegin()) { // erase the first node
-                _Node_t* const _Head = _Mystorage._Head;
-                if (_Head->_Next) {
-                    _Head->_Next->_Prev = nullptr;
-                    _Mystorage._Head    = _Head->_Next;
-                }
+            return _Make_iter<iterator>(_Iter._Get_node());
+        }
 
-                _Destroy_object(_Head);
-                return --_Mystorage._Size > 0 ? iterator{_Mystorage._Head} : iterator{};
-            } else if (_Where == cend()) { // erase the last node
-                _Node_t* const _Tail = _Mystorage._Tail;
-                if (_Tail->_Prev) {
-                    _Tail->_Prev->_Next = nullptr;
-                    _Mystorage._Tail    = _Tail->_Prev;
-                }
-
-                _Destroy_object(_Tail);
-                return --_Mystorage._Size > 0 ? iterator{_Mystorage._Tail} : iterator{};
-            } else { // erase the inner node
-                _Node_t* const _Node = _Where._Get_node();
-                _Node->_Prev->_Next  = _Node->_Next;
-                _Node->_Next->_Prev  = _Node->_Prev;
-                const iterator _Iter(_Node->_Next); // next node replaces _Where's node
-                _Destroy_object(_Node);
-                --_Mystorage._Size;
-                return _Iter;
+        node_type extract(const_iterator _Where) noexcept {
+            // Note: Unlinks the element at _Where and returns the handle that owns its node,
+            //       an empty handle if _Where is end().
+            static_assert(!_Is_slab_storage<_Storage> && !_Is_inline_storage<_Storage>
+                && !_Is_bounded_storage<_Storage>, "nodes cannot leave the slab, inline or bounded storage.");
+            _Where._Verify_owner(this);
+            if (!_Where) { // nothing to extract
+                return node_type(nullptr, _Mystorage._Get_allocator());
             }
+
+            _Node_t* const _Node = _Where._Get_node();
+            _Detach_chain(_Node, _Node);
+            --_Mystorage._Size;
+            return node_type(_Node, _Mystorage._Get_allocator());
         }
 
-        iterator erase(const_iterator _First, const_iterator _Last) noexcept {
-            if (_Mystorage._Size == 0) { // empty list, nothing to do
+        iterator insert(const_iterator _Where, node_type&& _Handle) noexcept {
+            // Note: Links the node owned by _Handle before _Where and returns an iterator to it.
+            //       If _Handle is empty, its allocator differs or the list is full, end() is returned
+            //       and _Handle keeps its node.
+            static_assert(!_Is_slab_storage<_Storage> && !_Is_inline_storage<_Storage>
+                && !_Is_bounded_storage<_Storage>, "nodes cannot leave the slab, inline or bounded storage.");
+            _Where._Verify_owner(this);
+            if (_Handle.empty() || !_Can_adopt_nodes(_Handle._Get_node_allocator(), 1)) {
                 return iterator{};
             }
 
-            iterator _Iter;
-            while (_First != _Last) {
-                _Iter  = erase(_First);
-                _First = const_iterator{_Iter._Get_node()}; // update _First's node
-            }
+            _Node_t* const _Node = _Handle._Release();
+            _Link_before(_Where._Get_node(), _Node);
+            return _Make_iter<iterator>(_Node);
+        }
 
-            return _Iter;
+        [[nodiscard]] bool merge(safe_list& _Other) noexcept(
+            noexcept(::std::declval<const _Ty&>() < ::std::declval<const _Ty&>())) {
+            return merge(_Other, ::std::less<>{});
         }
 
-        [[nodiscard]] bool push_back(
-            const value_type& _Value) noexcept(_Traits::template _Is_nothrow_copy_constructible) {
-            if (_Mystorage._Size == max_size()) { // not enough space for another element
-                return false;
+        template <class _Pr>
+        [[nodiscard]] bool merge(safe_list& _Other, _Pr _Pred) noexcept(
+            ::std::is_nothrow_invocable_v<_Pr&, const _Ty&, const _Ty&>) {
+            // Note: Both lists must be sorted with respect to _Pred. The merge is stable,
+            //       equivalent elements from *this precede those from _Other.
+            if (this == ::std::addressof(_Other) || _Other._Mystorage._Size == 0) { // nothing to do
+                return true;
             }
 
-            _Node_t* const _New_node = _Make_node(_Value);
-            if (!_New_node) { // allocation failed
+            static_assert(!_Is_slab_storage<_Storage> && !_Is_inline_storage<_Storage>
+                && !_Is_bounded_storage<_Storage>, "nodes cannot leave the slab, inline or bounded storage.");
+            if (!_Can_adopt_nodes(_Other._Mystorage._Get_allocator(), _Other._Mystorage._Size)) {
                 return false;
             }
 
-            if (_Mystorage._Size == 0) { // allocate the first node
-                _Mystorage._Head = _New_node;
-                _Mystorage._Tail = _Mystorage._Head;
-            } else { // allocate the next node
-                _Mystorage._Tail->_Next        = _New_node;
-                _Mystorage._Tail->_Next->_Prev = _Mystorage._Tail;
-                _Mystorage._Tail               = _Mystorage._Tail->_Next;
+            _Mystorage._Invalidate_index();
+            _Other._Mystorage._Invalidate_index();
+            _Node_t* _Left  = _Mystorage._Head;
+            _Node_t* _Right = _Other._Mystorage._Head;
+            _Node_t* _Head  = nullptr;
+            _Node_t* _Tail  = nullptr;
+            while (_Left && _Right) { // take the smaller node, prefer the left one if equivalent
+                _Node_t* _Node;
+                if (_Pred(static_cast<const _Ty&>(_Right->_Value), static_cast<const _Ty&>(_Left->_Value))) {
+                    _Node  = _Right;
+                    _Right = _Right->_Next;
+                } else {
+                    _Node = _Left;
+                    _Left = _Left->_Next;
+                }
+
+                _Append_to_chain(_Head, _Tail, _Node);
             }
 
-            ++_Mystorage._Size;
+            _Node_t* const _Rest = _Left ? _Left : _Right;
+            if (_Rest) { // append the remaining nodes at once
+                _Rest->_Prev = _Tail;
+                if (_Tail) {
+                    _Tail->_Next = _Rest;
+                } else {
+                    _Head = _Rest;
+                }
+
+                _Tail = _Left ? _Mystorage._Tail : _Other._Mystorage._Tail;
+            }
+
+            _Mystorage._Head = _Head;
+            _Mystorage._Tail = _Tail;
+            _Mystorage._Size += _Other._Mystorage._Size;
+            _Mystorage._On_size(_Mystorage._Size);
+            _Other._Mystorage._Head = nullptr;
+            _Other._Mystorage._Tail = nullptr;
+            _Other._Mystorage._Size = 0;
             return true;
         }
 
-        [[nodiscard]] bool push_back(value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
-            if (_Mystorage._Size == max_size()) { // not enough space for another element
-                return false;
-            }
+        void sort() noexcept(noexcept(::std::declval<const _Ty&>() < ::std::declval<const _Ty&>())) {
+            sort(::std::less<>{});
+        }
 
-            _Node_t* const _New_node = _Make_node(::std::move(_Value));
-            if (!_New_node) { // allocation failed
-                return false;
+        template <class _Pr>
+        void sort(_Pr _Pred) noexcept(::std::is_nothrow_invocable_v<_Pr&, const _Ty&, const _Ty&>) {
+            // Note: Bottom-up merge sort, stable and O(n log n). Runs of doubling width are merged
+            //       in place by relinking, so neither the values nor any extra memory are involved.
+            if (_Mystorage._Size < 2) { // already sorted
+                return;
             }
 
-            if (_Mystorage._Size == 0) { // allocate the first node
-                _Mystorage._Head = _New_node;
-                _Mystorage._Tail = _Mystorage._Head;
-            } else { // allocate the next node
-                _Mystorage._Tail->_Next        = _New_node;
-                _Mystorage._Tail->_Next->_Prev = _Mystorage._Tail;
-                _Mystorage._Tail               = _Mystorage._Tail->_Next;
+            _Mystorage._Invalidate_index();
+            _Node_t* _Head = _Mystorage._Head;
+            _Node_t* _Tail = nullptr;
+            for (size_type _Width = 1;; _Width *= 2) {
+                _Node_t* _Left    = _Head;
+                size_type _Merges = 0;
+                _Head             = nullptr;
+                _Tail             = nullptr;
+                while (_Left) { // merge the next two runs
+                    ++_Merges;
+                    _Node_t* _Right       = _Left;
+                    size_type _Left_size  = 0;
+                    size_type _Right_size = _Width;
+                    while (_Left_size < _Width && _Right) { // find the beginning of the right run
+                        ++_Left_size;
+                        _Right = _Right->_Next;
+                    }
+
+                    while (_Left_size > 0 || (_Right_size > 0 && _Right)) {
+                        _Node_t* _Node;
+                        if (_Left_size == 0) { // the left run is exhausted
+                            _Node  = _Right;
+                            _Right = _Right->_Next;
+                            --_Right_size;
+                        } else if (_Right_size == 0 || !_Right) { // the right run is exhausted
+                            _Node = _Left;
+                            _Left = _Left->_Next;
+                            --_Left_size;
+                        } else if (_Pred(static_cast<const _Ty&>(_Right->_Value),
+                                       static_cast<const _Ty&>(_Left->_Value))) { // take the smaller node
+                            _Node  = _Right;
+                            _Right = _Right->_Next;
+                            --_Right_size;
+                        } else { // prefer the left node if equivalent (stability)
+                            _Node = _Left;
+                            _Left = _Left->_Next;
+                            --_Left_size;
+                        }
+
+                        _Append_to_chain(_Head, _Tail, _Node);
+                    }
+
+                    _Left = _Right;
+                }
+
+                _Tail->_Next = nullptr;
+                if (_Merges <= 1) { // the whole list has been merged into one run
+                    break;
+                }
             }
 
-            ++_Mystorage._Size;
-            return true;
+            _Mystorage._Head = _Head;
+            _Mystorage._Tail = _Tail;
         }
 
-        template <class... _Types>
-        [[nodiscard]] bool emplace_back(
-            const _Types&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<const _Types&...>) {
-            return insert(cend(), _Ty{_Args...}).valid();
+    private:
+        friend _Safe_list_parallel_access;
+
+        template <class _Iter>
+        _Iter _Make_iter(_Node_t* const _Node) const noexcept {
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+            return _Iter{_Node, this};
+#else // ^^^ SAFE_LIST_CHECKED_ITERATORS ^^^ / vvv !SAFE_LIST_CHECKED_ITERATORS vvv
+            return _Iter{_Node};
+#endif // SAFE_LIST_CHECKED_ITERATORS
         }
 
         template <class... _Types>
-        [[nodiscard]] bool emplace_back(
-            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
-            return insert(cend(), _Ty{::std::forward<_Types>(_Args)...}).valid();
+        _Node_t* _Make_node(_Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            // Note: The value is constructed directly in the node with parentheses, like std::list does,
+            //       so neither a temporary nor brace-initialization (and narrowing checks) is involved.
+            static_assert(_Traits::template
+                _Is_constructible<_Types&&...>, "T must be constructible from Types...");
+            _Node_t* const _Raw = _Mystorage._Allocate_node();
+            _Mystorage._On_allocate(_Raw != nullptr);
+            return _Raw ? ::new (static_cast<void*>(_Raw)) _Node_t(::std::in_place, ::std::forward<_Types>(_Args)...)
+                        : nullptr;
         }
 
-        [[nodiscard]] bool push_front(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
-            if (_Mystorage._Size == max_size()) { // not enough space for another element
-                return false;
+        void _Link_back(_Node_t* const _New_node) noexcept {
+            if (_Mystorage._Size == 0) { // link the first node
+                _Mystorage._Head = _New_node;
+                _Mystorage._Tail = _New_node;
+            } else { // link after the last node
+                _New_node->_Prev        = _Mystorage._Tail;
+                _Mystorage._Tail->_Next = _New_node;
+                _Mystorage._Tail        = _New_node;
             }
 
-            _Node_t* const _New_node = _Make_node(_Value);
-            if (!_New_node) { // allocation failed
-                return false;
-            }
+            ++_Mystorage._Size;
+            _Mystorage._On_size(_Mystorage._Size);
+        }
 
-            if (_Mystorage._Size == 0) { // allocate the first node
+        void _Link_front(_Node_t* const _New_node) noexcept {
+            if (_Mystorage._Size == 0) { // link the first node
                 _Mystorage._Head = _New_node;
-                _Mystorage._Tail = _Mystorage._Head;
-            } else { // allocate the next node
-                _Mystorage._Head->_Prev        = _New_node;
-                _Mystorage._Head->_Prev->_Next = _Mystorage._Head;
-                _Mystorage._Head               = _Mystorage._Head->_Prev;
+                _Mystorage._Tail = _New_node;
+            } else { // link before the first node
+                _New_node->_Next        = _Mystorage._Head;
+                _Mystorage._Head->_Prev = _New_node;
+                _Mystorage._Head        = _New_node;
+                _Mystorage._Invalidate_index();
             }
 
             ++_Mystorage._Size;
-            return true;
+            _Mystorage._On_size(_Mystorage._Size);
         }
 
-        [[nodiscard]] bool push_front(value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
-            if (_Mystorage._Size == max_size()) { // not enough space for another element
-                return false;
+        void _Link_before(_Node_t* const _Where, _Node_t* const _New_node) noexcept {
+            if (_Mystorage._Size == 0 || !_Where) { // _Where is unused if the list is empty, append otherwise
+                _Link_back(_New_node);
+            } else if (_Where == _Mystorage._Head) { // insert before the first node
+                _Link_front(_New_node);
+            } else { // insert before the inner node
+                _Mystorage._Invalidate_index();
+                _Node_t* const _Old_prev = _Where->_Prev;
+                _Where->_Prev            = _New_node;
+                _New_node->_Prev         = _Old_prev;
+                _New_node->_Next         = _Where;
+                _Old_prev->_Next         = _New_node;
+                ++_Mystorage._Size;
+                _Mystorage._On_size(_Mystorage._Size);
             }
+        }
 
-            _Node_t* const _New_node = _Make_node(::std::move(_Value));
-            if (!_New_node) { // allocation failed
-                return false;
+        const _Node_t* _Find_node(const value_type& _Value) const noexcept {
+            _Safe_list_lookahead<const _Node_t> _Lookahead(_Mystorage._Head);
+            for (const _Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Node->_Next) {
+                _Lookahead._Step();
+                if (_Node->_Value == _Value) {
+                    return _Node;
+                }
             }
 
-            if (_Mystorage._Size == 0) { // allocate the first node
-                _Mystorage._Head = _New_node;
-                _Mystorage._Tail = _Mystorage._Head;
-            } else { // allocate the next node
-                _Mystorage._Head->_Prev        = _New_node;
-                _Mystorage._Head->_Prev->_Next = _Mystorage._Head;
-                _Mystorage._Head               = _Mystorage._Head->_Prev;
+            return nullptr;
+        }
+
+        void _Free_node(_Node_t* const _Node) noexcept {
+            _Node->~_Node_t();
+            _Mystorage._Deallocate_node(_Node);
+            _Mystorage._On_free();
+        }
+
+        template <class _Keyeq>
+        size_type _Dedupe_scan(_Keyeq& _Eq) noexcept(::std::is_nothrow_invocable_v<_Keyeq&, const _Ty&, const _Ty&>) {
+            // Note: Compares every element with the kept elements before it, used by dedupe_unsorted()
+            //       when its table cannot be allocated.
+            size_type _Count = 0;
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Mystorage._Head->_Next; _Node != nullptr; _Node = _Next) {
+                _Next = _Node->_Next;
+                for (_Node_t* _Kept = _Mystorage._Head; _Kept != _Node; _Kept = _Kept->_Next) {
+                    if (_Eq(static_cast<const _Ty&>(_Kept->_Value), static_cast<const _Ty&>(_Node->_Value))) {
+                        _Delete_node(_Node);
+                        ++_Count;
+                        break;
+                    }
+                }
             }
 
-            ++_Mystorage._Size;
-            return true;
+            return _Count;
         }
 
-        template <class... _Types>
-        [[nodiscard]] bool emplace_front(
-            const _Types&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<const _Types&...>) {
-            return insert(cbegin(), _Ty{_Args...}).valid();
+        void _Delete_node(_Node_t* const _Node) noexcept {
+            _Mystorage._Invalidate_index();
+            if (_Node == _Mystorage._Head) { // delete the first node
+                if (_Node->_Next) {
+                    _Node->_Next->_Prev = nullptr;
+                    _Mystorage._Head    = _Node->_Next;
+                } else { // delete the only node
+                    _Mystorage._Head = nullptr;
+                    _Mystorage._Tail = nullptr;
+                }
+            } else if (_Node == _Mystorage._Tail) { // delete the last node
+                _Node->_Prev->_Next = nullptr;
+                _Mystorage._Tail    = _Node->_Prev;
+            } else { // delete the inner node
+                _Node->_Prev->_Next = _Node->_Next;
+                _Node->_Next->_Prev = _Node->_Prev;
+            }
+
+            _Free_node(_Node);
+            --_Mystorage._Size;
         }
 
-        template <class... _Types>
-        [[nodiscard]] bool emplace_front(
-            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
-            return insert(cbegin(), _Ty{::std::forward<_Types>(_Args)...}).valid();
+        struct _Chain_t { // a detached chain of nodes
+            _Node_t* _First; // pointer to the first node
+            _Node_t* _Last; // pointer to the last node
+            size_type _Size; // number of nodes
+
+            _Chain_t() noexcept : _First(nullptr), _Last(nullptr), _Size(0) {}
+        };
+
+        struct _Front_cut { // removes the nodes freed by pop_front_n() from the list once the batch ends
+            safe_list& _List; // the list being popped
+            _Node_t* _Head; // pointer to the first node that is kept
+            size_type _Count; // number of freed nodes
+
+            explicit _Front_cut(safe_list& _Target) noexcept
+                : _List(_Target), _Head(_Target._Mystorage._Head), _Count(0) {}
+
+            ~_Front_cut() noexcept {
+                if (_Count > 0) {
+                    auto& _Mystorage = _List._Mystorage;
+                    _Mystorage._Invalidate_index();
+                    _Mystorage._Head = _Head;
+                    if (_Head) {
+                        _Head->_Prev = nullptr;
+                    } else { // the list is empty
+                        _Mystorage._Tail = nullptr;
+                    }
+
+                    _Mystorage._Size -= _Count;
+                }
+            }
+
+            _Front_cut(const _Front_cut&)            = delete;
+            _Front_cut& operator=(const _Front_cut&) = delete;
+        };
+
+        void _Prepare_nodes(const size_type _Count) noexcept {
+            // Note: With the slab storage, all slabs needed for _Count nodes are allocated at once.
+            if constexpr (_Is_slab_storage<_Storage>) {
+                (void) _Mystorage._Reserve(_Count);
+            } else {
+                (void) _Count;
+            }
         }
 
-        void pop_back() noexcept {
-            switch (_Mystorage._Size) {
-            case 0: // empty list, nothing to do
-                break;
-            case 1: // erase the only node (destroys the whole list)
-                _Destroy_object(_Mystorage._Head);
-                _Mystorage._Head = nullptr;
-                _Mystorage._Tail = nullptr;
-                _Mystorage._Size = 0;
-                break;
-            default: // erase an element
-                _Node_t* const _Tail = _Mystorage._Tail;
-                _Tail->_Prev->_Next  = nullptr;
-                _Mystorage._Tail     = _Tail->_Prev;
-                --_Mystorage._Size;
-                _Destroy_object(_Tail);
-                break;
+        template <class... _Types>
+        bool _Chain_append(_Chain_t& _Chain, _Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            _Node_t* const _New_node = _Make_node(::std::forward<_Types>(_Args)...);
+            if (!_New_node) { // allocation failed
+                return false;
             }
+
+            _Append_to_chain(_Chain._First, _Chain._Last, _New_node);
+            ++_Chain._Size;
+            return true;
         }
 
-        void pop_front() noexcept {
-            switch (_Mystorage._Size) {
-            case 0: // empty list, nothing to do
-                break;
-            case 1: // erase the only node (destroys the whole list)
-                _Destroy_object(_Mystorage._Head);
-                _Mystorage._Head = nullptr;
-                _Mystorage._Tail = nullptr;
-                _Mystorage._Size = 0;
-                break;
-            default: // erase an element
-                _Node_t* const _Head = _Mystorage._Head;
-                _Head->_Next->_Prev  = nullptr;
-                _Mystorage._Head     = _Head->_Next;
-                --_Mystorage._Size;
-                _Destroy_object(_Head);
-                break;
+        void _Free_chain(_Chain_t& _Chain) noexcept {
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Chain._First; _Node != nullptr; _Node = _Next) {
+                _Next = _Node->_Next;
+                _Free_node(_Node);
             }
+
+            _Chain = _Chain_t{};
         }
 
-        [[nodiscard]] bool resize(const size_type _New_size) noexcept(_Traits::_Is_nothrow_move_constructible) {
-            if (_Mystorage._Size < _New_size) { // create new nodes
-                while (_Mystorage._Size != _New_size) {
-                    if (!push_back(_Ty{})) { // failed to create a new node
-                        return false;
-                    }
-                }
-            } else { // delete existing nodes
-                while (_Mystorage._Size != _New_size) {
-                    pop_back();
+        template <class... _Types>
+        bool _Make_chain_n(_Chain_t& _Chain, const size_type _Count, const _Types&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<const _Types&...>) {
+            if (_Count > max_size() - _Mystorage._Size) { // not enough space for new elements
+                return false;
+            }
+
+            _Prepare_nodes(_Count);
+            while (_Chain._Size < _Count) {
+                if (!_Chain_append(_Chain, _Args...)) { // failed to create a new node, rollback
+                    _Free_chain(_Chain);
+                    return false;
                 }
             }
 
             return true;
         }
 
-        [[nodiscard]] bool resize(const size_type _New_size,
-            const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
-            if (_Mystorage._Size < _New_size) { // create new nodes
-                while (_Mystorage._Size != _New_size) {
-                    if (!push_back(_Value)) { // failed to create a new node
-                        return false;
-                    }
+        template <class _InIt>
+        bool _Make_chain(_Chain_t& _Chain, _InIt _First, const _InIt _Last) noexcept(
+            _Traits::template _Is_nothrow_constructible<decltype(*::std::declval<_InIt>())>) {
+            using _Category = typename ::std::iterator_traits<_InIt>::iterator_category;
+            size_type _Max_count = max_size() - _Mystorage._Size;
+            if constexpr (::std::is_base_of_v<::std::forward_iterator_tag, _Category>) {
+                // Note: The number of elements is known up front, check the size only once.
+                const size_type _Count = static_cast<size_type>(::std::distance(_First, _Last));
+                if (_Count > _Max_count) { // not enough space for new elements
+                    return false;
                 }
-            } else { // delete existing nodes
-                while (_Mystorage._Size != _New_size) {
-                    pop_back();
+
+                _Prepare_nodes(_Count);
+                _Max_count = _Count;
+            }
+
+            for (; _First != _Last; ++_First) {
+                if (_Chain._Size == _Max_count || !_Chain_append(_Chain, *_First)) { // rollback
+                    _Free_chain(_Chain);
+                    return false;
                 }
             }
 
             return true;
         }
 
-        void swap(safe_list& _Other) noexcept {
-            _Mystorage._Swap(_Other._Mystorage);
+        iterator _Adopt_chain(_Node_t* const _Where, _Chain_t& _Chain) noexcept {
+            // Note: Links the whole chain before _Where with a single update, returns its first node.
+            _Node_t* const _First = _Chain._First;
+            if (_First) {
+                _Attach_chain(_Where, _First, _Chain._Last);
+                _Mystorage._Size += _Chain._Size;
+                _Mystorage._On_size(_Mystorage._Size);
+                _Chain = _Chain_t{};
+            }
+
+            return _Make_iter<iterator>(_First);
         }
 
-        template <class _Pr>
-        size_type remove_if(_Pr _Pred) noexcept(::std::is_nothrow_invocable_v<_Pr, const _Ty&>) {
-            if (_Mystorage._Size == 0) { // must not be empty
-                return 0;
+        void _Truncate(const size_type _New_size) noexcept {
+            // Note: Detaches all nodes past _New_size at once and destroys them in a single loop.
+            //       The first detached node is searched from the nearer end of the list (or the skip index).
+            if (_New_size >= _Mystorage._Size) { // nothing to do
+                return;
             }
-            
-            size_type _Count = 0;
+
+            if (_New_size == 0) { // destroy the whole list
+                clear();
+                return;
+            }
+
+            _Node_t* const _First = _Mystorage._Node_at(_New_size);
+            _Mystorage._Invalidate_index(_New_size);
+            _Mystorage._Tail        = _First->_Prev;
+            _Mystorage._Tail->_Next = nullptr;
+            _Mystorage._Size        = _New_size;
+            _Node_t* _Next;
+            for (_Node_t* _Node = _First; _Node != nullptr; _Node = _Next) {
+                _Next = _Node->_Next;
+                _Free_node(_Node);
+            }
+        }
+
+        void _Destroy_nodes() noexcept {
+            // Note: Destroys all nodes, unlike clear() the storage keeps its memory.
+            _Mystorage._Invalidate_index();
+            _Safe_list_lookahead<_Node_t> _Lookahead(_Mystorage._Head);
             _Node_t* _Next;
             for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Next) {
                 _Next = _Node->_Next;
-                if (_Pred(_Node->_Value)) { // element found, erase it
-                    _Delete_node(_Node);
-                    ++_Count;
-                }
+                _Lookahead._Step();
+                _Free_node(_Node);
             }
 
-            return _Count;
+            _Mystorage._Head = nullptr;
+            _Mystorage._Tail = nullptr;
+            _Mystorage._Size = 0;
         }
 
-        size_type remove(const value_type& _Value) noexcept {
-            return remove_if(
-                [_Value](const value_type& _Node_value) noexcept {
-                    return _Node_value == _Value;
-                }
-            );
+        bool _Can_adopt_nodes(const _Alnode_t& _Al, const size_type _Count) const noexcept {
+            // Note: _Count nodes allocated with _Al can be linked into this list if _Al compares equal
+            //       to the list's allocator, the size stays within max_size() and the budget admits them.
+            return _Mystorage._Get_allocator() == _Al && _Mystorage._Size <= max_size() - _Count
+                && _Mystorage._Admits_growth(_Count * sizeof(_Node_t));
         }
 
-        void reverse() noexcept(_Traits::_Is_nothrow_swappable) {
-            if (_Mystorage._Size > 1) { // must contains at least 2 nodes
-                _Node_t* _Head = _Mystorage._Head;
-                _Node_t* _Tail = _Mystorage._Tail;
-                while (_Head != _Tail) {
-                    ::std::swap(_Head->_Value, _Tail->_Value);
-                    _Head = _Head->_Next;
-                    _Tail = _Tail->_Prev;
-                    if (_Head->_Next == _Tail) { // reverse two middle nodes
-                        ::std::swap(_Head->_Value, _Tail->_Value);
-                        break;
-                    }
-                }
+        static void _Append_to_chain(_Node_t*& _Head, _Node_t*& _Tail, _Node_t* const _Node) noexcept {
+            // Note: Appends _Node to a detached chain, _Node->_Next is fixed up by the caller.
+            _Node->_Prev = _Tail;
+            if (_Tail) {
+                _Tail->_Next = _Node;
+            } else {
+                _Head = _Node;
             }
-        }
 
-    private:
-        template <class... _Types>
-        static _Node_t* _Make_node(
-            const _Types&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<const _Types&...>) {
-            static_assert(_Traits::template
-                _Is_constructible<const _Types&...>, "T must be constructible from Types...");
-            return _Construct_object<_Node_t>(_Args...);
+            _Tail = _Node;
         }
 
-        template <class... _Types>
-        static _Node_t* _Make_node(
-            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
-            static_assert(_Traits::template
-                _Is_constructible<_Types&&...>, "T must be constructible from Types...");
-            return _Construct_object<_Node_t>(::std::forward<_Types>(_Args)...);
+        void _Detach_chain(_Node_t* const _First, _Node_t* const _Last) noexcept {
+            // Note: Unlinks the nodes [_First, _Last] (both inclusive), the size is not updated.
+            _Mystorage._Invalidate_index();
+            if (_First->_Prev) {
+                _First->_Prev->_Next = _Last->_Next;
+            } else {
+                _Mystorage._Head = _Last->_Next;
+            }
+
+            if (_Last->_Next) {
+                _Last->_Next->_Prev = _First->_Prev;
+            } else {
+                _Mystorage._Tail = _First->_Prev;
+            }
+
+            _First->_Prev = nullptr;
+            _Last->_Next  = nullptr;
         }
 
-        void _Delete_node(_Node_t* const _Node) noexcept {
-            if (_Node == _Mystorage._Head) { // delete the first node
-                if (_Node->_Next) {
-                    _Node->_Next->_Prev = nullptr;
-                    _Mystorage._Head    = _Node->_Next;
-                }
-            } else if (_Node == _Mystorage._Tail) { // delete the last node
-                _Node->_Prev->_Next = nullptr;
-                _Mystorage._Tail    = _Node->_Prev;
-            } else { // delete the inner node
-                _Node->_Prev->_Next = _Node->_Next;
-                _Node->_Next->_Prev = _Node->_Prev;
+        void _Attach_chain(_Node_t* const _Where, _Node_t* const _First, _Node_t* const _Last) noexcept {
+            // Note: Links a detached chain [_First, _Last] before _Where (or at the end if _Where
+            //       is a null-pointer), the size is not updated.
+            _Node_t* const _Prev = _Where ? _Where->_Prev : _Mystorage._Tail;
+            _First->_Prev        = _Prev;
+            _Last->_Next         = _Where;
+            if (_Prev) {
+                _Prev->_Next = _First;
+            } else {
+                _Mystorage._Head = _First;
             }
 
-            _Destroy_object(_Node);
-            --_Mystorage._Size;
+            if (_Where) {
+                _Where->_Prev = _Last;
+                _Mystorage._Invalidate_index(); // inserting before a node invalidates the index
+            } else { // appending keeps the index
+                _Mystorage._Tail = _Last;
+            }
         }
 
         [[nodiscard]] bool _Append_node(const _Ty& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
@@ -978,43 +3958,107 @@ namespace mjx {
                 return false;
             }
 
-            if (_Mystorage._Size == 0) { // allocate the first node
-                _Mystorage._Head = _New_node;
-                _Mystorage._Tail = _Mystorage._Head;
-            } else { // allocate the next node
-                _Mystorage._Tail->_Next        = _New_node;
-                _Mystorage._Tail->_Next->_Prev = _Mystorage._Tail;
-                _Mystorage._Tail               = _Mystorage._Tail->_Next;
-            }
-
-            ++_Mystorage._Size;
+            _Link_back(_New_node);
             return true;
         }
 
+        void _Append_copies(const _Node_t* _First) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            // Note: Appends copies of _First and all nodes after it, stops at the first failed allocation.
+            _Safe_list_lookahead<const _Node_t> _Lookahead(_First);
+            for (; _First != nullptr; _First = _First->_Next) {
+                _Lookahead._Step();
+                if (!_Append_node(_First->_Value)) { // failed to create a new node
+                    return;
+                }
+            }
+        }
+
         void _Copy_list(const safe_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible) {
-            for (const value_type& _Value : _Other) {
-                if (!_Append_node(_Value)) { // failed to create a new node
+            if constexpr (_Is_bounded_storage<_Storage>) { // the copy gets the same capacity
+                (void) _Mystorage._Reserve(_Other._Mystorage._Capacity);
+            }
+
+            if constexpr (_Is_slab_storage<_Storage> && ::std::is_trivially_copyable_v<_Ty>) {
+                // Note: All slabs are allocated up front, after that no allocation can fail, so the nodes
+                //       are filled and chained in a single pass without checks and linked at once.
+                //       Copying a trivially copyable T compiles to a plain memcpy() of the payload.
+                const size_type _Count = _Other._Mystorage._Size;
+                if (_Count > 0 && _Count <= max_size() - _Mystorage._Size && _Mystorage._Reserve(_Count)) {
+                    _Node_t* _First = nullptr;
+                    _Node_t* _Last  = nullptr;
+                    _Safe_list_lookahead<const _Node_t> _Lookahead(_Other._Mystorage._Head);
+                    for (const _Node_t* _Src = _Other._Mystorage._Head; _Src != nullptr; _Src = _Src->_Next) {
+                        _Lookahead._Step();
+                        _Node_t* const _New_node = ::new (static_cast<void*>(_Mystorage._Allocate_node()))
+                            _Node_t(::std::in_place, _Src->_Value); // never fails, the slabs are reserved
+                        _Mystorage._On_allocate(true);
+                        _Append_to_chain(_First, _Last, _New_node);
+                    }
+
+                    _Attach_chain(nullptr, _First, _Last);
+                    _Mystorage._Size += _Count;
+                    _Mystorage._On_size(_Mystorage._Size);
                     return;
                 }
             }
+
+            _Append_copies(_Other._Mystorage._Head);
+        }
+
+        void _Assign_list(const safe_list& _Other) noexcept(
+            _Traits::_Is_nothrow_copy_constructible && _Traits::_Is_nothrow_copy_assignable) {
+            // Note: The values of the existing nodes are overwritten, surplus nodes are freed
+            //       and the missing ones are appended, so the allocator is only used for the difference.
+            //       A T that cannot be assigned is destroyed and copy constructed in place instead,
+            //       unless its copy constructor may throw, then the nodes are not reused.
+            constexpr bool _Reuse_nodes = ::std::is_copy_assignable_v<_Ty> || _Traits::_Is_nothrow_copy_constructible;
+            if constexpr (_Is_bounded_storage<_Storage>) { // like a copy, a list without a block gets one
+                (void) _Mystorage._Reserve(_Other._Mystorage._Capacity);
+            }
+
+            if constexpr (!_Reuse_nodes) {
+                _Destroy_nodes();
+                _Copy_list(_Other);
+            } else {
+                _Node_t* _Node      = _Mystorage._Head;
+                const _Node_t* _Src = _Other._Mystorage._Head;
+                for (; _Node != nullptr && _Src != nullptr; _Node = _Node->_Next, _Src = _Src->_Next) {
+                    if constexpr (::std::is_copy_assignable_v<_Ty>) {
+                        _Node->_Value = _Src->_Value;
+                    } else {
+                        _Node->_Value.~_Ty();
+                        ::new (static_cast<void*>(::std::addressof(_Node->_Value))) _Ty(_Src->_Value);
+                    }
+                }
+
+                if (_Node) { // this list was longer, free the surplus nodes
+                    _Truncate(_Other._Mystorage._Size);
+                } else if (_Src) { // append the rest of _Other
+                    _Append_copies(_Src);
+                }
+            }
         }
 
-        _Safe_list_storage<_Ty, _Traits, size_type> _Mystorage;
+        _Safe_list_storage<_Ty, _Traits, size_type, _Alnode_t, _Storage, _Stats, _Index, _Budget> _Mystorage;
     };
 
-    template <class _Ty>
-    void swap(safe_list<_Ty>& _Left, safe_list<_Ty>& _Right) noexcept {
+    template <class _Ty, size_t _Capacity = 8, class _Alloc = safe_allocator<_Ty>>
+    using safe_small_list = safe_list<_Ty, _Alloc, safe_list_inline_storage<_Capacity>>; // short lists never allocate
+
+    template <class _Ty, class _Alloc, class _Storage>
+    void swap(safe_list<_Ty, _Alloc, _Storage>& _Left, safe_list<_Ty, _Alloc, _Storage>& _Right) noexcept {
         _Left.swap(_Right);
     }
 
-    template <class _Ty>
-    typename safe_list<_Ty>::size_type erase(safe_list<_Ty>& _List, const _Ty& _Value) noexcept {
+    template <class _Ty, class _Alloc, class _Storage>
+    typename safe_list<_Ty, _Alloc, _Storage>::size_type erase(
+        safe_list<_Ty, _Alloc, _Storage>& _List, const _Ty& _Value) noexcept {
         return _List.remove(_Value);
     }
 
-    template <class _Ty, class _Pr>
-    typename safe_list<_Ty>::size_type erase(
-        safe_list<_Ty>& _List, _Pr _Pred) noexcept(::std::is_nothrow_invocable_v<_Pr, const _Ty&>) {
+    template <class _Ty, class _Alloc, class _Storage, class _Pr>
+    typename safe_list<_Ty, _Alloc, _Storage>::size_type erase(safe_list<_Ty, _Alloc, _Storage>& _List,
+        _Pr _Pred) noexcept(::std::is_nothrow_invocable_v<_Pr, const _Ty&>) {
         return _List.remove_if(_Pred);
     }
 } // namespace mjx
@@ -0,0 +1,233 @@
+// safe_list_epoch.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SAFE_LIST_EPOCH_HPP_
+#define _SAFE_LIST_EPOCH_HPP_
+#include <atomic>
+#include <cstddef>
+
+namespace mjx {
+    // Note: Epoch-based reclamation for the concurrent containers. A thread pins the current epoch
+    //       for the duration of an operation (safe_list_epoch_guard), which costs a single store on entry
+    //       and on exit. Retired nodes are tagged with the epoch they were retired in, a node retired
+    //       in epoch E can be freed once the global epoch reached E + 2, since every thread pinned
+    //       at that point started after the node had become unreachable.
+    //       The epoch only advances when every pinned thread has observed it, so a thread that stays
+    //       pinned forever delays (but never breaks) the reclamation.
+    class _Safe_list_epoch_domain { // process-wide epoch state shared by all concurrent containers
+    public:
+        static constexpr size_t _Record_count = 128; // threads that can pin at the same time without sharing
+
+        struct alignas(64) _Record { // per-thread announcement
+            ::std::atomic<size_t> _Epoch{0}; // the pinned epoch, zero if the thread is not pinned
+            ::std::atomic<bool> _Used{false}; // set while the record belongs to a thread
+        };
+
+        static _Safe_list_epoch_domain& _Instance() noexcept {
+            static _Safe_list_epoch_domain _Domain;
+            return _Domain;
+        }
+
+        size_t _Current() const noexcept {
+            return _Epoch.load(::std::memory_order_seq_cst);
+        }
+
+        void _Pin() noexcept {
+            _Thread_state& _State = _Get_thread_state();
+            if (_State._Depth++ > 0) { // already pinned by an outer operation
+                return;
+            }
+
+            if (!_State._Rec) { // first operation of this thread, try to claim a record
+                _State._Rec = _Claim_record();
+            }
+
+            if (!_State._Rec) { // all records are taken, pin through the shared counter instead
+                _Unregistered.fetch_add(1, ::std::memory_order_seq_cst);
+                return;
+            }
+
+            size_t _Pinned = _Epoch.load(::std::memory_order_seq_cst);
+            for (;;) { // the announced epoch must still be current after the store
+                _State._Rec->_Epoch.store(_Pinned, ::std::memory_order_seq_cst);
+                const size_t _Now = _Epoch.load(::std::memory_order_seq_cst);
+                if (_Now == _Pinned) {
+                    break;
+                }
+
+                _Pinned = _Now;
+            }
+        }
+
+        void _Unpin() noexcept {
+            _Thread_state& _State = _Get_thread_state();
+            if (--_State._Depth > 0) { // an outer operation is still running
+                return;
+            }
+
+            if (_State._Rec) {
+                _State._Rec->_Epoch.store(0, ::std::memory_order_release);
+            } else {
+                _Unregistered.fetch_sub(1, ::std::memory_order_release);
+            }
+        }
+
+        bool _Try_advance() noexcept {
+            // Note: Advances the global epoch if every pinned thread announced the current one.
+            size_t _Now = _Epoch.load(::std::memory_order_seq_cst);
+            if (_Unregistered.load(::std::memory_order_seq_cst) != 0) { // unknown epochs in use
+                return false;
+            }
+
+            for (const _Record& _Rec : _Records) {
+                const size_t _Pinned = _Rec._Epoch.load(::std::memory_order_seq_cst);
+                if (_Pinned != 0 && _Pinned != _Now) { // a thread lags behind
+                    return false;
+                }
+            }
+
+            return _Epoch.compare_exchange_strong(_Now, _Now + 1, ::std::memory_order_seq_cst);
+        }
+
+    private:
+        struct _Thread_state { // the record of the calling thread and its pin depth
+            _Record* _Rec = nullptr;
+            size_t _Depth = 0;
+
+            ~_Thread_state() noexcept {
+                if (_Rec) { // the thread exits, give the record back
+                    _Rec->_Used.store(false, ::std::memory_order_release);
+                }
+            }
+        };
+
+        _Safe_list_epoch_domain() noexcept : _Epoch(1), _Unregistered(0), _Records() {}
+
+        static _Thread_state& _Get_thread_state() noexcept {
+            static thread_local _Thread_state _State;
+            return _State;
+        }
+
+        _Record* _Claim_record() noexcept {
+            for (_Record& _Rec : _Records) {
+                bool _Expected = false;
+                if (!_Rec._Used.load(::std::memory_order_relaxed)
+                    && _Rec._Used.compare_exchange_strong(_Expected, true, ::std::memory_order_acquire)) {
+                    return &_Rec;
+                }
+            }
+
+            return nullptr;
+        }
+
+        alignas(64) ::std::atomic<size_t> _Epoch; // the global epoch, starts at 1
+        ::std::atomic<size_t> _Unregistered; // pinned threads without a record
+        _Record _Records[_Record_count];
+    };
+
+    class safe_list_epoch_guard { // pins the current epoch for the lifetime of the guard
+    public:
+        safe_list_epoch_guard() noexcept {
+            _Safe_list_epoch_domain::_Instance()._Pin();
+        }
+
+        ~safe_list_epoch_guard() noexcept {
+            _Safe_list_epoch_domain::_Instance()._Unpin();
+        }
+
+        safe_list_epoch_guard(const safe_list_epoch_guard&)            = delete;
+        safe_list_epoch_guard& operator=(const safe_list_epoch_guard&) = delete;
+    };
+
+    struct _Safe_list_retired_link { // intrusive link of a retired node
+        _Safe_list_retired_link* _Retired_next = nullptr; // pointer to the next retired node
+        size_t _Retired_epoch                  = 0; // epoch in which the node was retired
+    };
+
+    template <class _Node>
+    class _Safe_list_retire_list { // retired nodes of one container, freed in batches
+    public:
+        static constexpr size_t _Batch_size = 64; // retired nodes that trigger a reclamation attempt
+
+        _Safe_list_retire_list() noexcept : _Head(nullptr), _Count(0) {}
+
+        _Safe_list_retire_list(const _Safe_list_retire_list&)            = delete;
+        _Safe_list_retire_list& operator=(const _Safe_list_retire_list&) = delete;
+
+        bool _Retire(_Node* const _Ptr) noexcept {
+            // Note: _Ptr must already be unreachable, returns true if a batch is ready to be reclaimed.
+            _Ptr->_Retired_epoch = _Safe_list_epoch_domain::_Instance()._Current();
+            _Ptr->_Retired_next  = _Head.load(::std::memory_order_relaxed);
+            while (!_Head.compare_exchange_weak(
+                _Ptr->_Retired_next, _Ptr, ::std::memory_order_release, ::std::memory_order_relaxed)) {}
+            return _Count.fetch_add(1, ::std::memory_order_relaxed) + 1 >= _Batch_size;
+        }
+
+        size_t _Size() const noexcept {
+            return _Count.load(::std::memory_order_relaxed);
+        }
+
+        template <class _Fn>
+        size_t _Reclaim(_Fn _Free_node) noexcept {
+            // Note: Frees every node that no pinned thread can reach, keeps the others for later.
+            //       The calling thread must not be pinned, otherwise the epoch cannot advance past it.
+            _Safe_list_epoch_domain& _Domain = _Safe_list_epoch_domain::_Instance();
+            (void) _Domain._Try_advance();
+            (void) _Domain._Try_advance();
+            _Safe_list_retired_link* _Link = _Head.exchange(nullptr, ::std::memory_order_acquire);
+            if (!_Link) { // nothing to free or taken by another thread
+                return 0;
+            }
+
+            const size_t _Safe_epoch       = _Domain._Current();
+            _Safe_list_retired_link* _Keep = nullptr;
+            _Safe_list_retired_link* _Last = nullptr;
+            size_t _Freed                  = 0;
+            _Safe_list_retired_link* _Next;
+            for (; _Link != nullptr; _Link = _Next) {
+                _Next = _Link->_Retired_next;
+                if (_Link->_Retired_epoch + 2 <= _Safe_epoch) { // unreachable for every pinned thread
+                    _Free_node(static_cast<_Node*>(_Link));
+                    ++_Freed;
+                } else { // still in use, keep it
+                    _Link->_Retired_next = _Keep;
+                    _Keep                = _Link;
+                    if (!_Last) {
+                        _Last = _Link;
+                    }
+                }
+            }
+
+            if (_Keep) { // put the remaining nodes back
+                _Last->_Retired_next = _Head.load(::std::memory_order_relaxed);
+                while (!_Head.compare_exchange_weak(
+                    _Last->_Retired_next, _Keep, ::std::memory_order_release, ::std::memory_order_relaxed)) {}
+            }
+
+            _Count.fetch_sub(_Freed, ::std::memory_order_relaxed);
+            return _Freed;
+        }
+
+        template <class _Fn>
+        void _Free_all(_Fn _Free_node) noexcept {
+            // Note: No other thread may use the nodes anymore.
+            _Safe_list_retired_link* _Next;
+            for (_Safe_list_retired_link* _Link = _Head.exchange(nullptr, ::std::memory_order_acquire);
+                 _Link != nullptr; _Link = _Next) {
+                _Next = _Link->_Retired_next;
+                _Free_node(static_cast<_Node*>(_Link));
+            }
+
+            _Count.store(0, ::std::memory_order_relaxed);
+        }
+
+    private:
+        ::std::atomic<_Safe_list_retired_link*> _Head; // the most recently retired node
+        ::std::atomic<size_t> _Count; // number of retired nodes
+    };
+} // namespace mjx
+
+#endif // _SAFE_LIST_EPOCH_HPP_
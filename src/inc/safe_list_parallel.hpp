@@ -0,0 +1,212 @@
+// safe_list_parallel.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SAFE_LIST_PARALLEL_HPP_
+#define _SAFE_LIST_PARALLEL_HPP_
+#include <thread>
+#include <safe_list.hpp>
+
+namespace mjx {
+    inline constexpr size_t _Safe_list_max_chunks    = 64; // upper bound for the number of threads
+    inline constexpr size_t _Safe_list_min_chunk_size = 4096; // smaller chunks are not worth a thread
+
+    // Note: The list is split into chunks by a single linear pass that records the first node of each chunk.
+    //       Every chunk is processed by its own thread, the calling thread takes the first one.
+    //       The chunk boundaries are kept on the stack, the list itself never allocates. If a thread
+    //       cannot be started, its chunk is processed by the calling thread instead.
+    //       The callbacks must not throw and must not modify the list, they run concurrently.
+    struct _Safe_list_parallel_access { // the parallel algorithms work on the nodes directly
+        template <class _List>
+        static auto& _Storage(_List& _Target) noexcept {
+            return _Target._Mystorage;
+        }
+
+        template <class _List, class _Node>
+        static void _Free_node(_List& _Target, _Node* const _Ptr) noexcept {
+            _Target._Free_node(_Ptr);
+        }
+    };
+
+    inline size_t _Safe_list_chunk_count(const size_t _Size, size_t _Threads) noexcept {
+        if (_Threads == 0) { // use every hardware thread
+            _Threads = ::std::thread::hardware_concurrency();
+        }
+
+        const size_t _Max_chunks = (_Size + _Safe_list_min_chunk_size - 1) / _Safe_list_min_chunk_size;
+        if (_Threads > _Max_chunks) {
+            _Threads = _Max_chunks;
+        }
+
+        if (_Threads > _Safe_list_max_chunks) {
+            _Threads = _Safe_list_max_chunks;
+        }
+
+        return _Threads > 0 ? _Threads : 1;
+    }
+
+    template <class _Node>
+    size_t _Safe_list_partition(_Node* _Head, const size_t _Size, const size_t _Threads,
+        _Node* (&_Firsts)[_Safe_list_max_chunks + 1]) noexcept {
+        // Note: Chunk _Idx covers the nodes in [_Firsts[_Idx], _Firsts[_Idx + 1]), the last bound is a null-pointer.
+        const size_t _Chunks     = _Safe_list_chunk_count(_Size, _Threads);
+        const size_t _Chunk_size = _Size / _Chunks;
+        const size_t _Remainder  = _Size % _Chunks; // the first chunks get one more node
+        for (size_t _Idx = 0; _Idx < _Chunks; ++_Idx) {
+            _Firsts[_Idx]       = _Head;
+            const size_t _Count = _Chunk_size + (_Idx < _Remainder ? 1 : 0);
+            for (size_t _Step = 0; _Step < _Count; ++_Step) {
+                _Head = _Head->_Next;
+            }
+        }
+
+        _Firsts[_Chunks] = nullptr;
+        return _Chunks;
+    }
+
+    template <class _Fn>
+    void _Safe_list_run_chunks(const size_t _Chunks, _Fn& _Func) noexcept {
+        ::std::thread _Workers[_Safe_list_max_chunks];
+        for (size_t _Idx = 1; _Idx < _Chunks; ++_Idx) {
+            try {
+                _Workers[_Idx] = ::std::thread([&_Func, _Idx]() noexcept { _Func(_Idx); });
+            } catch (...) { // the thread could not be started, process the chunk here
+                _Func(_Idx);
+            }
+        }
+
+        _Func(size_t{0});
+        for (size_t _Idx = 1; _Idx < _Chunks; ++_Idx) {
+            if (_Workers[_Idx].joinable()) {
+                _Workers[_Idx].join();
+            }
+        }
+    }
+
+    template <class _Ty, class _Alloc, class _Storage, class _Fn>
+    void parallel_for_each(safe_list<_Ty, _Alloc, _Storage>& _List, _Fn _Func, const size_t _Threads = 0) noexcept {
+        // Note: Calls _Func for every element, _Func may modify the element it is given.
+        static_assert(::std::is_nothrow_invocable_v<_Fn&, _Ty&>, "Fn must not throw.");
+        auto& _Mystorage = _Safe_list_parallel_access::_Storage(_List);
+        using _Node_t    = ::std::remove_pointer_t<decltype(_Mystorage._Head)>;
+        _Node_t* _Firsts[_Safe_list_max_chunks + 1];
+        const size_t _Chunks = _Safe_list_partition(_Mystorage._Head, _Mystorage._Size, _Threads, _Firsts);
+        auto _Process        = [&](const size_t _Idx) noexcept {
+            for (_Node_t* _Node = _Firsts[_Idx]; _Node != _Firsts[_Idx + 1]; _Node = _Node->_Next) {
+                _Func(_Node->_Value);
+            }
+        };
+        _Safe_list_run_chunks(_Chunks, _Process);
+    }
+
+    template <class _Ty, class _Alloc, class _Storage, class _Pr>
+    size_t parallel_count_if(
+        const safe_list<_Ty, _Alloc, _Storage>& _List, _Pr _Pred, const size_t _Threads = 0) noexcept {
+        static_assert(::std::is_nothrow_invocable_v<_Pr&, const _Ty&>, "Pr must not throw.");
+        const auto& _Mystorage = _Safe_list_parallel_access::_Storage(_List);
+        using _Node_t          = ::std::remove_pointer_t<decltype(_Mystorage._Head)>;
+        _Node_t* _Firsts[_Safe_list_max_chunks + 1];
+        size_t _Counts[_Safe_list_max_chunks];
+        const size_t _Chunks = _Safe_list_partition(_Mystorage._Head, _Mystorage._Size, _Threads, _Firsts);
+        auto _Process        = [&](const size_t _Idx) noexcept {
+            size_t _Count = 0; // keep the counter local, the array slots share cache lines
+            for (const _Node_t* _Node = _Firsts[_Idx]; _Node != _Firsts[_Idx + 1]; _Node = _Node->_Next) {
+                if (_Pred(static_cast<const _Ty&>(_Node->_Value))) {
+                    ++_Count;
+                }
+            }
+
+            _Counts[_Idx] = _Count;
+        };
+        _Safe_list_run_chunks(_Chunks, _Process);
+        size_t _Total = 0;
+        for (size_t _Idx = 0; _Idx < _Chunks; ++_Idx) {
+            _Total += _Counts[_Idx];
+        }
+
+        return _Total;
+    }
+
+    template <class _Ty, class _Alloc, class _Storage, class _Pr>
+    size_t parallel_remove_if(
+        safe_list<_Ty, _Alloc, _Storage>& _List, _Pr _Pred, const size_t _Threads = 0) noexcept {
+        // Note: Every thread relinks only the nodes of its own chunk into a chain of kept nodes
+        //       and a chain of removed nodes. The kept chains are joined and the removed nodes
+        //       are freed by the calling thread afterwards, since the node pool is not thread-safe.
+        static_assert(::std::is_nothrow_invocable_v<_Pr&, const _Ty&>, "Pr must not throw.");
+        auto& _Mystorage = _Safe_list_parallel_access::_Storage(_List);
+        using _Node_t    = ::std::remove_pointer_t<decltype(_Mystorage._Head)>;
+        struct _Chunk_result {
+            _Node_t* _First; // the first kept node
+            _Node_t* _Last; // the last kept node
+            _Node_t* _Removed; // the removed nodes, linked through _Next
+            size_t _Count; // number of removed nodes
+        };
+
+        _Node_t* _Firsts[_Safe_list_max_chunks + 1];
+        _Chunk_result _Results[_Safe_list_max_chunks];
+        const size_t _Chunks = _Safe_list_partition(_Mystorage._Head, _Mystorage._Size, _Threads, _Firsts);
+        auto _Process        = [&](const size_t _Idx) noexcept {
+            _Chunk_result _Result = {nullptr, nullptr, nullptr, 0};
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Firsts[_Idx]; _Node != _Firsts[_Idx + 1]; _Node = _Next) {
+                _Next = _Node->_Next;
+                if (_Pred(static_cast<const _Ty&>(_Node->_Value))) { // move the node to the removed chain
+                    _Node->_Next     = _Result._Removed;
+                    _Result._Removed = _Node;
+                    ++_Result._Count;
+                } else if (_Result._Last) { // append the node to the kept chain
+                    _Node->_Prev         = _Result._Last;
+                    _Result._Last->_Next = _Node;
+                    _Result._Last        = _Node;
+                } else { // the first kept node
+                    _Node->_Prev   = nullptr;
+                    _Result._First = _Node;
+                    _Result._Last  = _Node;
+                }
+            }
+
+            _Results[_Idx] = _Result;
+        };
+        _Safe_list_run_chunks(_Chunks, _Process);
+
+        _Node_t* _Head  = nullptr;
+        _Node_t* _Tail  = nullptr;
+        size_t _Removed = 0;
+        for (size_t _Idx = 0; _Idx < _Chunks; ++_Idx) { // join the kept chains, free the removed nodes
+            const _Chunk_result& _Result = _Results[_Idx];
+            if (_Result._First) {
+                if (_Tail) {
+                    _Tail->_Next          = _Result._First;
+                    _Result._First->_Prev = _Tail;
+                } else {
+                    _Head = _Result._First;
+                }
+
+                _Tail = _Result._Last;
+            }
+
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Result._Removed; _Node != nullptr; _Node = _Next) {
+                _Next = _Node->_Next;
+                _Safe_list_parallel_access::_Free_node(_List, _Node);
+            }
+
+            _Removed += _Result._Count;
+        }
+
+        if (_Tail) {
+            _Tail->_Next = nullptr;
+        }
+
+        _Mystorage._Invalidate_index();
+        _Mystorage._Head = _Head;
+        _Mystorage._Tail = _Tail;
+        _Mystorage._Size -= _Removed;
+        return _Removed;
+    }
+} // namespace mjx
+
+#endif // _SAFE_LIST_PARALLEL_HPP_
@@ -0,0 +1,219 @@
+// safe_list_snapshot.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SAFE_LIST_SNAPSHOT_HPP_
+#define _SAFE_LIST_SNAPSHOT_HPP_
+#include <safe_list.hpp>
+
+namespace mjx {
+    template <class _Ty, class _Alloc>
+    class safe_list_snapshot : private _Safe_list_alloc_holder<_Alloc> { // read-only contiguous copy of a list
+    private:
+        using _Traits  = _Safe_list_traits<_Ty>;
+        using _Mybase  = _Safe_list_alloc_holder<_Alloc>;
+
+        static_assert(::std::is_same_v<typename _Alloc::value_type, _Ty>, "Alloc::value_type must be T.");
+        static_assert(_Is_nothrow_allocator<_Alloc>, "Alloc must not throw, allocate() returns a null-pointer.");
+
+    public:
+        using value_type             = _Ty;
+        using allocator_type         = _Alloc;
+        using size_type              = size_t;
+        using difference_type        = ptrdiff_t;
+        using pointer                = const _Ty*;
+        using const_pointer          = const _Ty*;
+        using reference              = const _Ty&;
+        using const_reference        = const _Ty&;
+        using iterator               = const _Ty*;
+        using const_iterator         = const _Ty*;
+        using reverse_iterator       = ::std::reverse_iterator<const _Ty*>;
+        using const_reverse_iterator = ::std::reverse_iterator<const _Ty*>;
+
+        // Note: A snapshot is filled by safe_list<T, Alloc, Policy>::freeze(), which moves the elements
+        //       into a single array and frees the nodes, and turned back into a list by thaw().
+        //       The elements cannot be modified, iterators are plain pointers. A snapshot is only moved,
+        //       never copied, so it cannot fail to allocate after it has been frozen.
+
+        safe_list_snapshot() noexcept : _Mybase(), _Data(nullptr), _Size(0) {}
+
+        explicit safe_list_snapshot(const allocator_type& _Al) noexcept : _Mybase(_Al), _Data(nullptr), _Size(0) {}
+
+        safe_list_snapshot(safe_list_snapshot&& _Other) noexcept
+            : _Mybase(_Other._Get_allocator()), _Data(_Other._Data), _Size(_Other._Size) {
+            _Other._Data = nullptr;
+            _Other._Size = 0;
+        }
+
+        ~safe_list_snapshot() noexcept {
+            _Release();
+        }
+
+        safe_list_snapshot& operator=(safe_list_snapshot&& _Other) noexcept {
+            if (this != ::std::addressof(_Other)) {
+                swap(_Other);
+            }
+
+            return *this;
+        }
+
+        safe_list_snapshot(const safe_list_snapshot&)            = delete;
+        safe_list_snapshot& operator=(const safe_list_snapshot&) = delete;
+
+        allocator_type get_allocator() const noexcept {
+            return this->_Get_allocator();
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return _Size == 0;
+        }
+
+        size_type size() const noexcept {
+            return _Size;
+        }
+
+        const_pointer data() const noexcept {
+            return _Data;
+        }
+
+        const_iterator begin() const noexcept {
+            return _Data;
+        }
+
+        const_iterator cbegin() const noexcept {
+            return _Data;
+        }
+
+        const_iterator end() const noexcept {
+            return _Data + _Size;
+        }
+
+        const_iterator cend() const noexcept {
+            return _Data + _Size;
+        }
+
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator{end()};
+        }
+
+        const_reverse_iterator crbegin() const noexcept {
+            return const_reverse_iterator{end()};
+        }
+
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator{begin()};
+        }
+
+        const_reverse_iterator crend() const noexcept {
+            return const_reverse_iterator{begin()};
+        }
+
+        const_pointer front() const noexcept {
+            return _Size > 0 ? _Data : nullptr;
+        }
+
+        const_pointer back() const noexcept {
+            return _Size > 0 ? _Data + (_Size - 1) : nullptr;
+        }
+
+        const_pointer at_index(const size_type _Pos) const noexcept {
+            return _Pos < _Size ? _Data + _Pos : nullptr;
+        }
+
+        const_iterator find(const value_type& _Value) const noexcept {
+            // Note: Integers, enumerations and pointers are compared in SIMD blocks, as in safe_unrolled_list.
+            return _Data + _Safe_list_find_in_run<_Traits>(_Data, _Size, _Value);
+        }
+
+        size_type count(const value_type& _Value) const noexcept {
+            return _Safe_list_count_in_run<_Traits>(_Data, _Size, _Value);
+        }
+
+        [[nodiscard]] bool contains(const value_type& _Value) const noexcept {
+            return find(_Value) != end();
+        }
+
+        template <class _Pr>
+        size_type count_if(_Pr _Pred) const noexcept(::std::is_nothrow_invocable_v<_Pr&, const _Ty&>) {
+            size_type _Count = 0;
+            for (size_type _Idx = 0; _Idx < _Size; ++_Idx) {
+                if (_Pred(_Data[_Idx])) {
+                    ++_Count;
+                }
+            }
+
+            return _Count;
+        }
+
+        template <class _Fn>
+        void for_each(_Fn _Func) const noexcept(::std::is_nothrow_invocable_v<_Fn&, const _Ty&>) {
+            for (size_type _Idx = 0; _Idx < _Size; ++_Idx) {
+                _Func(_Data[_Idx]);
+            }
+        }
+
+        void clear() noexcept {
+            _Release();
+        }
+
+        void swap(safe_list_snapshot& _Other) noexcept {
+            using ::std::swap; // enable ADL for allocators
+            swap(this->_Get_allocator(), _Other._Get_allocator());
+            swap(_Data, _Other._Data);
+            swap(_Size, _Other._Size);
+        }
+
+        template <class _List>
+        bool _Take(_List& _Source) noexcept {
+            // Note: Used by safe_list<T, Alloc, Policy>::freeze(). The elements of _Source are moved
+            //       into a new array before the current one is released, so nothing changes if it fails.
+            static_assert(_Traits::_Is_nothrow_move_constructible, "T must be nothrow move constructible.");
+            const size_type _Count = _Source.size();
+            _Ty* _New_data         = nullptr;
+            if (_Count > 0) {
+                _New_data = this->_Get_allocator().allocate(_Count);
+                if (!_New_data) { // allocation failed
+                    return false;
+                }
+
+                _Ty* _Out = _New_data;
+                for (_Ty& _Value : _Source) {
+                    ::new (static_cast<void*>(_Out++)) _Ty(::std::move(_Value));
+                }
+            }
+
+            _Release();
+            _Data = _New_data;
+            _Size = _Count;
+            _Source.clear();
+            return true;
+        }
+
+    private:
+        void _Release() noexcept {
+            if (_Data) {
+                if constexpr (!::std::is_trivially_destructible_v<_Ty>) {
+                    for (size_type _Idx = 0; _Idx < _Size; ++_Idx) {
+                        _Data[_Idx].~_Ty();
+                    }
+                }
+
+                this->_Get_allocator().deallocate(_Data, _Size);
+                _Data = nullptr;
+                _Size = 0;
+            }
+        }
+
+        _Ty* _Data; // pointer to the first element, a null-pointer if empty
+        size_type _Size; // number of elements
+    };
+
+    template <class _Ty, class _Alloc>
+    void swap(safe_list_snapshot<_Ty, _Alloc>& _Left, safe_list_snapshot<_Ty, _Alloc>& _Right) noexcept {
+        _Left.swap(_Right);
+    }
+} // namespace mjx
+
+#endif // _SAFE_LIST_SNAPSHOT_HPP_
@@ -0,0 +1,107 @@
+// safe_list_view.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SAFE_LIST_VIEW_HPP_
+#define _SAFE_LIST_VIEW_HPP_
+#include <safe_list.hpp>
+
+namespace mjx {
+    template <class _Ty>
+    class safe_list_view { // read-only view of a list serialized by safe_list<T>::serialize_to()
+    private:
+        using _Image_t = _Safe_list_image<_Ty>;
+
+    public:
+        using value_type             = _Ty;
+        using size_type              = size_t;
+        using difference_type        = ptrdiff_t;
+        using pointer                = const _Ty*;
+        using const_pointer          = const _Ty*;
+        using reference              = const _Ty&;
+        using const_reference        = const _Ty&;
+        using iterator               = const _Ty*;
+        using const_iterator         = const _Ty*;
+        using reverse_iterator       = ::std::reverse_iterator<const _Ty*>;
+        using const_reverse_iterator = ::std::reverse_iterator<const _Ty*>;
+
+        // Note: The view iterates the elements of an image in place, no node is built and nothing
+        //       is copied, so a memory-mapped file can be used as soon as it is mapped. The image is
+        //       validated once, by the constructor. A malformed, truncated or misaligned image
+        //       gives an empty view whose valid() returns false. The view does not own the memory.
+
+        safe_list_view() noexcept : _First(nullptr), _Size(0) {}
+
+        safe_list_view(const void* const _Data, const size_type _Data_size) noexcept : _First(nullptr), _Size(0) {
+            _First = _Image_t::_Elements(_Data, _Data_size, _Size); // _Size is written only if the image is valid
+        }
+
+        bool valid() const noexcept {
+            return _First != nullptr;
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return _Size == 0;
+        }
+
+        size_type size() const noexcept {
+            return _Size;
+        }
+
+        const_pointer data() const noexcept {
+            return _First;
+        }
+
+        const_iterator begin() const noexcept {
+            return _First;
+        }
+
+        const_iterator cbegin() const noexcept {
+            return _First;
+        }
+
+        const_iterator end() const noexcept {
+            return _First + _Size;
+        }
+
+        const_iterator cend() const noexcept {
+            return _First + _Size;
+        }
+
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator{end()};
+        }
+
+        const_reverse_iterator crbegin() const noexcept {
+            return const_reverse_iterator{end()};
+        }
+
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator{begin()};
+        }
+
+        const_reverse_iterator crend() const noexcept {
+            return const_reverse_iterator{begin()};
+        }
+
+        const_pointer front() const noexcept {
+            return _Size > 0 ? _First : nullptr;
+        }
+
+        const_pointer back() const noexcept {
+            return _Size > 0 ? _First + (_Size - 1) : nullptr;
+        }
+
+        const_pointer at_index(const size_type _Pos) const noexcept {
+            return _Pos < _Size ? _First + _Pos : nullptr;
+        }
+
+    private:
+        const _Ty* _First; // pointer to the first element, a null-pointer if the view is not valid
+        size_type _Size; // number of elements
+    };
+} // namespace mjx
+
+#endif // _SAFE_LIST_VIEW_HPP_
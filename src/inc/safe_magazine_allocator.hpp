@@ -0,0 +1,285 @@
+// safe_magazine_allocator.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SAFE_MAGAZINE_ALLOCATOR_HPP_
+#define _SAFE_MAGAZINE_ALLOCATOR_HPP_
+#include <atomic>
+#include <thread>
+#include <safe_list.hpp>
+
+namespace mjx {
+    inline constexpr size_t _Safe_magazine_capacity    = 32; // blocks per magazine
+    inline constexpr size_t _Safe_magazine_depot_bytes = size_t{4} << 20; // free memory a depot keeps
+
+    struct _Safe_magazine_block { // a free block, linked into a magazine
+        _Safe_magazine_block* _Next; // pointer to the next block of the same magazine
+        _Safe_magazine_block* _Next_magazine; // pointer to the next magazine (the first block only)
+        size_t _Count; // number of blocks in the magazine (the first block only)
+    };
+
+    // Note: Every size class has a process-wide depot of full magazines and a cache in every thread
+    //       that holds two magazines, the loaded one and the previous one (Bonwick's magazine layer).
+    //       A thread allocates from and frees into its loaded magazine, it swaps the two magazines
+    //       when the loaded one runs empty or full and only goes to the depot when both are.
+    //       A whole magazine changes hands at once, so a thread that only frees (the consumer of a queue)
+    //       hands its blocks to the thread that only allocates (the producer) in batches, and the depot
+    //       lock is taken once per _Safe_magazine_capacity operations instead of on every one.
+    //       The depot and the caches are trivially destructible, a cache stays usable while its thread
+    //       runs the destructors of other thread-local objects. It is flushed to the depot when the thread
+    //       exits, after that the thread allocates and frees through the depot.
+    template <size_t _Size, size_t _Align>
+    class _Safe_magazine_class { // the depot and the thread caches of one size class
+    public:
+        static constexpr size_t _Block_size  = _Size > sizeof(_Safe_magazine_block) ? _Size
+                                                                                    : sizeof(_Safe_magazine_block);
+        static constexpr size_t _Block_align = _Align > alignof(_Safe_magazine_block) ? _Align
+                                                                                      : alignof(_Safe_magazine_block);
+        static constexpr size_t _Depot_limit = // magazines the depot keeps before it frees the returned ones
+            _Safe_magazine_depot_bytes / (_Block_size * _Safe_magazine_capacity) > 0
+                ? _Safe_magazine_depot_bytes / (_Block_size * _Safe_magazine_capacity) : 1;
+
+        static void* _Allocate() noexcept {
+            _Thread_cache& _Cache = _Get_cache();
+            if (_Cache._Exited) { // the cache was flushed, nothing may be cached anymore
+                return _Raw_allocate();
+            }
+
+            if (_Cache._Loaded_size == 0) { // refill the loaded magazine
+                if (_Cache._Previous_size > 0) { // the previous magazine holds blocks
+                    _Swap_magazines(_Cache);
+                } else {
+                    _Safe_magazine_block* const _Magazine = _Pop_magazine();
+                    if (!_Magazine) { // the depot is empty, allocate a new block
+                        return _Raw_allocate();
+                    }
+
+                    _Cache._Loaded      = _Magazine;
+                    _Cache._Loaded_size = _Magazine->_Count;
+                }
+            }
+
+            _Safe_magazine_block* const _Block = _Cache._Loaded;
+            _Cache._Loaded                     = _Block->_Next;
+            --_Cache._Loaded_size;
+            return _Block;
+        }
+
+        static void _Deallocate(void* const _Ptr) noexcept {
+            _Thread_cache& _Cache = _Get_cache();
+            if (_Cache._Exited) { // the cache was flushed, pass the block to the depot directly
+                _Push_magazine(_Make_block(_Ptr, nullptr, 1));
+                return;
+            }
+
+            if (_Cache._Loaded_size == _Safe_magazine_capacity) { // the loaded magazine is full
+                if (_Cache._Previous_size == _Safe_magazine_capacity) { // so is the previous one
+                    _Push_magazine(_Cache._Previous);
+                    _Cache._Previous      = nullptr;
+                    _Cache._Previous_size = 0;
+                }
+
+                _Swap_magazines(_Cache);
+            }
+
+            _Cache._Loaded = _Make_block(_Ptr, _Cache._Loaded, _Cache._Loaded_size + 1);
+            ++_Cache._Loaded_size;
+        }
+
+        static size_t _Cached() noexcept {
+            const _Thread_cache& _Cache = _Get_cache();
+            return _Cache._Loaded_size + _Cache._Previous_size;
+        }
+
+        static void _Flush() noexcept {
+            // Note: Returns the blocks cached by the calling thread to the depot.
+            _Thread_cache& _Cache = _Get_cache();
+            if (_Cache._Loaded) {
+                _Cache._Loaded->_Count = _Cache._Loaded_size;
+                _Push_magazine(_Cache._Loaded);
+            }
+
+            if (_Cache._Previous) {
+                _Cache._Previous->_Count = _Cache._Previous_size;
+                _Push_magazine(_Cache._Previous);
+            }
+
+            _Cache._Loaded        = nullptr;
+            _Cache._Loaded_size   = 0;
+            _Cache._Previous      = nullptr;
+            _Cache._Previous_size = 0;
+        }
+
+    private:
+        struct _Thread_cache { // the magazines of one thread, constant-initialized
+            _Safe_magazine_block* _Loaded; // the magazine blocks are taken from and freed into
+            _Safe_magazine_block* _Previous; // the magazine swapped with the loaded one
+            size_t _Loaded_size; // number of blocks in the loaded magazine
+            size_t _Previous_size; // number of blocks in the previous magazine
+            bool _Registered; // the exit guard of this thread has been constructed
+            bool _Exited; // the thread is exiting, the cache is no longer used
+        };
+
+        struct _Exit_guard { // flushes the cache when its thread exits
+            ~_Exit_guard() noexcept {
+                _Flush();
+                _Local._Exited = true;
+            }
+        };
+
+        struct _Depot { // full (and flushed partial) magazines shared by all threads
+            ::std::atomic_flag _Lock; // a spin lock, std::mutex::lock() may throw
+            _Safe_magazine_block* _Magazines; // pointer to the first magazine
+            size_t _Count; // number of magazines
+        };
+
+        static _Thread_cache& _Get_cache() noexcept {
+            if (!_Local._Registered) { // the first use on this thread, construct the exit guard
+                _Local._Registered = true;
+                (void) &_Guard;
+            }
+
+            return _Local;
+        }
+
+        static void _Swap_magazines(_Thread_cache& _Cache) noexcept {
+            ::std::swap(_Cache._Loaded, _Cache._Previous);
+            ::std::swap(_Cache._Loaded_size, _Cache._Previous_size);
+        }
+
+        static _Safe_magazine_block* _Make_block(
+            void* const _Ptr, _Safe_magazine_block* const _Next, const size_t _Count) noexcept {
+            return ::new (_Ptr) _Safe_magazine_block{_Next, nullptr, _Count};
+        }
+
+        static void _Lock_depot() noexcept {
+            while (_Mydepot._Lock.test_and_set(::std::memory_order_acquire)) {
+                ::std::this_thread::yield();
+            }
+        }
+
+        static void _Unlock_depot() noexcept {
+            _Mydepot._Lock.clear(::std::memory_order_release);
+        }
+
+        static _Safe_magazine_block* _Pop_magazine() noexcept {
+            _Lock_depot();
+            _Safe_magazine_block* const _Magazine = _Mydepot._Magazines;
+            if (_Magazine) {
+                _Mydepot._Magazines = _Magazine->_Next_magazine;
+                --_Mydepot._Count;
+            }
+
+            _Unlock_depot();
+            return _Magazine;
+        }
+
+        static void _Push_magazine(_Safe_magazine_block* const _Magazine) noexcept {
+            _Lock_depot();
+            if (_Mydepot._Count < _Depot_limit) { // keep the magazine
+                _Magazine->_Next_magazine = _Mydepot._Magazines;
+                _Mydepot._Magazines       = _Magazine;
+                ++_Mydepot._Count;
+                _Unlock_depot();
+                return;
+            }
+
+            _Unlock_depot();
+            _Safe_magazine_block* _Next;
+            for (_Safe_magazine_block* _Block = _Magazine; _Block != nullptr; _Block = _Next) { // the depot is full
+                _Next = _Block->_Next;
+                _Raw_deallocate(_Block);
+            }
+        }
+
+        static void* _Raw_allocate() noexcept {
+            if constexpr (_Block_align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) { // over-aligned class
+                return ::operator new(_Block_size, ::std::align_val_t{_Block_align}, ::std::nothrow);
+            } else {
+                return ::operator new(_Block_size, ::std::nothrow);
+            }
+        }
+
+        static void _Raw_deallocate(void* const _Ptr) noexcept {
+            if constexpr (_Block_align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) { // over-aligned class
+                ::operator delete(_Ptr, ::std::align_val_t{_Block_align}, ::std::nothrow);
+            } else {
+                ::operator delete(_Ptr, ::std::nothrow);
+            }
+        }
+
+        static inline _Depot _Mydepot = {ATOMIC_FLAG_INIT, nullptr, 0};
+        static inline thread_local _Thread_cache _Local = {nullptr, nullptr, 0, 0, false, false};
+        static inline thread_local _Exit_guard _Guard;
+    };
+
+    template <class _Ty>
+    class safe_magazine_allocator { // non-throwing allocator with per-thread node caches
+    private:
+        using _Class_t = _Safe_magazine_class<sizeof(_Ty), alignof(_Ty)>;
+
+    public:
+        using value_type      = _Ty;
+        using size_type       = size_t;
+        using difference_type = ptrdiff_t;
+
+        using propagate_on_container_copy_assignment = ::std::false_type;
+        using propagate_on_container_move_assignment = ::std::true_type;
+        using propagate_on_container_swap            = ::std::true_type;
+        using is_always_equal                        = ::std::true_type;
+
+        template <class _Other>
+        struct rebind {
+            using other = safe_magazine_allocator<_Other>;
+        };
+
+        constexpr safe_magazine_allocator() noexcept = default;
+
+        template <class _Other>
+        constexpr safe_magazine_allocator(const safe_magazine_allocator<_Other>&) noexcept {}
+
+        // Note: Single objects (the nodes of a list) go through the magazines of their size class,
+        //       a block freed by one thread can be reused by any other. Arrays are allocated
+        //       with safe_allocator<T>. A null-pointer is returned if the allocation failed.
+
+        [[nodiscard]] _Ty* allocate(const size_type _Count) noexcept {
+            if (_Count != 1) { // not a node, bypass the magazines
+                return safe_allocator<_Ty>{}.allocate(_Count);
+            }
+
+            return static_cast<_Ty*>(_Class_t::_Allocate());
+        }
+
+        void deallocate(_Ty* const _Ptr, const size_type _Count) noexcept {
+            if (_Count != 1) {
+                safe_allocator<_Ty>{}.deallocate(_Ptr, _Count);
+            } else {
+                _Class_t::_Deallocate(_Ptr);
+            }
+        }
+
+        static size_type thread_cache_size() noexcept {
+            // Note: Returns the number of free blocks cached by the calling thread for this size class.
+            return _Class_t::_Cached();
+        }
+
+        static void flush_thread_cache() noexcept {
+            // Note: Returns the calling thread's cached blocks of this size class to the shared depot.
+            _Class_t::_Flush();
+        }
+
+        template <class _Other>
+        bool operator==(const safe_magazine_allocator<_Other>&) const noexcept {
+            return true;
+        }
+
+        template <class _Other>
+        bool operator!=(const safe_magazine_allocator<_Other>&) const noexcept {
+            return false;
+        }
+    };
+} // namespace mjx
+
+#endif // _SAFE_MAGAZINE_ALLOCATOR_HPP_
@@ -0,0 +1,242 @@
+// safe_mpsc_list.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SAFE_MPSC_LIST_HPP_
+#define _SAFE_MPSC_LIST_HPP_
+#include <atomic>
+#include <safe_list.hpp>
+
+namespace mjx {
+    struct _Safe_mpsc_list_link { // link shared by the stub and the value nodes
+        ::std::atomic<_Safe_mpsc_list_link*> _Next; // pointer to the next (newer) node
+
+        _Safe_mpsc_list_link() noexcept : _Next(nullptr) {}
+    };
+
+    template <class _Ty, class _Traits>
+    class _Safe_mpsc_list_node : public _Safe_mpsc_list_link {
+    public:
+        _Ty _Value; // the stored value
+
+        template <class... _Types>
+        explicit _Safe_mpsc_list_node(::std::in_place_t, _Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>)
+            : _Safe_mpsc_list_link(), _Value(::std::forward<_Types>(_Args)...) {}
+
+        ~_Safe_mpsc_list_node() noexcept {}
+    };
+
+    template <class _Ty, class _Alloc = safe_allocator<_Ty>>
+    class safe_mpsc_list { // exception-safe multi-producer single-consumer queue
+    private:
+        using _Traits    = _Safe_list_traits<_Ty>;
+        using _Link_t    = _Safe_mpsc_list_link;
+        using _Node_t    = _Safe_mpsc_list_node<_Ty, _Traits>;
+        using _Al_traits = ::std::allocator_traits<_Alloc>;
+        using _Alnode_t  = typename _Al_traits::template rebind_alloc<_Node_t>;
+
+        static_assert(_Is_nothrow_allocator<_Alnode_t>, "Alloc must not throw, allocate() returns a null-pointer.");
+
+    public:
+        using value_type      = _Ty;
+        using allocator_type  = _Alloc;
+        using size_type       = size_t;
+        using reference       = _Ty&;
+        using const_reference = const _Ty&;
+
+        // Note: Any number of threads may call push_back() and emplace_back() at the same time,
+        //       each push is wait-free (one exchange and one store). All other member functions
+        //       belong to the single consumer and must not be called from more than one thread at a time.
+        //       The allocator is used by producers and the consumer at the same time, so it must be thread-safe.
+        //       pop_front() may return false while a producer is between its exchange and its store,
+        //       such an element becomes visible right after the store.
+
+        safe_mpsc_list() noexcept : _Mystorage() {}
+
+        explicit safe_mpsc_list(const allocator_type& _Al) noexcept : _Mystorage(_Alnode_t(_Al)) {}
+
+        safe_mpsc_list(const safe_mpsc_list&)            = delete;
+        safe_mpsc_list& operator=(const safe_mpsc_list&) = delete;
+
+        ~safe_mpsc_list() noexcept {
+            // Note: No producer may be running, the remaining elements are destroyed.
+            clear();
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(_Mystorage._Get_allocator());
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            // Note: Meaningful only for the consumer, a concurrent push may complete right after the call.
+            const _Link_t* _Head = _Mystorage._Head;
+            if (_Head == &_Mystorage._Stub) { // skip the stub
+                _Head = _Head->_Next.load(::std::memory_order_acquire);
+            }
+
+            return _Head == nullptr;
+        }
+
+        [[nodiscard]] bool push_back(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace_back(_Value);
+        }
+
+        [[nodiscard]] bool push_back(value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace_back(::std::move(_Value));
+        }
+
+        template <class... _Types>
+        [[nodiscard]] bool emplace_back(_Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            _Node_t* const _Raw = _Mystorage._Get_allocator().allocate(1);
+            if (!_Raw) { // allocation failed
+                return false;
+            }
+
+            _Push_link(::new (static_cast<void*>(_Raw)) _Node_t(::std::in_place, ::std::forward<_Types>(_Args)...));
+            return true;
+        }
+
+        [[nodiscard]] bool pop_front(value_type& _Value) noexcept(::std::is_nothrow_move_assignable_v<_Ty>) {
+            _Node_t* const _Node = _Pop_link();
+            if (!_Node) { // nothing to pop (yet)
+                return false;
+            }
+
+            _Value = ::std::move(_Node->_Value);
+            _Free_node(_Node);
+            return true;
+        }
+
+        // Note: _Pop_front_with(), _Consumer_mark() and _Pushed_since() are used by safe_async_list<T, Alloc>,
+        //       they are not a part of the public interface.
+
+        template <class _Fn>
+        bool _Pop_front_with(_Fn& _Func) noexcept(::std::is_nothrow_invocable_v<_Fn&, _Ty&&>) {
+            // Note: Passes the oldest visible element to _Func and frees its node.
+            _Node_t* const _Node = _Pop_link();
+            if (!_Node) { // nothing to pop (yet)
+                return false;
+            }
+
+            _Func(::std::move(_Node->_Value));
+            _Free_node(_Node);
+            return true;
+        }
+
+        const void* _Consumer_mark() const noexcept {
+            // Note: Identifies the consumer's position, must be taken right after a failed pop
+            //       (or by a producer while the consumer is suspended after one).
+            return _Mystorage._Head;
+        }
+
+        bool _Pushed_since(const void* const _Mark) const noexcept {
+            // Note: Reads only the producers' end, so it may be called while the consumer is resumed elsewhere.
+            //       After a failed pop, the tail equals _Mark only if no push has started since.
+            return _Mystorage._Tail.load(::std::memory_order_acquire) != _Mark;
+        }
+
+        template <class _Fn>
+        size_type drain(_Fn _Func) noexcept(::std::is_nothrow_invocable_v<_Fn&, _Ty&&>) {
+            // Note: Passes every element that is already visible to _Func and frees its node.
+            size_type _Count = 0;
+            for (_Node_t* _Node = _Pop_link(); _Node != nullptr; _Node = _Pop_link(), ++_Count) {
+                _Func(::std::move(_Node->_Value));
+                _Free_node(_Node);
+            }
+
+            return _Count;
+        }
+
+        template <class _Other_alloc, class _Storage>
+        size_type drain(safe_list<_Ty, _Other_alloc, _Storage>& _List) noexcept(
+            _Traits::_Is_nothrow_move_constructible) {
+            // Note: Moves the visible elements to the back of _List. If _List cannot allocate
+            //       a node, the remaining elements stay in the queue.
+            size_type _Count = 0;
+            for (_Node_t* _Node = _Pop_link(); _Node != nullptr; _Node = _Pop_link(), ++_Count) {
+                if (!_List.push_back(::std::move(_Node->_Value))) { // the element is not lost, put it back
+                    _Mystorage._Head = _Node;
+                    break;
+                }
+
+                _Free_node(_Node);
+            }
+
+            return _Count;
+        }
+
+        void clear() noexcept {
+            for (_Node_t* _Node = _Pop_link(); _Node != nullptr; _Node = _Pop_link()) {
+                _Free_node(_Node);
+            }
+        }
+
+    private:
+        struct _Storage_t : _Safe_list_alloc_holder<_Alnode_t> {
+            using _Mybase = _Safe_list_alloc_holder<_Alnode_t>;
+
+            // Note: The queue is intrusive (D. Vyukov's MPSC queue). Producers append at _Tail,
+            //       the consumer reads from _Head. The stub node keeps the queue non-empty,
+            //       so producers never touch _Head. _Tail is kept on its own cache line.
+            _Link_t _Stub; // placeholder node, re-queued whenever the queue runs empty
+            _Link_t* _Head; // the oldest node, owned by the consumer
+            alignas(64) ::std::atomic<_Link_t*> _Tail; // the newest node, shared by producers
+
+            _Storage_t() noexcept : _Mybase(), _Stub(), _Head(&_Stub), _Tail(&_Stub) {}
+
+            explicit _Storage_t(const _Alnode_t& _Al) noexcept : _Mybase(_Al), _Stub(), _Head(&_Stub), _Tail(&_Stub) {}
+        };
+
+        void _Push_link(_Link_t* const _Link) noexcept {
+            _Link->_Next.store(nullptr, ::std::memory_order_relaxed);
+            _Link_t* const _Prev = _Mystorage._Tail.exchange(_Link, ::std::memory_order_acq_rel);
+            _Prev->_Next.store(_Link, ::std::memory_order_release); // publish the node to the consumer
+        }
+
+        _Node_t* _Pop_link() noexcept {
+            // Note: Unlinks the oldest visible node, returns a null-pointer if there is none.
+            _Link_t* _Head = _Mystorage._Head;
+            _Link_t* _Next = _Head->_Next.load(::std::memory_order_acquire);
+            if (_Head == &_Mystorage._Stub) { // skip the stub
+                if (!_Next) { // the queue is empty
+                    return nullptr;
+                }
+
+                _Mystorage._Head = _Next;
+                _Head            = _Next;
+                _Next            = _Next->_Next.load(::std::memory_order_acquire);
+            }
+
+            if (_Next) { // _Head is not the last node
+                _Mystorage._Head = _Next;
+                return static_cast<_Node_t*>(_Head);
+            }
+
+            if (_Head != _Mystorage._Tail.load(::std::memory_order_acquire)) { // a push is in progress
+                return nullptr;
+            }
+
+            _Push_link(&_Mystorage._Stub); // _Head is the last node, re-queue the stub behind it
+            _Next = _Head->_Next.load(::std::memory_order_acquire);
+            if (_Next) { // either the stub or a node pushed meanwhile
+                _Mystorage._Head = _Next;
+                return static_cast<_Node_t*>(_Head);
+            }
+
+            return nullptr;
+        }
+
+        void _Free_node(_Node_t* const _Node) noexcept {
+            _Node->~_Node_t();
+            _Mystorage._Get_allocator().deallocate(_Node, 1);
+        }
+
+        _Storage_t _Mystorage;
+    };
+} // namespace mjx
+
+#endif // _SAFE_MPSC_LIST_HPP_
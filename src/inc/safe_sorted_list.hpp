@@ -0,0 +1,683 @@
+// safe_sorted_list.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SAFE_SORTED_LIST_HPP_
+#define _SAFE_SORTED_LIST_HPP_
+#include <cstdint>
+#include <safe_list.hpp>
+
+namespace mjx {
+    inline constexpr size_t _Safe_sorted_list_max_levels = 16; // enough for 4^16 elements
+
+    template <class _Ty, class _Traits>
+    class _Safe_sorted_list_node {
+    public:
+        _Safe_sorted_list_node* _Next; // pointer to the next node (the lowest level)
+        _Safe_sorted_list_node* _Prev; // pointer to the previous node (the lowest level)
+        size_t _Levels; // number of levels the node is linked into (at least one)
+        _Ty _Value; // the stored value
+
+        // Note: The links of the levels above the lowest one (_Levels - 1 pointers) are stored
+        //       right after the node, in the same allocation.
+
+        template <class... _Types>
+        explicit _Safe_sorted_list_node(const size_t _Count, ::std::in_place_t, _Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>)
+            : _Next(nullptr), _Prev(nullptr), _Levels(_Count), _Value(::std::forward<_Types>(_Args)...) {
+            for (size_t _Level = 1; _Level < _Count; ++_Level) {
+                ::new (static_cast<void*>(_Upper_links() + (_Level - 1))) _Safe_sorted_list_node*(nullptr);
+            }
+        }
+
+        ~_Safe_sorted_list_node() noexcept {}
+
+        _Safe_sorted_list_node(const _Safe_sorted_list_node&)            = delete;
+        _Safe_sorted_list_node& operator=(const _Safe_sorted_list_node&) = delete;
+
+        static size_t _Units(const size_t _Count) noexcept {
+            // Note: Returns the number of node-sized units that hold a node linked into _Count levels.
+            constexpr size_t _Link_size = sizeof(_Safe_sorted_list_node*);
+            constexpr size_t _Unit_size = sizeof(_Safe_sorted_list_node);
+            return 1 + ((_Count - 1) * _Link_size + _Unit_size - 1) / _Unit_size;
+        }
+
+        _Safe_sorted_list_node*& _Link(const size_t _Level) noexcept {
+            return _Level == 0 ? _Next : _Upper_links()[_Level - 1];
+        }
+
+    private:
+        _Safe_sorted_list_node** _Upper_links() noexcept {
+            // Note: sizeof(*this) is a multiple of alignof(*this), which is at least alignof(void*).
+            return ::std::launder(reinterpret_cast<_Safe_sorted_list_node**>(this + 1));
+        }
+    };
+
+    template <class _Pr, bool = ::std::is_empty_v<_Pr> && !::std::is_final_v<_Pr>>
+    class _Safe_sorted_list_compare_holder : private _Pr { // stores an empty comparator (EBO)
+    public:
+        _Safe_sorted_list_compare_holder() noexcept(::std::is_nothrow_default_constructible_v<_Pr>) : _Pr() {}
+
+        explicit _Safe_sorted_list_compare_holder(const _Pr& _Comp) noexcept(
+            ::std::is_nothrow_copy_constructible_v<_Pr>) : _Pr(_Comp) {}
+
+        const _Pr& _Get_compare() const noexcept {
+            return *this;
+        }
+    };
+
+    template <class _Pr>
+    class _Safe_sorted_list_compare_holder<_Pr, false> { // stores a stateful or final comparator
+    public:
+        _Safe_sorted_list_compare_holder() noexcept(::std::is_nothrow_default_constructible_v<_Pr>) : _Mycomp() {}
+
+        explicit _Safe_sorted_list_compare_holder(const _Pr& _Comp) noexcept(
+            ::std::is_nothrow_copy_constructible_v<_Pr>) : _Mycomp(_Comp) {}
+
+        const _Pr& _Get_compare() const noexcept {
+            return _Mycomp;
+        }
+
+    private:
+        _Pr _Mycomp;
+    };
+
+    template <class _Ty, class _Pr = ::std::less<>, class _Alloc = safe_allocator<_Ty>>
+    class safe_sorted_list : private _Safe_sorted_list_compare_holder<_Pr> { // exception-safe sorted skip list
+    private:
+        using _Traits     = _Safe_list_traits<_Ty>;
+        using _Self_t     = safe_sorted_list<_Ty, _Pr, _Alloc>;
+        using _Node_t     = _Safe_sorted_list_node<_Ty, _Traits>;
+        using _Al_traits  = ::std::allocator_traits<_Alloc>;
+        using _Alnode_t   = typename _Al_traits::template rebind_alloc<_Node_t>;
+        using _Compare_t  = _Safe_sorted_list_compare_holder<_Pr>;
+
+        static constexpr size_t _Max_levels = _Safe_sorted_list_max_levels;
+
+        static_assert(_Is_nothrow_allocator<_Alnode_t>, "Alloc must not throw, allocate() returns a null-pointer.");
+        static_assert(::std::is_nothrow_invocable_r_v<bool, const _Pr&, const _Ty&, const _Ty&>,
+            "Compare must not throw.");
+
+    public:
+        using value_type      = _Ty;
+        using value_compare   = _Pr;
+        using allocator_type  = _Alloc;
+        using size_type       = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer         = const _Ty*;
+        using const_pointer   = const _Ty*;
+        using reference       = const _Ty&;
+        using const_reference = const _Ty&;
+
+        // Note: The elements must stay sorted, so every iterator is a constant iterator.
+        using iterator               = _Safe_list_const_iterator<_Self_t, _Traits>;
+        using const_iterator         = _Safe_list_const_iterator<_Self_t, _Traits>;
+        using reverse_iterator       = _Safe_list_const_reverse_iterator<_Self_t, _Traits>;
+        using const_reverse_iterator = _Safe_list_const_reverse_iterator<_Self_t, _Traits>;
+
+        // Note: A skip list, the lowest level is a doubly-linked list of all elements and every node is
+        //       also linked into each level above with probability 1/4. The levels are chosen by a
+        //       xorshift generator kept by the list, so a list always builds the same shape for the same
+        //       sequence of insertions. insert(), find(), lower_bound() and erase() run in O(log n)
+        //       expected time. Equivalent elements keep their insertion order. Iterators stay valid until
+        //       their element is erased.
+
+        // Note: Used by the iterators, not a part of the public interface.
+        using _Node_type = _Node_t;
+
+        static reference _Value_of(_Node_t* const _Node) noexcept {
+            return _Node->_Value;
+        }
+
+        safe_sorted_list() noexcept(::std::is_nothrow_default_constructible_v<_Pr>) : _Compare_t(), _Mystorage() {}
+
+        explicit safe_sorted_list(const _Pr& _Comp, const allocator_type& _Al = allocator_type{}) noexcept(
+            ::std::is_nothrow_copy_constructible_v<_Pr>) : _Compare_t(_Comp), _Mystorage(_Alnode_t(_Al)) {}
+
+        explicit safe_sorted_list(const allocator_type& _Al) noexcept(::std::is_nothrow_default_constructible_v<_Pr>)
+            : _Compare_t(), _Mystorage(_Alnode_t(_Al)) {}
+
+        safe_sorted_list(const safe_sorted_list& _Other) noexcept(
+            _Traits::_Is_nothrow_copy_constructible && ::std::is_nothrow_copy_constructible_v<_Pr>)
+            : _Compare_t(_Other._Get_compare()),
+              _Mystorage(_Alnode_t(_Al_traits::select_on_container_copy_construction(_Other.get_allocator()))) {
+            (void) _Append_copies(_Other);
+        }
+
+        safe_sorted_list(safe_sorted_list&& _Other) noexcept(::std::is_nothrow_copy_constructible_v<_Pr>)
+            : _Compare_t(_Other._Get_compare()), _Mystorage(_Other._Mystorage._Get_allocator()) {
+            _Mystorage._Swap(_Other._Mystorage); // swap storages
+        }
+
+        safe_sorted_list(::std::initializer_list<value_type> _Init_list, const _Pr& _Comp = _Pr{},
+            const allocator_type& _Al = allocator_type{}) noexcept(_Traits::_Is_nothrow_copy_constructible
+                                                                   && ::std::is_nothrow_copy_constructible_v<_Pr>)
+            : _Compare_t(_Comp), _Mystorage(_Alnode_t(_Al)) {
+            (void) insert(_Init_list);
+        }
+
+        ~safe_sorted_list() noexcept {
+            clear();
+        }
+
+        safe_sorted_list& operator=(const safe_sorted_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            // Note: The comparator is not assigned, both lists must order their elements the same way.
+            if (this != ::std::addressof(_Other)) {
+                clear();
+                (void) _Append_copies(_Other);
+            }
+
+            return *this;
+        }
+
+        safe_sorted_list& operator=(safe_sorted_list&& _Other) noexcept {
+            if (this != ::std::addressof(_Other)) {
+                _Mystorage._Swap(_Other._Mystorage);
+            }
+
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(_Mystorage._Get_allocator());
+        }
+
+        value_compare value_comp() const noexcept(::std::is_nothrow_copy_constructible_v<_Pr>) {
+            return this->_Get_compare();
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return _Mystorage._Size == 0;
+        }
+
+        size_type size() const noexcept {
+            return _Mystorage._Size;
+        }
+
+        size_type max_size() const noexcept {
+            return static_cast<size_type>(-1) / (sizeof(_Node_t) * _Node_t::_Units(_Max_levels));
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator{_Mystorage._Heads[0]};
+        }
+
+        const_iterator cbegin() const noexcept {
+            return const_iterator{_Mystorage._Heads[0]};
+        }
+
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator{_Mystorage._Tail};
+        }
+
+        const_reverse_iterator crbegin() const noexcept {
+            return const_reverse_iterator{_Mystorage._Tail};
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator{nullptr}; // past-the-last element (null-pointer)
+        }
+
+        const_iterator cend() const noexcept {
+            return const_iterator{nullptr}; // past-the-last element (null-pointer)
+        }
+
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator{nullptr};
+        }
+
+        const_reverse_iterator crend() const noexcept {
+            return const_reverse_iterator{nullptr};
+        }
+
+        const_pointer front() const noexcept {
+            return _Mystorage._Heads[0] ? ::std::addressof(_Mystorage._Heads[0]->_Value) : nullptr;
+        }
+
+        const_pointer back() const noexcept {
+            return _Mystorage._Tail ? ::std::addressof(_Mystorage._Tail->_Value) : nullptr;
+        }
+
+        void clear() noexcept {
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Mystorage._Heads[0]; _Node != nullptr; _Node = _Next) {
+                _Next = _Node->_Next;
+                _Free_node(_Node);
+            }
+
+            _Mystorage._Reset();
+        }
+
+        iterator insert(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace(_Value);
+        }
+
+        iterator insert(value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace(::std::move(_Value));
+        }
+
+        template <class _InIt>
+        [[nodiscard]] bool insert(_InIt _First, _InIt _Last) noexcept(
+            _Traits::template _Is_nothrow_constructible<decltype(*::std::declval<_InIt>())>) {
+            // Note: All nodes are created first and linked once every allocation succeeded.
+            //       If an allocation fails, the created nodes are freed and the list is not modified.
+            static_assert(_Traits::template _Is_constructible<decltype(*::std::declval<_InIt>())>,
+                "T must be constructible from InIt's value type.");
+            _Node_t* _Chain   = nullptr; // the created nodes, linked through _Next
+            size_type _Count  = 0;
+            const size_type _Max_count = max_size() - _Mystorage._Size;
+            for (; _First != _Last; ++_First) {
+                _Node_t* const _New_node = _Count < _Max_count ? _Make_node(*_First) : nullptr;
+                if (!_New_node) { // rollback
+                    _Free_chain(_Chain);
+                    return false;
+                }
+
+                _New_node->_Next = _Chain;
+                _Chain           = _New_node;
+                ++_Count;
+            }
+
+            // Note: The chain holds the values in reverse order, linking it from the front keeps
+            //       equivalent values in their original order, since every node goes after its equals.
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Reverse_chain(_Chain); _Node != nullptr; _Node = _Next) {
+                _Next = _Node->_Next;
+                _Link_sorted(_Node);
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] bool insert(
+            ::std::initializer_list<value_type> _Init_list) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return insert(_Init_list.begin(), _Init_list.end());
+        }
+
+        template <class... _Types>
+        iterator emplace(_Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            // Note: Inserts after the equivalent elements, returns an empty iterator if the allocation failed.
+            if (_Mystorage._Size == max_size()) { // not enough space for another element
+                return iterator{};
+            }
+
+            _Node_t* const _New_node = _Make_node(::std::forward<_Types>(_Args)...);
+            if (!_New_node) { // allocation failed
+                return iterator{};
+            }
+
+            _Link_sorted(_New_node);
+            return iterator{_New_node};
+        }
+
+        iterator erase(const_iterator _Where) noexcept {
+            // Note: Returns an iterator to the element after the erased one. The predecessors are
+            //       searched only on the upper levels of the node, most nodes have none.
+            _Node_t* const _Node = const_cast<_Node_t*>(_Where._Get_node());
+            if (!_Node) { // past-the-last element, nothing to erase
+                return end();
+            }
+
+            _Node_t* const _Next = _Node->_Next;
+            _Node_t* _Preds[_Max_levels];
+            _Find_predecessors(_Node, _Preds);
+            _Unlink(_Node, _Preds);
+            return iterator{_Next};
+        }
+
+        iterator erase(const_iterator _First, const const_iterator _Last) noexcept {
+            while (_First != _Last) {
+                _First = erase(_First);
+            }
+
+            return iterator{const_cast<_Node_t*>(_Last._Get_node())};
+        }
+
+        void pop_back() noexcept {
+            if (_Mystorage._Tail) {
+                (void) erase(const_iterator{_Mystorage._Tail});
+            }
+        }
+
+        void pop_front() noexcept {
+            // Note: Every level of the first node starts at the head, no search is needed.
+            if (_Mystorage._Heads[0]) {
+                _Node_t* _Preds[_Max_levels] = {};
+                _Unlink(_Mystorage._Heads[0], _Preds);
+            }
+        }
+
+        const_iterator lower_bound(const value_type& _Value) const noexcept {
+            // Note: Returns an iterator to the first element not less than _Value.
+            return const_iterator{_Search<false>(_Value, nullptr)};
+        }
+
+        const_iterator upper_bound(const value_type& _Value) const noexcept {
+            // Note: Returns an iterator to the first element greater than _Value.
+            return const_iterator{_Search<true>(_Value, nullptr)};
+        }
+
+        ::std::pair<const_iterator, const_iterator> equal_range(const value_type& _Value) const noexcept {
+            return {lower_bound(_Value), upper_bound(_Value)};
+        }
+
+        const_iterator find(const value_type& _Value) const noexcept {
+            // Note: Returns an iterator to the first element equivalent to _Value, end() if there is none.
+            _Node_t* const _Node = _Search<false>(_Value, nullptr);
+            return const_iterator{_Node && !_Compare(_Value, _Node->_Value) ? _Node : nullptr};
+        }
+
+        [[nodiscard]] bool contains(const value_type& _Value) const noexcept {
+            return find(_Value).valid();
+        }
+
+        size_type count(const value_type& _Value) const noexcept {
+            size_type _Count = 0;
+            for (_Node_t* _Node = _Search<false>(_Value, nullptr); _Node && !_Compare(_Value, _Node->_Value);
+                 _Node          = _Node->_Next) {
+                ++_Count;
+            }
+
+            return _Count;
+        }
+
+        size_type remove(const value_type& _Value) noexcept {
+            // Note: Erases the elements equivalent to _Value in O(log n + count). _Value may refer to
+            //       one of them, so both bounds are found before anything is erased.
+            auto [_First, _Last] = equal_range(_Value);
+            size_type _Count     = 0;
+            while (_First != _Last) {
+                _First = erase(_First);
+                ++_Count;
+            }
+
+            return _Count;
+        }
+
+        template <class _Fn>
+        size_type remove_if(_Fn _Pred) noexcept(::std::is_nothrow_invocable_v<_Fn, const _Ty&>) {
+            // Note: A single pass over the lowest level, the last kept node of every level is remembered,
+            //       so each erased node is unlinked without a search.
+            _Node_t* _Last[_Max_levels] = {}; // null-pointers stand for the head
+            size_type _Count            = 0;
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Mystorage._Heads[0]; _Node != nullptr; _Node = _Next) {
+                _Next               = _Node->_Next;
+                const size_t _Levels = _Node->_Levels;
+                if (_Pred(static_cast<const _Ty&>(_Node->_Value))) { // element found, erase it
+                    for (size_t _Level = 0; _Level < _Levels; ++_Level) {
+                        _Link_after(_Last[_Level], _Level) = _Node->_Link(_Level);
+                    }
+
+                    if (_Next) {
+                        _Next->_Prev = _Last[0];
+                    } else {
+                        _Mystorage._Tail = _Last[0];
+                    }
+
+                    _Free_node(_Node);
+                    ++_Count;
+                } else {
+                    for (size_t _Level = 0; _Level < _Levels; ++_Level) {
+                        _Last[_Level] = _Node;
+                    }
+                }
+            }
+
+            _Mystorage._Size -= _Count;
+            _Mystorage._Drop_empty_levels();
+            return _Count;
+        }
+
+        void swap(safe_sorted_list& _Other) noexcept {
+            // Note: The comparators are not swapped, both lists must order their elements the same way.
+            _Mystorage._Swap(_Other._Mystorage);
+        }
+
+    private:
+        struct _Storage_t : _Safe_list_alloc_holder<_Alnode_t> {
+            using _Mybase = _Safe_list_alloc_holder<_Alnode_t>;
+
+            _Node_t* _Heads[_Max_levels]; // the first node of every level, _Heads[0] is the first node
+            _Node_t* _Tail; // pointer to the last node
+            size_type _Size; // number of elements
+            size_t _Levels; // number of levels in use (at least one)
+            uint32_t _Seed; // state of the level generator
+
+            _Storage_t() noexcept : _Mybase(), _Heads{}, _Tail(nullptr), _Size(0), _Levels(1), _Seed(0x9E3779B9u) {}
+
+            explicit _Storage_t(const _Alnode_t& _Al) noexcept
+                : _Mybase(_Al), _Heads{}, _Tail(nullptr), _Size(0), _Levels(1), _Seed(0x9E3779B9u) {}
+
+            void _Reset() noexcept {
+                for (_Node_t*& _Head : _Heads) {
+                    _Head = nullptr;
+                }
+
+                _Tail   = nullptr;
+                _Size   = 0;
+                _Levels = 1;
+            }
+
+            void _Drop_empty_levels() noexcept {
+                while (_Levels > 1 && !_Heads[_Levels - 1]) {
+                    --_Levels;
+                }
+            }
+
+            size_t _Random_levels() noexcept {
+                // Note: xorshift32, every pair of bits promotes the node with probability 1/4.
+                _Seed ^= _Seed << 13;
+                _Seed ^= _Seed >> 17;
+                _Seed ^= _Seed << 5;
+                size_t _Result = 1;
+                for (uint32_t _Bits = _Seed; _Result < _Max_levels && (_Bits & 3) == 0; _Bits >>= 2) {
+                    ++_Result;
+                }
+
+                return _Result;
+            }
+
+            void _Swap(_Storage_t& _Other) noexcept {
+                using ::std::swap; // enable ADL for allocators
+                swap(this->_Get_allocator(), _Other._Get_allocator());
+                swap(_Heads, _Other._Heads);
+                swap(_Tail, _Other._Tail);
+                swap(_Size, _Other._Size);
+                swap(_Levels, _Other._Levels);
+                swap(_Seed, _Other._Seed);
+            }
+        };
+
+        bool _Compare(const _Ty& _Left, const _Ty& _Right) const noexcept {
+            return this->_Get_compare()(_Left, _Right);
+        }
+
+        _Node_t*& _Link_after(_Node_t* const _Pred, const size_t _Level) noexcept {
+            // Note: A null _Pred stands for the head of the level.
+            return _Pred ? _Pred->_Link(_Level) : _Mystorage._Heads[_Level];
+        }
+
+        template <bool _Past_equivalent>
+        _Node_t* _Search(const _Ty& _Value, _Node_t** const _Preds) const noexcept {
+            // Note: Returns the first node not less than _Value (or greater than _Value if _Past_equivalent).
+            //       If _Preds is not a null-pointer, _Preds[_Level] receives the last node before it
+            //       on every level in use (a null-pointer for the head).
+            _Node_t* _Pred = nullptr;
+            for (size_t _Level = _Mystorage._Levels; _Level-- > 0;) {
+                _Node_t* _Next = _Pred ? _Pred->_Link(_Level) : _Mystorage._Heads[_Level];
+                while (_Next
+                       && (_Past_equivalent ? !_Compare(_Value, _Next->_Value) : _Compare(_Next->_Value, _Value))) {
+                    _Pred = _Next;
+                    _Next = _Pred->_Link(_Level);
+                }
+
+                if (_Preds) {
+                    _Preds[_Level] = _Pred;
+                }
+            }
+
+            return _Pred ? _Pred->_Next : _Mystorage._Heads[0];
+        }
+
+        void _Find_predecessors(_Node_t* const _Node, _Node_t** const _Preds) const noexcept {
+            // Note: The lowest level has a back link. On the upper levels of _Node, the search skips
+            //       the smaller elements and then walks the equivalent ones until it reaches _Node.
+            _Preds[0] = _Node->_Prev;
+            if (_Node->_Levels == 1) { // the common case, nothing to search
+                return;
+            }
+
+            _Node_t* _Pred = nullptr;
+            for (size_t _Level = _Mystorage._Levels; _Level-- > 1;) {
+                _Node_t* _Next = _Pred ? _Pred->_Link(_Level) : _Mystorage._Heads[_Level];
+                while (_Next && _Compare(_Next->_Value, _Node->_Value)) {
+                    _Pred = _Next;
+                    _Next = _Pred->_Link(_Level);
+                }
+
+                if (_Level < _Node->_Levels) { // _Node is linked into this level, find it among its equals
+                    while (_Next != _Node) {
+                        _Pred = _Next;
+                        _Next = _Pred->_Link(_Level);
+                    }
+
+                    _Preds[_Level] = _Pred;
+                }
+            }
+        }
+
+        void _Link_sorted(_Node_t* const _New_node) noexcept {
+            _Node_t* _Preds[_Max_levels];
+            (void) _Search<true>(_New_node->_Value, _Preds); // insert after the equivalent elements
+            const size_t _Levels = _New_node->_Levels;
+            for (size_t _Level = _Mystorage._Levels; _Level < _Levels; ++_Level) { // new levels start at the head
+                _Preds[_Level] = nullptr;
+            }
+
+            if (_Levels > _Mystorage._Levels) {
+                _Mystorage._Levels = _Levels;
+            }
+
+            for (size_t _Level = 0; _Level < _Levels; ++_Level) {
+                _Node_t*& _Link        = _Link_after(_Preds[_Level], _Level);
+                _New_node->_Link(_Level) = _Link;
+                _Link                  = _New_node;
+            }
+
+            _New_node->_Prev = _Preds[0];
+            if (_New_node->_Next) {
+                _New_node->_Next->_Prev = _New_node;
+            } else {
+                _Mystorage._Tail = _New_node;
+            }
+
+            ++_Mystorage._Size;
+        }
+
+        void _Unlink(_Node_t* const _Node, _Node_t* const* const _Preds) noexcept {
+            for (size_t _Level = 0; _Level < _Node->_Levels; ++_Level) {
+                _Link_after(_Preds[_Level], _Level) = _Node->_Link(_Level);
+            }
+
+            if (_Node->_Next) {
+                _Node->_Next->_Prev = _Node->_Prev;
+            } else {
+                _Mystorage._Tail = _Node->_Prev;
+            }
+
+            --_Mystorage._Size;
+            _Free_node(_Node);
+            _Mystorage._Drop_empty_levels();
+        }
+
+        template <class... _Types>
+        _Node_t* _Make_node(_Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            static_assert(_Traits::template
+                _Is_constructible<_Types&&...>, "T must be constructible from Types...");
+            const size_t _Levels = _Mystorage._Random_levels();
+            _Node_t* const _Raw  = _Mystorage._Get_allocator().allocate(_Node_t::_Units(_Levels));
+            return _Raw ? ::new (static_cast<void*>(_Raw))
+                              _Node_t(_Levels, ::std::in_place, ::std::forward<_Types>(_Args)...)
+                        : nullptr;
+        }
+
+        void _Free_node(_Node_t* const _Node) noexcept {
+            const size_t _Units = _Node_t::_Units(_Node->_Levels);
+            _Node->~_Node_t();
+            _Mystorage._Get_allocator().deallocate(_Node, _Units);
+        }
+
+        void _Free_chain(_Node_t* _Chain) noexcept {
+            _Node_t* _Next;
+            for (; _Chain != nullptr; _Chain = _Next) {
+                _Next = _Chain->_Next;
+                _Free_node(_Chain);
+            }
+        }
+
+        static _Node_t* _Reverse_chain(_Node_t* _Chain) noexcept {
+            _Node_t* _Reversed = nullptr;
+            while (_Chain) {
+                _Node_t* const _Next = _Chain->_Next;
+                _Chain->_Next        = _Reversed;
+                _Reversed            = _Chain;
+                _Chain               = _Next;
+            }
+
+            return _Reversed;
+        }
+
+        bool _Append_copies(const safe_sorted_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            // Note: Called on an empty list. The values are already sorted, so every node is appended
+            //       to the end of its levels without a search. Stops at the first failed allocation,
+            //       the copied elements form a valid list.
+            _Node_t* _Last[_Max_levels] = {};
+            for (const _Node_t* _Src = _Other._Mystorage._Heads[0]; _Src != nullptr; _Src = _Src->_Next) {
+                _Node_t* const _New_node = _Make_node(_Src->_Value);
+                if (!_New_node) { // allocation failed
+                    return false;
+                }
+
+                const size_t _Levels = _New_node->_Levels;
+                for (size_t _Level = 0; _Level < _Levels; ++_Level) {
+                    _Link_after(_Last[_Level], _Level) = _New_node;
+                    _Last[_Level]                      = _New_node;
+                }
+
+                if (_Levels > _Mystorage._Levels) {
+                    _Mystorage._Levels = _Levels;
+                }
+
+                _New_node->_Prev = _Mystorage._Tail;
+                _Mystorage._Tail = _New_node;
+                ++_Mystorage._Size;
+            }
+
+            return true;
+        }
+
+        _Storage_t _Mystorage;
+    };
+
+    template <class _Ty, class _Pr, class _Alloc>
+    void swap(safe_sorted_list<_Ty, _Pr, _Alloc>& _Left, safe_sorted_list<_Ty, _Pr, _Alloc>& _Right) noexcept {
+        _Left.swap(_Right);
+    }
+
+    template <class _Ty, class _Pr, class _Alloc>
+    typename safe_sorted_list<_Ty, _Pr, _Alloc>::size_type erase(
+        safe_sorted_list<_Ty, _Pr, _Alloc>& _List, const _Ty& _Value) noexcept {
+        return _List.remove(_Value);
+    }
+
+    template <class _Ty, class _Pr, class _Alloc, class _Fn>
+    typename safe_sorted_list<_Ty, _Pr, _Alloc>::size_type erase(safe_sorted_list<_Ty, _Pr, _Alloc>& _List,
+        _Fn _Pred) noexcept(::std::is_nothrow_invocable_v<_Fn, const _Ty&>) {
+        return _List.remove_if(_Pred);
+    }
+} // namespace mjx
+
+#endif // _SAFE_SORTED_LIST_HPP_
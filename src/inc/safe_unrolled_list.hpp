@@ -0,0 +1,993 @@
+// safe_unrolled_list.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SAFE_UNROLLED_LIST_HPP_
+#define _SAFE_UNROLLED_LIST_HPP_
+#include <cstdint>
+#include <cstring>
+#include <safe_list.hpp>
+
+namespace mjx {
+    template <class _Ty>
+    inline constexpr size_t _Safe_unrolled_list_default_count = // fills roughly 256 bytes per node
+        sizeof(_Ty) < 64 ? 256 / sizeof(_Ty) : 4;
+
+    template <size_t _Count>
+    using _Safe_unrolled_list_count_t = ::std::conditional_t<_Count <= UINT8_MAX, uint8_t,
+        ::std::conditional_t<_Count <= UINT16_MAX, uint16_t, uint32_t>>;
+
+    template <class _Ty, size_t _Count_per_node>
+    class _Safe_unrolled_list_node {
+    public:
+        using _Count_type = _Safe_unrolled_list_count_t<_Count_per_node>;
+
+        _Safe_unrolled_list_node* _Next; // pointer to the next node
+        _Safe_unrolled_list_node* _Prev; // pointer to the previous node
+        _Count_type _Count; // number of constructed elements
+        alignas(_Ty) unsigned char _Storage[_Count_per_node * sizeof(_Ty)]; // storage for the elements
+
+        _Safe_unrolled_list_node() noexcept : _Next(nullptr), _Prev(nullptr), _Count(0) {}
+
+        ~_Safe_unrolled_list_node() noexcept {
+            _Destroy_elements(0, _Count);
+        }
+
+        _Safe_unrolled_list_node(const _Safe_unrolled_list_node&)            = delete;
+        _Safe_unrolled_list_node& operator=(const _Safe_unrolled_list_node&) = delete;
+
+        bool _Full() const noexcept {
+            return _Count == _Count_per_node;
+        }
+
+        _Ty* _Data() noexcept {
+            return ::std::launder(reinterpret_cast<_Ty*>(_Storage));
+        }
+
+        const _Ty* _Data() const noexcept {
+            return ::std::launder(reinterpret_cast<const _Ty*>(_Storage));
+        }
+
+        void _Destroy_elements(const size_t _First, const size_t _Last) noexcept {
+            if constexpr (!::std::is_trivially_destructible_v<_Ty>) {
+                _Ty* const _Elems = _Data();
+                for (size_t _Idx = _First; _Idx < _Last; ++_Idx) {
+                    _Elems[_Idx].~_Ty();
+                }
+            }
+        }
+
+        static void _Relocate(_Ty* const _Dest, _Ty* const _Src, const size_t _Size) noexcept {
+            // Note: Moves _Size elements from _Src to the uninitialized _Dest and destroys the sources.
+            //       The ranges may overlap, the direction of the copy depends on their order.
+            if (_Size == 0 || _Dest == _Src) { // nothing to do
+                return;
+            }
+
+            if constexpr (::std::is_trivially_copyable_v<_Ty>) {
+                ::memmove(static_cast<void*>(_Dest), static_cast<const void*>(_Src), _Size * sizeof(_Ty));
+            } else if (_Dest < _Src) { // move forward
+                for (size_t _Idx = 0; _Idx < _Size; ++_Idx) {
+                    ::new (static_cast<void*>(_Dest + _Idx)) _Ty(::std::move(_Src[_Idx]));
+                    _Src[_Idx].~_Ty();
+                }
+            } else { // move backward
+                for (size_t _Idx = _Size; _Idx > 0; --_Idx) {
+                    ::new (static_cast<void*>(_Dest + _Idx - 1)) _Ty(::std::move(_Src[_Idx - 1]));
+                    _Src[_Idx - 1].~_Ty();
+                }
+            }
+        }
+    };
+
+    template <class _Ty, class _Node_t, bool _Is_const, bool _Is_reverse>
+    class _Safe_unrolled_list_iterator { // list iterator, points to the node and the element's index
+    public:
+        using value_type        = _Ty;
+        using difference_type   = ptrdiff_t;
+        using pointer           = ::std::conditional_t<_Is_const, const _Ty*, _Ty*>;
+        using reference         = ::std::conditional_t<_Is_const, const _Ty&, _Ty&>;
+        using iterator_category = ::std::bidirectional_iterator_tag;
+
+        _Safe_unrolled_list_iterator() noexcept : _Node(nullptr), _Index(0) {}
+
+        _Safe_unrolled_list_iterator(_Node_t* const _Node, const size_t _Index) noexcept
+            : _Node(_Node), _Index(_Index) {}
+
+        template <bool _Other_const, ::std::enable_if_t<_Is_const && !_Other_const, int> = 0>
+        _Safe_unrolled_list_iterator(
+            const _Safe_unrolled_list_iterator<_Ty, _Node_t, _Other_const, _Is_reverse>& _Other) noexcept
+            : _Node(_Other._Get_node()), _Index(_Other._Get_index()) {}
+
+        ~_Safe_unrolled_list_iterator() noexcept {}
+
+        explicit operator bool() const noexcept {
+            return _Node != nullptr;
+        }
+
+        bool valid() const noexcept {
+            return _Node != nullptr;
+        }
+
+        bool operator==(const _Safe_unrolled_list_iterator& _Other) const noexcept {
+            return _Node == _Other._Node && _Index == _Other._Index;
+        }
+
+        bool operator!=(const _Safe_unrolled_list_iterator& _Other) const noexcept {
+            return !(*this == _Other);
+        }
+
+        reference operator*() const noexcept {
+            return _Node->_Data()[_Index];
+        }
+
+        pointer operator->() const noexcept {
+            return _Node->_Data() + _Index;
+        }
+
+        _Safe_unrolled_list_iterator& operator++() noexcept {
+            if constexpr (_Is_reverse) {
+                _Retreat();
+            } else {
+                _Advance();
+            }
+
+            return *this;
+        }
+
+        _Safe_unrolled_list_iterator operator++(int) noexcept {
+            _Safe_unrolled_list_iterator _Temp = *this;
+            ++*this;
+            return _Temp;
+        }
+
+        _Safe_unrolled_list_iterator& operator--() noexcept {
+            if constexpr (_Is_reverse) {
+                _Advance();
+            } else {
+                _Retreat();
+            }
+
+            return *this;
+        }
+
+        _Safe_unrolled_list_iterator operator--(int) noexcept {
+            _Safe_unrolled_list_iterator _Temp = *this;
+            --*this;
+            return _Temp;
+        }
+
+        _Node_t* _Get_node() const noexcept {
+            return _Node;
+        }
+
+        size_t _Get_index() const noexcept {
+            return _Index;
+        }
+
+    private:
+        void _Advance() noexcept {
+            if (++_Index == _Node->_Count) { // move to the first element of the next node
+                _Node  = _Node->_Next;
+                _Index = 0;
+            }
+        }
+
+        void _Retreat() noexcept {
+            if (_Index == 0) { // move to the last element of the previous node
+                _Node  = _Node->_Prev;
+                _Index = _Node ? _Node->_Count - 1 : 0;
+            } else {
+                --_Index;
+            }
+        }
+
+        _Node_t* _Node;
+        size_t _Index;
+    };
+
+    template <class _Ty, size_t _Count_per_node = _Safe_unrolled_list_default_count<_Ty>,
+        class _Alloc = safe_allocator<_Ty>>
+    class safe_unrolled_list { // exception-safe unrolled doubly-linked list
+    private:
+        using _Traits    = _Safe_list_traits<_Ty>;
+        using _Node_t    = _Safe_unrolled_list_node<_Ty, _Count_per_node>;
+        using _Al_traits = ::std::allocator_traits<_Alloc>;
+        using _Alnode_t  = typename _Al_traits::template rebind_alloc<_Node_t>;
+
+        static_assert(_Count_per_node > 0 && _Count_per_node <= UINT32_MAX, "N must be in range [1, 2^32).");
+        static_assert(_Traits::_Is_nothrow_move_constructible, "T must be nothrow move constructible.");
+        static_assert(_Is_nothrow_allocator<_Alnode_t>, "Alloc must not throw, allocate() returns a null-pointer.");
+
+    public:
+        using value_type      = _Ty;
+        using allocator_type  = _Alloc;
+        using size_type       = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer         = _Ty*;
+        using const_pointer   = const _Ty*;
+        using reference       = _Ty&;
+        using const_reference = const _Ty&;
+
+        using iterator               = _Safe_unrolled_list_iterator<_Ty, _Node_t, false, false>;
+        using const_iterator         = _Safe_unrolled_list_iterator<_Ty, _Node_t, true, false>;
+        using reverse_iterator       = _Safe_unrolled_list_iterator<_Ty, _Node_t, false, true>;
+        using const_reverse_iterator = _Safe_unrolled_list_iterator<_Ty, _Node_t, true, true>;
+
+        static constexpr size_type elements_per_node = _Count_per_node;
+
+        // Note: Elements are stored in nodes of up to N elements, kept contiguous at the front of each
+        //       node. This trades per-element iterator stability for memory use and scan speed:
+        //       - push_back() and emplace_back() never invalidate iterators, pointers or references,
+        //       - push_front() and emplace_front() invalidate those that refer to the first node,
+        //       - insert() and emplace() invalidate those that refer to the node the element is inserted
+        //         into (including elements moved to a new node when a full node is split),
+        //       - pop_back() and pop_front() invalidate only those that refer to the removed element,
+        //       - erase() invalidates those that refer to the node of the erased element and its next node
+        //         (sparse neighbouring nodes are merged),
+        //       - remove(), remove_if() and reverse() invalidate all iterators.
+
+        safe_unrolled_list() noexcept : _Mystorage() {}
+
+        explicit safe_unrolled_list(const allocator_type& _Al) noexcept : _Mystorage(_Alnode_t(_Al)) {}
+
+        safe_unrolled_list(const safe_unrolled_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible)
+            : _Mystorage(_Alnode_t(_Al_traits::select_on_container_copy_construction(_Other.get_allocator()))) {
+            (void) _Copy_list(_Other);
+        }
+
+        safe_unrolled_list(safe_unrolled_list&& _Other) noexcept : _Mystorage(_Other._Mystorage._Get_allocator()) {
+            _Mystorage._Swap(_Other._Mystorage); // swap storages
+        }
+
+        explicit safe_unrolled_list(const size_type _Count, const allocator_type& _Al = allocator_type{}) noexcept(
+            _Traits::_Is_nothrow_default_constructible) : _Mystorage(_Alnode_t(_Al)) {
+            (void) resize(_Count);
+        }
+
+        explicit safe_unrolled_list(const size_type _Count, const value_type& _Value,
+            const allocator_type& _Al = allocator_type{}) noexcept(_Traits::_Is_nothrow_copy_constructible)
+            : _Mystorage(_Alnode_t(_Al)) {
+            (void) resize(_Count, _Value);
+        }
+
+        safe_unrolled_list(::std::initializer_list<value_type> _Init_list,
+            const allocator_type& _Al = allocator_type{}) noexcept(_Traits::_Is_nothrow_copy_constructible)
+            : _Mystorage(_Alnode_t(_Al)) {
+            (void) assign(_Init_list);
+        }
+
+        ~safe_unrolled_list() noexcept {
+            clear();
+        }
+
+        safe_unrolled_list& operator=(const safe_unrolled_list& _Other) noexcept(
+            _Traits::_Is_nothrow_copy_constructible) {
+            if (this != ::std::addressof(_Other)) {
+                clear();
+                (void) _Copy_list(_Other);
+            }
+
+            return *this;
+        }
+
+        safe_unrolled_list& operator=(safe_unrolled_list&& _Other) noexcept {
+            if (this != ::std::addressof(_Other)) {
+                _Mystorage._Swap(_Other._Mystorage);
+            }
+
+            return *this;
+        }
+
+        safe_unrolled_list& operator=(
+            ::std::initializer_list<value_type> _Init_list) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            (void) assign(_Init_list);
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(_Mystorage._Get_allocator());
+        }
+
+        bool empty() const noexcept {
+            return _Mystorage._Size == 0;
+        }
+
+        size_type size() const noexcept {
+            return _Mystorage._Size;
+        }
+
+        size_type max_size() const noexcept {
+            return static_cast<size_type>(-1) / sizeof(_Ty);
+        }
+
+        iterator begin() noexcept {
+            return iterator{_Mystorage._Head, 0};
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator{_Mystorage._Head, 0};
+        }
+
+        const_iterator cbegin() const noexcept {
+            return const_iterator{_Mystorage._Head, 0};
+        }
+
+        reverse_iterator rbegin() noexcept {
+            return _Mystorage._Tail ? reverse_iterator{_Mystorage._Tail, _Mystorage._Tail->_Count - 1u}
+                                    : reverse_iterator{};
+        }
+
+        const_reverse_iterator rbegin() const noexcept {
+            return _Mystorage._Tail ? const_reverse_iterator{_Mystorage._Tail, _Mystorage._Tail->_Count - 1u}
+                                    : const_reverse_iterator{};
+        }
+
+        const_reverse_iterator crbegin() const noexcept {
+            return rbegin();
+        }
+
+        iterator end() noexcept {
+            return iterator{}; // past-the-last element (null-pointer)
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator{}; // past-the-last element (null-pointer)
+        }
+
+        const_iterator cend() const noexcept {
+            return const_iterator{}; // past-the-last element (null-pointer)
+        }
+
+        reverse_iterator rend() noexcept {
+            return reverse_iterator{};
+        }
+
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator{};
+        }
+
+        const_reverse_iterator crend() const noexcept {
+            return const_reverse_iterator{};
+        }
+
+        pointer front() noexcept {
+            return !empty() ? _Mystorage._Head->_Data() : nullptr;
+        }
+
+        const_pointer front() const noexcept {
+            return !empty() ? _Mystorage._Head->_Data() : nullptr;
+        }
+
+        pointer back() noexcept {
+            return !empty() ? _Mystorage._Tail->_Data() + (_Mystorage._Tail->_Count - 1) : nullptr;
+        }
+
+        const_pointer back() const noexcept {
+            return !empty() ? _Mystorage._Tail->_Data() + (_Mystorage._Tail->_Count - 1) : nullptr;
+        }
+
+        [[nodiscard]] bool assign(
+            size_type _Count, const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            // Note: The new nodes are created before the old ones are destroyed,
+            //       so the list is left unchanged if an allocation fails.
+            safe_unrolled_list _Chain(get_allocator());
+            if (!_Chain.resize(_Count, _Value)) { // failed to create new nodes
+                return false;
+            }
+
+            _Mystorage._Swap(_Chain._Mystorage); // the old nodes are destroyed with _Chain
+            return true;
+        }
+
+        template <class _InIt>
+        [[nodiscard]] bool assign(_InIt _First, _InIt _Last) noexcept(
+            _Traits::template _Is_nothrow_constructible<decltype(*::std::declval<_InIt>())>) {
+            static_assert(_Traits::template _Is_constructible<decltype(*::std::declval<_InIt>())>,
+                "T must be constructible from InIt's value type.");
+            safe_unrolled_list _Chain(get_allocator()); // same as assign(count, value)
+            for (; _First != _Last; ++_First) {
+                if (!_Chain.emplace_back(*_First)) { // failed to create a new node
+                    return false;
+                }
+            }
+
+            _Mystorage._Swap(_Chain._Mystorage); // the old nodes are destroyed with _Chain
+            return true;
+        }
+
+        [[nodiscard]] bool assign(
+            ::std::initializer_list<value_type> _Init_list) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return assign(_Init_list.begin(), _Init_list.end());
+        }
+
+        void clear() noexcept {
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Next) {
+                _Next = _Node->_Next;
+                _Free_node(_Node);
+            }
+
+            _Mystorage._Head = nullptr;
+            _Mystorage._Tail = nullptr;
+            _Mystorage._Size = 0;
+        }
+
+        iterator insert(
+            const_iterator _Where, const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace(_Where, _Value);
+        }
+
+        iterator insert(const_iterator _Where, value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace(_Where, ::std::move(_Value));
+        }
+
+        iterator insert(const_iterator _Where,
+            size_type _Count, const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            // Note: All nodes are created first and linked at once. If an allocation fails,
+            //       the already created nodes are destroyed and the list is left unchanged.
+            if (_Count == 0) { // nothing to insert
+                return iterator{_Where._Get_node(), _Where._Get_index()};
+            }
+
+            if (_Count > max_size() - _Mystorage._Size) { // not enough space for the new elements
+                return iterator{};
+            }
+
+            safe_unrolled_list _Chain(get_allocator());
+            if (!_Chain.resize(_Count, _Value)) { // failed to create new nodes
+                return iterator{};
+            }
+
+            return _Adopt_chain(_Where, _Chain);
+        }
+
+        template <class _InIt>
+        iterator insert(const_iterator _Where, _InIt _First, _InIt _Last) noexcept(
+            _Traits::template _Is_nothrow_constructible<decltype(*::std::declval<_InIt>())>) {
+            static_assert(_Traits::template _Is_constructible<decltype(*::std::declval<_InIt>())>,
+                "T must be constructible from InIt's value type.");
+            if (_First == _Last) { // nothing to insert
+                return iterator{_Where._Get_node(), _Where._Get_index()};
+            }
+
+            safe_unrolled_list _Chain(get_allocator()); // same as insert(where, count, value)
+            for (; _First != _Last; ++_First) {
+                if (!_Chain.emplace_back(*_First)) { // failed to create a new element
+                    return iterator{};
+                }
+            }
+
+            if (_Chain._Mystorage._Size > max_size() - _Mystorage._Size) { // not enough space for the new elements
+                return iterator{};
+            }
+
+            return _Adopt_chain(_Where, _Chain);
+        }
+
+        iterator insert(const_iterator _Where,
+            ::std::initializer_list<value_type> _Init_list) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return insert(_Where, _Init_list.begin(), _Init_list.end());
+        }
+
+        template <class... _Types>
+        iterator emplace(const_iterator _Where,
+            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            static_assert(_Traits::template _Is_constructible<_Types&&...>, "T must be constructible from Types...");
+            if (_Mystorage._Size == max_size()) { // not enough space for another element
+                return iterator{};
+            }
+
+            _Node_t* _Node = _Where._Get_node();
+            size_t _Index  = _Where._Get_index();
+            if (!_Node) { // insert after the last element
+                _Node  = _Mystorage._Tail;
+                _Index = _Node ? _Node->_Count : 0;
+            }
+
+            if (!_Node) { // the list is empty, create the first node
+                _Node = _Link_new_node(nullptr);
+                if (!_Node) { // allocation failed
+                    return iterator{};
+                }
+            } else if (_Node->_Full()) { // making space moves elements, the arguments may refer to them
+                _Ty _Temp(::std::forward<_Types>(_Args)...);
+                if (!_Make_space(_Node, _Index)) { // allocation failed
+                    return iterator{};
+                }
+
+                return _Construct_in_node(_Node, _Index, ::std::move(_Temp));
+            }
+
+            return _Construct_in_node(_Node, _Index, ::std::forward<_Types>(_Args)...);
+        }
+
+        iterator erase(const_iterator _Where) noexcept {
+            _Node_t* _Node = _Where._Get_node();
+            if (!_Node) { // nothing to erase
+                return iterator{};
+            }
+
+            const size_t _Index = _Where._Get_index();
+            _Ty* const _Elems   = _Node->_Data();
+            _Elems[_Index].~_Ty();
+            _Node_t::_Relocate(_Elems + _Index, _Elems + _Index + 1, _Node->_Count - _Index - 1);
+            --_Node->_Count;
+            --_Mystorage._Size;
+            if (_Node->_Count == 0) { // the node is empty, release it
+                _Node_t* const _Next = _Node->_Next;
+                _Unlink_node(_Node);
+                _Free_node(_Node);
+                return iterator{_Next, 0};
+            }
+
+            _Node_t* const _Next = _Node->_Next;
+            if (_Next && _Node->_Count + _Next->_Count <= _Count_per_node / 2) { // merge sparse neighbours
+                _Node_t::_Relocate(_Elems + _Node->_Count, _Next->_Data(), _Next->_Count);
+                _Node->_Count = static_cast<typename _Node_t::_Count_type>(_Node->_Count + _Next->_Count);
+                _Next->_Count = 0;
+                _Unlink_node(_Next);
+                _Free_node(_Next);
+            }
+
+            return _Index < _Node->_Count ? iterator{_Node, _Index} : iterator{_Node->_Next, 0};
+        }
+
+        iterator erase(const_iterator _First, const_iterator _Last) noexcept {
+            // Note: Erasing may merge nodes and invalidate _Last, count the elements first.
+            size_type _Count = 0;
+            for (const_iterator _Iter = _First; _Iter != _Last; ++_Iter) {
+                ++_Count;
+            }
+
+            iterator _Iter{_First._Get_node(), _First._Get_index()};
+            while (_Count-- > 0) {
+                _Iter = erase(const_iterator{_Iter._Get_node(), _Iter._Get_index()});
+            }
+
+            return _Iter;
+        }
+
+        [[nodiscard]] bool push_back(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace_back(_Value);
+        }
+
+        [[nodiscard]] bool push_back(value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace_back(::std::move(_Value));
+        }
+
+        template <class... _Types>
+        [[nodiscard]] bool emplace_back(
+            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            static_assert(_Traits::template _Is_constructible<_Types&&...>, "T must be constructible from Types...");
+            if (_Mystorage._Size == max_size()) { // not enough space for another element
+                return false;
+            }
+
+            _Node_t* _Node = _Mystorage._Tail;
+            if (!_Node || _Node->_Full()) { // no space left in the last node
+                _Node = _Link_new_node(_Node);
+                if (!_Node) { // allocation failed
+                    return false;
+                }
+            }
+
+            ::new (static_cast<void*>(_Node->_Data() + _Node->_Count)) _Ty(::std::forward<_Types>(_Args)...);
+            ++_Node->_Count;
+            ++_Mystorage._Size;
+            return true;
+        }
+
+        [[nodiscard]] bool push_front(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace_front(_Value);
+        }
+
+        [[nodiscard]] bool push_front(value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace_front(::std::move(_Value));
+        }
+
+        template <class... _Types>
+        [[nodiscard]] bool emplace_front(
+            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            return emplace(cbegin(), ::std::forward<_Types>(_Args)...).valid();
+        }
+
+        void pop_back() noexcept {
+            _Node_t* const _Tail = _Mystorage._Tail;
+            if (!_Tail) { // empty list, nothing to do
+                return;
+            }
+
+            _Tail->_Destroy_elements(_Tail->_Count - 1u, _Tail->_Count);
+            --_Tail->_Count;
+            --_Mystorage._Size;
+            if (_Tail->_Count == 0) { // the last node is empty, release it
+                _Unlink_node(_Tail);
+                _Free_node(_Tail);
+            }
+        }
+
+        void pop_front() noexcept {
+            if (_Mystorage._Head) { // non-empty list, erase the first element
+                (void) erase(cbegin());
+            }
+        }
+
+        [[nodiscard]] bool resize(const size_type _New_size) noexcept(_Traits::_Is_nothrow_default_constructible) {
+            while (_Mystorage._Size < _New_size) { // create new elements
+                if (!emplace_back()) { // failed to create a new element
+                    return false;
+                }
+            }
+
+            while (_Mystorage._Size > _New_size) { // delete existing elements
+                pop_back();
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] bool resize(const size_type _New_size,
+            const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            while (_Mystorage._Size < _New_size) { // create new elements
+                if (!emplace_back(_Value)) { // failed to create a new element
+                    return false;
+                }
+            }
+
+            while (_Mystorage._Size > _New_size) { // delete existing elements
+                pop_back();
+            }
+
+            return true;
+        }
+
+        void swap(safe_unrolled_list& _Other) noexcept {
+            _Mystorage._Swap(_Other._Mystorage);
+        }
+
+        template <class _Pr>
+        size_type remove_if(_Pr _Pred) noexcept(::std::is_nothrow_invocable_v<_Pr, const _Ty&>) {
+            // Note: Every node is compacted in place, nodes that become empty are released.
+            size_type _Count = 0;
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Next) {
+                _Next   = _Node->_Next;
+                _Count += _Compact_node(_Node, 0, _Pred);
+            }
+
+            _Mystorage._Size -= _Count;
+            return _Count;
+        }
+
+        size_type remove(const value_type& _Value) noexcept {
+            // Note: The elements of a node are contiguous, so the first match is searched with
+            //       the block kernels and nodes without a match are not touched at all.
+            //       _Value may refer to an element of this list, compare against a copy.
+            const value_type _Copy = _Value;
+            auto _Pred             = [&_Copy](const value_type& _Elem) noexcept {
+                return _Elem == _Copy;
+            };
+
+            size_type _Count = 0;
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Next) {
+                _Next              = _Node->_Next;
+                const size_t _Kept = _Safe_list_find_in_run<_Traits>(
+                    static_cast<const _Node_t*>(_Node)->_Data(), _Node->_Count, _Copy);
+                if (_Kept != _Node->_Count) { // at least one element matches
+                    _Count += _Compact_node(_Node, _Kept, _Pred);
+                }
+            }
+
+            _Mystorage._Size -= _Count;
+            return _Count;
+        }
+
+        iterator find(const value_type& _Value) noexcept {
+            // Note: Returns end() if no element is equal to _Value.
+            const const_iterator _Where = static_cast<const safe_unrolled_list&>(*this).find(_Value);
+            return iterator{_Where._Get_node(), _Where._Get_index()};
+        }
+
+        const_iterator find(const value_type& _Value) const noexcept {
+            for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Node->_Next) {
+                const size_t _Idx = _Safe_list_find_in_run<_Traits>(
+                    static_cast<const _Node_t*>(_Node)->_Data(), _Node->_Count, _Value);
+                if (_Idx != _Node->_Count) {
+                    return const_iterator{_Node, _Idx};
+                }
+            }
+
+            return end();
+        }
+
+        size_type count(const value_type& _Value) const noexcept {
+            size_type _Count = 0;
+            for (const _Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Node->_Next) {
+                _Count += _Safe_list_count_in_run<_Traits>(_Node->_Data(), _Node->_Count, _Value);
+            }
+
+            return _Count;
+        }
+
+        [[nodiscard]] bool contains(const value_type& _Value) const noexcept {
+            return find(_Value) != end();
+        }
+
+        void reverse() noexcept {
+            _Node_t* _Node = _Mystorage._Head;
+            while (_Node) { // reverse the elements of every node and swap its links
+                _Ty* const _Elems = _Node->_Data();
+                for (size_t _Left = 0, _Right = _Node->_Count; _Left + 1 < _Right; ++_Left, --_Right) {
+                    _Swap_elements(_Elems[_Left], _Elems[_Right - 1]);
+                }
+
+                _Node_t* const _Next = _Node->_Next;
+                _Node->_Next         = _Node->_Prev;
+                _Node->_Prev         = _Next;
+                _Node                = _Next;
+            }
+
+            ::std::swap(_Mystorage._Head, _Mystorage._Tail);
+        }
+
+    private:
+        struct _Storage_t : _Safe_list_alloc_holder<_Alnode_t> {
+            using _Mybase = _Safe_list_alloc_holder<_Alnode_t>;
+
+            _Node_t* _Head; // pointer to the first node
+            _Node_t* _Tail; // pointer to the last node
+            size_type _Size; // number of elements
+
+            _Storage_t() noexcept : _Mybase(), _Head(nullptr), _Tail(nullptr), _Size(0) {}
+
+            explicit _Storage_t(const _Alnode_t& _Al) noexcept
+                : _Mybase(_Al), _Head(nullptr), _Tail(nullptr), _Size(0) {}
+
+            void _Swap(_Storage_t& _Other) noexcept {
+                using ::std::swap; // enable ADL for allocators
+                swap(this->_Get_allocator(), _Other._Get_allocator());
+                swap(_Head, _Other._Head);
+                swap(_Tail, _Other._Tail);
+                swap(_Size, _Other._Size);
+            }
+        };
+
+        static void _Swap_elements(_Ty& _Left, _Ty& _Right) noexcept {
+            // Note: Elements are nothrow move constructible, avoid depending on a throwing swap().
+            _Ty _Temp(::std::move(_Left));
+            _Left.~_Ty();
+            ::new (static_cast<void*>(::std::addressof(_Left))) _Ty(::std::move(_Right));
+            _Right.~_Ty();
+            ::new (static_cast<void*>(::std::addressof(_Right))) _Ty(::std::move(_Temp));
+        }
+
+        bool _Make_space(_Node_t*& _Node, size_t& _Index) noexcept {
+            // Note: Frees a slot at _Index in the full _Node, using a neighbour or splitting the node.
+            if (_Index == _Count_per_node) { // append to the next node
+                if (!_Node->_Next || _Node->_Next->_Full()) {
+                    if (!_Link_new_node(_Node)) { // allocation failed
+                        return false;
+                    }
+                }
+
+                _Node  = _Node->_Next;
+                _Index = 0;
+            } else if (_Index == 0) { // append to the previous node
+                if (!_Node->_Prev || _Node->_Prev->_Full()) {
+                    if (!_Link_new_node(_Node->_Prev)) { // allocation failed
+                        return false;
+                    }
+                }
+
+                _Node  = _Node->_Prev;
+                _Index = _Node->_Count;
+            } else { // split the node, the upper half is moved to a new node
+                _Node_t* const _New_node = _Link_new_node(_Node);
+                if (!_New_node) { // allocation failed
+                    return false;
+                }
+
+                constexpr size_t _Half = (_Count_per_node + 1) / 2;
+                _Node_t::_Relocate(_New_node->_Data(), _Node->_Data() + _Half, _Count_per_node - _Half);
+                _New_node->_Count = static_cast<typename _Node_t::_Count_type>(_Count_per_node - _Half);
+                _Node->_Count     = static_cast<typename _Node_t::_Count_type>(_Half);
+                if (_Index > _Half) { // the new element belongs to the new node
+                    _Node  = _New_node;
+                    _Index -= _Half;
+                }
+            }
+
+            return true;
+        }
+
+        template <class... _Types>
+        iterator _Construct_in_node(_Node_t* const _Node, const size_t _Index,
+            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            // Note: _Node must have space for another element.
+            _Ty* const _Elems = _Node->_Data();
+            if (_Index == _Node->_Count) { // construct at the end of the node, nothing has to be moved
+                ::new (static_cast<void*>(_Elems + _Index)) _Ty(::std::forward<_Types>(_Args)...);
+            } else { // make a gap, the arguments may refer to the elements being moved
+                _Ty _Temp(::std::forward<_Types>(_Args)...);
+                _Node_t::_Relocate(_Elems + _Index + 1, _Elems + _Index, _Node->_Count - _Index);
+                ::new (static_cast<void*>(_Elems + _Index)) _Ty(::std::move(_Temp));
+            }
+
+            ++_Node->_Count;
+            ++_Mystorage._Size;
+            return iterator{_Node, _Index};
+        }
+
+        _Node_t* _Link_new_node(_Node_t* const _After) noexcept {
+            // Note: Links an empty node after _After, or before the first node if _After is a null-pointer.
+            _Node_t* const _Raw = _Mystorage._Get_allocator().allocate(1);
+            if (!_Raw) { // allocation failed
+                return nullptr;
+            }
+
+            _Node_t* const _New_node = ::new (static_cast<void*>(_Raw)) _Node_t();
+            _Node_t* const _Next     = _After ? _After->_Next : _Mystorage._Head;
+            _New_node->_Prev         = _After;
+            _New_node->_Next         = _Next;
+            if (_After) {
+                _After->_Next = _New_node;
+            } else {
+                _Mystorage._Head = _New_node;
+            }
+
+            if (_Next) {
+                _Next->_Prev = _New_node;
+            } else {
+                _Mystorage._Tail = _New_node;
+            }
+
+            return _New_node;
+        }
+
+        iterator _Adopt_chain(const const_iterator _Where, safe_unrolled_list& _Chain) noexcept {
+            // Note: Links the nodes of the non-empty _Chain before _Where and returns an iterator to the first
+            //       of them. If _Where is inside a node, the node is split, its elements from _Where on are
+            //       moved to a node after the chain. That node is the only allocation, the list is left
+            //       unchanged if it fails.
+            _Node_t* const _Node   = _Where._Get_node();
+            const size_t _Index    = _Where._Get_index();
+            const size_type _Added = _Chain._Mystorage._Size;
+            _Node_t* _After; // the node to link the chain after, a null-pointer for the front
+            if (!_Node) { // append to the list
+                _After = _Mystorage._Tail;
+            } else if (_Index == 0) { // insert before the node
+                _After = _Node->_Prev;
+            } else { // split the node
+                _Node_t* const _Rest = _Chain._Link_new_node(_Chain._Mystorage._Tail);
+                if (!_Rest) { // allocation failed
+                    return iterator{};
+                }
+
+                _Node_t::_Relocate(_Rest->_Data(), _Node->_Data() + _Index, _Node->_Count - _Index);
+                _Rest->_Count = static_cast<typename _Node_t::_Count_type>(_Node->_Count - _Index);
+                _Node->_Count = static_cast<typename _Node_t::_Count_type>(_Index);
+                _After        = _Node;
+            }
+
+            _Node_t* const _First = _Chain._Mystorage._Head;
+            _Node_t* const _Last  = _Chain._Mystorage._Tail;
+            _Node_t* const _Next  = _After ? _After->_Next : _Mystorage._Head;
+            _First->_Prev         = _After;
+            _Last->_Next          = _Next;
+            if (_After) {
+                _After->_Next = _First;
+            } else {
+                _Mystorage._Head = _First;
+            }
+
+            if (_Next) {
+                _Next->_Prev = _Last;
+            } else {
+                _Mystorage._Tail = _Last;
+            }
+
+            _Mystorage._Size       += _Added;
+            _Chain._Mystorage._Head = nullptr;
+            _Chain._Mystorage._Tail = nullptr;
+            _Chain._Mystorage._Size = 0;
+            return iterator{_First, 0};
+        }
+
+        template <class _Pr>
+        size_t _Compact_node(_Node_t* const _Node, const size_t _First, _Pr& _Pred) noexcept(
+            ::std::is_nothrow_invocable_v<_Pr&, const _Ty&>) {
+            // Note: Erases the matching elements from _First on and closes the gaps, the elements
+            //       before _First are kept. Releases the node if it becomes empty.
+            _Ty* const _Elems = _Node->_Data();
+            size_t _Kept      = _First;
+            size_t _Erased    = 0;
+            for (size_t _Idx = _First; _Idx < _Node->_Count; ++_Idx) {
+                if (_Pred(static_cast<const _Ty&>(_Elems[_Idx]))) { // element found, erase it
+                    _Elems[_Idx].~_Ty();
+                    ++_Erased;
+                } else { // keep the element, close the gap
+                    _Node_t::_Relocate(_Elems + _Kept, _Elems + _Idx, 1);
+                    ++_Kept;
+                }
+            }
+
+            _Node->_Count = static_cast<typename _Node_t::_Count_type>(_Kept);
+            if (_Kept == 0) { // the node is empty, release it
+                _Unlink_node(_Node);
+                _Free_node(_Node);
+            }
+
+            return _Erased;
+        }
+
+        void _Unlink_node(_Node_t* const _Node) noexcept {
+            if (_Node->_Prev) {
+                _Node->_Prev->_Next = _Node->_Next;
+            } else {
+                _Mystorage._Head = _Node->_Next;
+            }
+
+            if (_Node->_Next) {
+                _Node->_Next->_Prev = _Node->_Prev;
+            } else {
+                _Mystorage._Tail = _Node->_Prev;
+            }
+        }
+
+        void _Free_node(_Node_t* const _Node) noexcept {
+            _Node->~_Node_t();
+            _Mystorage._Get_allocator().deallocate(_Node, 1);
+        }
+
+        bool _Copy_list(const safe_unrolled_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            // Note: The nodes are copied one by one, so the copy has the same layout as the source.
+            for (const _Node_t* _Src = _Other._Mystorage._Head; _Src != nullptr; _Src = _Src->_Next) {
+                _Node_t* const _Node = _Link_new_node(_Mystorage._Tail);
+                if (!_Node) { // allocation failed
+                    return false;
+                }
+
+                const _Ty* const _Elems = _Src->_Data();
+                if constexpr (::std::is_trivially_copyable_v<_Ty>) {
+                    ::memcpy(static_cast<void*>(_Node->_Data()), _Elems, _Src->_Count * sizeof(_Ty));
+                    _Node->_Count = _Src->_Count;
+                } else {
+                    for (; _Node->_Count < _Src->_Count; ++_Node->_Count) {
+                        ::new (static_cast<void*>(_Node->_Data() + _Node->_Count)) _Ty(_Elems[_Node->_Count]);
+                    }
+                }
+
+                _Mystorage._Size += _Node->_Count;
+            }
+
+            return true;
+        }
+
+        _Storage_t _Mystorage;
+    };
+
+    template <class _Ty, size_t _Count_per_node, class _Alloc>
+    void swap(safe_unrolled_list<_Ty, _Count_per_node, _Alloc>& _Left,
+        safe_unrolled_list<_Ty, _Count_per_node, _Alloc>& _Right) noexcept {
+        _Left.swap(_Right);
+    }
+
+    template <class _Ty, size_t _Count_per_node, class _Alloc>
+    typename safe_unrolled_list<_Ty, _Count_per_node, _Alloc>::size_type erase(
+        safe_unrolled_list<_Ty, _Count_per_node, _Alloc>& _List, const _Ty& _Value) noexcept {
+        return _List.remove(_Value);
+    }
+
+    template <class _Ty, size_t _Count_per_node, class _Alloc, class _Pr>
+    typename safe_unrolled_list<_Ty, _Count_per_node, _Alloc>::size_type erase(
+        safe_unrolled_list<_Ty, _Count_per_node, _Alloc>& _List,
+        _Pr _Pred) noexcept(::std::is_nothrow_invocable_v<_Pr, const _Ty&>) {
+        return _List.remove_if(_Pred);
+    }
+} // namespace mjx
+
+#endif // _SAFE_UNROLLED_LIST_HPP_
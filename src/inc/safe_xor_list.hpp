@@ -0,0 +1,509 @@
+// safe_xor_list.hpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#ifndef _SAFE_XOR_LIST_HPP_
+#define _SAFE_XOR_LIST_HPP_
+#include <cstdint>
+#include <safe_list.hpp>
+
+namespace mjx {
+    template <class _Ty, class _Traits>
+    class _Safe_xor_list_node {
+    public:
+        uintptr_t _Link; // address of the previous node XOR address of the next node
+        _Ty _Value; // the stored value
+
+        template <class... _Types>
+        explicit _Safe_xor_list_node(::std::in_place_t, _Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>)
+            : _Link(0), _Value(::std::forward<_Types>(_Args)...) {}
+
+        ~_Safe_xor_list_node() noexcept {}
+
+        _Safe_xor_list_node* _Other(const _Safe_xor_list_node* const _Neighbour) const noexcept {
+            // Note: Returns the neighbour on the other side of _Neighbour.
+            return reinterpret_cast<_Safe_xor_list_node*>(_Link ^ reinterpret_cast<uintptr_t>(_Neighbour));
+        }
+
+        void _Replace(const _Safe_xor_list_node* const _Old, const _Safe_xor_list_node* const _New) noexcept {
+            // Note: Replaces the neighbour _Old with _New.
+            _Link ^= reinterpret_cast<uintptr_t>(_Old) ^ reinterpret_cast<uintptr_t>(_New);
+        }
+    };
+
+    template <class _Ty, class _Node_t, bool _Is_const, bool _Is_reverse>
+    class _Safe_xor_list_iterator { // list iterator, points to the node and the node before it
+    public:
+        using value_type        = _Ty;
+        using difference_type   = ptrdiff_t;
+        using pointer           = ::std::conditional_t<_Is_const, const _Ty*, _Ty*>;
+        using reference         = ::std::conditional_t<_Is_const, const _Ty&, _Ty&>;
+        using iterator_category = ::std::bidirectional_iterator_tag;
+
+        // Note: A node only knows the XOR of its neighbours, so the iterator also keeps the node
+        //       it came from. A reverse iterator is the same walk started from the other end.
+
+        _Safe_xor_list_iterator() noexcept : _Prev(nullptr), _Node(nullptr) {}
+
+        _Safe_xor_list_iterator(_Node_t* const _Prev, _Node_t* const _Node) noexcept : _Prev(_Prev), _Node(_Node) {}
+
+        template <bool _Other_const, ::std::enable_if_t<_Is_const && !_Other_const, int> = 0>
+        _Safe_xor_list_iterator(const _Safe_xor_list_iterator<_Ty, _Node_t, _Other_const, _Is_reverse>& _Other) noexcept
+            : _Prev(_Other._Get_prev()), _Node(_Other._Get_node()) {}
+
+        ~_Safe_xor_list_iterator() noexcept {}
+
+        explicit operator bool() const noexcept {
+            return _Node != nullptr;
+        }
+
+        bool valid() const noexcept {
+            return _Node != nullptr;
+        }
+
+        bool operator==(const _Safe_xor_list_iterator& _Other) const noexcept {
+            return _Node == _Other._Node;
+        }
+
+        bool operator!=(const _Safe_xor_list_iterator& _Other) const noexcept {
+            return _Node != _Other._Node;
+        }
+
+        reference operator*() const noexcept {
+            return _Node->_Value;
+        }
+
+        pointer operator->() const noexcept {
+            return ::std::addressof(_Node->_Value);
+        }
+
+        _Safe_xor_list_iterator& operator++() noexcept {
+            _Node_t* const _Next = _Node->_Other(_Prev);
+            _Prev                = _Node;
+            _Node                = _Next;
+            return *this;
+        }
+
+        _Safe_xor_list_iterator operator++(int) noexcept {
+            _Safe_xor_list_iterator _Temp = *this;
+            ++*this;
+            return _Temp;
+        }
+
+        _Safe_xor_list_iterator& operator--() noexcept {
+            // Note: Also works on end(), its _Prev is the last node.
+            _Node_t* const _Before = _Prev->_Other(_Node);
+            _Node                  = _Prev;
+            _Prev                  = _Before;
+            return *this;
+        }
+
+        _Safe_xor_list_iterator operator--(int) noexcept {
+            _Safe_xor_list_iterator _Temp = *this;
+            --*this;
+            return _Temp;
+        }
+
+        _Node_t* _Get_prev() const noexcept {
+            return _Prev;
+        }
+
+        _Node_t* _Get_node() const noexcept {
+            return _Node;
+        }
+
+    private:
+        _Node_t* _Prev;
+        _Node_t* _Node;
+    };
+
+    template <class _Ty, class _Alloc = safe_allocator<_Ty>>
+    class safe_xor_list { // exception-safe XOR-linked list
+    private:
+        using _Traits    = _Safe_list_traits<_Ty>;
+        using _Node_t    = _Safe_xor_list_node<_Ty, _Traits>;
+        using _Al_traits = ::std::allocator_traits<_Alloc>;
+        using _Alnode_t  = typename _Al_traits::template rebind_alloc<_Node_t>;
+
+        static_assert(_Is_nothrow_allocator<_Alnode_t>, "Alloc must not throw, allocate() returns a null-pointer.");
+
+    public:
+        using value_type      = _Ty;
+        using allocator_type  = _Alloc;
+        using size_type       = size_t;
+        using difference_type = ptrdiff_t;
+        using pointer         = _Ty*;
+        using const_pointer   = const _Ty*;
+        using reference       = _Ty&;
+        using const_reference = const _Ty&;
+
+        using iterator               = _Safe_xor_list_iterator<_Ty, _Node_t, false, false>;
+        using const_iterator         = _Safe_xor_list_iterator<_Ty, _Node_t, true, false>;
+        using reverse_iterator       = _Safe_xor_list_iterator<_Ty, _Node_t, false, true>;
+        using const_reverse_iterator = _Safe_xor_list_iterator<_Ty, _Node_t, true, true>;
+
+        // Note: Every node stores a single link (the XOR of its neighbours' addresses), which saves
+        //       one pointer per node compared to safe_list<T>. In exchange, iterators are twice as large and
+        //       an iterator is invalidated when the node before it changes, as well as by its own removal:
+        //       - insert() and emplace() invalidate the iterators to the node at the insert position,
+        //       - erase() invalidates the iterators to the erased node and to the node after it,
+        //       - push_front() and pop_front() invalidate begin(), push_back() and pop_back() invalidate rbegin(),
+        //       - reverse() runs in O(1) and invalidates all iterators.
+        //       Pointers and references to the elements stay valid until the element is erased.
+
+        safe_xor_list() noexcept : _Mystorage() {}
+
+        explicit safe_xor_list(const allocator_type& _Al) noexcept : _Mystorage(_Alnode_t(_Al)) {}
+
+        safe_xor_list(const safe_xor_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible)
+            : _Mystorage(_Alnode_t(_Al_traits::select_on_container_copy_construction(_Other.get_allocator()))) {
+            (void) _Copy_list(_Other);
+        }
+
+        safe_xor_list(safe_xor_list&& _Other) noexcept : _Mystorage(_Other._Mystorage._Get_allocator()) {
+            _Mystorage._Swap(_Other._Mystorage); // swap storages
+        }
+
+        safe_xor_list(::std::initializer_list<value_type> _Init_list,
+            const allocator_type& _Al = allocator_type{}) noexcept(_Traits::_Is_nothrow_copy_constructible)
+            : _Mystorage(_Alnode_t(_Al)) {
+            for (const value_type& _Value : _Init_list) {
+                if (!push_back(_Value)) { // allocation failed
+                    break;
+                }
+            }
+        }
+
+        ~safe_xor_list() noexcept {
+            clear();
+        }
+
+        safe_xor_list& operator=(const safe_xor_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            if (this != ::std::addressof(_Other)) {
+                clear();
+                (void) _Copy_list(_Other);
+            }
+
+            return *this;
+        }
+
+        safe_xor_list& operator=(safe_xor_list&& _Other) noexcept {
+            if (this != ::std::addressof(_Other)) {
+                _Mystorage._Swap(_Other._Mystorage);
+            }
+
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(_Mystorage._Get_allocator());
+        }
+
+        bool empty() const noexcept {
+            return _Mystorage._Size == 0;
+        }
+
+        size_type size() const noexcept {
+            return _Mystorage._Size;
+        }
+
+        size_type max_size() const noexcept {
+            return static_cast<size_type>(-1) / sizeof(_Node_t);
+        }
+
+        iterator begin() noexcept {
+            return iterator{nullptr, _Mystorage._Head};
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator{nullptr, _Mystorage._Head};
+        }
+
+        const_iterator cbegin() const noexcept {
+            return const_iterator{nullptr, _Mystorage._Head};
+        }
+
+        reverse_iterator rbegin() noexcept {
+            return reverse_iterator{nullptr, _Mystorage._Tail};
+        }
+
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator{nullptr, _Mystorage._Tail};
+        }
+
+        const_reverse_iterator crbegin() const noexcept {
+            return const_reverse_iterator{nullptr, _Mystorage._Tail};
+        }
+
+        iterator end() noexcept {
+            return iterator{_Mystorage._Tail, nullptr}; // past-the-last element, can be decremented
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator{_Mystorage._Tail, nullptr};
+        }
+
+        const_iterator cend() const noexcept {
+            return const_iterator{_Mystorage._Tail, nullptr};
+        }
+
+        reverse_iterator rend() noexcept {
+            return reverse_iterator{_Mystorage._Head, nullptr};
+        }
+
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator{_Mystorage._Head, nullptr};
+        }
+
+        const_reverse_iterator crend() const noexcept {
+            return const_reverse_iterator{_Mystorage._Head, nullptr};
+        }
+
+        pointer front() noexcept {
+            return _Mystorage._Head ? ::std::addressof(_Mystorage._Head->_Value) : nullptr;
+        }
+
+        const_pointer front() const noexcept {
+            return _Mystorage._Head ? ::std::addressof(_Mystorage._Head->_Value) : nullptr;
+        }
+
+        pointer back() noexcept {
+            return _Mystorage._Tail ? ::std::addressof(_Mystorage._Tail->_Value) : nullptr;
+        }
+
+        const_pointer back() const noexcept {
+            return _Mystorage._Tail ? ::std::addressof(_Mystorage._Tail->_Value) : nullptr;
+        }
+
+        void clear() noexcept {
+            _Node_t* _Prev = nullptr;
+            _Node_t* _Next;
+            for (_Node_t* _Node = _Mystorage._Head; _Node != nullptr; _Node = _Next) {
+                _Next = _Node->_Other(_Prev);
+                _Prev = _Node;
+                _Free_node(_Node);
+            }
+
+            _Mystorage._Head = nullptr;
+            _Mystorage._Tail = nullptr;
+            _Mystorage._Size = 0;
+        }
+
+        iterator insert(const_iterator _Where, const value_type& _Value) noexcept(
+            _Traits::_Is_nothrow_copy_constructible) {
+            return emplace(_Where, _Value);
+        }
+
+        iterator insert(const_iterator _Where, value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace(_Where, ::std::move(_Value));
+        }
+
+        template <class... _Types>
+        iterator emplace(const_iterator _Where,
+            _Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            // Note: Inserts before _Where, returns an empty iterator if the allocation failed.
+            if (_Mystorage._Size == max_size()) { // not enough space for another element
+                return iterator{};
+            }
+
+            _Node_t* const _New_node = _Make_node(::std::forward<_Types>(_Args)...);
+            if (!_New_node) { // allocation failed
+                return iterator{};
+            }
+
+            _Link_between(_Where._Get_prev(), _Where._Get_node(), _New_node);
+            return iterator{_Where._Get_prev(), _New_node};
+        }
+
+        [[nodiscard]] bool push_back(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace_back(_Value);
+        }
+
+        [[nodiscard]] bool push_back(value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace_back(::std::move(_Value));
+        }
+
+        [[nodiscard]] bool push_front(const value_type& _Value) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            return emplace_front(_Value);
+        }
+
+        [[nodiscard]] bool push_front(value_type&& _Value) noexcept(_Traits::_Is_nothrow_move_constructible) {
+            return emplace_front(::std::move(_Value));
+        }
+
+        template <class... _Types>
+        [[nodiscard]] bool emplace_back(_Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            return emplace(cend(), ::std::forward<_Types>(_Args)...).valid();
+        }
+
+        template <class... _Types>
+        [[nodiscard]] bool emplace_front(_Types&&... _Args) noexcept(
+            _Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            return emplace(cbegin(), ::std::forward<_Types>(_Args)...).valid();
+        }
+
+        iterator erase(const_iterator _Where) noexcept {
+            // Note: Returns an iterator to the element after the erased one.
+            _Node_t* const _Prev = _Where._Get_prev();
+            _Node_t* const _Node = _Where._Get_node();
+            if (!_Node) { // past-the-last element, nothing to erase
+                return iterator{_Prev, nullptr};
+            }
+
+            _Node_t* const _Next = _Node->_Other(_Prev);
+            _Unlink(_Prev, _Node, _Next);
+            return iterator{_Prev, _Next};
+        }
+
+        void pop_back() noexcept {
+            if (_Mystorage._Tail) {
+                _Unlink(_Mystorage._Tail->_Other(nullptr), _Mystorage._Tail, nullptr);
+            }
+        }
+
+        void pop_front() noexcept {
+            if (_Mystorage._Head) {
+                _Unlink(nullptr, _Mystorage._Head, _Mystorage._Head->_Other(nullptr));
+            }
+        }
+
+        template <class _Pr>
+        size_type remove_if(_Pr _Pred) noexcept(::std::is_nothrow_invocable_v<_Pr, const _Ty&>) {
+            size_type _Count = 0;
+            _Node_t* _Prev   = nullptr;
+            _Node_t* _Node   = _Mystorage._Head;
+            while (_Node) {
+                _Node_t* const _Next = _Node->_Other(_Prev);
+                if (_Pred(static_cast<const _Ty&>(_Node->_Value))) { // element found, erase it
+                    _Unlink(_Prev, _Node, _Next);
+                    ++_Count;
+                } else {
+                    _Prev = _Node;
+                }
+
+                _Node = _Next;
+            }
+
+            return _Count;
+        }
+
+        size_type remove(const value_type& _Value) noexcept {
+            return remove_if([_Value](const value_type& _Node_value) noexcept { return _Node_value == _Value; });
+        }
+
+        void reverse() noexcept {
+            // Note: The links are symmetric, swapping both ends reverses the list.
+            ::std::swap(_Mystorage._Head, _Mystorage._Tail);
+        }
+
+        void swap(safe_xor_list& _Other) noexcept {
+            _Mystorage._Swap(_Other._Mystorage);
+        }
+
+    private:
+        struct _Storage_t : _Safe_list_alloc_holder<_Alnode_t> {
+            using _Mybase = _Safe_list_alloc_holder<_Alnode_t>;
+
+            _Node_t* _Head; // pointer to the first node
+            _Node_t* _Tail; // pointer to the last node
+            size_type _Size; // number of elements
+
+            _Storage_t() noexcept : _Mybase(), _Head(nullptr), _Tail(nullptr), _Size(0) {}
+
+            explicit _Storage_t(const _Alnode_t& _Al) noexcept
+                : _Mybase(_Al), _Head(nullptr), _Tail(nullptr), _Size(0) {}
+
+            void _Swap(_Storage_t& _Other) noexcept {
+                using ::std::swap; // enable ADL for allocators
+                swap(this->_Get_allocator(), _Other._Get_allocator());
+                swap(_Head, _Other._Head);
+                swap(_Tail, _Other._Tail);
+                swap(_Size, _Other._Size);
+            }
+        };
+
+        template <class... _Types>
+        _Node_t* _Make_node(_Types&&... _Args) noexcept(_Traits::template _Is_nothrow_constructible<_Types&&...>) {
+            static_assert(_Traits::template
+                _Is_constructible<_Types&&...>, "T must be constructible from Types...");
+            _Node_t* const _Raw = _Mystorage._Get_allocator().allocate(1);
+            return _Raw ? ::new (static_cast<void*>(_Raw)) _Node_t(::std::in_place, ::std::forward<_Types>(_Args)...)
+                        : nullptr;
+        }
+
+        void _Free_node(_Node_t* const _Node) noexcept {
+            _Node->~_Node_t();
+            _Mystorage._Get_allocator().deallocate(_Node, 1);
+        }
+
+        void _Link_between(_Node_t* const _Prev, _Node_t* const _Next, _Node_t* const _New_node) noexcept {
+            // Note: _Prev and _Next must be adjacent, a null-pointer stands for the end of the list.
+            _New_node->_Link = reinterpret_cast<uintptr_t>(_Prev) ^ reinterpret_cast<uintptr_t>(_Next);
+            if (_Prev) {
+                _Prev->_Replace(_Next, _New_node);
+            } else {
+                _Mystorage._Head = _New_node;
+            }
+
+            if (_Next) {
+                _Next->_Replace(_Prev, _New_node);
+            } else {
+                _Mystorage._Tail = _New_node;
+            }
+
+            ++_Mystorage._Size;
+        }
+
+        void _Unlink(_Node_t* const _Prev, _Node_t* const _Node, _Node_t* const _Next) noexcept {
+            if (_Prev) {
+                _Prev->_Replace(_Node, _Next);
+            } else {
+                _Mystorage._Head = _Next;
+            }
+
+            if (_Next) {
+                _Next->_Replace(_Node, _Prev);
+            } else {
+                _Mystorage._Tail = _Prev;
+            }
+
+            --_Mystorage._Size;
+            _Free_node(_Node);
+        }
+
+        bool _Copy_list(const safe_xor_list& _Other) noexcept(_Traits::_Is_nothrow_copy_constructible) {
+            for (const value_type& _Value : _Other) {
+                if (!push_back(_Value)) { // allocation failed
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        _Storage_t _Mystorage;
+    };
+
+    template <class _Ty, class _Alloc>
+    void swap(safe_xor_list<_Ty, _Alloc>& _Left, safe_xor_list<_Ty, _Alloc>& _Right) noexcept {
+        _Left.swap(_Right);
+    }
+
+    template <class _Ty, class _Alloc>
+    typename safe_xor_list<_Ty, _Alloc>::size_type erase(
+        safe_xor_list<_Ty, _Alloc>& _List, const _Ty& _Value) noexcept {
+        return _List.remove(_Value);
+    }
+
+    template <class _Ty, class _Alloc, class _Pr>
+    typename safe_xor_list<_Ty, _Alloc>::size_type erase(
+        safe_xor_list<_Ty, _Alloc>& _List, _Pr _Pred) noexcept(::std::is_nothrow_invocable_v<_Pr, const _Ty&>) {
+        return _List.remove_if(_Pred);
+    }
+} // namespace mjx
+
+#endif // _SAFE_XOR_LIST_HPP_
@@ -0,0 +1,501 @@
+// main.cpp
+
+// Copyright (c) Mateusz Jandura. All rights reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <safe_list.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <list>
+#include <new>
+#include <vector>
+
+// Note: Runs random operations on safe_list<T> while a share of the allocations fails. Every operation
+//       is mirrored on a std::list<T> that never fails. The lists must stay equal and no node may leak.
+//       A second, unchecked run measures the throughput under the same memory pressure.
+//       Usage: safe_list_stress [operations per run] [seed]
+namespace stress {
+    using ::mjx::safe_list;
+
+    class _Random { // xorshift64*, the same sequence on every platform
+    public:
+        explicit _Random(const uint64_t _Seed) noexcept : _State(_Seed ? _Seed : 1) {}
+
+        uint64_t _Next() noexcept {
+            _State ^= _State >> 12;
+            _State ^= _State << 25;
+            _State ^= _State >> 27;
+            return _State * 0x2545F4914F6CDD1DULL;
+        }
+
+        size_t _Below(const size_t _Bound) noexcept { // uniform enough for _Bound much smaller than 2^32
+            return _Bound == 0 ? 0 : static_cast<size_t>((_Next() >> 32) % _Bound);
+        }
+
+    private:
+        uint64_t _State;
+    };
+
+    struct _Fault_plan { // shared by all copies of a _Faulty_allocator
+        _Random _Rng{1};
+        size_t _Rate     = 0; // failed allocations per 1000 requests
+        size_t _Live     = 0; // allocations that were not freed yet
+        size_t _Requests = 0;
+        size_t _Failures = 0;
+    };
+
+    template <class _Ty>
+    class _Faulty_allocator { // fails a random share of the allocations
+    public:
+        using value_type = _Ty;
+
+        _Fault_plan* _Plan;
+
+        explicit _Faulty_allocator(_Fault_plan* const _Plan) noexcept : _Plan(_Plan) {}
+
+        template <class _Other>
+        _Faulty_allocator(const _Faulty_allocator<_Other>& _Other_al) noexcept : _Plan(_Other_al._Plan) {}
+
+        _Ty* allocate(const size_t _Count) noexcept {
+            ++_Plan->_Requests;
+            if (_Plan->_Rng._Below(1000) < _Plan->_Rate) { // inject a failure
+                ++_Plan->_Failures;
+                return nullptr;
+            }
+
+            _Ty* const _Ptr = static_cast<_Ty*>(::operator new(_Count * sizeof(_Ty), ::std::nothrow));
+            if (_Ptr) {
+                ++_Plan->_Live;
+            }
+
+            return _Ptr;
+        }
+
+        void deallocate(_Ty* const _Ptr, size_t) noexcept {
+            --_Plan->_Live;
+            ::operator delete(_Ptr, ::std::nothrow);
+        }
+
+        template <class _Other>
+        bool operator==(const _Faulty_allocator<_Other>& _Other_al) const noexcept {
+            return _Plan == _Other_al._Plan;
+        }
+
+        template <class _Other>
+        bool operator!=(const _Faulty_allocator<_Other>& _Other_al) const noexcept {
+            return _Plan != _Other_al._Plan;
+        }
+    };
+
+    using _Oracle_t = ::std::list<int>;
+
+    template <class _Storage>
+    using _List_t = safe_list<int, _Faulty_allocator<int>, _Storage>;
+
+    inline constexpr size_t _Max_size = 512; // the lists are cleared once they grow beyond it
+    inline constexpr int _Value_range = 32; // small, so that unique() and remove_if() find something
+    inline constexpr size_t _Op_count = 20; // kinds of operations, see _Harness::_Step()
+
+    template <class _Storage>
+    class _Harness {
+    private:
+        using _Iter_t = typename _List_t<_Storage>::iterator;
+
+    public:
+        _Harness(const uint64_t _Seed, const size_t _Rate) noexcept
+            : _Plan(), _Rng(_Seed), _Left(_Faulty_allocator<int>{&_Plan}), _Right(_Faulty_allocator<int>{&_Plan}),
+              _Left_oracle(), _Right_oracle(), _Failed_ops(0) {
+            _Plan._Rng  = _Random{_Seed ^ 0x9E3779B97F4A7C15ULL};
+            _Plan._Rate = _Rate;
+        }
+
+        const _Fault_plan& _Get_plan() const noexcept {
+            return _Plan;
+        }
+
+        size_t _Get_failed_ops() const noexcept {
+            return _Failed_ops;
+        }
+
+        bool _Run_checked(const size_t _Count) {
+            for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+                const size_t _Op = _Step<true>();
+                if (!_Equal(_Left, _Left_oracle) || !_Equal(_Right, _Right_oracle)) {
+                    ::std::fprintf(stderr, "operation %zu (kind %zu): the list differs from std::list\n", _Idx, _Op);
+                    return false;
+                }
+
+                if (!_No_leaks()) {
+                    ::std::fprintf(stderr, "operation %zu (kind %zu): %zu live allocations, expected %zu\n",
+                        _Idx, _Op, _Plan._Live, _Owned_nodes());
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        void _Run_unchecked(const size_t _Count) {
+            for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+                (void) _Step<false>();
+            }
+        }
+
+        bool _Destroy() noexcept {
+            // Note: Every allocation must be returned once both lists are gone.
+            _Left  = _List_t<_Storage>(_Faulty_allocator<int>{&_Plan});
+            _Right = _List_t<_Storage>(_Faulty_allocator<int>{&_Plan});
+            _Left.shrink_to_fit();
+            _Right.shrink_to_fit();
+            return _Plan._Live == 0;
+        }
+
+    private:
+        static bool _Equal(const _List_t<_Storage>& _List, const _Oracle_t& _Oracle) {
+            return _List.size() == _Oracle.size() && ::std::equal(_List.begin(), _List.end(), _Oracle.begin());
+        }
+
+        size_t _Owned_nodes() const noexcept {
+            return _Left.size() + _Left.cached_nodes() + _Right.size() + _Right.cached_nodes();
+        }
+
+        bool _No_leaks() const noexcept {
+            // Note: The heap storage allocates one node at a time, so every allocation is either linked
+            //       or cached. The other storages allocate blocks, their leaks are caught by _Destroy().
+            if constexpr (::std::is_same_v<_Storage, ::mjx::safe_list_heap_storage>) {
+                return _Plan._Live == _Owned_nodes();
+            } else {
+                return true;
+            }
+        }
+
+        int _Value() noexcept {
+            return static_cast<int>(_Rng._Below(_Value_range));
+        }
+
+        ::std::vector<int> _Values() {
+            ::std::vector<int> _Result(1 + _Rng._Below(16));
+            for (int& _Elem : _Result) {
+                _Elem = _Value();
+            }
+
+            return _Result;
+        }
+
+        template <bool _Checked>
+        size_t _Step() {
+            const bool _Use_left      = _Rng._Below(2) == 0;
+            _List_t<_Storage>& _List  = _Use_left ? _Left : _Right;
+            _List_t<_Storage>& _Other = _Use_left ? _Right : _Left;
+            _Oracle_t& _Oracle        = _Use_left ? _Left_oracle : _Right_oracle;
+            _Oracle_t& _Other_oracle  = _Use_left ? _Right_oracle : _Left_oracle;
+            const size_t _Size        = _List.size();
+            const size_t _Pos         = _Rng._Below(_Size + 1); // insertion point, _Size means the end
+            const size_t _Op          = _Size > _Max_size ? 0 : _Rng._Below(_Op_count);
+            bool _Done                = true;
+            switch (_Op) {
+            case 0:
+                _List.clear();
+                if constexpr (_Checked) {
+                    _Oracle.clear();
+                }
+
+                break;
+            case 1:
+                {
+                    const int _Val = _Value();
+                    _Done          = _List.push_back(_Val);
+                    if constexpr (_Checked) {
+                        if (_Done) {
+                            _Oracle.push_back(_Val);
+                        }
+                    }
+                }
+
+                break;
+            case 2:
+                {
+                    const int _Val = _Value();
+                    _Done          = _List.push_front(_Val);
+                    if constexpr (_Checked) {
+                        if (_Done) {
+                            _Oracle.push_front(_Val);
+                        }
+                    }
+                }
+
+                break;
+            case 3:
+                {
+                    const int _Val = _Value();
+                    _Done          = _List.emplace(_List.iterator_at(_Pos), _Val) != _Iter_t{};
+                    if constexpr (_Checked) {
+                        if (_Done) {
+                            _Oracle.insert(::std::next(_Oracle.begin(), _Pos), _Val);
+                        }
+                    }
+                }
+
+                break;
+            case 4:
+                {
+                    const size_t _Count = 1 + _Rng._Below(16);
+                    const int _Val      = _Value();
+                    _Done               = _List.insert(_List.iterator_at(_Pos), _Count, _Val) != _Iter_t{};
+                    if constexpr (_Checked) {
+                        if (_Done) {
+                            _Oracle.insert(::std::next(_Oracle.begin(), _Pos), _Count, _Val);
+                        }
+                    }
+                }
+
+                break;
+            case 5:
+                {
+                    const ::std::vector<int> _Range = _Values();
+                    _Done = _List.insert(_List.iterator_at(_Pos), _Range.begin(), _Range.end()) != _Iter_t{};
+                    if constexpr (_Checked) {
+                        if (_Done) {
+                            _Oracle.insert(::std::next(_Oracle.begin(), _Pos), _Range.begin(), _Range.end());
+                        }
+                    }
+                }
+
+                break;
+            case 6:
+                {
+                    const ::std::vector<int> _Range = _Values();
+                    _Done                           = _List.append_range(_Range);
+                    if constexpr (_Checked) {
+                        if (_Done) {
+                            _Oracle.insert(_Oracle.end(), _Range.begin(), _Range.end());
+                        }
+                    }
+                }
+
+                break;
+            case 7:
+                {
+                    const ::std::vector<int> _Range = _Values();
+                    _Done                           = _List.prepend_range(_Range);
+                    if constexpr (_Checked) {
+                        if (_Done) {
+                            _Oracle.insert(_Oracle.begin(), _Range.begin(), _Range.end());
+                        }
+                    }
+                }
+
+                break;
+            case 8:
+                {
+                    const ::std::vector<int> _Range = _Values();
+                    _Done                           = _List.push_back_n(_Range.begin(), _Range.size());
+                    if constexpr (_Checked) {
+                        if (_Done) {
+                            _Oracle.insert(_Oracle.end(), _Range.begin(), _Range.end());
+                        }
+                    }
+                }
+
+                break;
+            case 9:
+                {
+                    const ::std::vector<int> _Range = _Values();
+                    _Done                           = _List.assign(_Range.begin(), _Range.end());
+                    if constexpr (_Checked) {
+                        if (_Done) {
+                            _Oracle.assign(_Range.begin(), _Range.end());
+                        }
+                    }
+                }
+
+                break;
+            case 10:
+                {
+                    const size_t _New_size = _Rng._Below(_Size + 32);
+                    const int _Val         = _Value();
+                    _Done                  = _List.resize(_New_size, _Val);
+                    if constexpr (_Checked) {
+                        if (_Done) {
+                            _Oracle.resize(_New_size, _Val);
+                        }
+                    }
+                }
+
+                break;
+            case 11:
+                if (_Size > 0) {
+                    const size_t _Where = _Rng._Below(_Size);
+                    (void) _List.erase(_List.iterator_at(_Where));
+                    if constexpr (_Checked) {
+                        _Oracle.erase(::std::next(_Oracle.begin(), _Where));
+                    }
+                }
+
+                break;
+            case 12:
+                {
+                    const size_t _First = _Rng._Below(_Size + 1);
+                    const size_t _Last  = _First + _Rng._Below(_Size - _First + 1);
+                    (void) _List.erase(_List.iterator_at(_First), _List.iterator_at(_Last));
+                    if constexpr (_Checked) {
+                        _Oracle.erase(::std::next(_Oracle.begin(), _First), ::std::next(_Oracle.begin(), _Last));
+                    }
+                }
+
+                break;
+            case 13:
+                {
+                    const int _Divisor = 2 + static_cast<int>(_Rng._Below(5));
+                    auto _Pred         = [_Divisor](const int _Val) noexcept { return _Val % _Divisor == 0; };
+                    (void) _List.remove_if(_Pred);
+                    if constexpr (_Checked) {
+                        _Oracle.remove_if(_Pred);
+                    }
+                }
+
+                break;
+            case 14:
+                (void) _List.unique();
+                if constexpr (_Checked) {
+                    _Oracle.unique();
+                }
+
+                break;
+            case 15:
+                // Note: The hash table of dedupe_unsorted() may fail to allocate, the fallback must agree.
+                (void) _List.dedupe_unsorted();
+                if constexpr (_Checked) {
+                    ::std::vector<int> _Seen;
+                    _Oracle.remove_if([&_Seen](const int _Val) {
+                        if (::std::find(_Seen.begin(), _Seen.end(), _Val) != _Seen.end()) {
+                            return true;
+                        }
+
+                        _Seen.push_back(_Val);
+                        return false;
+                    });
+                }
+
+                break;
+            case 16:
+                _List.sort();
+                if (_Rng._Below(2) == 0) {
+                    _List.reverse();
+                    if constexpr (_Checked) {
+                        _Oracle.sort();
+                        _Oracle.reverse();
+                    }
+                } else if constexpr (_Checked) {
+                    _Oracle.sort();
+                }
+
+                break;
+            case 17:
+                if constexpr (::std::is_same_v<_Storage, ::mjx::safe_list_heap_storage>) {
+                    // Note: Moves a part of the other list, nothing is allocated.
+                    const size_t _Other_size = _Other.size();
+                    const size_t _First      = _Rng._Below(_Other_size + 1);
+                    const size_t _Last       = _First + _Rng._Below(_Other_size - _First + 1);
+                    _Done = _List.splice(_List.iterator_at(_Pos), _Other, _Other.iterator_at(_First),
+                        _Other.iterator_at(_Last), _Last - _First);
+                    if constexpr (_Checked) {
+                        if (_Done) {
+                            _Oracle.splice(::std::next(_Oracle.begin(), _Pos), _Other_oracle,
+                                ::std::next(_Other_oracle.begin(), _First), ::std::next(_Other_oracle.begin(), _Last));
+                        }
+                    }
+                }
+
+                break;
+            case 18:
+                if constexpr (::std::is_same_v<_Storage, ::mjx::safe_list_heap_storage>) {
+                    _List.sort();
+                    _Other.sort();
+                    _Done = _List.merge(_Other);
+                    if constexpr (_Checked) {
+                        _Oracle.sort();
+                        _Other_oracle.sort();
+                        if (_Done) {
+                            _Oracle.merge(_Other_oracle);
+                        }
+                    }
+                }
+
+                break;
+            default:
+                {
+                    // Note: A copy that runs out of memory may stop early, what it holds must still be a prefix.
+                    const _List_t<_Storage> _Copy(_List);
+                    _Done = _Copy.size() == _Size;
+                    if (!::std::equal(_Copy.begin(), _Copy.end(), _List.begin())) {
+                        ::std::fprintf(stderr, "a copy is not a prefix of its source\n");
+                        ::std::exit(EXIT_FAILURE);
+                    }
+                }
+
+                break;
+            }
+
+            if (!_Done) {
+                ++_Failed_ops;
+            }
+
+            return _Op;
+        }
+
+        _Fault_plan _Plan;
+        _Random _Rng;
+        _List_t<_Storage> _Left;
+        _List_t<_Storage> _Right;
+        _Oracle_t _Left_oracle;
+        _Oracle_t _Right_oracle;
+        size_t _Failed_ops;
+    };
+
+    template <class _Storage>
+    bool _Run(const char* const _Name, const size_t _Count, const uint64_t _Seed) {
+        constexpr size_t _Rates[] = {0, 10, 100, 500}; // per 1000 allocations
+        for (const size_t _Rate : _Rates) {
+            bool _Passed;
+            {
+                _Harness<_Storage> _Checked(_Seed, _Rate);
+                _Passed = _Checked._Run_checked(_Count) && _Checked._Destroy();
+                ::std::printf("%-8s fail %4.1f%%: %zu checked operations, %zu failed (%zu of %zu allocations) %s\n",
+                    _Name, static_cast<double>(_Rate) / 10.0, _Count, _Checked._Get_failed_ops(),
+                    _Checked._Get_plan()._Failures, _Checked._Get_plan()._Requests, _Passed ? "ok" : "FAILED");
+            }
+
+            if (!_Passed) {
+                return false;
+            }
+
+            _Harness<_Storage> _Soak(_Seed + 1, _Rate);
+            const auto _Start = ::std::chrono::steady_clock::now();
+            _Soak._Run_unchecked(_Count);
+            const ::std::chrono::duration<double> _Elapsed = ::std::chrono::steady_clock::now() - _Start;
+            if (!_Soak._Destroy()) {
+                ::std::printf("%-8s fail %4.1f%%: the soak run leaked\n", _Name, static_cast<double>(_Rate) / 10.0);
+                return false;
+            }
+
+            ::std::printf("%-8s fail %4.1f%%: %.2f M operations/s unchecked\n", _Name,
+                static_cast<double>(_Rate) / 10.0, static_cast<double>(_Count) / _Elapsed.count() / 1e6);
+        }
+
+        return true;
+    }
+} // namespace stress
+
+int main(int _Argc, char** _Argv) {
+    const size_t _Count   = _Argc > 1 ? static_cast<size_t>(::std::strtoull(_Argv[1], nullptr, 10)) : 200000;
+    const uint64_t _Seed  = _Argc > 2 ? ::std::strtoull(_Argv[2], nullptr, 10) : 20240611;
+    ::std::printf("seed %llu\n", static_cast<unsigned long long>(_Seed));
+    const bool _Passed = ::stress::_Run<::mjx::safe_list_heap_storage>("heap", _Count, _Seed)
+                      && ::stress::_Run<::mjx::safe_list_slab_storage<256>>("slab", _Count, _Seed);
+    return _Passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -3,11 +3,41 @@
 // Copyright (c) Mateusz Jandura. All rights reserved.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <safe_async_list.hpp>
+#include <safe_concurrent_list.hpp>
+#include <safe_forward_list.hpp>
+#include <safe_index_list.hpp>
+#include <safe_intrusive_list.hpp>
 #include <safe_list.hpp>
+#include <safe_list_parallel.hpp>
+#include <safe_list_snapshot.hpp>
+#include <safe_list_view.hpp>
+#include <safe_magazine_allocator.hpp>
+#include <safe_mpsc_list.hpp>
+#include <safe_sorted_list.hpp>
+#include <safe_unrolled_list.hpp>
+#include <safe_xor_list.hpp>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace tests {
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+    using ::mjx::safe_async_list;
+#endif // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+    using ::mjx::safe_concurrent_list;
+    using ::mjx::safe_forward_list;
+    using ::mjx::safe_index_list;
+    using ::mjx::safe_intrusive_list;
     using ::mjx::safe_list;
+    using ::mjx::safe_mpsc_list;
+    using ::mjx::safe_sorted_list;
+    using ::mjx::safe_unrolled_list;
+    using ::mjx::safe_xor_list;
 
     template <class _InIt1, class _InIt2>
     constexpr bool _Compare_arrays(_InIt1 _Left_first, const _InIt1 _Left_last, _InIt2 _Right) noexcept {
@@ -34,11 +64,79 @@ namespace tests {
             return _Array + _Size;
         }
 
-        static constexpr ::std::initializer_list<int> _Init_list() noexcept {
-            return ::std::initializer_list<int>(_Array, _Array + _Size);
+        static ::std::initializer_list<int> _Init_list() noexcept {
+            // Note: Only a braced list makes an std::initializer_list portably, a pointer range works
+            //       with MSVC alone. The list is static, so its array outlives every caller.
+            static constexpr ::std::initializer_list<int> _List = {
+                251, 515, 25, 16232, 5156, 2551, 251, 5621, 6722, 915
+            };
+            static_assert(_List.size() == _Size && _Compare_arrays(_List.begin(), _List.end(), _Array),
+                "the list must hold the same values as the array.");
+            return _List;
+        }
+    };
+
+    template <class _Ty>
+    class _Counting_allocator { // counts live allocations, optionally fails after the given limit
+    public:
+        using value_type = _Ty;
+
+        size_t* _Live;
+        size_t _Limit;
+
+        _Counting_allocator(size_t* const _Live, const size_t _Limit = static_cast<size_t>(-1)) noexcept
+            : _Live(_Live), _Limit(_Limit) {}
+
+        template <class _Other>
+        _Counting_allocator(const _Counting_allocator<_Other>& _Other_al) noexcept
+            : _Live(_Other_al._Live), _Limit(_Other_al._Limit) {}
+
+        _Ty* allocate(const size_t _Count) noexcept {
+            if (*_Live >= _Limit) { // simulate allocation failure
+                return nullptr;
+            }
+
+            ++*_Live;
+            return static_cast<_Ty*>(::operator new(_Count * sizeof(_Ty), ::std::nothrow));
+        }
+
+        void deallocate(_Ty* const _Ptr, size_t) noexcept {
+            --*_Live;
+            ::operator delete(_Ptr, ::std::nothrow);
+        }
+
+        template <class _Other>
+        bool operator==(const _Counting_allocator<_Other>& _Other_al) const noexcept {
+            return _Live == _Other_al._Live;
+        }
+
+        template <class _Other>
+        bool operator!=(const _Counting_allocator<_Other>& _Other_al) const noexcept {
+            return _Live != _Other_al._Live;
         }
     };
 
+    struct _Move_counter { // counts constructions, copies and moves
+        static size_t _Copies;
+        static size_t _Moves;
+
+        int _Left;
+        int _Right;
+
+        _Move_counter(const int _Left, const int _Right) noexcept : _Left(_Left), _Right(_Right) {}
+
+        _Move_counter(const _Move_counter& _Other) noexcept : _Left(_Other._Left), _Right(_Other._Right) {
+            ++_Copies;
+        }
+
+        _Move_counter(_Move_counter&& _Other) noexcept : _Left(_Other._Left), _Right(_Other._Right) {
+            ++_Moves;
+        }
+    };
+
+    size_t _Move_counter::_Copies = 0;
+    size_t _Move_counter::_Moves  = 0;
+
     inline namespace accessors {
         TEST(accessors, non_empty_list_front) {
             safe_list<int> _List(_Sample_data::_Init_list());
@@ -67,6 +165,443 @@ namespace tests {
         }
     } // namespace accessors
 
+    inline namespace allocators {
+        TEST(allocators, default_allocator_is_empty) {
+            GTEST_EXPECT_TRUE(sizeof(safe_list<int>) < sizeof(safe_list<int, _Counting_allocator<int>>));
+        }
+
+        TEST(allocators, custom_allocator_owns_nodes) {
+            size_t _Live = 0;
+            {
+                safe_list<int, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live});
+                GTEST_ASSERT_TRUE(_List.assign(_Sample_data::_Begin(), _Sample_data::_End()));
+                GTEST_EXPECT_TRUE(_Live == _Sample_data::_Size);
+                _List.pop_front();
+                GTEST_EXPECT_TRUE(_Live == _Sample_data::_Size - 1);
+                safe_list<int, _Counting_allocator<int>> _Moved(::std::move(_List));
+                GTEST_EXPECT_TRUE(_Moved.get_allocator() == _Counting_allocator<int>{&_Live});
+                GTEST_EXPECT_TRUE(_Live == _Sample_data::_Size - 1);
+            }
+
+            GTEST_EXPECT_TRUE(_Live == 0);
+        }
+
+        TEST(allocators, allocation_failure) {
+            size_t _Live = 0;
+            safe_list<int, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live, 3});
+            GTEST_ASSERT_TRUE(_List.push_back(1));
+            GTEST_ASSERT_TRUE(_List.push_front(2));
+            GTEST_ASSERT_TRUE(_List.insert(_List.cend(), 3).valid());
+            GTEST_EXPECT_TRUE(!_List.push_back(4));
+            GTEST_EXPECT_TRUE(!_List.insert(_List.cbegin(), 5).valid());
+            GTEST_EXPECT_TRUE(_List.size() == 3);
+            GTEST_EXPECT_TRUE(_Live == 3);
+        }
+
+        TEST(allocators, node_cache_reuses_nodes) {
+            size_t _Live = 0;
+            safe_list<int, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live});
+            GTEST_ASSERT_TRUE(_List.reserve_nodes(4));
+            GTEST_EXPECT_TRUE(_List.cached_nodes() == 4);
+            GTEST_EXPECT_TRUE(_Live == 4);
+            for (int _Value = 0; _Value < 100; ++_Value) { // steady-state queue, no new allocations
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+                GTEST_ASSERT_TRUE(_List.push_back(_Value + 1));
+                GTEST_EXPECT_TRUE(*_List.front() == _Value);
+                _List.pop_front();
+                _List.pop_front();
+            }
+
+            GTEST_EXPECT_TRUE(_Live == 4);
+            GTEST_EXPECT_TRUE(_List.cached_nodes() == 4);
+            _List.shrink_to_fit();
+            GTEST_EXPECT_TRUE(_Live == 0);
+        }
+
+        TEST(allocators, node_cache_is_bounded) {
+            size_t _Live = 0;
+            safe_list<int, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live});
+            _List.node_cache_limit(2);
+            GTEST_ASSERT_TRUE(_List.assign(_Sample_data::_Begin(), _Sample_data::_End()));
+            _List.clear();
+            GTEST_EXPECT_TRUE(_List.cached_nodes() == 2);
+            GTEST_EXPECT_TRUE(_Live == 2);
+            _List.node_cache_limit(0);
+            GTEST_EXPECT_TRUE(_Live == 0);
+        }
+
+        TEST(allocators, node_cache_reserve_failure) {
+            size_t _Live = 0;
+            safe_list<int, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live, 3});
+            GTEST_EXPECT_TRUE(!_List.reserve_nodes(5));
+            GTEST_EXPECT_TRUE(_List.cached_nodes() == 3);
+            GTEST_ASSERT_TRUE(_List.push_back(1));
+            GTEST_EXPECT_TRUE(_List.cached_nodes() == 2);
+        }
+
+        TEST(allocators, slab_storage_is_contiguous) {
+            safe_list<int, ::mjx::safe_allocator<int>, ::mjx::safe_list_slab_storage<4096>> _List;
+            for (int _Value = 0; _Value < 64; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+            }
+
+            auto _Iter = _List.cbegin();
+            for (auto _Prev = _Iter++; _Iter != _List.cend(); _Prev = _Iter++) { // nodes follow each other
+                GTEST_EXPECT_TRUE(reinterpret_cast<const char*>(_Iter._Get_node())
+                    - reinterpret_cast<const char*>(_Prev._Get_node()) == sizeof(*_Iter._Get_node()));
+            }
+        }
+
+        TEST(allocators, slab_storage_releases_slabs) {
+            size_t _Live = 0;
+            safe_list<int, _Counting_allocator<int>, ::mjx::safe_list_slab_storage<256>> _List(
+                _Counting_allocator<int>{&_Live});
+            for (int _Value = 0; _Value < 100; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+            }
+
+            const size_t _Slabs = _Live;
+            GTEST_EXPECT_TRUE(_Slabs > 1 && _Slabs < 100);
+            _List.remove_if(
+                [](const int _Value) noexcept {
+                    return _Value % 2 == 0;
+                }
+            );
+            GTEST_ASSERT_TRUE(_List.push_back(100)); // reuses a spent node
+            GTEST_EXPECT_TRUE(_Live == _Slabs);
+            _List.clear();
+            GTEST_EXPECT_TRUE(_Live == 0);
+        }
+
+        TEST(allocators, slab_storage_reserve) {
+            size_t _Live = 0;
+            safe_list<int, _Counting_allocator<int>, ::mjx::safe_list_slab_storage<256>> _List(
+                _Counting_allocator<int>{&_Live});
+            GTEST_ASSERT_TRUE(_List.reserve_nodes(50));
+            GTEST_EXPECT_TRUE(_List.cached_nodes() >= 50);
+            const size_t _Slabs = _Live;
+            for (int _Value = 0; _Value < 50; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+            }
+
+            GTEST_EXPECT_TRUE(_Live == _Slabs);
+            _List.clear();
+            _List.shrink_to_fit();
+            GTEST_EXPECT_TRUE(_Live == 0);
+        }
+
+        TEST(allocators, inline_storage_spills_to_heap) {
+            size_t _Live = 0;
+            ::mjx::safe_small_list<int, 4, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live});
+            for (int _Value = 0; _Value < 4; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+            }
+
+            GTEST_EXPECT_TRUE(_Live == 0); // every node is inline
+            GTEST_ASSERT_TRUE(_List.push_back(4));
+            GTEST_ASSERT_TRUE(_List.push_back(5));
+            GTEST_EXPECT_TRUE(_Live == 2);
+            _List.pop_front();
+            GTEST_ASSERT_TRUE(_List.push_front(-1)); // reuses the spent slot
+            GTEST_EXPECT_TRUE(_Live == 2);
+            constexpr int _Expected[] = {-1, 1, 2, 3, 4, 5};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            _List.clear();
+            GTEST_EXPECT_TRUE(_Live == 0);
+            GTEST_ASSERT_TRUE(_List.reserve_nodes(6)); // caches only the nodes that do not fit inline
+            GTEST_EXPECT_TRUE(_Live == 2 && _List.cached_nodes() == 6);
+            _List.shrink_to_fit();
+            GTEST_EXPECT_TRUE(_Live == 0);
+        }
+
+        TEST(allocators, inline_storage_move) {
+            size_t _Live = 0;
+            using _List_t = ::mjx::safe_small_list<::std::string, 3, _Counting_allocator<::std::string>>;
+            _List_t _List(_Counting_allocator<::std::string>{&_Live});
+            for (int _Value = 0; _Value < 5; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(::std::to_string(_Value)));
+            }
+
+            const char* const _Expected[] = {"0", "1", "2", "3", "4"};
+            _List_t _Moved = ::std::move(_List); // the inline values are moved, the heap nodes taken over
+            GTEST_EXPECT_TRUE(_List.empty() && _Live == 2);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Moved.begin(), _Moved.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Moved.crbegin(), ++++_Moved.crbegin(), ::std::rbegin(_Expected)));
+            GTEST_ASSERT_TRUE(_List.push_back("a")); // the moved-from list is usable
+            _List = ::std::move(_Moved); // "a" is destroyed
+            GTEST_EXPECT_TRUE(_Moved.empty() && _List.size() == 5);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_ASSERT_TRUE(_Moved.push_back("b"));
+            swap(_List, _Moved);
+            GTEST_EXPECT_TRUE(_List.size() == 1 && *_List.front() == "b");
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Moved.begin(), _Moved.end(), _Expected));
+            const _List_t _Copy = _Moved;
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Copy.begin(), _Copy.end(), _Expected));
+            _Moved.clear();
+            _List.clear();
+            GTEST_EXPECT_TRUE(_Live == 2); // the copy spilled two nodes
+        }
+
+        TEST(allocators, bounded_storage) {
+            size_t _Live = 0;
+            using _List_t = safe_list<int, _Counting_allocator<int>, ::mjx::safe_list_bounded_storage>;
+            _List_t _List(_Counting_allocator<int>{&_Live});
+            GTEST_EXPECT_TRUE(_List.max_size() == 0 && !_List.push_back(0)); // no capacity yet
+            GTEST_ASSERT_TRUE(_List.reserve_nodes(4)); // one block for every node
+            GTEST_EXPECT_TRUE(_Live == 1 && _List.max_size() == 4 && _List.cached_nodes() == 4);
+            GTEST_EXPECT_TRUE(!_List.reserve_nodes(5)); // the capacity is fixed
+            for (int _Value = 0; _Value < 4; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+            }
+
+            GTEST_EXPECT_TRUE(!_List.push_back(4) && !_List.push_front(-1)); // full
+            GTEST_EXPECT_TRUE(!_List.resize(5) && _List.size() == 4);
+            _List.pop_front();
+            GTEST_ASSERT_TRUE(_List.push_back(4)); // reuses the spent node
+            GTEST_EXPECT_TRUE(_Live == 1);
+            constexpr int _Expected[] = {1, 2, 3, 4};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            const _List_t _Copy = _List; // the copy gets its own block
+            GTEST_EXPECT_TRUE(_Live == 2 && _Copy.max_size() == 4);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Copy.begin(), _Copy.end(), _Expected));
+            _List_t _Moved = ::std::move(_List); // the block travels with the nodes
+            GTEST_EXPECT_TRUE(_List.max_size() == 0 && _Moved.size() == 4 && _Live == 2);
+            _Moved.shrink_to_fit(); // the block is in use
+            GTEST_EXPECT_TRUE(_Live == 2);
+            _Moved.clear();
+            GTEST_EXPECT_TRUE(_Moved.cached_nodes() == 4);
+            _Moved.shrink_to_fit();
+            GTEST_EXPECT_TRUE(_Live == 1 && _Moved.max_size() == 0);
+        }
+
+        TEST(allocators, bounded_storage_capacity) {
+            size_t _Live = 0;
+            using _List_t = safe_list<int, _Counting_allocator<int>, ::mjx::safe_list_bounded_storage>;
+            _List_t _List(::mjx::safe_list_reserve, 4, _Counting_allocator<int>{&_Live});
+            GTEST_EXPECT_TRUE(_Live == 1 && _List.max_size() == 4 && _List.empty()); // allocated up front
+            GTEST_ASSERT_TRUE(_List.push_back(1) && _List.push_back(2));
+            _List_t _Target(_Counting_allocator<int>{&_Live});
+            _Target = _List; // the target gets a block of the same capacity
+            GTEST_EXPECT_TRUE(_Target.max_size() == 4 && _Target.size() == 2 && _Live == 2);
+            constexpr int _Expected[] = {1, 2};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Target.begin(), _Target.end(), _Expected));
+            _List_t _Small(::mjx::safe_list_reserve, 1, _Counting_allocator<int>{&_Live});
+            _Small = _List; // the capacity is fixed, only the first element fits
+            GTEST_EXPECT_TRUE(_Small.max_size() == 1 && _Small.size() == 1 && *_Small.front() == 1);
+            _List_t _Failed(::mjx::safe_list_reserve, 4, _Counting_allocator<int>{&_Live, 0});
+            GTEST_EXPECT_TRUE(_Failed.max_size() == 0); // the block could not be allocated
+        }
+
+        TEST(allocators, bounded_storage_handles) {
+            using _List_t = safe_list<::std::string, ::mjx::safe_allocator<::std::string>,
+                ::mjx::safe_list_bounded_storage>;
+            _List_t _List;
+            GTEST_ASSERT_TRUE(_List.reserve_nodes(8));
+            GTEST_ASSERT_TRUE(_List.push_back("a"));
+            GTEST_ASSERT_TRUE(_List.push_back("b"));
+            const ::mjx::safe_list_handle _First  = _List.handle(_List.cbegin());
+            const ::mjx::safe_list_handle _Second = _List.handle(++_List.cbegin());
+            GTEST_EXPECT_TRUE(_First != _Second && !_List.find(::mjx::safe_list_handle{}).valid());
+            GTEST_EXPECT_TRUE(_List.find(_First) == _List.begin() && *_List.find(_Second) == "b");
+            GTEST_ASSERT_TRUE(_List.erase(_First));
+            GTEST_EXPECT_TRUE(!_List.erase(_First) && !_List.find(_First).valid()); // stale
+            GTEST_ASSERT_TRUE(_List.push_front("c")); // reuses the node of "a"
+            GTEST_EXPECT_TRUE(!_List.find(_First).valid() && _List.handle(_List.cbegin()) != _First);
+            _List_t _Moved = ::std::move(_List); // the handles follow their elements
+            GTEST_EXPECT_TRUE(*_Moved.find(_Second) == "b" && !_List.find(_Second).valid());
+            const _List_t _Copy = _Moved; // the copy has its own block
+            GTEST_EXPECT_TRUE(!_Copy.find(_Second).valid());
+            const ::mjx::safe_list_handle _Third = _Moved.handle(_Moved.cbegin());
+            _Moved.clear();
+            GTEST_EXPECT_TRUE(!_Moved.find(_Second).valid() && !_Moved.find(_Third).valid());
+            GTEST_ASSERT_TRUE(_Moved.push_back("d"));
+            GTEST_ASSERT_TRUE(_Moved.erase(_Moved.handle(_Moved.cbegin()))); // the only element
+            GTEST_EXPECT_TRUE(_Moved.empty() && !_Moved.begin().valid() && !_Moved.cend().valid());
+        }
+
+        TEST(allocators, magazine_allocator_reuses_blocks) {
+            using _List_t = safe_list<int, ::mjx::safe_magazine_allocator<int>>;
+            using _Node_t = ::std::remove_pointer_t<decltype(::std::declval<_List_t::iterator&>()._Get_node())>;
+            using _Node_al = ::mjx::safe_magazine_allocator<_Node_t>; // the allocator the list rebinds to
+            _List_t _List;
+            GTEST_ASSERT_TRUE(_List.push_back(1));
+            const int* const _First = _List.front();
+            _List.pop_back(); // the node goes to this thread's cache
+            GTEST_EXPECT_TRUE(_Node_al::thread_cache_size() >= 1);
+            GTEST_ASSERT_TRUE(_List.push_back(2));
+            GTEST_EXPECT_TRUE(_List.front() == _First); // and comes back first
+            for (int _Value = 0; _Value < 1000; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+            }
+
+            _List.clear();
+            GTEST_EXPECT_TRUE(_Node_al::thread_cache_size() <= 64); // two magazines, the rest went to the depot
+            _Node_al::flush_thread_cache();
+            GTEST_EXPECT_TRUE(_Node_al::thread_cache_size() == 0);
+        }
+
+        TEST(allocators, magazine_allocator_cross_thread) {
+            // Note: Workers build the lists and the main thread frees them, the blocks flow back through the depot.
+            using _List_t = safe_list<int, ::mjx::safe_magazine_allocator<int>>;
+            constexpr size_t _Workers = 4;
+            constexpr int _Count      = 2000;
+            for (int _Round = 0; _Round < 5; ++_Round) {
+                _List_t _Lists[_Workers];
+                ::std::thread _Threads[_Workers];
+                for (size_t _Idx = 0; _Idx < _Workers; ++_Idx) {
+                    _Threads[_Idx] = ::std::thread([&_Target = _Lists[_Idx]]() noexcept {
+                        for (int _Value = 0; _Value < _Count; ++_Value) {
+                            (void) _Target.push_back(_Value);
+                        }
+                    });
+                }
+
+                for (::std::thread& _Thread : _Threads) {
+                    _Thread.join();
+                }
+
+                for (const _List_t& _List : _Lists) {
+                    GTEST_ASSERT_TRUE(_List.size() == static_cast<size_t>(_Count));
+                    GTEST_EXPECT_TRUE(*_List.front() == 0 && *_List.back() == _Count - 1);
+                }
+            } // the main thread frees every node here
+        }
+    } // namespace allocators
+
+    inline namespace stats {
+        template <size_t _Sample_period = 0>
+        using _Stats_policy = ::mjx::safe_list_policy<::mjx::safe_list_heap_storage,
+            ::mjx::safe_list_counting_stats<_Sample_period>>;
+
+        TEST(stats, disabled_by_default) {
+            GTEST_EXPECT_TRUE((sizeof(safe_list<int, ::mjx::safe_allocator<int>, ::mjx::safe_list_policy<>>)
+                               == sizeof(safe_list<int>)));
+            safe_list<int> _List = _Sample_data::_Init_list();
+            GTEST_EXPECT_TRUE(_List.stats().allocations == 0);
+            GTEST_EXPECT_TRUE(_List.stats().peak_size == 0);
+        }
+
+        TEST(stats, counters) {
+            size_t _Live = 0;
+            safe_list<int, _Counting_allocator<int>, _Stats_policy<>> _List(_Counting_allocator<int>{&_Live, 3});
+            GTEST_ASSERT_TRUE(_List.push_back(1));
+            GTEST_ASSERT_TRUE(_List.push_back(2));
+            GTEST_ASSERT_TRUE(_List.push_front(0));
+            GTEST_EXPECT_TRUE(!_List.push_back(3)); // allocation failed
+            _List.pop_back();
+            ::mjx::safe_list_stats _Stats = _List.stats();
+            GTEST_EXPECT_TRUE(_Stats.allocations == 3);
+            GTEST_EXPECT_TRUE(_Stats.failed_allocations == 1);
+            GTEST_EXPECT_TRUE(_Stats.frees == 1);
+            GTEST_EXPECT_TRUE(_Stats.peak_size == 3);
+            GTEST_EXPECT_TRUE(_Stats.sampled_operations == 0); // sampling is disabled
+            _List.clear();
+            GTEST_EXPECT_TRUE(_List.stats().frees == 3);
+            _List.reset_stats();
+            _Stats = _List.stats();
+            GTEST_EXPECT_TRUE(_Stats.allocations == 0 && _Stats.frees == 0 && _Stats.peak_size == 0);
+        }
+
+        TEST(stats, slab_storage_and_sampling) {
+            using _Policy = ::mjx::safe_list_policy<::mjx::safe_list_slab_storage<256>,
+                ::mjx::safe_list_counting_stats<2>>;
+            safe_list<int, ::mjx::safe_allocator<int>, _Policy> _List;
+            for (int _Value = 0; _Value < 10; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+            }
+
+            _List.clear(); // releases the slabs at once
+            const ::mjx::safe_list_stats _Stats = _List.stats();
+            GTEST_EXPECT_TRUE(_Stats.allocations == 10 && _Stats.frees == 10);
+            GTEST_EXPECT_TRUE(_Stats.peak_size == 10);
+            GTEST_EXPECT_TRUE(_Stats.sampled_operations == 5); // every second operation of 11
+        }
+        TEST(stats, memory_usage) {
+            safe_list<int> _List;
+            GTEST_EXPECT_TRUE(_List.memory_usage() == 0);
+            GTEST_ASSERT_TRUE(_List.push_back(0));
+            const size_t _Node_bytes = _List.memory_usage();
+            GTEST_EXPECT_TRUE(_Node_bytes >= sizeof(int) + 2 * sizeof(void*));
+            GTEST_ASSERT_TRUE(_List.push_back(1));
+            GTEST_ASSERT_TRUE(_List.push_back(2));
+            GTEST_EXPECT_TRUE(_List.memory_usage() == 3 * _Node_bytes);
+            _List.node_cache_limit(4);
+            _List.pop_back();
+            GTEST_EXPECT_TRUE(_List.memory_usage() == 3 * _Node_bytes); // the spent node is cached
+            _List.shrink_to_fit();
+            GTEST_EXPECT_TRUE(_List.memory_usage() == 2 * _Node_bytes);
+
+            safe_list<int, ::mjx::safe_allocator<int>, ::mjx::safe_list_inline_storage<4>> _Inline_list;
+            for (int _Value = 0; _Value < 4; ++_Value) {
+                GTEST_ASSERT_TRUE(_Inline_list.push_back(_Value));
+            }
+
+            GTEST_EXPECT_TRUE(_Inline_list.memory_usage() == 0); // the slots are part of the list
+            GTEST_ASSERT_TRUE(_Inline_list.push_back(4));
+            GTEST_EXPECT_TRUE(_Inline_list.memory_usage() > 0);
+
+            safe_list<int, ::mjx::safe_allocator<int>, ::mjx::safe_list_slab_storage<256>> _Slab_list;
+            GTEST_ASSERT_TRUE(_Slab_list.push_back(0));
+            const size_t _Slab_bytes = _Slab_list.memory_usage();
+            GTEST_EXPECT_TRUE(_Slab_bytes > 0 && _Slab_bytes <= 256); // a whole slab
+            GTEST_ASSERT_TRUE(_Slab_list.push_back(1));
+            GTEST_EXPECT_TRUE(_Slab_list.memory_usage() == _Slab_bytes); // the same slab
+
+            safe_list<int, ::mjx::safe_allocator<int>, ::mjx::safe_list_bounded_storage> _Bounded_list;
+            GTEST_ASSERT_TRUE(_Bounded_list.reserve_nodes(8));
+            GTEST_EXPECT_TRUE(_Bounded_list.memory_usage() >= 8 * (sizeof(int) + 2 * sizeof(void*)));
+        }
+
+        TEST(stats, memory_budget) {
+            using _Policy = ::mjx::safe_list_policy<::mjx::safe_list_heap_storage,
+                ::mjx::safe_list_counting_stats<>, ::mjx::safe_list_no_index, ::mjx::safe_list_memory_budget>;
+            safe_list<int, ::mjx::safe_allocator<int>, _Policy> _List;
+            GTEST_EXPECT_TRUE(_List.memory_budget() == static_cast<size_t>(-1)); // unlimited until set
+            GTEST_ASSERT_TRUE(_List.push_back(0));
+            const size_t _Node_bytes = _List.memory_usage();
+            _List.memory_budget(3 * _Node_bytes);
+            GTEST_ASSERT_TRUE(_List.push_back(1));
+            GTEST_ASSERT_TRUE(_List.push_back(2));
+            GTEST_EXPECT_TRUE(!_List.push_back(3)); // over the budget
+            GTEST_EXPECT_TRUE(!_List.insert(_List.end(), size_t{2}, 3)); // all or none
+            GTEST_EXPECT_TRUE(!_List.reserve_nodes(4));
+            GTEST_EXPECT_TRUE(_List.size() == 3 && _List.memory_usage() == 3 * _Node_bytes);
+            GTEST_EXPECT_TRUE(_List.stats().failed_allocations >= 2);
+
+            _List.node_cache_limit(1);
+            _List.pop_front();
+            _List.memory_budget(2 * _Node_bytes); // below the usage, nothing is freed
+            GTEST_EXPECT_TRUE(_List.memory_usage() == 3 * _Node_bytes);
+            GTEST_EXPECT_TRUE(_List.push_back(3)); // reuses the cached node
+            GTEST_EXPECT_TRUE(!_List.push_back(4));
+            _List.pop_front();
+            _List.shrink_to_fit();
+            GTEST_EXPECT_TRUE(_List.memory_usage() == 2 * _Node_bytes);
+            GTEST_EXPECT_TRUE(!_List.push_back(4)); // still at the budget
+        }
+
+        TEST(stats, memory_budget_index) {
+            using _Policy = ::mjx::safe_list_policy<::mjx::safe_list_heap_storage, ::mjx::safe_list_no_stats,
+                ::mjx::safe_list_skip_index<4>, ::mjx::safe_list_memory_budget>;
+            safe_list<int, ::mjx::safe_allocator<int>, _Policy> _List;
+            for (int _Value = 0; _Value < 64; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+            }
+
+            const size_t _Nodes_bytes = _List.memory_usage();
+            _List.memory_budget(_Nodes_bytes); // no room for the index
+            for (int _Pos = 0; _Pos < 64; ++_Pos) { // the lookups walk the list instead
+                GTEST_EXPECT_TRUE(*_List.iterator_at(static_cast<size_t>(_Pos)) == _Pos);
+            }
+
+            GTEST_EXPECT_TRUE(_List.memory_usage() == _Nodes_bytes);
+            _List.memory_budget(static_cast<size_t>(-1));
+            GTEST_EXPECT_TRUE(*_List.iterator_at(30) == 30); // nearer the head than the tail
+            GTEST_EXPECT_TRUE(_List.memory_usage() > _Nodes_bytes); // the index has grown
+        }
+
+    } // namespace stats
+
     inline namespace capacity {
         TEST(capacity, ctor_non_empty_list) {
             safe_list<int> _List(10, 251);
@@ -148,6 +683,59 @@ namespace tests {
             GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
         }
 
+        TEST(modifiers, emplace_in_place) {
+            safe_list<_Move_counter> _List;
+            _Move_counter::_Copies = 0;
+            _Move_counter::_Moves  = 0;
+            GTEST_ASSERT_TRUE(_List.emplace_back(1, 2));
+            GTEST_ASSERT_TRUE(_List.emplace_front(3, 4));
+            GTEST_ASSERT_TRUE(_List.emplace(++_List.cbegin(), 5, 6).valid());
+            GTEST_EXPECT_TRUE(_Move_counter::_Copies == 0);
+            GTEST_EXPECT_TRUE(_Move_counter::_Moves == 0);
+            GTEST_EXPECT_TRUE(_List.size() == 3);
+            GTEST_EXPECT_TRUE(_List.front()->_Left == 3);
+            GTEST_EXPECT_TRUE((++_List.cbegin())->_Left == 5);
+            GTEST_EXPECT_TRUE(_List.back()->_Right == 2);
+        }
+
+        TEST(modifiers, emplace_uses_parentheses) {
+            safe_list<::std::vector<int>> _List;
+            GTEST_ASSERT_TRUE(_List.emplace_back(size_t{3}, 1)); // vector(3, 1), not vector{3, 1}
+            GTEST_EXPECT_TRUE(_List.front()->size() == 3);
+        }
+
+        TEST(modifiers, ranges) {
+            safe_list<int> _List;
+            const ::std::vector<int> _Middle = {3, 4};
+            constexpr int _Front[]           = {1, 2};
+            GTEST_ASSERT_TRUE(_List.assign_range(_Middle));
+            GTEST_ASSERT_TRUE(_List.prepend_range(_Front));
+            GTEST_ASSERT_TRUE(_List.append_range(::std::vector<int>{7, 8}));
+            auto _Iter = _List.insert_range(++++++++_List.cbegin(), ::std::vector<int>{5, 6});
+            GTEST_ASSERT_TRUE(_Iter.valid());
+            GTEST_EXPECT_TRUE(*_Iter == 5);
+            constexpr int _Expected[] = {1, 2, 3, 4, 5, 6, 7, 8};
+            GTEST_EXPECT_TRUE(_List.size() == 8);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.rbegin(), _List.rend(), ::std::rbegin(_Expected)));
+        }
+
+        TEST(modifiers, bulk_insert_rollback) {
+            size_t _Live = 0;
+            safe_list<int, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live, 12});
+            GTEST_ASSERT_TRUE(_List.assign(_Sample_data::_Begin(), _Sample_data::_End()));
+            GTEST_EXPECT_TRUE(!_List.insert(++_List.cbegin(), size_t{3}, 1).valid());
+            GTEST_EXPECT_TRUE(!_List.insert(_List.cbegin(), _Sample_data::_Begin(), _Sample_data::_End()).valid());
+            GTEST_EXPECT_TRUE(!_List.append_range(_Sample_data::_Array));
+            GTEST_EXPECT_TRUE(!_List.resize(15));
+            GTEST_EXPECT_TRUE(!_List.assign(size_t{13}, 1)); // needs 3 new nodes, only 2 can be allocated
+            GTEST_EXPECT_TRUE(_List.size() == _Sample_data::_Size);
+            GTEST_EXPECT_TRUE(_Live == _Sample_data::_Size);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Sample_data::_Array));
+            GTEST_EXPECT_TRUE(_List.resize(12, 7));
+            GTEST_EXPECT_TRUE(*_List.back() == 7);
+        }
+
         TEST(modifiers, erase_empty_list) {
             safe_list<int> _List;
             GTEST_EXPECT_TRUE(!_List.erase(_List.cbegin()).valid()); // should points to a null-pointer
@@ -159,6 +747,7 @@ namespace tests {
             GTEST_EXPECT_TRUE(*_List.cbegin() == 515);
         }
 
+#ifndef SAFE_LIST_CHECKED_ITERATORS // erase(cend()) aborts with the checks, see checked_iterators
         TEST(modifiers, erase_end) {
             safe_list<int> _List(_Sample_data::_Init_list());
             _List.erase(_List.cend());
@@ -169,6 +758,7 @@ namespace tests {
 
             GTEST_EXPECT_TRUE(*_Iter == 6722);
         }
+#endif // SAFE_LIST_CHECKED_ITERATORS
 
         TEST(modifiers, erase_range) {
             safe_list<int> _List(_Sample_data::_Init_list());
@@ -184,6 +774,50 @@ namespace tests {
             GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
         }
 
+        TEST(modifiers, erase_range_to_end) {
+            safe_list<int> _List(_Sample_data::_Init_list());
+            auto _First = _List.cbegin();
+            for (uint8_t _Count = 0; _Count < 7; ++_Count) { // find 8-th node
+                ++_First;
+            }
+
+            GTEST_EXPECT_TRUE(!_List.erase(_First, _List.cend()).valid()); // returns end()
+            GTEST_EXPECT_TRUE(_List.size() == 7);
+            GTEST_EXPECT_TRUE(*_List.back() == 251);
+            auto _Last = _List.cbegin();
+            while (_Last._Get_node()->_Next) { // find last valid node
+                ++_Last;
+            }
+
+            GTEST_EXPECT_TRUE(!_List.erase(_Last).valid()); // the last element is followed by end()
+            GTEST_EXPECT_TRUE(*_List.back() == 2551);
+            GTEST_EXPECT_TRUE(!_List.erase(_List.cbegin(), _List.cend()).valid());
+            GTEST_EXPECT_TRUE(_List.empty());
+            GTEST_EXPECT_TRUE(_List.begin() == _List.end());
+        }
+
+        TEST(modifiers, slice) {
+            size_t _Live = 0;
+            safe_list<int, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live});
+            GTEST_ASSERT_TRUE(_List.assign(_Sample_data::_Init_list()));
+            auto _Last = _List.cbegin();
+            for (uint8_t _Count = 0; _Count < 4; ++_Count) { // find 5-th node
+                ++_Last;
+            }
+
+            const auto _Slice = _List.slice(++_List.cbegin(), _Last); // 515, 25, 16232
+            constexpr int _Expected_slice[] = {515, 25, 16232};
+            constexpr int _Expected_rest[]  = {251, 5156, 2551, 251, 5621, 6722, 915};
+            GTEST_EXPECT_TRUE(_Slice.size() == 3);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Slice.begin(), _Slice.end(), _Expected_slice));
+            GTEST_EXPECT_TRUE(_List.size() == 7);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected_rest));
+            GTEST_EXPECT_TRUE(_Live == _Sample_data::_Size); // nothing was allocated
+            const auto _Tail = _List.slice(++_List.cbegin(), _List.cend(), 6);
+            GTEST_EXPECT_TRUE(_Tail.size() == 6 && *_Tail.back() == 915);
+            GTEST_EXPECT_TRUE(_List.size() == 1 && *_List.back() == 251);
+        }
+
         TEST(modifiers, push_back_empty_list) {
             safe_list<int> _List;
             GTEST_ASSERT_TRUE(_List.push_back(4512));
@@ -274,16 +908,141 @@ namespace tests {
             GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
         }
 
+        TEST(modifiers, insert_with_mutable_iterator) {
+            safe_list<int> _List = _Sample_data::_Init_list();
+            safe_list<int>::iterator _Where = ++_List.begin(); // converts to const_iterator
+            _Where = _List.insert(_Where, 0);
+            GTEST_ASSERT_TRUE(_Where.valid());
+            GTEST_EXPECT_TRUE(*_Where == 0);
+            GTEST_EXPECT_TRUE(*++_Where == 515);
+            GTEST_EXPECT_TRUE(_List.size() == _Sample_data::_Size + 1);
+        }
+
+        TEST(modifiers, resize_truncate) {
+            size_t _Live = 0;
+            safe_list<int, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live});
+            GTEST_ASSERT_TRUE(_List.assign(_Sample_data::_Begin(), _Sample_data::_End()));
+            GTEST_ASSERT_TRUE(_List.resize(8)); // the boundary is found from the back
+            GTEST_ASSERT_TRUE(_List.resize(2)); // the boundary is found from the front
+            GTEST_EXPECT_TRUE(_List.size() == 2);
+            GTEST_EXPECT_TRUE(_Live == 2);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Sample_data::_Array));
+            GTEST_EXPECT_TRUE(*_List.crbegin() == 515);
+            GTEST_ASSERT_TRUE(_List.resize(0));
+            GTEST_EXPECT_TRUE(_List.empty());
+            GTEST_EXPECT_TRUE(_Live == 0);
+        }
+
+        TEST(modifiers, clear_slab_storage) {
+            size_t _Live = 0;
+            safe_list<::std::string, _Counting_allocator<::std::string>, ::mjx::safe_list_slab_storage<512>> _List(
+                _Counting_allocator<::std::string>{&_Live});
+            for (int _Value = 0; _Value < 100; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(::std::string(32, 'x'))); // not a small string
+            }
+
+            _List.clear();
+            GTEST_EXPECT_TRUE(_List.empty());
+            GTEST_EXPECT_TRUE(_Live == 0);
+        }
+
+        TEST(modifiers, assign_reuses_nodes) {
+            size_t _Live = 0;
+            safe_list<int, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live, _Sample_data::_Size});
+            GTEST_ASSERT_TRUE(_List.assign(_Sample_data::_Init_list()));
+            constexpr int _Reversed[_Sample_data::_Size] = {
+                915, 6722, 5621, 251, 2551, 5156, 16232, 25, 515, 251};
+            GTEST_ASSERT_TRUE(_List.assign(::std::begin(_Reversed), ::std::end(_Reversed))); // no new nodes needed
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Reversed));
+            GTEST_ASSERT_TRUE(_List.assign(size_t{4}, 7)); // the surplus nodes are freed
+            GTEST_EXPECT_TRUE(_List.size() == 4 && *_List.front() == 7 && *_List.back() == 7);
+            GTEST_EXPECT_TRUE(_Live == 4);
+            GTEST_EXPECT_TRUE(!_List.assign(_Sample_data::_Size + 1, 1)); // the list is left unchanged
+            GTEST_EXPECT_TRUE(_List.size() == 4 && *_List.front() == 7);
+            GTEST_ASSERT_TRUE(_List.assign(_Sample_data::_Init_list())); // 6 new nodes
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Sample_data::_Array));
+            GTEST_EXPECT_TRUE(_Live == _Sample_data::_Size);
+        }
+
+        TEST(modifiers, copy_assignment_reuses_nodes) {
+            size_t _Live = 0;
+            safe_list<int, _Counting_allocator<int>> _Tiny(_Counting_allocator<int>{&_Live});
+            safe_list<int, _Counting_allocator<int>> _Short(_Counting_allocator<int>{&_Live});
+            safe_list<int, _Counting_allocator<int>> _Long(_Counting_allocator<int>{&_Live});
+            GTEST_ASSERT_TRUE(_Tiny.assign({1, 2}));
+            GTEST_ASSERT_TRUE(_Short.assign({3, 4, 5}));
+            GTEST_ASSERT_TRUE(_Long.assign(_Sample_data::_Init_list()));
+            _Short = _Long; // the 3 nodes are reused, 7 are allocated
+            GTEST_EXPECT_TRUE(_Short.size() == _Sample_data::_Size);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Short.begin(), _Short.end(), _Sample_data::_Array));
+            GTEST_EXPECT_TRUE(_Live == 22);
+            _Long = _Tiny; // the 8 surplus nodes are freed
+            GTEST_EXPECT_TRUE(_Long.size() == 2);
+            GTEST_EXPECT_TRUE(*_Long.front() == 1 && *_Long.back() == 2);
+            GTEST_EXPECT_TRUE(_Live == 14);
+            _Long = safe_list<int, _Counting_allocator<int>>(_Counting_allocator<int>{&_Live});
+            _Short = _Long;
+            GTEST_EXPECT_TRUE(_Short.empty());
+            GTEST_EXPECT_TRUE(_Live == 2);
+        }
+
+        TEST(modifiers, copy_slab_storage) {
+            using _Slab_list = safe_list<int, ::mjx::safe_allocator<int>, ::mjx::safe_list_slab_storage<256>>;
+            _Slab_list _List;
+            for (int _Value = 0; _Value < 1000; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+            }
+
+            const _Slab_list _Copy = _List;
+            GTEST_EXPECT_TRUE(_Copy.size() == 1000);
+            GTEST_EXPECT_TRUE(::std::equal(_Copy.begin(), _Copy.end(), _List.begin(), _List.end()));
+            GTEST_EXPECT_TRUE(*_Copy.back() == 999);
+            const _Slab_list _Empty_copy = _Slab_list{};
+            GTEST_EXPECT_TRUE(_Empty_copy.empty());
+        }
+
         TEST(modifiers, swap) {
             constexpr int _Reversed[_Sample_data::_Size] = {
                 915, 6722, 5621, 251, 2551, 5156, 16232, 25, 515, 251
             };
             safe_list<int> _Left(_Sample_data::_Init_list());
-            safe_list<int> _Right(::std::initializer_list<int>(_Reversed, _Reversed + _Sample_data::_Size));
+            safe_list<int> _Right;
+            GTEST_ASSERT_TRUE(_Right.assign(::std::begin(_Reversed), ::std::end(_Reversed)));
             _Left.swap(_Right);
             GTEST_EXPECT_TRUE(_Compare_arrays(_Left.begin(), _Left.end(), _Reversed));
             GTEST_EXPECT_TRUE(_Compare_arrays(_Right.begin(), _Right.end(), _Sample_data::_Array));
         }
+
+        TEST(modifiers, batch_push_and_pop) {
+            safe_list<int> _List;
+            GTEST_ASSERT_TRUE(_List.push_back_n(_Sample_data::_Array, _Sample_data::_Size));
+            GTEST_ASSERT_TRUE(_List.push_back_n(_Sample_data::_Array, 0));
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Sample_data::_Array));
+            int _Popped[_Sample_data::_Size] = {};
+            int* const _Popped_end           = _List.pop_front_n(4, _Popped);
+            GTEST_EXPECT_TRUE(_Popped_end == _Popped + 4);
+            GTEST_EXPECT_TRUE(::std::equal(_Popped, _Popped_end, _Sample_data::_Array));
+            GTEST_EXPECT_TRUE(_List.size() == _Sample_data::_Size - 4);
+            GTEST_EXPECT_TRUE(*_List.front() == _Sample_data::_Array[4] && !_List.begin()._Get_node()->_Prev);
+            ::std::vector<int> _Drained;
+            (void) _List.drain_into(::std::back_inserter(_Drained));
+            GTEST_EXPECT_TRUE(_List.empty() && _List.begin() == _List.end());
+            GTEST_EXPECT_TRUE(::std::equal(_Drained.begin(), _Drained.end(), _Sample_data::_Array + 4));
+            GTEST_EXPECT_TRUE(_List.pop_front_n(3, _Popped) == _Popped); // nothing to pop
+            GTEST_ASSERT_TRUE(_List.push_back(1));
+            GTEST_EXPECT_TRUE(_List.pop_front_n(5, _Popped) == _Popped + 1); // clamped to the size
+            GTEST_EXPECT_TRUE(_List.empty() && !_List.back());
+        }
+
+        TEST(modifiers, batch_push_allocation_failure) {
+            size_t _Live = 0;
+            using _Alloc_t = _Counting_allocator<int>;
+            safe_list<int, _Alloc_t> _List({1, 2}, _Alloc_t{&_Live, 6});
+            GTEST_EXPECT_TRUE(!_List.push_back_n(_Sample_data::_Array, 5)); // only 4 nodes fit
+            GTEST_EXPECT_TRUE(_List.size() == 2 && _Live == 2); // unchanged, the partial chain was freed
+            GTEST_ASSERT_TRUE(_List.push_back_n(_Sample_data::_Array, 4));
+            GTEST_EXPECT_TRUE(_List.size() == 6 && *_List.back() == _Sample_data::_Array[3]);
+        }
     } // namespace modifiers
 
     inline namespace operations {
@@ -313,6 +1072,58 @@ namespace tests {
             GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
         }
 
+        TEST(operations, unique) {
+            safe_list<int> _List{1, 1, 2, 2, 2, 3, 1, 1, 4};
+            const int* const _Kept = _List.front();
+            GTEST_EXPECT_TRUE(_List.unique() == 4);
+            constexpr int _Expected[] = {1, 2, 3, 1, 4};
+            GTEST_EXPECT_TRUE(_List.size() == 5 && _List.front() == _Kept); // the first node stays
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.rbegin(), _List.rend(), ::std::rbegin(_Expected)));
+            GTEST_EXPECT_TRUE(_List.unique(
+                [](const int _Kept_value, const int _Value) noexcept { // compares with the kept element
+                    return _Value - _Kept_value <= 1;
+                }) == 3);
+            constexpr int _Expected_runs[] = {1, 3};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected_runs));
+            safe_list<int> _Empty;
+            GTEST_EXPECT_TRUE(_Empty.unique() == 0);
+        }
+
+        TEST(operations, dedupe_unsorted) {
+            safe_list<::std::string> _List{"b", "a", "b", "c", "a", "d", "b"};
+            GTEST_EXPECT_TRUE(_List.dedupe_unsorted() == 3);
+            const char* const _Expected[] = {"b", "a", "c", "d"}; // the first occurrences stay in order
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_EXPECT_TRUE(*_List.back() == "d");
+            safe_list<int> _Numbers;
+            for (int _Value = 0; _Value < 3000; ++_Value) { // every value occurs three times
+                GTEST_ASSERT_TRUE(_Numbers.push_back(_Value * 7 % 1000));
+            }
+
+            GTEST_EXPECT_TRUE(_Numbers.dedupe_unsorted() == 2000);
+            int _Next = 0;
+            for (const int _Value : _Numbers) {
+                GTEST_EXPECT_TRUE(_Value == _Next * 7 % 1000);
+                ++_Next;
+            }
+
+            GTEST_EXPECT_TRUE(_Next == 1000);
+        }
+
+        TEST(operations, dedupe_unsorted_without_table) {
+            size_t _Live = 0;
+            safe_list<int, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live, 6});
+            for (const int _Value : {4, 1, 4, 2, 1, 4}) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+            }
+
+            GTEST_EXPECT_TRUE(_List.dedupe_unsorted() == 3); // the table cannot be allocated, scans instead
+            constexpr int _Expected[] = {4, 1, 2};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Live == 3);
+        }
+
         TEST(operations, reverse) {
             safe_list<int> _List(_Sample_data::_Init_list());
             constexpr int _Expected[_Sample_data::_Size] = {
@@ -321,7 +1132,1788 @@ namespace tests {
             _List.reverse();
             GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
         }
-    } // namespace operations
+
+        TEST(operations, reverse_relinks_nodes) {
+            safe_list<_Move_counter> _List;
+            GTEST_ASSERT_TRUE(_List.emplace_back(1, 0));
+            GTEST_ASSERT_TRUE(_List.emplace_back(2, 0));
+            GTEST_ASSERT_TRUE(_List.emplace_back(3, 0));
+            const _Move_counter* const _First = _List.front();
+            _Move_counter::_Copies = 0;
+            _Move_counter::_Moves  = 0;
+            _List.reverse();
+            GTEST_EXPECT_TRUE(_Move_counter::_Copies == 0);
+            GTEST_EXPECT_TRUE(_Move_counter::_Moves == 0);
+            GTEST_EXPECT_TRUE(_List.back() == _First);
+            GTEST_EXPECT_TRUE(_List.front()->_Left == 3);
+            GTEST_EXPECT_TRUE(_List.crbegin()->_Left == 1);
+            GTEST_EXPECT_TRUE((++_List.crbegin())->_Left == 2);
+            static_assert(noexcept(_List.reverse()));
+        }
+
+        TEST(operations, splice_range) {
+            safe_list<int> _List(_Sample_data::_Init_list());
+            safe_list<int> _Other{1, 2, 3, 4};
+            GTEST_ASSERT_TRUE(_List.splice(++_List.cbegin(), _Other, ++_Other.cbegin(), _Other.cend(), 3));
+            constexpr int _Expected[] = {251, 2, 3, 4, 515, 25, 16232, 5156, 2551, 251, 5621, 6722, 915};
+            GTEST_EXPECT_TRUE(_List.size() == _Sample_data::_Size + 3);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Other.size() == 1);
+            GTEST_EXPECT_TRUE(*_Other.back() == 1);
+            GTEST_ASSERT_TRUE(_List.splice(_List.cend(), _Other));
+            GTEST_EXPECT_TRUE(_Other.empty());
+            GTEST_EXPECT_TRUE(*_List.back() == 1);
+            GTEST_EXPECT_TRUE(*_List.crbegin() == 1);
+            GTEST_EXPECT_TRUE(*++_List.crbegin() == 915);
+        }
+
+        TEST(operations, splice_same_list) {
+            safe_list<int> _List{1, 2, 3, 4, 5};
+            GTEST_ASSERT_TRUE(_List.splice(_List.cbegin(), _List, ++++++_List.cbegin(), _List.cend()));
+            constexpr int _Expected[] = {4, 5, 1, 2, 3};
+            GTEST_EXPECT_TRUE(_List.size() == 5);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.rbegin(), _List.rend(), ::std::rbegin(_Expected)));
+        }
+
+        TEST(operations, splice_into_itself) {
+            safe_list<int> _List{1, 2, 3, 4};
+            constexpr int _Expected[] = {1, 2, 3, 4};
+            GTEST_ASSERT_TRUE(_List.splice(++_List.cbegin(), _List, ++_List.cbegin())); // before itself
+            GTEST_ASSERT_TRUE(_List.splice(++_List.cbegin(), _List, _List.cbegin(), _List.cend())); // inside
+            GTEST_ASSERT_TRUE(_List.splice(_List.cbegin(), _List, _List.cbegin(), ++++_List.cbegin(), 2));
+            GTEST_EXPECT_TRUE(_List.size() == 4);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.rbegin(), _List.rend(), ::std::rbegin(_Expected)));
+            GTEST_ASSERT_TRUE(_List.splice(_List.cend(), _List, _List.cbegin(), ++++_List.cbegin())); // after it
+            constexpr int _Rotated[] = {3, 4, 1, 2};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Rotated));
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.rbegin(), _List.rend(), ::std::rbegin(_Rotated)));
+        }
+
+        template <class _Storage>
+        void _Test_splice_owned_nodes() {
+            safe_list<int, ::mjx::safe_allocator<int>, _Storage> _List;
+            safe_list<int, ::mjx::safe_allocator<int>, _Storage> _Other;
+            if constexpr (::std::is_same_v<_Storage, ::mjx::safe_list_bounded_storage>) {
+                GTEST_ASSERT_TRUE(_List.reserve_nodes(4));
+                GTEST_ASSERT_TRUE(_Other.reserve_nodes(4));
+            }
+
+            GTEST_ASSERT_TRUE(_List.push_back(1) && _List.push_back(2) && _List.push_back(3));
+            GTEST_ASSERT_TRUE(_Other.push_back(4));
+            GTEST_ASSERT_TRUE(_List.splice(_List.cbegin(), _List, ++_List.cbegin())); // reorders in place
+            GTEST_EXPECT_TRUE(*_List.transfer(_List.cend(), _List, _List.cbegin()) == 2);
+            constexpr int _Expected[] = {1, 3, 2};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.rbegin(), _List.rend(), ::std::rbegin(_Expected)));
+            GTEST_EXPECT_TRUE(!_List.splice(_List.cend(), _Other)); // the nodes cannot leave _Other
+            GTEST_EXPECT_TRUE(_List.transfer(_List.cend(), _Other, _Other.cbegin()) == _List.end());
+            GTEST_EXPECT_TRUE(_List.size() == 3 && _Other.size() == 1);
+        }
+
+        TEST(operations, splice_owned_nodes) {
+            _Test_splice_owned_nodes<::mjx::safe_list_slab_storage<256>>();
+            _Test_splice_owned_nodes<::mjx::safe_list_inline_storage<2>>();
+            _Test_splice_owned_nodes<::mjx::safe_list_bounded_storage>();
+        }
+
+        TEST(operations, splice_unequal_allocators) {
+            size_t _Left_live  = 0;
+            size_t _Right_live = 0;
+            safe_list<int, _Counting_allocator<int>> _Left(_Counting_allocator<int>{&_Left_live});
+            safe_list<int, _Counting_allocator<int>> _Right(_Counting_allocator<int>{&_Right_live});
+            GTEST_ASSERT_TRUE(_Right.push_back(1));
+            GTEST_EXPECT_TRUE(!_Left.splice(_Left.cend(), _Right));
+            GTEST_EXPECT_TRUE(!_Left.merge(_Right));
+            GTEST_EXPECT_TRUE(_Left.empty());
+            GTEST_EXPECT_TRUE(_Right.size() == 1);
+        }
+
+        TEST(operations, transfer) {
+            size_t _Live = 0;
+            const _Counting_allocator<int> _Al(&_Live);
+            safe_list<int, _Counting_allocator<int>> _Left({1, 2, 3}, _Al);
+            safe_list<int, _Counting_allocator<int>> _Right({4, 5}, _Al);
+            const int* const _Moved = _Right.front();
+            auto _Iter              = _Left.transfer(++_Left.cbegin(), _Right, _Right.cbegin());
+            GTEST_ASSERT_TRUE(_Iter != _Left.end());
+            GTEST_EXPECT_TRUE(&*_Iter == _Moved); // the same node, nothing was allocated
+            GTEST_EXPECT_TRUE(_Live == 5);
+            constexpr int _Expected[] = {1, 4, 2, 3};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Left.begin(), _Left.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Right.size() == 1 && *_Right.front() == 5);
+            GTEST_EXPECT_TRUE(_Left.transfer(_Left.cbegin(), _Right, _Right.cend()) == _Left.end());
+
+            _Iter = _Left.transfer(_Left.cend(), _Left, _Left.cbegin()); // within the list
+            constexpr int _Rotated[] = {4, 2, 3, 1};
+            GTEST_EXPECT_TRUE(*_Iter == 1);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Left.begin(), _Left.end(), _Rotated));
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Left.rbegin(), _Left.rend(), ::std::rbegin(_Rotated)));
+            _Iter = _Left.transfer(_Iter, _Left, _Iter); // already in place
+            GTEST_EXPECT_TRUE(*_Iter == 1 && _Left.size() == 4);
+
+            size_t _Other_live = 0;
+            safe_list<int, _Counting_allocator<int>> _Other({6}, _Counting_allocator<int>{&_Other_live});
+            GTEST_EXPECT_TRUE(_Left.transfer(_Left.cend(), _Other, _Other.cbegin()) == _Left.end());
+            GTEST_EXPECT_TRUE(_Other.size() == 1 && _Left.size() == 4);
+        }
+
+        TEST(operations, extract_and_insert) {
+            size_t _Live = 0;
+            const _Counting_allocator<int> _Al(&_Live);
+            using _List_t = safe_list<int, _Counting_allocator<int>>;
+            _List_t _List({1, 2, 3}, _Al);
+            _List_t::node_type _Handle = _List.extract(++_List.cbegin());
+            GTEST_ASSERT_TRUE(_Handle && !_Handle.empty());
+            GTEST_EXPECT_TRUE(_Handle.value() == 2);
+            GTEST_EXPECT_TRUE(_Handle.get_allocator() == _Al);
+            GTEST_EXPECT_TRUE(_List.size() == 2 && _Live == 3); // the node is parked in the handle
+            GTEST_EXPECT_TRUE(_List.extract(_List.cend()).empty());
+
+            _Handle.value() = 4;
+            _List_t _Other(_Al);
+            auto _Iter = _Other.insert(_Other.cend(), ::std::move(_Handle));
+            GTEST_ASSERT_TRUE(_Iter != _Other.end());
+            GTEST_EXPECT_TRUE(_Handle.empty());
+            GTEST_EXPECT_TRUE(*_Iter == 4 && _Other.size() == 1 && _Live == 3);
+            GTEST_EXPECT_TRUE(_Other.insert(_Other.cend(), ::std::move(_Handle)) == _Other.end()); // empty handle
+
+            size_t _Foreign_live = 0;
+            _List_t _Foreign(_Counting_allocator<int>{&_Foreign_live});
+            _Handle = _List.extract(_List.cbegin());
+            GTEST_EXPECT_TRUE(_Foreign.insert(_Foreign.cend(), ::std::move(_Handle)) == _Foreign.end());
+            GTEST_EXPECT_TRUE(!_Handle.empty() && _Foreign.empty()); // the handle keeps its node
+
+            _List_t::node_type _Swapped = _Other.extract(_Other.cbegin());
+            swap(_Handle, _Swapped);
+            GTEST_EXPECT_TRUE(_Handle.value() == 4 && _Swapped.value() == 1);
+            _Handle = ::std::move(_Swapped); // destroys the node holding 4
+            GTEST_EXPECT_TRUE(_Handle.value() == 1 && _Live == 2);
+            {
+                _List_t::node_type _Dropped = _List.extract(_List.cbegin());
+                GTEST_EXPECT_TRUE(_List.empty());
+            }
+
+            GTEST_EXPECT_TRUE(_Live == 1);
+        }
+
+        TEST(operations, adoption_respects_the_budget) {
+            using _Policy = ::mjx::safe_list_policy<::mjx::safe_list_heap_storage, ::mjx::safe_list_no_stats,
+                ::mjx::safe_list_no_index, ::mjx::safe_list_memory_budget>;
+            safe_list<int, ::mjx::safe_allocator<int>, _Policy> _Left{1};
+            safe_list<int, ::mjx::safe_allocator<int>, _Policy> _Right{2, 3};
+            _Left.memory_budget(_Left.memory_usage()); // full
+            GTEST_EXPECT_TRUE(!_Left.splice(_Left.cend(), _Right));
+            GTEST_EXPECT_TRUE(_Left.transfer(_Left.cend(), _Right, _Right.cbegin()) == _Left.end());
+            GTEST_EXPECT_TRUE(_Left.insert(_Left.cend(), _Right.extract(_Right.cbegin())) == _Left.end());
+            GTEST_EXPECT_TRUE(_Left.size() == 1 && _Right.size() == 1); // the rejected handle freed its node
+            _Left.pop_back();
+            GTEST_EXPECT_TRUE(_Left.transfer(_Left.cend(), _Right, _Right.cbegin()) != _Left.end());
+        }
+
+        TEST(operations, merge) {
+            safe_list<int> _Left{1, 3, 5, 7};
+            safe_list<int> _Right{0, 3, 4, 8, 9};
+            GTEST_ASSERT_TRUE(_Left.merge(_Right));
+            constexpr int _Expected[] = {0, 1, 3, 3, 4, 5, 7, 8, 9};
+            GTEST_EXPECT_TRUE(_Left.size() == 9);
+            GTEST_EXPECT_TRUE(_Right.empty());
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Left.begin(), _Left.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Left.rbegin(), _Left.rend(), ::std::rbegin(_Expected)));
+        }
+
+        TEST(operations, sort) {
+            safe_list<int> _List(_Sample_data::_Init_list());
+            constexpr int _Expected[_Sample_data::_Size] = {
+                25, 251, 251, 515, 915, 2551, 5156, 5621, 6722, 16232
+            };
+            _List.sort();
+            GTEST_EXPECT_TRUE(_List.size() == _Sample_data::_Size);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.rbegin(), _List.rend(), ::std::rbegin(_Expected)));
+        }
+
+        TEST(operations, sort_is_stable) {
+            safe_list<::std::pair<int, int>> _List{{2, 0}, {1, 1}, {2, 2}, {0, 3}, {1, 4}, {2, 5}, {0, 6}};
+            _List.sort(
+                [](const ::std::pair<int, int>& _Left, const ::std::pair<int, int>& _Right) noexcept {
+                    return _Left.first < _Right.first;
+                }
+            );
+            const ::std::pair<int, int> _Expected[] = {{0, 3}, {0, 6}, {1, 1}, {1, 4}, {2, 0}, {2, 2}, {2, 5}};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+        }
+
+        TEST(operations, parallel_algorithms) {
+            constexpr int _Count = 100000;
+            safe_list<int> _List;
+            for (int _Value = 0; _Value < _Count; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+            }
+
+            ::mjx::parallel_for_each(_List, [](int& _Value) noexcept { _Value *= 2; }, 4);
+            GTEST_EXPECT_TRUE(*_List.front() == 0);
+            GTEST_EXPECT_TRUE(*_List.back() == 2 * (_Count - 1));
+            GTEST_EXPECT_TRUE(::mjx::parallel_count_if(_List, [](const int _Value) noexcept {
+                return _Value % 4 == 0;
+            }, 4) == _Count / 2);
+            GTEST_EXPECT_TRUE(::mjx::parallel_remove_if(_List, [](const int _Value) noexcept {
+                return _Value % 4 == 0 || _Value < 20000;
+            }, 4) == _Count / 2 + 5000);
+            GTEST_EXPECT_TRUE(_List.size() == _Count / 2 - 5000);
+            int _Expected = 20002;
+            bool _Linked  = true;
+            for (const int _Value : _List) {
+                _Linked    = _Linked && _Value == _Expected;
+                _Expected += 4;
+            }
+
+            GTEST_EXPECT_TRUE(_Linked);
+            _Expected = 2 * (_Count - 1);
+            for (auto _Iter = _List.crbegin(); _Iter != _List.crend(); ++_Iter) { // the back links are intact
+                _Linked    = _Linked && *_Iter == _Expected;
+                _Expected -= 4;
+            }
+
+            GTEST_EXPECT_TRUE(_Linked);
+            const size_t _Size = _List.size();
+            GTEST_EXPECT_TRUE(::mjx::parallel_remove_if(_List, [](const int) noexcept { return true; }) == _Size);
+            GTEST_EXPECT_TRUE(_List.empty());
+            GTEST_EXPECT_TRUE(_List.push_back(1)); // the list is still usable
+        }
+
+        TEST(operations, parallel_algorithms_small_list) {
+            safe_list<int> _List = _Sample_data::_Init_list();
+            GTEST_EXPECT_TRUE(::mjx::parallel_count_if(_List, [](const int _Value) noexcept {
+                return _Value == 251;
+            }) == 2);
+            GTEST_EXPECT_TRUE(::mjx::parallel_remove_if(_List, [](const int _Value) noexcept {
+                return _Value == 251;
+            }) == 2);
+            GTEST_EXPECT_TRUE(_List.size() == _Sample_data::_Size - 2);
+            GTEST_EXPECT_TRUE(*_List.front() == 515);
+            GTEST_EXPECT_TRUE(*_List.back() == 915);
+        }
+
+        TEST(operations, for_each_and_prefetching_iterator) {
+            safe_list<int> _List = _Sample_data::_Init_list();
+            _List.for_each([](int& _Value) noexcept { _Value *= 2; });
+            int _Sum = 0;
+            ::std::as_const(_List).for_each([&_Sum](const int _Value) noexcept { _Sum += _Value; });
+            GTEST_EXPECT_TRUE(_Sum == 2 * 38239);
+            size_t _Idx = 0;
+            for (const int _Value : ::mjx::safe_list_prefetched(::std::as_const(_List))) {
+                GTEST_EXPECT_TRUE(_Value == 2 * _Sample_data::_Array[_Idx++]);
+            }
+
+            GTEST_EXPECT_TRUE(_Idx == _Sample_data::_Size);
+            using _Iter = ::mjx::safe_list_prefetching_iterator<safe_list<int>::iterator, 1>;
+            for (_Iter _First(_List.begin()), _Last(_List.end()); _First != _Last; ++_First) {
+                *_First /= 2;
+            }
+
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Sample_data::_Array));
+            safe_list<int> _Empty;
+            for (const int _Value : ::mjx::safe_list_prefetched<0>(_Empty)) { // never visited
+                GTEST_EXPECT_TRUE(_Value != _Value);
+            }
+        }
+
+        TEST(operations, find_count_contains) {
+            safe_list<int> _List = _Sample_data::_Init_list();
+            auto _Iter = _List.find(251);
+            GTEST_ASSERT_TRUE(_Iter.valid());
+            GTEST_EXPECT_TRUE(_Iter == _List.begin());
+            _Iter = _List.find(915);
+            GTEST_ASSERT_TRUE(_Iter.valid());
+            *_Iter = 916;
+            GTEST_EXPECT_TRUE(*_List.back() == 916);
+            GTEST_EXPECT_TRUE(!::std::as_const(_List).find(915).valid());
+            GTEST_EXPECT_TRUE(_List.count(251) == 2);
+            GTEST_EXPECT_TRUE(_List.count(0) == 0);
+            GTEST_EXPECT_TRUE(_List.contains(5621));
+            GTEST_EXPECT_TRUE(!_List.contains(5622));
+            safe_list<int> _Empty;
+            GTEST_EXPECT_TRUE(_Empty.find(1) == _Empty.end());
+            GTEST_EXPECT_TRUE(_Empty.count(1) == 0);
+        }
+
+        TEST(operations, positional_access) {
+            safe_list<int> _List = _Sample_data::_Init_list();
+            for (size_t _Idx = 0; _Idx < _Sample_data::_Size; ++_Idx) { // both halves, walked from either end
+                GTEST_EXPECT_TRUE(*_List.at_index(_Idx) == _Sample_data::_Array[_Idx]);
+                GTEST_EXPECT_TRUE(*::std::as_const(_List).iterator_at(_Idx) == _Sample_data::_Array[_Idx]);
+            }
+
+            GTEST_EXPECT_TRUE(_List.at_index(_Sample_data::_Size) == nullptr);
+            GTEST_EXPECT_TRUE(_List.iterator_at(_Sample_data::_Size) == _List.end());
+            GTEST_ASSERT_TRUE(_List.insert_at(2, 7).valid());
+            GTEST_ASSERT_TRUE(_List.insert_at(_List.size(), 8).valid());
+            GTEST_EXPECT_TRUE(!_List.insert_at(_List.size() + 1, 9).valid());
+            GTEST_EXPECT_TRUE(*_List.erase_at(0) == 515);
+            GTEST_EXPECT_TRUE(_List.erase_at(_List.size()) == _List.end());
+            constexpr int _Expected[] = {515, 7, 25, 16232, 5156, 2551, 251, 5621, 6722, 915, 8};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+        }
+
+        template <class _List>
+        bool _Check_positions(const _List& _Target, const ::std::vector<int>& _Expected) {
+            if (_Target.size() != _Expected.size()) {
+                return false;
+            }
+
+            for (size_t _Idx = 0; _Idx < _Expected.size(); ++_Idx) {
+                const int* const _Value = _Target.at_index(_Idx);
+                if (!_Value || *_Value != _Expected[_Idx]) {
+                    return false;
+                }
+            }
+
+            return _Target.at_index(_Expected.size()) == nullptr;
+        }
+
+        template <class _Storage>
+        void _Test_skip_index() {
+            using _Policy =
+                ::mjx::safe_list_policy<_Storage, ::mjx::safe_list_no_stats, ::mjx::safe_list_skip_index<4>>;
+            safe_list<int, ::mjx::safe_allocator<int>, _Policy> _List;
+            ::std::vector<int> _Expected;
+            uint32_t _Seed = 12345;
+            auto _Random   = [&_Seed](const size_t _Bound) noexcept { // a small LCG, the same sequence every run
+                _Seed = _Seed * 1664525u + 1013904223u;
+                return _Bound > 0 ? static_cast<size_t>(_Seed >> 8) % _Bound : size_t{0};
+            };
+
+            for (int _Value = 0; _Value < 200; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+                _Expected.push_back(_Value);
+            }
+
+            for (int _Round = 0; _Round < 300; ++_Round) {
+                const size_t _Pos = _Random(_Expected.size());
+                switch (_Random(8)) {
+                case 0:
+                    GTEST_ASSERT_TRUE(_List.insert_at(_Pos, _Round).valid());
+                    _Expected.insert(_Expected.begin() + static_cast<ptrdiff_t>(_Pos), _Round);
+                    break;
+                case 1:
+                    (void) _List.erase_at(_Pos);
+                    _Expected.erase(_Expected.begin() + static_cast<ptrdiff_t>(_Pos));
+                    break;
+                case 2:
+                    GTEST_ASSERT_TRUE(_List.push_back(_Round));
+                    _Expected.push_back(_Round);
+                    break;
+                case 3:
+                    _List.pop_back();
+                    _Expected.pop_back();
+                    break;
+                case 4:
+                    GTEST_ASSERT_TRUE(_List.push_front(_Round));
+                    _Expected.insert(_Expected.begin(), _Round);
+                    break;
+                case 5:
+                    (void) _List.erase(_List.iterator_at(_Pos));
+                    _Expected.erase(_Expected.begin() + static_cast<ptrdiff_t>(_Pos));
+                    break;
+                case 6:
+                    GTEST_ASSERT_TRUE(_List.resize(_Pos + 10));
+                    _Expected.resize(_Pos + 10);
+                    break;
+                default:
+                    _List.reverse();
+                    ::std::reverse(_Expected.begin(), _Expected.end());
+                    break;
+                }
+
+                for (int _Probe = 0; _Probe < 3; ++_Probe) { // extend the index by random lookups
+                    const size_t _Idx = _Random(_Expected.size());
+                    GTEST_ASSERT_TRUE(*_List.at_index(_Idx) == _Expected[_Idx]);
+                }
+
+                GTEST_ASSERT_TRUE(_Check_positions(_List, _Expected));
+            }
+
+            _List.sort();
+            ::std::sort(_Expected.begin(), _Expected.end());
+            GTEST_EXPECT_TRUE(_Check_positions(_List, _Expected));
+            decltype(_List) _Other;
+            GTEST_ASSERT_TRUE(_Other.push_back(-1));
+            GTEST_EXPECT_TRUE(*_Other.at_index(0) == -1);
+            _Other.swap(_List); // the tables move with the nodes
+            GTEST_EXPECT_TRUE(_Check_positions(_Other, _Expected));
+            GTEST_EXPECT_TRUE(_Check_positions(_List, ::std::vector<int>{-1}));
+            _Other.clear();
+            GTEST_EXPECT_TRUE(_Other.at_index(0) == nullptr);
+        }
+
+        TEST(operations, skip_index) {
+            _Test_skip_index<::mjx::safe_list_heap_storage>();
+            _Test_skip_index<::mjx::safe_list_slab_storage<256>>();
+            _Test_skip_index<::mjx::safe_list_inline_storage<16>>();
+        }
+
+        TEST(operations, serialization) {
+            const safe_list<int> _List = _Sample_data::_Init_list();
+            const size_t _Bytes = _List.serialized_size();
+            GTEST_EXPECT_TRUE(_Bytes == 24 + _Sample_data::_Size * sizeof(int));
+            ::std::vector<uint64_t> _Buffer(_Bytes / sizeof(uint64_t) + 1); // aligned like a mapped file
+            GTEST_EXPECT_TRUE(!_List.serialize_to(_Buffer.data(), _Bytes - 1)); // too small
+            GTEST_ASSERT_TRUE(_List.serialize_to(_Buffer.data(), _Bytes));
+
+            const ::mjx::safe_list_view<int> _View(_Buffer.data(), _Bytes);
+            GTEST_ASSERT_TRUE(_View.valid());
+            GTEST_EXPECT_TRUE(_View.size() == _Sample_data::_Size);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_View.begin(), _View.end(), _Sample_data::_Array));
+            GTEST_EXPECT_TRUE(*_View.front() == 251 && *_View.back() == 915 && *_View.at_index(3) == 16232);
+            GTEST_EXPECT_TRUE(!_View.at_index(_Sample_data::_Size));
+
+            safe_list<int, ::mjx::safe_allocator<int>, ::mjx::safe_list_slab_storage<256>> _Restored;
+            GTEST_ASSERT_TRUE(_Restored.deserialize_from(_Buffer.data(), _Bytes));
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Restored.begin(), _Restored.end(), _Sample_data::_Array));
+            safe_list<int> _Shorter = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+            GTEST_ASSERT_TRUE(_Shorter.deserialize_from(_Buffer.data(), _Bytes)); // the surplus nodes are freed
+            GTEST_EXPECT_TRUE(_Shorter.size() == _Sample_data::_Size);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Shorter.begin(), _Shorter.end(), _Sample_data::_Array));
+        }
+
+        TEST(operations, serialization_rejects_bad_images) {
+            const safe_list<int> _Empty;
+            uint64_t _Buffer[8] = {};
+            GTEST_ASSERT_TRUE(_Empty.serialize_to(_Buffer, sizeof(_Buffer)));
+            GTEST_EXPECT_TRUE(::mjx::safe_list_view<int>(_Buffer, sizeof(_Buffer)).valid()); // an empty list
+            GTEST_EXPECT_TRUE(::mjx::safe_list_view<int>(_Buffer, sizeof(_Buffer)).empty());
+            GTEST_EXPECT_TRUE(!::mjx::safe_list_view<int>(_Buffer, 16).valid()); // truncated header
+            GTEST_EXPECT_TRUE(!::mjx::safe_list_view<long long>(_Buffer, sizeof(_Buffer)).valid()); // other T
+            GTEST_EXPECT_TRUE(!::mjx::safe_list_view<int>(reinterpret_cast<char*>(_Buffer) + 1, 60).valid());
+
+            const safe_list<int> _List = {1, 2, 3, 4, 5};
+            GTEST_ASSERT_TRUE(_List.serialize_to(_Buffer, sizeof(_Buffer)));
+            safe_list<int> _Target = {7};
+            GTEST_EXPECT_TRUE(!_Target.deserialize_from(_Buffer, 24 + 4 * sizeof(int))); // the last element is cut
+            GTEST_EXPECT_TRUE(_Target.size() == 1 && *_Target.front() == 7); // left unchanged
+            _Buffer[0] = 0; // not an image
+            GTEST_EXPECT_TRUE(!_Target.deserialize_from(_Buffer, sizeof(_Buffer)));
+            GTEST_EXPECT_TRUE(!_Target.deserialize_from(nullptr, 0));
+            GTEST_EXPECT_TRUE(_Target.size() == 1);
+        }
+
+        TEST(operations, freeze_and_thaw) {
+            safe_list<::std::string> _List = {"a", "b", "c", "b"};
+            ::mjx::safe_list_snapshot<::std::string> _Snapshot;
+            GTEST_EXPECT_TRUE(_Snapshot.empty() && _Snapshot.begin() == _Snapshot.end());
+            GTEST_ASSERT_TRUE(_List.freeze(_Snapshot));
+            GTEST_EXPECT_TRUE(_List.empty()); // the nodes are gone
+            const char* const _Expected[] = {"a", "b", "c", "b"};
+            GTEST_EXPECT_TRUE(_Snapshot.size() == 4);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Snapshot.begin(), _Snapshot.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Snapshot.end() - _Snapshot.begin() == 4); // random access
+            GTEST_EXPECT_TRUE(*_Snapshot.at_index(2) == "c" && !_Snapshot.at_index(4));
+            GTEST_EXPECT_TRUE(_Snapshot.count("b") == 2 && _Snapshot.find("c") == _Snapshot.begin() + 2);
+            GTEST_EXPECT_TRUE(!_Snapshot.contains("d"));
+            GTEST_ASSERT_TRUE(_List.push_back("z"));
+            GTEST_ASSERT_TRUE(_List.thaw(_Snapshot)); // replaces "z"
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Snapshot.size() == 4); // the snapshot is kept
+            ::mjx::safe_list_snapshot<::std::string> _Moved = ::std::move(_Snapshot);
+            GTEST_EXPECT_TRUE(_Snapshot.empty() && *_Moved.back() == "b");
+
+            safe_list<int> _Numbers;
+            for (int _Value = 0; _Value < 1000; ++_Value) {
+                GTEST_ASSERT_TRUE(_Numbers.push_back(_Value % 10));
+            }
+
+            ::mjx::safe_list_snapshot<int> _Frozen;
+            GTEST_ASSERT_TRUE(_Numbers.freeze(_Frozen));
+            GTEST_EXPECT_TRUE(_Frozen.count(7) == 100); // the SIMD kernels
+            GTEST_EXPECT_TRUE(_Frozen.find(9) == _Frozen.begin() + 9);
+            GTEST_EXPECT_TRUE(_Frozen.count_if([](const int _Value) noexcept { return _Value < 5; }) == 500);
+            int _Sum = 0;
+            _Frozen.for_each([&_Sum](const int _Value) noexcept { _Sum += _Value; });
+            GTEST_EXPECT_TRUE(_Sum == 4500);
+        }
+
+        TEST(operations, freeze_allocation_failure) {
+            size_t _Live = 0;
+            using _Alloc_t = _Counting_allocator<int>;
+            safe_list<int, _Alloc_t> _List({1, 2, 3}, _Alloc_t{&_Live});
+            ::mjx::safe_list_snapshot<int, _Alloc_t> _Snapshot(_Alloc_t{&_Live, 3}); // the nodes use the limit
+            GTEST_EXPECT_TRUE(!_List.freeze(_Snapshot));
+            GTEST_EXPECT_TRUE(_List.size() == 3 && _Snapshot.empty()); // both unchanged
+            _Snapshot = ::mjx::safe_list_snapshot<int, _Alloc_t>(_Alloc_t{&_Live});
+            GTEST_ASSERT_TRUE(_List.freeze(_Snapshot));
+            GTEST_EXPECT_TRUE(_Live == 1); // the array only
+        }
+    } // namespace operations
+
+    inline namespace unrolled_list {
+        TEST(unrolled_list, push_and_pop) {
+            safe_unrolled_list<int, 4> _List;
+            for (int _Value = 0; _Value < 10; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+            }
+
+            GTEST_ASSERT_TRUE(_List.push_front(-1));
+            GTEST_EXPECT_TRUE(_List.size() == 11);
+            GTEST_EXPECT_TRUE(*_List.front() == -1);
+            GTEST_EXPECT_TRUE(*_List.back() == 9);
+            _List.pop_front();
+            _List.pop_back();
+            constexpr int _Expected[] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+            GTEST_EXPECT_TRUE(_List.size() == 9);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+        }
+
+        TEST(unrolled_list, insert_splits_nodes) {
+            safe_unrolled_list<int, 4> _List(_Sample_data::_Init_list());
+            auto _Where = _List.cbegin();
+            for (uint8_t _Count = 0; _Count < 5; ++_Count) {
+                ++_Where;
+            }
+
+            GTEST_ASSERT_TRUE(_List.insert(_Where, 1).valid());
+            GTEST_ASSERT_TRUE(_List.insert(_List.cbegin(), {2, 3}).valid());
+            GTEST_ASSERT_TRUE(_List.insert(_List.cend(), size_t{2}, 4).valid());
+            constexpr int _Expected[] = {2, 3, 251, 515, 25, 16232, 5156, 1, 2551, 251, 5621, 6722, 915, 4, 4};
+            GTEST_EXPECT_TRUE(_List.size() == 15);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.rbegin(), _List.rend(), ::std::rbegin(_Expected)));
+        }
+
+        struct _Live_value { // records the live objects, so that reading a destroyed one is detected
+            static ::std::vector<const _Live_value*> _Live;
+            static size_t _Dead_reads;
+
+            int _Value;
+
+            _Live_value(const int _Value) noexcept : _Value(_Value) {
+                _Live.push_back(this);
+            }
+
+            _Live_value(const _Live_value& _Other) noexcept : _Value(_Other._Value) {
+                _Check_alive(_Other);
+                _Live.push_back(this);
+            }
+
+            _Live_value(_Live_value&& _Other) noexcept : _Value(_Other._Value) {
+                _Check_alive(_Other);
+                _Other._Value = -1;
+                _Live.push_back(this);
+            }
+
+            ~_Live_value() noexcept {
+                _Live.erase(::std::find(_Live.begin(), _Live.end(), this));
+            }
+
+            bool operator!=(const int _Other) const noexcept {
+                return _Value != _Other;
+            }
+
+            static void _Check_alive(const _Live_value& _Other) noexcept {
+                if (::std::find(_Live.begin(), _Live.end(), &_Other) == _Live.end()) {
+                    ++_Dead_reads;
+                }
+            }
+        };
+
+        ::std::vector<const _Live_value*> _Live_value::_Live;
+        size_t _Live_value::_Dead_reads = 0;
+
+        TEST(unrolled_list, insert_aliased_into_full_node) {
+            safe_unrolled_list<_Live_value, 4> _List{1, 2, 3, 4};
+            GTEST_ASSERT_TRUE(_List.insert(++_List.cbegin(), *::std::next(_List.begin(), 3)).valid()); // split
+            GTEST_ASSERT_TRUE(_List.insert(_List.cbegin(), *::std::next(_List.begin(), 1)).valid());
+            GTEST_ASSERT_TRUE(_List.insert(_List.cend(), size_t{2}, *::std::next(_List.begin(), 2)).valid());
+            constexpr int _Expected[] = {4, 1, 4, 2, 3, 4, 4, 4};
+            GTEST_EXPECT_TRUE(_List.size() == 8);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_ASSERT_TRUE(_List.insert(::std::next(_List.cbegin(), 5), _List.begin(), _List.end()).valid());
+            constexpr int _Expected_self[] = {4, 1, 4, 2, 3, 4, 1, 4, 2, 3, 4, 4, 4, 4, 4, 4};
+            GTEST_EXPECT_TRUE(_List.size() == 16);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected_self));
+            GTEST_ASSERT_TRUE(_List.assign(size_t{2}, *_List.front()));
+            GTEST_EXPECT_TRUE(_List.size() == 2 && _List.front()->_Value == 4 && _List.back()->_Value == 4);
+            GTEST_EXPECT_TRUE(_Live_value::_Dead_reads == 0);
+        }
+
+        TEST(unrolled_list, erase_merges_nodes) {
+            safe_unrolled_list<int, 4> _List(_Sample_data::_Init_list());
+            auto _Iter = _List.erase(++_List.cbegin());
+            GTEST_ASSERT_TRUE(_Iter.valid());
+            GTEST_EXPECT_TRUE(*_Iter == 25);
+            auto _Last = _List.cbegin();
+            for (uint8_t _Count = 0; _Count < 6; ++_Count) {
+                ++_Last;
+            }
+
+            _Iter = _List.erase(++_List.cbegin(), _Last);
+            GTEST_ASSERT_TRUE(_Iter.valid());
+            GTEST_EXPECT_TRUE(*_Iter == 5621);
+            constexpr int _Expected[] = {251, 5621, 6722, 915};
+            GTEST_EXPECT_TRUE(_List.size() == 4);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+        }
+
+        TEST(unrolled_list, remove_and_reverse) {
+            safe_unrolled_list<::std::string, 3> _List{"a", "bb", "c", "dd", "e", "ff", "g"};
+            GTEST_EXPECT_TRUE(_List.remove_if(
+                [](const ::std::string& _Value) noexcept {
+                    return _Value.size() == 2;
+                }
+            ) == 3);
+            _List.reverse();
+            const ::std::string _Expected[] = {"g", "e", "c", "a"};
+            GTEST_EXPECT_TRUE(_List.size() == 4);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_ASSERT_TRUE(_List.push_back("g"));
+            GTEST_EXPECT_TRUE(_List.remove(*_List.front()) == 2); // the argument refers to a removed element
+            const ::std::string _Expected_left[] = {"e", "c", "a"};
+            GTEST_EXPECT_TRUE(_List.size() == 3);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected_left));
+            safe_unrolled_list<int, 4> _Ints{5, 7, 7};
+            GTEST_EXPECT_TRUE(_Ints.remove(*_Ints.front()) == 1);
+            constexpr int _Expected_ints[] = {7, 7};
+            GTEST_EXPECT_TRUE(_Ints.size() == 2);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Ints.begin(), _Ints.end(), _Expected_ints));
+        }
+
+        TEST(unrolled_list, copy_and_move) {
+            safe_unrolled_list<int, 4> _List(_Sample_data::_Init_list());
+            safe_unrolled_list<int, 4> _Copy(_List);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Copy.begin(), _Copy.end(), _Sample_data::_Array));
+            safe_unrolled_list<int, 4> _Moved(::std::move(_Copy));
+            GTEST_EXPECT_TRUE(_Copy.empty());
+            GTEST_EXPECT_TRUE(_Moved.size() == _Sample_data::_Size);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Moved.begin(), _Moved.end(), _Sample_data::_Array));
+        }
+
+        TEST(unrolled_list, allocation_failure) {
+            size_t _Live = 0;
+            safe_unrolled_list<int, 2, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live, 2});
+            for (int _Value = 0; _Value < 4; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+            }
+
+            GTEST_EXPECT_TRUE(!_List.push_back(4));
+            GTEST_EXPECT_TRUE(!_List.insert(++_List.cbegin(), 5).valid());
+            GTEST_EXPECT_TRUE(_List.size() == 4);
+            GTEST_EXPECT_TRUE(!_List.insert(_List.cend(), size_t{5}, 9).valid());
+            GTEST_EXPECT_TRUE(!_List.insert(++_List.cbegin(), {5, 6}).valid()); // the split node does not fit
+            GTEST_EXPECT_TRUE(!_List.assign(size_t{6}, 1));
+            GTEST_EXPECT_TRUE(!_List.assign({5, 6, 7}));
+            constexpr int _Expected[] = {0, 1, 2, 3}; // all or nothing, the list is unchanged
+            GTEST_EXPECT_TRUE(_List.size() == 4);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Live == 2);
+            _List.pop_back();
+            _List.pop_back(); // frees the last node, the new one is created before the old one is freed
+            GTEST_ASSERT_TRUE(_List.assign({5, 6}));
+            GTEST_EXPECT_TRUE(_List.size() == 2 && *_List.front() == 5 && _Live == 1);
+            _List.clear();
+            GTEST_EXPECT_TRUE(_Live == 0);
+        }
+
+        template <class _Ty>
+        bool _Check_unrolled_search() {
+            // Note: 100 elements span several nodes, full blocks and tails shorter than a block.
+            safe_unrolled_list<_Ty, 37> _List;
+            for (int _Value = 0; _Value < 100; ++_Value) {
+                if (!_List.push_back(static_cast<_Ty>(_Value % 10 == 9 ? -1 : _Value))) {
+                    return false;
+                }
+            }
+
+            bool _Result = _List.count(static_cast<_Ty>(-1)) == 10 && _List.count(static_cast<_Ty>(42)) == 1
+                        && _List.count(static_cast<_Ty>(101)) == 0 && _List.contains(static_cast<_Ty>(98))
+                        && !_List.contains(static_cast<_Ty>(99));
+            for (int _Value = 0; _Value < 100; ++_Value) { // find every position, including the last one
+                if (_Value % 10 == 9) {
+                    continue;
+                }
+
+                auto _Iter = _List.find(static_cast<_Ty>(_Value));
+                _Result    = _Result && _Iter.valid() && *_Iter == static_cast<_Ty>(_Value);
+            }
+
+            _Result = _Result && *_List.find(static_cast<_Ty>(-1)) == static_cast<_Ty>(-1)
+                   && _List.find(static_cast<_Ty>(101)) == _List.end();
+            _Result = _Result && _List.remove(static_cast<_Ty>(-1)) == 10 && _List.size() == 90
+                   && _List.count(static_cast<_Ty>(-1)) == 0 && _List.remove(static_cast<_Ty>(101)) == 0;
+            int _Expected = 0;
+            for (const _Ty _Value : _List) {
+                if (_Expected % 10 == 9) {
+                    ++_Expected;
+                }
+
+                _Result = _Result && _Value == static_cast<_Ty>(_Expected++);
+            }
+
+            return _Result;
+        }
+
+        TEST(unrolled_list, search_kernels) {
+            enum class _Color : short { _Red, _Green };
+            GTEST_EXPECT_TRUE(_Check_unrolled_search<int8_t>());
+            GTEST_EXPECT_TRUE(_Check_unrolled_search<uint16_t>());
+            GTEST_EXPECT_TRUE(_Check_unrolled_search<int>());
+            GTEST_EXPECT_TRUE(_Check_unrolled_search<int64_t>());
+            GTEST_EXPECT_TRUE(_Check_unrolled_search<double>()); // compared with operator==, not bitwise
+            safe_unrolled_list<uint8_t, 5000> _Bytes(size_t{4999}, uint8_t{7}); // the 8-bit counters wrap around
+            GTEST_EXPECT_TRUE(_Bytes.count(7) == 4999);
+            GTEST_EXPECT_TRUE(_Bytes.find(8) == _Bytes.end());
+            safe_unrolled_list<_Color, 4> _Colors{_Color::_Red, _Color::_Green, _Color::_Green};
+            GTEST_EXPECT_TRUE(_Colors.count(_Color::_Green) == 2);
+            GTEST_EXPECT_TRUE(_Colors.remove(_Color::_Red) == 1);
+            GTEST_EXPECT_TRUE(*_Colors.front() == _Color::_Green);
+            safe_unrolled_list<::std::string, 3> _Strings{"a", "bb", "a", "c"};
+            GTEST_EXPECT_TRUE(_Strings.count("a") == 2);
+            GTEST_EXPECT_TRUE(_Strings.find("c") != _Strings.end());
+            GTEST_EXPECT_TRUE(_Strings.remove("a") == 2);
+            GTEST_EXPECT_TRUE(_Strings.size() == 2);
+        }
+    } // namespace unrolled_list
+
+    inline namespace xor_list {
+        TEST(xor_list, node_size) {
+            GTEST_EXPECT_TRUE((sizeof(::mjx::_Safe_xor_list_node<int, ::mjx::_Safe_list_traits<int>>)
+                               < sizeof(::mjx::_Safe_list_node<int, ::mjx::_Safe_list_traits<int>>)));
+        }
+
+        TEST(xor_list, modifiers) {
+            safe_xor_list<int> _List = _Sample_data::_Init_list();
+            GTEST_EXPECT_TRUE(_List.size() == _Sample_data::_Size);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Sample_data::_Array));
+            GTEST_EXPECT_TRUE(*_List.front() == 251);
+            GTEST_EXPECT_TRUE(*_List.back() == 915);
+            GTEST_EXPECT_TRUE(*--_List.cend() == 915); // end() can be decremented
+            auto _Where = _List.insert(++_List.cbegin(), 7); // before 515
+            GTEST_ASSERT_TRUE(_Where.valid());
+            GTEST_EXPECT_TRUE(*_Where == 7);
+            GTEST_EXPECT_TRUE(*++_Where == 515);
+            _Where = _List.erase(_Where); // erase 515
+            GTEST_EXPECT_TRUE(*_Where == 25);
+            GTEST_EXPECT_TRUE(*--_Where == 7);
+            _List.pop_front();
+            _List.pop_back();
+            GTEST_ASSERT_TRUE(_List.push_front(1));
+            GTEST_ASSERT_TRUE(_List.emplace_back(2));
+            constexpr int _Expected[] = {1, 7, 25, 16232, 5156, 2551, 251, 5621, 6722, 2};
+            GTEST_EXPECT_TRUE(_List.size() == 10);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+        }
+
+        TEST(xor_list, operations) {
+            safe_xor_list<int> _List = _Sample_data::_Init_list();
+            _List.reverse();
+            constexpr int _Reversed[_Sample_data::_Size] = {
+                915, 6722, 5621, 251, 2551, 5156, 16232, 25, 515, 251};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Reversed));
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.crbegin(), _List.crend(), _Sample_data::_Array));
+            GTEST_EXPECT_TRUE(_List.remove(251) == 2);
+            GTEST_EXPECT_TRUE(::mjx::erase(_List, [](const int _Value) noexcept { return _Value > 6000; }) == 2);
+            constexpr int _Expected[] = {915, 5621, 2551, 5156, 25, 515};
+            GTEST_EXPECT_TRUE(_List.size() == 6);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            const safe_xor_list<int> _Copy = _List;
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Copy.begin(), _Copy.end(), _Expected));
+            GTEST_EXPECT_TRUE(_List.remove(*_List.front()) == 1); // the argument refers to a removed element
+            GTEST_EXPECT_TRUE(_List.size() == 5 && *_List.front() == 5621);
+            _List.clear();
+            GTEST_EXPECT_TRUE(_List.empty());
+            GTEST_EXPECT_TRUE(_List.begin() == _List.end());
+        }
+
+        TEST(xor_list, allocation_failure) {
+            size_t _Live = 0;
+            safe_xor_list<int, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live, 2});
+            GTEST_ASSERT_TRUE(_List.push_back(1));
+            GTEST_ASSERT_TRUE(_List.push_back(2));
+            GTEST_EXPECT_TRUE(!_List.push_front(0));
+            GTEST_EXPECT_TRUE(!_List.insert(_List.cend(), 3).valid());
+            GTEST_EXPECT_TRUE(_List.size() == 2);
+            _List.clear();
+            GTEST_EXPECT_TRUE(_Live == 0);
+        }
+    } // namespace xor_list
+
+    inline namespace forward_list {
+        template <class _Storage, class _Size = ::mjx::safe_list_counted_size, class _Tail = ::mjx::safe_list_no_tail>
+        using _Forward_list = ::mjx::safe_forward_list<int, ::mjx::safe_allocator<int>,
+            ::mjx::safe_forward_list_policy<_Storage, _Size, _Tail>>;
+
+        TEST(forward_list, node_and_list_size) {
+            using _List_t = safe_forward_list<int>;
+            using _Node_t = ::std::remove_pointer_t<decltype(::std::declval<_List_t::iterator&>()._Get_node())>;
+            GTEST_EXPECT_TRUE((sizeof(_Node_t) < sizeof(::mjx::_Safe_list_node<int, ::mjx::_Safe_list_traits<int>>)));
+            using _Heap = ::mjx::safe_list_heap_storage;
+            GTEST_EXPECT_TRUE((sizeof(_Forward_list<_Heap, ::mjx::safe_list_uncounted_size>) + sizeof(size_t)
+                               == sizeof(_Forward_list<_Heap>))); // the counter compiles away
+            GTEST_EXPECT_TRUE((sizeof(_Forward_list<_Heap, ::mjx::safe_list_counted_size, ::mjx::safe_list_with_tail>)
+                               == sizeof(_Forward_list<_Heap>) + sizeof(void*)));
+        }
+
+        TEST(forward_list, modifiers) {
+            safe_forward_list<int> _List = _Sample_data::_Init_list();
+            GTEST_EXPECT_TRUE(_List.size() == _Sample_data::_Size);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Sample_data::_Array));
+            GTEST_ASSERT_TRUE(_List.push_front(7));
+            GTEST_EXPECT_TRUE(*_List.front() == 7);
+            auto _Where = _List.insert_after(_List.cbegin(), 8); // after 7
+            GTEST_ASSERT_TRUE(_Where.valid());
+            GTEST_EXPECT_TRUE(*++_Where == 251);
+            _Where = _List.erase_after(_List.cbegin()); // erase 8
+            GTEST_EXPECT_TRUE(*_Where == 251);
+            _List.pop_front();
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Sample_data::_Array));
+            GTEST_EXPECT_TRUE(_List.remove(251) == 2);
+            GTEST_EXPECT_TRUE(::mjx::erase(_List, [](const int _Value) noexcept { return _Value > 6000; }) == 2);
+            constexpr int _Expected[] = {915, 5621, 2551, 5156, 25, 515};
+            _List.reverse();
+            GTEST_EXPECT_TRUE(_List.size() == 6);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            const safe_forward_list<int> _Copy = _List;
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Copy.begin(), _Copy.end(), _Expected));
+            GTEST_EXPECT_TRUE(_List.remove(*_List.front()) == 1); // the argument refers to a removed element
+            GTEST_EXPECT_TRUE(_List.size() == 5 && *_List.front() == 5621);
+            _List.clear();
+            GTEST_EXPECT_TRUE(_List.empty() && _List.size() == 0 && !_List.front());
+        }
+
+        TEST(forward_list, size_and_tail_policies) {
+            using _Heap = ::mjx::safe_list_heap_storage;
+            _Forward_list<_Heap, ::mjx::safe_list_uncounted_size, ::mjx::safe_list_with_tail> _List;
+            for (int _Value = 0; _Value < 5; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+            }
+
+            GTEST_ASSERT_TRUE(_List.push_front(-1));
+            GTEST_EXPECT_TRUE(_List.size() == 6); // counted by a walk
+            GTEST_EXPECT_TRUE(*_List.back() == 4);
+            auto _Before_last = ::std::next(_List.cbegin(), 4);
+            (void) _List.erase_after(_Before_last); // erase the last node
+            GTEST_EXPECT_TRUE(*_List.back() == 3);
+            GTEST_ASSERT_TRUE(_List.insert_after(::std::next(_List.cbegin(), 4), 9).valid()); // after the last node
+            GTEST_EXPECT_TRUE(*_List.back() == 9);
+            _List.reverse();
+            GTEST_EXPECT_TRUE(*_List.back() == -1 && *_List.front() == 9);
+            GTEST_ASSERT_TRUE(_List.push_back(10));
+            constexpr int _Expected[] = {9, 3, 2, 1, 0, -1, 10};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_EXPECT_TRUE(_List.remove_if([](const int _Value) noexcept { return _Value >= 9; }) == 2);
+            GTEST_EXPECT_TRUE(*_List.back() == -1);
+            while (!_List.empty()) {
+                _List.pop_front();
+            }
+
+            GTEST_EXPECT_TRUE(!_List.back());
+            GTEST_ASSERT_TRUE(_List.push_back(1));
+            GTEST_EXPECT_TRUE(_List.front() == _List.back());
+        }
+
+        TEST(forward_list, storages) {
+            _Forward_list<::mjx::safe_list_slab_storage<256>> _Slab_list;
+            for (int _Value = 0; _Value < 100; ++_Value) {
+                GTEST_ASSERT_TRUE(_Slab_list.push_front(_Value));
+            }
+
+            GTEST_EXPECT_TRUE(_Slab_list.size() == 100 && *_Slab_list.front() == 99);
+            _Forward_list<::mjx::safe_list_bounded_storage> _Bounded_list;
+            GTEST_ASSERT_TRUE(_Bounded_list.reserve_nodes(2));
+            GTEST_ASSERT_TRUE(_Bounded_list.push_front(1));
+            GTEST_ASSERT_TRUE(_Bounded_list.push_front(2));
+            GTEST_EXPECT_TRUE(!_Bounded_list.push_front(3) && _Bounded_list.max_size() == 2);
+            using _Inline_list = _Forward_list<::mjx::safe_list_inline_storage<4>, ::mjx::safe_list_counted_size,
+                ::mjx::safe_list_with_tail>;
+            _Inline_list _Source;
+            for (int _Value = 0; _Value < 6; ++_Value) { // four inline nodes, two on the heap
+                GTEST_ASSERT_TRUE(_Source.push_back(_Value));
+            }
+
+            _Inline_list _Moved(::std::move(_Source));
+            constexpr int _Expected[] = {0, 1, 2, 3, 4, 5};
+            GTEST_EXPECT_TRUE(_Source.empty() && _Moved.size() == 6);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Moved.begin(), _Moved.end(), _Expected));
+            GTEST_EXPECT_TRUE(*_Moved.back() == 5);
+            _Inline_list _Other = {7};
+            _Other.swap(_Moved);
+            GTEST_EXPECT_TRUE(_Other.size() == 6 && *_Moved.front() == 7 && *_Other.back() == 5);
+            GTEST_ASSERT_TRUE(_Source.push_back(1)); // the moved-from list is usable
+            GTEST_EXPECT_TRUE(*_Source.back() == 1);
+        }
+
+        TEST(forward_list, allocation_failure) {
+            size_t _Live = 0;
+            using _Alloc_t = _Counting_allocator<int>;
+            ::mjx::safe_forward_list<int, _Alloc_t> _List(_Alloc_t{&_Live, 2});
+            GTEST_ASSERT_TRUE(_List.push_front(1));
+            GTEST_ASSERT_TRUE(_List.push_front(2));
+            GTEST_EXPECT_TRUE(!_List.push_front(0));
+            GTEST_EXPECT_TRUE(!_List.insert_after(_List.cbegin(), 3).valid());
+            GTEST_EXPECT_TRUE(_List.size() == 2);
+            _List.node_cache_limit(2);
+            _List.pop_front();
+            GTEST_EXPECT_TRUE(_List.cached_nodes() == 1 && _Live == 2); // the spent node is cached
+            GTEST_ASSERT_TRUE(_List.push_front(3)); // reuses the cached node
+            _List.clear();
+            _List.shrink_to_fit();
+            GTEST_EXPECT_TRUE(_Live == 0);
+        }
+    } // namespace forward_list
+
+    inline namespace index_list {
+        TEST(index_list, modifiers) {
+            safe_index_list<int> _List = _Sample_data::_Init_list();
+            GTEST_EXPECT_TRUE(_List.size() == _Sample_data::_Size);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Sample_data::_Array));
+            GTEST_EXPECT_TRUE(*_List.front() == 251);
+            GTEST_EXPECT_TRUE(*_List.back() == 915);
+            GTEST_EXPECT_TRUE(*--_List.cend() == 915); // end() can be decremented
+            auto _Where = _List.insert(++_List.cbegin(), 7); // before 515
+            GTEST_ASSERT_TRUE(_Where.valid());
+            GTEST_EXPECT_TRUE(*_Where == 7);
+            GTEST_EXPECT_TRUE(*++_Where == 515);
+            _Where = _List.erase(_Where); // erase 515
+            GTEST_EXPECT_TRUE(*_Where == 25);
+            GTEST_EXPECT_TRUE(*--_Where == 7);
+            _List.pop_front();
+            _List.pop_back();
+            GTEST_ASSERT_TRUE(_List.push_front(1));
+            GTEST_ASSERT_TRUE(_List.emplace_back(2));
+            constexpr int _Expected[] = {1, 7, 25, 16232, 5156, 2551, 251, 5621, 6722, 2};
+            GTEST_EXPECT_TRUE(_List.size() == 10);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            GTEST_EXPECT_TRUE(_List.capacity() == 20); // grown once by insert(), push_*() reused erased slots
+        }
+
+        TEST(index_list, stable_slots) {
+            safe_index_list<::std::string> _List;
+            GTEST_ASSERT_TRUE(_List.push_back("first"));
+            const auto _First = _List.cbegin();
+            const size_t _Slot = _First.index();
+            for (int _Idx = 0; _Idx < 100; ++_Idx) { // grow the arrays a few times
+                GTEST_ASSERT_TRUE(_List.push_back(::std::to_string(_Idx)));
+            }
+
+            GTEST_EXPECT_TRUE(_List.capacity() >= 101);
+            GTEST_EXPECT_TRUE(*_First == "first"); // iterators and slot indices survive the growth
+            GTEST_EXPECT_TRUE(_List.iterator_to_slot(_Slot).index() == _Slot);
+            GTEST_ASSERT_TRUE(_List.push_back(*_List.front())); // the argument refers to an element
+            GTEST_EXPECT_TRUE(*_List.back() == "first");
+            _List.pop_front();
+            GTEST_EXPECT_TRUE(!_List.iterator_to_slot(_Slot).valid());
+            GTEST_EXPECT_TRUE(!_List.iterator_to_slot(1000).valid());
+            GTEST_ASSERT_TRUE(_List.push_front("again"));
+            GTEST_EXPECT_TRUE(_List.cbegin().index() == _Slot); // the erased slot is reused
+        }
+
+        TEST(index_list, operations) {
+            safe_index_list<int> _List = _Sample_data::_Init_list();
+            _List.reverse();
+            constexpr int _Reversed[_Sample_data::_Size] = {
+                915, 6722, 5621, 251, 2551, 5156, 16232, 25, 515, 251};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Reversed));
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.crbegin(), _List.crend(), _Sample_data::_Array));
+            GTEST_EXPECT_TRUE(_List.remove(251) == 2);
+            GTEST_EXPECT_TRUE(::mjx::erase(_List, [](const int _Value) noexcept { return _Value > 6000; }) == 2);
+            constexpr int _Expected[] = {915, 5621, 2551, 5156, 25, 515};
+            GTEST_EXPECT_TRUE(_List.size() == 6);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            const safe_index_list<int> _Copy = _List; // copied as it is, including the free slots
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Copy.begin(), _Copy.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Copy.cbegin().index() == _List.cbegin().index());
+            const safe_index_list<::std::string> _Strings = {"a", "b", "c"};
+            safe_index_list<::std::string> _Strings_copy;
+            _Strings_copy = _Strings;
+            GTEST_EXPECT_TRUE(_Strings_copy.size() == 3 && *_Strings_copy.back() == "c");
+            GTEST_ASSERT_TRUE(_Strings_copy.push_back("a"));
+            GTEST_EXPECT_TRUE(_Strings_copy.remove(*_Strings_copy.front()) == 2); // refers to a removed element
+            GTEST_EXPECT_TRUE(_Strings_copy.size() == 2 && *_Strings_copy.front() == "b");
+            _List.clear();
+            GTEST_EXPECT_TRUE(_List.empty());
+            GTEST_EXPECT_TRUE(_List.begin() == _List.end());
+        }
+
+        TEST(index_list, allocation_failure) {
+            size_t _Live = 0;
+            safe_index_list<int, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live, 2});
+            for (int _Idx = 0; _Idx < 8; ++_Idx) { // the first growth allocates both arrays
+                GTEST_ASSERT_TRUE(_List.push_back(_Idx));
+            }
+
+            GTEST_EXPECT_TRUE(!_List.push_front(8)); // the arrays cannot grow
+            GTEST_EXPECT_TRUE(!_List.insert(_List.cend(), 9).valid());
+            GTEST_EXPECT_TRUE(!_List.reserve(16));
+            GTEST_EXPECT_TRUE(_List.size() == 8);
+            _List.pop_back();
+            GTEST_ASSERT_TRUE(_List.push_back(7)); // the erased slot is reused
+            _List.clear();
+            GTEST_EXPECT_TRUE(_Live == 2); // clear() keeps the arrays
+        }
+    } // namespace index_list
+
+    inline namespace sorted_list {
+        template <class _List>
+        bool _Is_sorted_both_ways(const _List& _Target) noexcept {
+            // Note: Checks the order and the back links, and that size() matches both traversals.
+            size_t _Forward  = 0;
+            size_t _Backward = 0;
+            for (auto _Iter = _Target.begin(); _Iter != _Target.end(); ++_Iter, ++_Forward) {
+                auto _Next = _Iter;
+                if (++_Next != _Target.end() && *_Next < *_Iter) {
+                    return false;
+                }
+            }
+
+            for (auto _Iter = _Target.rbegin(); _Iter != _Target.rend(); ++_Iter) {
+                ++_Backward;
+            }
+
+            return _Forward == _Target.size() && _Backward == _Target.size();
+        }
+
+        TEST(sorted_list, insert_and_iterate) {
+            safe_sorted_list<int> _List = _Sample_data::_Init_list();
+            constexpr int _Sorted[_Sample_data::_Size] = {25, 251, 251, 515, 915, 2551, 5156, 5621, 6722, 16232};
+            GTEST_EXPECT_TRUE(_List.size() == _Sample_data::_Size);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Sorted));
+            GTEST_EXPECT_TRUE(*_List.front() == 25);
+            GTEST_EXPECT_TRUE(*_List.back() == 16232);
+            auto _Where = _List.insert(600);
+            GTEST_ASSERT_TRUE(_Where.valid());
+            GTEST_EXPECT_TRUE(*--_Where == 515);
+            GTEST_EXPECT_TRUE(*++++_Where == 915);
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.crbegin(), ++_List.crbegin(), &_Sorted[_Sample_data::_Size - 1]));
+
+            safe_sorted_list<int, ::std::greater<>> _Descending = {3, 1, 2};
+            constexpr int _Expected[] = {3, 2, 1};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Descending.begin(), _Descending.end(), _Expected));
+        }
+
+        TEST(sorted_list, stable_duplicates) {
+            using _Pair_t = ::std::pair<int, int>;
+            struct _Key_less {
+                bool operator()(const _Pair_t& _Left, const _Pair_t& _Right) const noexcept {
+                    return _Left.first < _Right.first; // the second member records the insertion order
+                }
+            };
+
+            safe_sorted_list<_Pair_t, _Key_less> _List;
+            for (int _Idx = 0; _Idx < 300; ++_Idx) {
+                GTEST_ASSERT_TRUE(_List.emplace(_Idx % 3, _Idx).valid());
+            }
+
+            int _Last_key   = 0;
+            int _Last_order = -1;
+            for (const auto& _Pair : _List) {
+                if (_Pair.first != _Last_key) {
+                    _Last_key   = _Pair.first;
+                    _Last_order = -1;
+                }
+
+                GTEST_EXPECT_TRUE(_Pair.second > _Last_order);
+                _Last_order = _Pair.second;
+            }
+
+            GTEST_EXPECT_TRUE(_List.count({1, 0}) == 100);
+            GTEST_EXPECT_TRUE(_List.find({1, 0})->second == 1); // the first inserted equivalent element
+            GTEST_EXPECT_TRUE(_List.remove({1, 0}) == 100);
+            GTEST_EXPECT_TRUE(!_List.contains({1, 0}));
+            GTEST_EXPECT_TRUE(_List.size() == 200);
+        }
+
+        TEST(sorted_list, lookup) {
+            safe_sorted_list<int> _List;
+            for (int _Idx = 0; _Idx < 1000; ++_Idx) { // even values only, in a scrambled order
+                GTEST_ASSERT_TRUE(_List.insert((_Idx * 397) % 1000 * 2).valid());
+            }
+
+            GTEST_EXPECT_TRUE(_Is_sorted_both_ways(_List));
+            GTEST_EXPECT_TRUE(_List.contains(998));
+            GTEST_EXPECT_TRUE(!_List.contains(999));
+            GTEST_EXPECT_TRUE(!_List.find(-1).valid());
+            GTEST_EXPECT_TRUE(*_List.lower_bound(999) == 1000);
+            GTEST_EXPECT_TRUE(*_List.lower_bound(1000) == 1000);
+            GTEST_EXPECT_TRUE(*_List.upper_bound(1000) == 1002);
+            GTEST_EXPECT_TRUE(_List.lower_bound(-5) == _List.begin());
+            GTEST_EXPECT_TRUE(_List.upper_bound(1998) == _List.end());
+            const auto _Range = _List.equal_range(500);
+            GTEST_EXPECT_TRUE(*_Range.first == 500 && *_Range.second == 502);
+            GTEST_EXPECT_TRUE(_List.count(500) == 1 && _List.count(501) == 0);
+        }
+
+        TEST(sorted_list, erase) {
+            safe_sorted_list<int> _List;
+            for (int _Idx = 0; _Idx < 2000; ++_Idx) {
+                GTEST_ASSERT_TRUE(_List.insert(_Idx % 500).valid()); // four copies of every value
+            }
+
+            auto _Where = _List.erase(_List.find(10)); // the first 10
+            GTEST_EXPECT_TRUE(*_Where == 10 && _List.count(10) == 3);
+            _Where = _List.erase(_List.lower_bound(20), _List.upper_bound(29));
+            GTEST_EXPECT_TRUE(*_Where == 30);
+            GTEST_EXPECT_TRUE(_List.size() == 2000 - 1 - 40);
+            GTEST_EXPECT_TRUE(_List.remove_if([](const int _Value) noexcept { return _Value % 2 != 0; }) == 1000 - 20);
+            GTEST_EXPECT_TRUE(::mjx::erase(_List, 100) == 4);
+            _List.pop_front();
+            _List.pop_back();
+            GTEST_EXPECT_TRUE(*_List.front() == 0 && *_List.back() == 498);
+            GTEST_EXPECT_TRUE(_Is_sorted_both_ways(_List));
+            GTEST_EXPECT_TRUE(_List.remove(*_List.front()) == 3); // the argument refers to a removed element
+            GTEST_EXPECT_TRUE(*_List.front() == 2 && _Is_sorted_both_ways(_List));
+            while (!_List.empty()) { // erase in the middle until nothing is left
+                (void) _List.erase(_List.lower_bound(250));
+                GTEST_ASSERT_TRUE(_Is_sorted_both_ways(_List));
+                if (!_List.empty()) {
+                    _List.pop_back();
+                }
+            }
+
+            GTEST_ASSERT_TRUE(_List.insert(5).valid()); // the levels are usable again
+            GTEST_EXPECT_TRUE(_List.size() == 1 && _List.contains(5));
+        }
+
+        TEST(sorted_list, copy_and_move) {
+            safe_sorted_list<::std::string> _List = {"delta", "alpha", "charlie", "bravo"};
+            const safe_sorted_list<::std::string> _Copy = _List;
+            const char* const _Expected[] = {"alpha", "bravo", "charlie", "delta"};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_Copy.begin(), _Copy.end(), _Expected));
+            GTEST_EXPECT_TRUE(_Copy.contains("charlie")); // the copy keeps a working skip structure
+            safe_sorted_list<::std::string> _Moved = ::std::move(_List);
+            GTEST_EXPECT_TRUE(_List.empty() && _Moved.size() == 4);
+            GTEST_ASSERT_TRUE(_List.insert("echo").valid()); // the moved-from list is usable
+            _List = _Copy;
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            swap(_List, _Moved);
+            _List.clear();
+            GTEST_EXPECT_TRUE(_List.empty() && _Moved.size() == 4);
+        }
+
+        TEST(sorted_list, allocation_failure) {
+            size_t _Live = 0;
+            safe_sorted_list<int, ::std::less<>, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live, 4});
+            GTEST_ASSERT_TRUE(_List.insert({4, 2, 3}));
+            GTEST_EXPECT_TRUE(!_List.insert({7, 5})); // all or nothing
+            GTEST_EXPECT_TRUE(_List.size() == 3 && _Live == 3);
+            GTEST_ASSERT_TRUE(_List.insert(1).valid());
+            GTEST_EXPECT_TRUE(!_List.emplace(6).valid());
+            constexpr int _Expected[] = {1, 2, 3, 4};
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Expected));
+            _List.clear();
+            GTEST_EXPECT_TRUE(_Live == 0);
+        }
+    } // namespace sorted_list
+
+    inline namespace intrusive_list {
+        struct _Intrusive_item { // the hook is not the first member, so its offset is not zero
+            int _Value;
+            ::mjx::safe_list_hook _Hook;
+            ::mjx::safe_list_hook _Other_hook;
+
+            explicit _Intrusive_item(const int _Value = 0) noexcept : _Value(_Value), _Hook(), _Other_hook() {}
+        };
+
+        using _Intrusive_list       = safe_intrusive_list<_Intrusive_item, &_Intrusive_item::_Hook>;
+        using _Other_intrusive_list = safe_intrusive_list<_Intrusive_item, &_Intrusive_item::_Other_hook>;
+
+        template <class _List>
+        ::std::vector<int> _Intrusive_values(const _List& _Target) {
+            ::std::vector<int> _Values;
+            for (const _Intrusive_item& _Item : _Target) {
+                _Values.push_back(_Item._Value);
+            }
+
+            return _Values;
+        }
+
+        TEST(intrusive_list, modifiers) {
+            _Intrusive_item _Items[5] = {
+                _Intrusive_item{1}, _Intrusive_item{2}, _Intrusive_item{3}, _Intrusive_item{4}, _Intrusive_item{5}};
+            _Intrusive_list _List;
+            GTEST_ASSERT_TRUE(_List.push_back(_Items[1]));
+            GTEST_ASSERT_TRUE(_List.push_front(_Items[0]));
+            GTEST_ASSERT_TRUE(_List.push_back(_Items[3]));
+            GTEST_EXPECT_TRUE(!_List.push_back(_Items[3])); // already linked
+            GTEST_ASSERT_TRUE(_List.insert(_List.iterator_to(_Items[3]), _Items[2]).valid());
+            GTEST_EXPECT_TRUE(_List.size() == 4);
+            GTEST_EXPECT_TRUE(_Intrusive_values(_List) == (::std::vector<int>{1, 2, 3, 4}));
+            GTEST_EXPECT_TRUE(_List.front() == &_Items[0]);
+            GTEST_EXPECT_TRUE(_List.back() == &_Items[3]);
+            GTEST_EXPECT_TRUE(_List.crbegin()->_Value == 4);
+            GTEST_EXPECT_TRUE(_List.erase(_Items[1])); // O(1) from the element itself
+            GTEST_EXPECT_TRUE(!_Items[1]._Hook.is_linked());
+            GTEST_EXPECT_TRUE(!_List.erase(_Items[4]));
+            GTEST_EXPECT_TRUE(_List.erase(_List.cbegin())->_Value == 3);
+            GTEST_EXPECT_TRUE(_Intrusive_values(_List) == (::std::vector<int>{3, 4}));
+            _List.clear();
+            GTEST_EXPECT_TRUE(_List.empty());
+            GTEST_EXPECT_TRUE(!_Items[2]._Hook.is_linked() && !_Items[3]._Hook.is_linked());
+        }
+
+        TEST(intrusive_list, two_hooks) {
+            _Intrusive_item _Items[3] = {_Intrusive_item{1}, _Intrusive_item{2}, _Intrusive_item{3}};
+            _Intrusive_list _List;
+            _Other_intrusive_list _Other;
+            for (_Intrusive_item& _Item : _Items) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Item));
+                GTEST_ASSERT_TRUE(_Other.push_front(_Item));
+            }
+
+            GTEST_EXPECT_TRUE(_Intrusive_values(_List) == (::std::vector<int>{1, 2, 3}));
+            GTEST_EXPECT_TRUE(_Intrusive_values(_Other) == (::std::vector<int>{3, 2, 1}));
+            _Intrusive_item _Copy = _Items[0];
+            GTEST_EXPECT_TRUE(!_Copy._Hook.is_linked()); // links are not copied
+            int _Sum = 0;
+            for (const _Intrusive_item& _Item : ::mjx::safe_list_prefetched(_Other)) {
+                _Sum = _Sum * 10 + _Item._Value;
+            }
+
+            GTEST_EXPECT_TRUE(_Sum == 321);
+        }
+
+        TEST(intrusive_list, operations) {
+            _Intrusive_item _Items[6] = {_Intrusive_item{1}, _Intrusive_item{2}, _Intrusive_item{3},
+                _Intrusive_item{4}, _Intrusive_item{5}, _Intrusive_item{6}};
+            _Intrusive_list _List;
+            _Intrusive_list _Other;
+            for (size_t _Idx = 0; _Idx < 3; ++_Idx) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Items[_Idx]));
+                GTEST_ASSERT_TRUE(_Other.push_back(_Items[_Idx + 3]));
+            }
+
+            _List.splice(++_List.cbegin(), _Other);
+            GTEST_EXPECT_TRUE(_Other.empty());
+            GTEST_EXPECT_TRUE(_Intrusive_values(_List) == (::std::vector<int>{1, 4, 5, 6, 2, 3}));
+            _List.reverse();
+            GTEST_EXPECT_TRUE(_Intrusive_values(_List) == (::std::vector<int>{3, 2, 6, 5, 4, 1}));
+            GTEST_EXPECT_TRUE(_List.remove_if([](const _Intrusive_item& _Item) noexcept {
+                return _Item._Value % 2 == 0;
+            }) == 3);
+            GTEST_EXPECT_TRUE(_Intrusive_values(_List) == (::std::vector<int>{3, 5, 1}));
+            _List.pop_front();
+            _List.pop_back();
+            GTEST_EXPECT_TRUE(_Intrusive_values(_List) == (::std::vector<int>{5}));
+            _Intrusive_list _Moved(::std::move(_List));
+            GTEST_EXPECT_TRUE(_List.empty());
+            GTEST_EXPECT_TRUE(_Moved.size() == 1);
+        }
+    } // namespace intrusive_list
+
+    inline namespace mpsc_list {
+        TEST(mpsc_list, push_pop) {
+            safe_mpsc_list<::std::string> _Queue;
+            ::std::string _Value;
+            GTEST_EXPECT_TRUE(_Queue.empty());
+            GTEST_EXPECT_TRUE(!_Queue.pop_front(_Value));
+            GTEST_ASSERT_TRUE(_Queue.push_back("first"));
+            GTEST_ASSERT_TRUE(_Queue.emplace_back(3, 'x'));
+            GTEST_EXPECT_TRUE(!_Queue.empty());
+            GTEST_ASSERT_TRUE(_Queue.pop_front(_Value));
+            GTEST_EXPECT_TRUE(_Value == "first");
+            GTEST_ASSERT_TRUE(_Queue.pop_front(_Value));
+            GTEST_EXPECT_TRUE(_Value == "xxx");
+            GTEST_EXPECT_TRUE(_Queue.empty());
+            GTEST_EXPECT_TRUE(!_Queue.pop_front(_Value));
+            GTEST_ASSERT_TRUE(_Queue.push_back("again")); // the stub is re-queued
+            GTEST_ASSERT_TRUE(_Queue.pop_front(_Value));
+            GTEST_EXPECT_TRUE(_Value == "again");
+        }
+
+        TEST(mpsc_list, allocation_failure) {
+            size_t _Live = 0;
+            safe_mpsc_list<int, _Counting_allocator<int>> _Queue(_Counting_allocator<int>{&_Live, 2});
+            GTEST_ASSERT_TRUE(_Queue.push_back(1));
+            GTEST_ASSERT_TRUE(_Queue.push_back(2));
+            GTEST_EXPECT_TRUE(!_Queue.push_back(3));
+            int _Value = 0;
+            GTEST_ASSERT_TRUE(_Queue.pop_front(_Value));
+            GTEST_EXPECT_TRUE(_Value == 1);
+            GTEST_ASSERT_TRUE(_Queue.push_back(3));
+            _Queue.clear();
+            GTEST_EXPECT_TRUE(_Live == 0);
+        }
+
+        TEST(mpsc_list, drain) {
+            safe_mpsc_list<int> _Queue;
+            for (int _Value = 0; _Value < 5; ++_Value) {
+                GTEST_ASSERT_TRUE(_Queue.push_back(_Value));
+            }
+
+            int _Sum = 0;
+            GTEST_EXPECT_TRUE(_Queue.drain([&_Sum](int&& _Value) noexcept { _Sum += _Value; }) == 5);
+            GTEST_EXPECT_TRUE(_Sum == 10);
+            for (const int _Value : _Sample_data::_Array) {
+                GTEST_ASSERT_TRUE(_Queue.push_back(_Value));
+            }
+
+            safe_list<int> _List;
+            GTEST_EXPECT_TRUE(_Queue.drain(_List) == _Sample_data::_Size);
+            GTEST_EXPECT_TRUE(_Queue.empty());
+            GTEST_EXPECT_TRUE(_Compare_arrays(_List.begin(), _List.end(), _Sample_data::_Array));
+        }
+
+        TEST(mpsc_list, concurrent_producers) {
+            constexpr int _Producers = 4;
+            constexpr int _Count     = 20000;
+            safe_mpsc_list<int> _Queue;
+            ::std::vector<::std::thread> _Threads;
+            for (int _Id = 0; _Id < _Producers; ++_Id) {
+                _Threads.emplace_back([&_Queue, _Id] {
+                    for (int _Idx = 0; _Idx < _Count; ++_Idx) {
+                        while (!_Queue.push_back(_Id * _Count + _Idx)) {}
+                    }
+                });
+            }
+
+            int _Last[_Producers] = {-1, -1, -1, -1};
+            int _Received         = 0;
+            bool _Ordered         = true;
+            int _Value;
+            while (_Received < _Producers * _Count) {
+                if (_Queue.pop_front(_Value)) { // elements of one producer keep their order
+                    const int _Id = _Value / _Count;
+                    _Ordered      = _Ordered && _Value % _Count == _Last[_Id] + 1;
+                    _Last[_Id]    = _Value % _Count;
+                    ++_Received;
+                }
+            }
+
+            for (::std::thread& _Thread : _Threads) {
+                _Thread.join();
+            }
+
+            GTEST_EXPECT_TRUE(_Ordered);
+            GTEST_EXPECT_TRUE(_Queue.empty());
+        }
+    } // namespace mpsc_list
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+    inline namespace async_list {
+        struct _Detached_task { // fire-and-forget coroutine, the frame is freed when the body ends
+            struct promise_type {
+                _Detached_task get_return_object() noexcept {
+                    return {};
+                }
+
+                ::std::suspend_never initial_suspend() noexcept {
+                    return {};
+                }
+
+                ::std::suspend_never final_suspend() noexcept {
+                    return {};
+                }
+
+                void return_void() noexcept {}
+
+                void unhandled_exception() noexcept {
+                    ::std::terminate();
+                }
+            };
+        };
+
+        template <class _Ty, class _Alloc>
+        _Detached_task _Consume(safe_async_list<_Ty, _Alloc>& _List, const size_t _Count, _Ty* const _Dest,
+            ::std::atomic<size_t>* const _Done) {
+            for (size_t _Idx = 0; _Idx < _Count; ++_Idx) {
+                _Dest[_Idx] = co_await _List.pop_front();
+                _Done->fetch_add(1, ::std::memory_order_release);
+            }
+        }
+
+        TEST(async_list, ready_and_suspended) {
+            safe_async_list<::std::string> _List;
+            ::std::string _Values[3];
+            ::std::atomic<size_t> _Done{0};
+            GTEST_ASSERT_TRUE(_List.push_back("first"));
+            _Consume(_List, 3, _Values, &_Done); // takes the first element without suspending
+            GTEST_EXPECT_TRUE(_Done == 1);
+            GTEST_EXPECT_TRUE(_Values[0] == "first");
+            GTEST_ASSERT_TRUE(_List.emplace_back(3, 'x')); // resumes the coroutine before returning
+            GTEST_EXPECT_TRUE(_Done == 2);
+            GTEST_EXPECT_TRUE(_Values[1] == "xxx");
+            GTEST_ASSERT_TRUE(_List.push_back("last"));
+            GTEST_EXPECT_TRUE(_Done == 3);
+            GTEST_EXPECT_TRUE(_Values[2] == "last");
+            GTEST_EXPECT_TRUE(_List.empty());
+            ::std::string _Value;
+            GTEST_ASSERT_TRUE(_List.push_back("again")); // nobody waits
+            GTEST_ASSERT_TRUE(_List.try_pop_front(_Value));
+            GTEST_EXPECT_TRUE(_Value == "again");
+            GTEST_EXPECT_TRUE(!_List.try_pop_front(_Value));
+        }
+
+        TEST(async_list, allocation_failure) {
+            size_t _Live = 0;
+            safe_async_list<int, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live, 1});
+            int _Values[2] = {0, 0};
+            ::std::atomic<size_t> _Done{0};
+            _Consume(_List, 2, _Values, &_Done);
+            GTEST_ASSERT_TRUE(_List.push_back(1));
+            GTEST_EXPECT_TRUE(_Done == 1);
+            GTEST_ASSERT_TRUE(_List.push_back(2)); // the first node was freed
+            GTEST_EXPECT_TRUE(_Done == 2);
+            GTEST_ASSERT_TRUE(_List.push_back(3));
+            GTEST_EXPECT_TRUE(!_List.push_back(4)); // nobody waits, the failure does not resume anything
+            GTEST_EXPECT_TRUE(_Values[0] == 1 && _Values[1] == 2);
+            _List.clear();
+            GTEST_EXPECT_TRUE(_Live == 0);
+        }
+
+        TEST(async_list, concurrent_producers) {
+            constexpr int _Producers = 4;
+            constexpr int _Count     = 20000;
+            safe_async_list<int> _List;
+            ::std::vector<int> _Values(_Producers * _Count);
+            ::std::atomic<size_t> _Done{0};
+            _Consume(_List, _Values.size(), _Values.data(), &_Done); // suspends, resumed by the producers
+            ::std::vector<::std::thread> _Threads;
+            for (int _Id = 0; _Id < _Producers; ++_Id) {
+                _Threads.emplace_back([&_List, _Id] {
+                    for (int _Idx = 0; _Idx < _Count; ++_Idx) {
+                        while (!_List.push_back(_Id * _Count + _Idx)) {}
+                    }
+                });
+            }
+
+            for (::std::thread& _Thread : _Threads) {
+                _Thread.join();
+            }
+
+            GTEST_ASSERT_TRUE(_Done == _Values.size()); // no wake-up was lost
+            int _Last[_Producers] = {-1, -1, -1, -1};
+            bool _Ordered         = true;
+            for (const int _Value : _Values) { // elements of one producer keep their order
+                const int _Id = _Value / _Count;
+                _Ordered      = _Ordered && _Value % _Count == _Last[_Id] + 1;
+                _Last[_Id]    = _Value % _Count;
+            }
+
+            GTEST_EXPECT_TRUE(_Ordered);
+            GTEST_EXPECT_TRUE(_List.empty());
+        }
+    } // namespace async_list
+#endif // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+    inline namespace concurrent_list {
+        TEST(concurrent_list, modifiers) {
+            safe_concurrent_list<int> _List;
+            GTEST_ASSERT_TRUE(_List.push_back(2));
+            GTEST_ASSERT_TRUE(_List.push_front(1));
+            GTEST_ASSERT_TRUE(_List.push_back(4));
+            GTEST_ASSERT_TRUE(_List.insert_before([](const int _Value) noexcept { return _Value > 2; }, 3));
+            GTEST_ASSERT_TRUE(_List.emplace_before([](const int) noexcept { return false; }, 5)); // at the end
+            GTEST_EXPECT_TRUE(_List.size() == 5);
+            ::std::vector<int> _Values;
+            _List.for_each([&_Values](const int _Value) { _Values.push_back(_Value); });
+            GTEST_EXPECT_TRUE(_Values == (::std::vector<int>{1, 2, 3, 4, 5}));
+            GTEST_EXPECT_TRUE(_List.contains(3));
+            GTEST_EXPECT_TRUE(_List.count_if([](const int _Value) noexcept { return _Value % 2 != 0; }) == 3);
+            int _Found = 0;
+            GTEST_EXPECT_TRUE(_List.find_if([](const int _Value) noexcept { return _Value > 3; }, _Found));
+            GTEST_EXPECT_TRUE(_Found == 4);
+            GTEST_EXPECT_TRUE(_List.erase_first([](const int _Value) noexcept { return _Value > 1; }));
+            GTEST_EXPECT_TRUE(!_List.contains(2));
+            GTEST_EXPECT_TRUE(_List.remove(3) == 1);
+            GTEST_EXPECT_TRUE(!_List.erase_first([](const int _Value) noexcept { return _Value == 3; }));
+            GTEST_EXPECT_TRUE(_List.size() == 3);
+            _List.clear();
+            GTEST_EXPECT_TRUE(_List.empty());
+        }
+
+        TEST(concurrent_list, allocation_failure) {
+            size_t _Live = 0;
+            {
+                safe_concurrent_list<int, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live, 2});
+                GTEST_ASSERT_TRUE(_List.push_back(1));
+                GTEST_ASSERT_TRUE(_List.push_back(2));
+                GTEST_EXPECT_TRUE(!_List.push_front(3));
+                GTEST_EXPECT_TRUE(_List.size() == 2);
+                GTEST_EXPECT_TRUE(_List.remove(1) == 1);
+                GTEST_EXPECT_TRUE(_Live == 2); // retired, freed with the next batch
+                GTEST_EXPECT_TRUE(_List.reclaim() == 1);
+                GTEST_EXPECT_TRUE(_Live == 1);
+            }
+
+            GTEST_EXPECT_TRUE(_Live == 0);
+        }
+
+        TEST(concurrent_list, epoch_reclamation) {
+            size_t _Live = 0;
+            safe_concurrent_list<int, _Counting_allocator<int>> _List(_Counting_allocator<int>{&_Live});
+            for (int _Value = 0; _Value < 10; ++_Value) {
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+            }
+
+            ::std::atomic<int> _Step{0};
+            ::std::thread _Reader([&_Step] { // stays pinned until the main thread tried to reclaim
+                const ::mjx::safe_list_epoch_guard _Guard;
+                _Step.store(1);
+                while (_Step.load() != 2) {
+                    ::std::this_thread::yield();
+                }
+            });
+
+            while (_Step.load() != 1) {
+                ::std::this_thread::yield();
+            }
+
+            GTEST_EXPECT_TRUE(_List.remove_if([](const int _Value) noexcept { return _Value < 5; }) == 5);
+            GTEST_EXPECT_TRUE(_List.reclaim() == 0); // the reader may still reach the nodes
+            GTEST_EXPECT_TRUE(_Live == 10);
+            _Step.store(2);
+            _Reader.join();
+            GTEST_EXPECT_TRUE(_List.reclaim() == 5);
+            GTEST_EXPECT_TRUE(_Live == 5);
+            for (int _Value = 0; _Value < 200; ++_Value) { // full batches are reclaimed by the writers
+                GTEST_ASSERT_TRUE(_List.push_back(_Value));
+                GTEST_EXPECT_TRUE(_List.remove(_Value) >= 1);
+            }
+
+            GTEST_EXPECT_TRUE(_Live < 5 + ::mjx::_Safe_list_retire_list<int>::_Batch_size);
+        }
+
+        TEST(concurrent_list, concurrent_writers_and_readers) {
+            constexpr int _Writers = 4;
+            constexpr int _Count   = 2000;
+            safe_concurrent_list<int> _List;
+            ::std::atomic<bool> _Done{false};
+            ::std::vector<::std::thread> _Threads;
+            for (int _Id = 0; _Id < _Writers; ++_Id) {
+                _Threads.emplace_back([&_List, _Id] {
+                    for (int _Idx = 0; _Idx < _Count; ++_Idx) { // keeps the odd values of its own range
+                        const int _Value = _Id * _Count + _Idx;
+                        if (_Idx % 3 == 0) {
+                            while (!_List.push_front(_Value)) {}
+                        } else {
+                            while (!_List.insert_before(
+                                [](const int _Elem) noexcept { return _Elem % 2 == 0; }, _Value)) {}
+                        }
+                    }
+
+                    (void) _List.remove_if([_Id](const int _Elem) noexcept {
+                        return _Elem / _Count == _Id && _Elem % 2 == 0;
+                    });
+                });
+            }
+
+            bool _Bounded = true;
+            ::std::thread _Reader([&] {
+                while (!_Done.load()) {
+                    size_t _Seen = 0;
+                    _List.for_each([&_Seen](const int _Value) noexcept { _Seen += _Value >= 0 ? 1 : 0; });
+                    _Bounded = _Bounded && _Seen <= static_cast<size_t>(_Writers * _Count);
+                }
+            });
+
+            for (::std::thread& _Thread : _Threads) {
+                _Thread.join();
+            }
+
+            _Done.store(true);
+            _Reader.join();
+            GTEST_EXPECT_TRUE(_Bounded);
+            GTEST_EXPECT_TRUE(_List.size() == static_cast<size_t>(_Writers * _Count / 2));
+            GTEST_EXPECT_TRUE(_List.count_if([](const int _Value) noexcept { return _Value % 2 != 0; })
+                              == static_cast<size_t>(_Writers * _Count / 2));
+        }
+    } // namespace concurrent_list
+
+    inline namespace fault_injection {
+        struct _Fault_plan { // shared by all copies of a _Faulty_allocator
+            size_t _Live      = 0; // allocations that were not freed yet
+            size_t _Requests  = 0;
+            size_t _Fail_from = static_cast<size_t>(-1); // this request and all later ones fail
+        };
+
+        template <class _Ty>
+        class _Faulty_allocator { // fails every allocation from the chosen one on
+        public:
+            using value_type = _Ty;
+
+            _Fault_plan* _Plan;
+
+            explicit _Faulty_allocator(_Fault_plan* const _Plan) noexcept : _Plan(_Plan) {}
+
+            template <class _Other>
+            _Faulty_allocator(const _Faulty_allocator<_Other>& _Other_al) noexcept : _Plan(_Other_al._Plan) {}
+
+            _Ty* allocate(const size_t _Count) noexcept {
+                if (_Plan->_Requests++ >= _Plan->_Fail_from) { // inject a failure
+                    return nullptr;
+                }
+
+                ++_Plan->_Live;
+                return static_cast<_Ty*>(::operator new(_Count * sizeof(_Ty), ::std::nothrow));
+            }
+
+            void deallocate(_Ty* const _Ptr, size_t) noexcept {
+                --_Plan->_Live;
+                ::operator delete(_Ptr, ::std::nothrow);
+            }
+
+            template <class _Other>
+            bool operator==(const _Faulty_allocator<_Other>& _Other_al) const noexcept {
+                return _Plan == _Other_al._Plan;
+            }
+
+            template <class _Other>
+            bool operator!=(const _Faulty_allocator<_Other>& _Other_al) const noexcept {
+                return _Plan != _Other_al._Plan;
+            }
+        };
+
+        template <class _Storage, class _Op, class _Expected>
+        void _Sweep_failures(const _Op _Operation, const _Expected _Apply) {
+            // Note: Fails the first, then the second, ... allocation of _Operation until it succeeds.
+            //       A failed operation must leave the list unchanged and no allocation may outlive the list.
+            using _List_t = safe_list<int, _Faulty_allocator<int>, _Storage>;
+            for (size_t _Fail_from = 0;; ++_Fail_from) {
+                _Fault_plan _Plan;
+                bool _Done;
+                {
+                    _List_t _List(_Faulty_allocator<int>{&_Plan});
+                    GTEST_ASSERT_TRUE(_List.assign(_Sample_data::_Begin(), _Sample_data::_End()));
+                    ::std::list<int> _Oracle(_Sample_data::_Begin(), _Sample_data::_End());
+                    _Plan._Requests  = 0;
+                    _Plan._Fail_from = _Fail_from;
+                    _Done            = _Operation(_List);
+                    if (_Done) {
+                        _Apply(_Oracle);
+                    }
+
+                    GTEST_ASSERT_TRUE(_List.size() == _Oracle.size());
+                    GTEST_ASSERT_TRUE(::std::equal(_List.begin(), _List.end(), _Oracle.begin()));
+                    if constexpr (::std::is_same_v<_Storage, ::mjx::safe_list_heap_storage>) {
+                        GTEST_ASSERT_TRUE(_Plan._Live == _List.size() + _List.cached_nodes());
+                    }
+                }
+
+                GTEST_ASSERT_TRUE(_Plan._Live == 0);
+                if (_Done) { // with the heap storage, each of the swept operations allocates
+                    GTEST_EXPECT_TRUE(_Fail_from > 0 || !(::std::is_same_v<_Storage, ::mjx::safe_list_heap_storage>));
+                    break;
+                }
+            }
+        }
+
+        template <class _Storage>
+        void _Sweep_bulk_operations() {
+            using _Iter_t                   = typename safe_list<int, _Faulty_allocator<int>, _Storage>::iterator;
+            const ::std::vector<int> _Range = {7, 3, 7, 1, 9, 4, 4, 2, 8, 6, 5, 0};
+            _Sweep_failures<_Storage>([](auto& _List) { return _List.push_back(1); },
+                [](::std::list<int>& _Oracle) { _Oracle.push_back(1); });
+            _Sweep_failures<_Storage>([](auto& _List) { return _List.emplace(_List.iterator_at(4), 1) != _Iter_t{}; },
+                [](::std::list<int>& _Oracle) { _Oracle.insert(::std::next(_Oracle.begin(), 4), 1); });
+            _Sweep_failures<_Storage>(
+                [](auto& _List) { return _List.insert(_List.iterator_at(3), size_t{20}, 1) != _Iter_t{}; },
+                [](::std::list<int>& _Oracle) { _Oracle.insert(::std::next(_Oracle.begin(), 3), 20, 1); });
+            _Sweep_failures<_Storage>(
+                [&](auto& _List) {
+                    return _List.insert(_List.iterator_at(5), _Range.begin(), _Range.end()) != _Iter_t{};
+                },
+                [&](::std::list<int>& _Oracle) {
+                    _Oracle.insert(::std::next(_Oracle.begin(), 5), _Range.begin(), _Range.end());
+                });
+            _Sweep_failures<_Storage>([&](auto& _List) { return _List.append_range(_Range); },
+                [&](::std::list<int>& _Oracle) { _Oracle.insert(_Oracle.end(), _Range.begin(), _Range.end()); });
+            _Sweep_failures<_Storage>([&](auto& _List) { return _List.prepend_range(_Range); },
+                [&](::std::list<int>& _Oracle) { _Oracle.insert(_Oracle.begin(), _Range.begin(), _Range.end()); });
+            _Sweep_failures<_Storage>([&](auto& _List) { return _List.push_back_n(_Range.begin(), _Range.size()); },
+                [&](::std::list<int>& _Oracle) { _Oracle.insert(_Oracle.end(), _Range.begin(), _Range.end()); });
+            _Sweep_failures<_Storage>([](auto& _List) { return _List.assign(size_t{25}, 1); },
+                [](::std::list<int>& _Oracle) { _Oracle.assign(25, 1); });
+            _Sweep_failures<_Storage>([&](auto& _List) { return _List.assign(_Range.begin(), _Range.end()); },
+                [&](::std::list<int>& _Oracle) { _Oracle.assign(_Range.begin(), _Range.end()); });
+            _Sweep_failures<_Storage>([](auto& _List) { return _List.resize(30, 1); },
+                [](::std::list<int>& _Oracle) { _Oracle.resize(30, 1); });
+        }
+
+        TEST(fault_injection, bulk_operations) {
+            _Sweep_bulk_operations<::mjx::safe_list_heap_storage>();
+            _Sweep_bulk_operations<::mjx::safe_list_slab_storage<256>>();
+        }
+
+        TEST(fault_injection, dedupe_unsorted) {
+            // Note: Without its hash table dedupe_unsorted() falls back to a scan, the result is the same.
+            ::std::list<int> _Oracle(_Sample_data::_Begin(), _Sample_data::_End());
+            _Oracle.erase(::std::next(_Oracle.begin(), 6)); // the second 251
+            for (const size_t _Fail_from : {size_t{0}, static_cast<size_t>(-1)}) {
+                _Fault_plan _Plan;
+                {
+                    safe_list<int, _Faulty_allocator<int>> _List(_Faulty_allocator<int>{&_Plan});
+                    GTEST_ASSERT_TRUE(_List.assign(_Sample_data::_Begin(), _Sample_data::_End()));
+                    _Plan._Requests  = 0;
+                    _Plan._Fail_from = _Fail_from;
+                    GTEST_EXPECT_TRUE(_List.dedupe_unsorted() == 1);
+                    GTEST_EXPECT_TRUE(_Plan._Requests == 1); // the table was requested once
+                    GTEST_EXPECT_TRUE(::std::equal(_List.begin(), _List.end(), _Oracle.begin(), _Oracle.end()));
+                }
+
+                GTEST_EXPECT_TRUE(_Plan._Live == 0);
+            }
+        }
+
+        TEST(fault_injection, copies) {
+            // Note: A copy that runs out of memory holds a prefix of its source and leaks nothing.
+            for (size_t _Fail_from = 0; _Fail_from <= _Sample_data::_Size; ++_Fail_from) {
+                _Fault_plan _Plan;
+                {
+                    safe_list<int, _Faulty_allocator<int>> _List(_Faulty_allocator<int>{&_Plan});
+                    GTEST_ASSERT_TRUE(_List.assign(_Sample_data::_Begin(), _Sample_data::_End()));
+                    _Plan._Requests  = 0;
+                    _Plan._Fail_from = _Fail_from;
+                    const safe_list<int, _Faulty_allocator<int>> _Copy(_List);
+                    GTEST_EXPECT_TRUE(_Copy.size() <= _Fail_from);
+                    GTEST_EXPECT_TRUE(::std::equal(_Copy.begin(), _Copy.end(), _Sample_data::_Begin()));
+                }
+
+                GTEST_EXPECT_TRUE(_Plan._Live == 0);
+            }
+        }
+    } // namespace fault_injection
+
+    inline namespace checked_iterators {
+        TEST(checked_iterators, layout) {
+            // Note: Without SAFE_LIST_CHECKED_ITERATORS an iterator is nothing but a node pointer.
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+            GTEST_EXPECT_TRUE(sizeof(safe_list<int>::iterator) == 2 * sizeof(void*));
+#else // ^^^ SAFE_LIST_CHECKED_ITERATORS ^^^ / vvv !SAFE_LIST_CHECKED_ITERATORS vvv
+            GTEST_EXPECT_TRUE(sizeof(safe_list<int>::iterator) == sizeof(void*));
+            GTEST_EXPECT_TRUE(sizeof(safe_list<int>::const_reverse_iterator) == sizeof(void*));
+#endif // SAFE_LIST_CHECKED_ITERATORS
+        }
+
+#ifdef SAFE_LIST_CHECKED_ITERATORS
+        TEST(checked_iterators, end_iterator) {
+            safe_list<int> _List = _Sample_data::_Init_list();
+            EXPECT_DEATH((void) *_List.end(), "cannot be dereferenced");
+            EXPECT_DEATH(++_List.end(), "cannot be dereferenced");
+            EXPECT_DEATH((void) *_List.crend(), "cannot be dereferenced");
+        }
+
+        TEST(checked_iterators, foreign_iterator) {
+            safe_list<int> _List  = _Sample_data::_Init_list();
+            safe_list<int> _Other = _Sample_data::_Init_list();
+            EXPECT_DEATH((void) (_List.begin() == _Other.begin()), "different lists");
+            EXPECT_DEATH((void) _List.erase(_Other.begin()), "another list");
+            EXPECT_DEATH((void) _List.insert(_Other.end(), 1), "another list");
+            EXPECT_DEATH((void) _List.splice(_List.end(), _Other, _List.begin()), "another list");
+
+            // Note: Default constructed iterators have no owner.
+            GTEST_EXPECT_TRUE(_List.begin() != safe_list<int>::iterator{});
+            GTEST_EXPECT_TRUE(_List.splice(_List.end(), _Other, _Other.begin()));
+            GTEST_EXPECT_TRUE(_List.size() == _Sample_data::_Size + 1);
+        }
+
+        TEST(checked_iterators, erase_end) {
+            safe_list<int> _List = _Sample_data::_Init_list();
+            EXPECT_DEATH((void) _List.erase(_List.cend()), "cannot be erased");
+            GTEST_EXPECT_TRUE(_List.size() == _Sample_data::_Size);
+            _List.clear();
+            GTEST_EXPECT_TRUE(!_List.erase(_List.cend()).valid()); // nothing to erase, nothing is checked
+        }
+#endif // SAFE_LIST_CHECKED_ITERATORS
+    } // namespace checked_iterators
 } // namespace tests
 
 int main() {